@@ -0,0 +1,1031 @@
+/* Accuracy and conformance harness.
+ *
+ * Every transform is checked against a long double reference before it is
+ * timed, and its error reported with the timings as the counters:
+ *
+ *   max_error - the largest error in any output divided by the largest output
+ *   rms_error - the rms error divided by the rms output
+ *   rms_ulps  - rms_error in units of the precision's machine epsilon
+ *
+ * A transform fails if its rms_ulps is more than --tolerance (default 2)
+ * times log2 of its size. Failures are labelled FAIL, listed at the end of
+ * the run, and give a non-zero exit status.
+ *
+ * In multi-backend builds the 1-D transforms are checked for every backend,
+ * including the variants of the native implementation which always use
+ * Rader's or Bluestein's algorithm. The reference is only more accurate
+ * than the transforms under test where long double is wider than the
+ * precision atfft was built with, so in long double builds the errors are
+ * better compared between backends than against the tolerance.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <limits>
+#include <complex>
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <atfft/atfft.h>
+
+#ifndef BENCHMARK_IMPL
+#define BENCHMARK_IMPL "native"
+#endif
+
+typedef std::complex <long double> Complex;
+typedef std::vector <long double> Signal;
+
+static const long double pi = 3.141592653589793238462643383279502884L;
+
+/* Reference transforms ******************************************************/
+
+static bool isPowerOf2 (int n)
+{
+    return n > 0 && !(n & (n - 1));
+}
+
+/* An in place radix-2 FFT, computing each twiddle factor directly. */
+static void referenceFftPowerOf2 (std::vector <Complex> &x, int sign)
+{
+    int n = x.size();
+
+    for (int i = 1, j = 0; i < n; ++i)
+    {
+        int bit = n >> 1;
+
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+
+        j ^= bit;
+
+        if (i < j)
+            std::swap (x [i], x [j]);
+    }
+
+    for (int length = 2; length <= n; length <<= 1)
+    {
+        std::vector <Complex> twiddles (length / 2);
+
+        for (int k = 0; k < length / 2; ++k)
+        {
+            long double angle = sign * 2.0L * pi * k / length;
+            twiddles [k] = Complex (cosl (angle), sinl (angle));
+        }
+
+        for (int i = 0; i < n; i += length)
+        {
+            for (int k = 0; k < length / 2; ++k)
+            {
+                Complex a = x [i + k];
+                Complex b = x [i + k + length / 2] * twiddles [k];
+
+                x [i + k] = a + b;
+                x [i + k + length / 2] = a - b;
+            }
+        }
+    }
+}
+
+/* A DFT of any length, using Bluestein's algorithm
+ * for lengths which aren't powers of 2. */
+static std::vector <Complex> referenceDft (const std::vector <Complex> &x, int sign)
+{
+    int n = x.size();
+
+    if (isPowerOf2 (n))
+    {
+        std::vector <Complex> y (x);
+        referenceFftPowerOf2 (y, sign);
+        return y;
+    }
+
+    int m = 1;
+
+    while (m < 2 * n - 1)
+        m <<= 1;
+
+    /* the chirp, with n^2 reduced modulo 2n to keep the angles accurate */
+    std::vector <Complex> chirp (n);
+
+    for (int i = 0; i < n; ++i)
+    {
+        long long r = ((long long) i * i) % (2 * n);
+        long double angle = sign * pi * r / n;
+        chirp [i] = Complex (cosl (angle), sinl (angle));
+    }
+
+    std::vector <Complex> a (m), b (m);
+
+    for (int i = 0; i < n; ++i)
+    {
+        a [i] = x [i] * chirp [i];
+        b [i] = std::conj (chirp [i]);
+
+        if (i > 0)
+            b [m - i] = b [i];
+    }
+
+    referenceFftPowerOf2 (a, -1);
+    referenceFftPowerOf2 (b, -1);
+
+    for (int i = 0; i < m; ++i)
+    {
+        a [i] *= b [i];
+    }
+
+    referenceFftPowerOf2 (a, 1);
+
+    std::vector <Complex> y (n);
+
+    for (int i = 0; i < n; ++i)
+    {
+        y [i] = chirp [i] * a [i] / (long double) m;
+    }
+
+    return y;
+}
+
+static int product (const std::vector <int> &dims)
+{
+    int p = 1;
+
+    for (int d : dims)
+        p *= d;
+
+    return p;
+}
+
+/* An n-dimensional DFT, transforming each dimension in turn. */
+static std::vector <Complex> referenceDftNd (std::vector <Complex> x, const std::vector <int> &dims, int sign)
+{
+    int total = product (dims);
+    int stride = total;
+
+    for (int size : dims)
+    {
+        stride /= size;
+        std::vector <Complex> line (size);
+
+        for (int start = 0; start < total; ++start)
+        {
+            /* only start from the first element of each line */
+            if ((start / stride) % size)
+                continue;
+
+            for (int i = 0; i < size; ++i)
+                line [i] = x [start + i * stride];
+
+            line = referenceDft (line, sign);
+
+            for (int i = 0; i < size; ++i)
+                x [start + i * stride] = line [i];
+        }
+    }
+
+    return x;
+}
+
+/* The full spectrum of a real signal from the halfcomplex
+ * spectrum stored by atfft's real transforms. */
+static std::vector <Complex> fromHalfcomplex (const std::vector <Complex> &halfcomplex, const std::vector <int> &dims)
+{
+    int n_dims = dims.size();
+    int last = dims [n_dims - 1];
+    int halfcomplexLast = atfft_halfcomplex_size (last);
+    int total = product (dims);
+    std::vector <Complex> full (total);
+    std::vector <int> index (n_dims);
+
+    for (int i = 0; i < total; ++i)
+    {
+        int r = i;
+
+        for (int d = n_dims - 1; d >= 0; --d)
+        {
+            index [d] = r % dims [d];
+            r /= dims [d];
+        }
+
+        bool conjugate = index [n_dims - 1] >= halfcomplexLast;
+        int h = 0;
+
+        for (int d = 0; d < n_dims - 1; ++d)
+        {
+            int k = conjugate ? (dims [d] - index [d]) % dims [d] : index [d];
+            h = h * dims [d] + k;
+        }
+
+        int k = conjugate ? last - index [n_dims - 1] : index [n_dims - 1];
+        h = h * halfcomplexLast + k;
+
+        full [i] = conjugate ? std::conj (halfcomplex [h]) : halfcomplex [h];
+    }
+
+    return full;
+}
+
+/* The halfcomplex part of a full spectrum. */
+static std::vector <Complex> toHalfcomplex (const std::vector <Complex> &full, const std::vector <int> &dims)
+{
+    int last = dims [dims.size() - 1];
+    int halfcomplexLast = atfft_halfcomplex_size (last);
+    int rows = product (dims) / last;
+    std::vector <Complex> halfcomplex (rows * halfcomplexLast);
+
+    for (int r = 0; r < rows; ++r)
+    {
+        for (int k = 0; k < halfcomplexLast; ++k)
+            halfcomplex [r * halfcomplexLast + k] = full [r * last + k];
+    }
+
+    return halfcomplex;
+}
+
+/* A table of cos (pi * m / denominator) and sin (pi * m / denominator). */
+struct TrigTable
+{
+    long long denominator;
+    Signal c, s;
+
+    explicit TrigTable (long long d)
+        : denominator (d), c (2 * d), s (2 * d)
+    {
+        for (long long m = 0; m < 2 * d; ++m)
+        {
+            c [m] = cosl (pi * m / d);
+            s [m] = sinl (pi * m / d);
+        }
+    }
+
+    long double cos (long long numerator) const { return c [numerator % (2 * denominator)]; }
+    long double sin (long long numerator) const { return s [numerator % (2 * denominator)]; }
+};
+
+static int dctOutputSize (atfft_dct_type type, int size)
+{
+    return type == ATFFT_IMDCT ? 2 * size : size;
+}
+
+static int dctInputSize (atfft_dct_type type, int size)
+{
+    return type == ATFFT_MDCT ? 2 * size : size;
+}
+
+/* The cosine and sine transforms, straight from their definitions in atfft/dct.h. */
+static Signal referenceDct (const Signal &x, atfft_dct_type type, int n)
+{
+    Signal y (dctOutputSize (type, n), 0.0L);
+
+    switch (type)
+    {
+        case ATFFT_DCT_I:
+        {
+            TrigTable t (n - 1);
+
+            for (int k = 0; k < n; ++k)
+            {
+                y [k] = 0.5L * (x [0] + (k % 2 ? -x [n - 1] : x [n - 1]));
+
+                for (int i = 1; i < n - 1; ++i)
+                    y [k] += x [i] * t.cos ((long long) i * k);
+            }
+
+            break;
+        }
+
+        case ATFFT_DCT_II:
+        {
+            TrigTable t (2 * n);
+
+            for (int k = 0; k < n; ++k)
+                for (int i = 0; i < n; ++i)
+                    y [k] += x [i] * t.cos ((2LL * i + 1) * k);
+
+            break;
+        }
+
+        case ATFFT_DCT_III:
+        {
+            TrigTable t (2 * n);
+
+            for (int k = 0; k < n; ++k)
+            {
+                y [k] = 0.5L * x [0];
+
+                for (int i = 1; i < n; ++i)
+                    y [k] += x [i] * t.cos (i * (2LL * k + 1));
+            }
+
+            break;
+        }
+
+        case ATFFT_DCT_IV:
+        {
+            TrigTable t (4 * n);
+
+            for (int k = 0; k < n; ++k)
+                for (int i = 0; i < n; ++i)
+                    y [k] += x [i] * t.cos ((2LL * i + 1) * (2LL * k + 1));
+
+            break;
+        }
+
+        case ATFFT_DST_I:
+        {
+            TrigTable t (n + 1);
+
+            for (int k = 0; k < n; ++k)
+                for (int i = 0; i < n; ++i)
+                    y [k] += x [i] * t.sin ((i + 1LL) * (k + 1LL));
+
+            break;
+        }
+
+        case ATFFT_DST_II:
+        {
+            TrigTable t (2 * n);
+
+            for (int k = 0; k < n; ++k)
+                for (int i = 0; i < n; ++i)
+                    y [k] += x [i] * t.sin ((2LL * i + 1) * (k + 1LL));
+
+            break;
+        }
+
+        case ATFFT_DST_III:
+        {
+            TrigTable t (2 * n);
+
+            for (int k = 0; k < n; ++k)
+            {
+                y [k] = 0.5L * (k % 2 ? -x [n - 1] : x [n - 1]);
+
+                for (int i = 0; i < n - 1; ++i)
+                    y [k] += x [i] * t.sin ((i + 1LL) * (2LL * k + 1));
+            }
+
+            break;
+        }
+
+        case ATFFT_DST_IV:
+        {
+            TrigTable t (4 * n);
+
+            for (int k = 0; k < n; ++k)
+                for (int i = 0; i < n; ++i)
+                    y [k] += x [i] * t.sin ((2LL * i + 1) * (2LL * k + 1));
+
+            break;
+        }
+
+        case ATFFT_MDCT:
+        {
+            TrigTable t (4 * n);
+
+            for (int k = 0; k < n; ++k)
+                for (int i = 0; i < 2 * n; ++i)
+                    y [k] += x [i] * t.cos ((2LL * i + 1 + n) * (2LL * k + 1));
+
+            break;
+        }
+
+        case ATFFT_IMDCT:
+        {
+            TrigTable t (4 * n);
+
+            for (int i = 0; i < 2 * n; ++i)
+                for (int k = 0; k < n; ++k)
+                    y [i] += x [k] * t.cos ((2LL * i + 1 + n) * (2LL * k + 1));
+
+            break;
+        }
+    }
+
+    return y;
+}
+
+/* Test cases ****************************************************************/
+
+enum Kind
+{
+    COMPLEX_FORWARD,
+    COMPLEX_BACKWARD,
+    REAL_FORWARD,
+    REAL_BACKWARD,
+    ND_COMPLEX_FORWARD,
+    ND_REAL_FORWARD,
+    ND_REAL_BACKWARD,
+    DCT,
+    DCT_BATCH
+};
+
+static const char *kindNames [] =
+{
+    "dft_complex_forward",
+    "dft_complex_backward",
+    "dft_real_forward",
+    "dft_real_backward",
+    "dft_nd_complex_forward",
+    "dft_nd_real_forward",
+    "dft_nd_real_backward",
+    "dct",
+    "dct_batch"
+};
+
+static const char *dctTypeNames [] =
+{
+    "dct_i", "dct_ii", "dct_iii", "dct_iv", "dst_i", "dst_ii", "dst_iii", "dst_iv", "mdct", "imdct"
+};
+
+struct Error
+{
+    double max, rms;
+};
+
+struct Case
+{
+    Kind kind;
+    std::string backend;
+    std::vector <int> dims;
+    atfft_dct_type dctType;
+
+    std::string name;
+    bool checked;
+    Error error;
+};
+
+static double tolerance = 2.0;
+static std::vector <const Case*> failures;
+
+static std::string dimsString (const std::vector <int> &dims)
+{
+    std::string s;
+
+    for (size_t i = 0; i < dims.size(); ++i)
+        s += (i ? "x" : "") + std::to_string (dims [i]);
+
+    return s;
+}
+
+/* Random samples in [-1, 1), the same for every backend. */
+static std::vector <atfft_sample> randomSamples (int n, int seed)
+{
+    std::mt19937 generator (seed);
+    std::uniform_real_distribution <double> distribution (-1.0, 1.0);
+    std::vector <atfft_sample> x (n);
+
+    for (auto &sample : x)
+        sample = distribution (generator);
+
+    return x;
+}
+
+static std::vector <Complex> toComplex (const std::vector <atfft_sample> &x)
+{
+    std::vector <Complex> c (x.size() / 2);
+
+    for (size_t i = 0; i < c.size(); ++i)
+        c [i] = Complex (x [2 * i], x [2 * i + 1]);
+
+    return c;
+}
+
+static std::vector <Complex> toComplexReal (const std::vector <atfft_sample> &x)
+{
+    return std::vector <Complex> (x.begin(), x.end());
+}
+
+/* Round a reference spectrum to atfft_complex values. */
+static std::vector <atfft_sample> toSamples (const std::vector <Complex> &c)
+{
+    std::vector <atfft_sample> x (2 * c.size());
+
+    for (size_t i = 0; i < c.size(); ++i)
+    {
+        x [2 * i] = c [i].real();
+        x [2 * i + 1] = c [i].imag();
+    }
+
+    return x;
+}
+
+/* Compare complex outputs with the reference. */
+static Error complexError (const std::vector <atfft_sample> &y, const std::vector <Complex> &reference)
+{
+    long double errorSquares = 0.0L, referenceSquares = 0.0L, maxError = 0.0L, maxReference = 0.0L;
+
+    for (size_t i = 0; i < reference.size(); ++i)
+    {
+        long double e = std::abs (Complex (y [2 * i], y [2 * i + 1]) - reference [i]);
+        long double r = std::abs (reference [i]);
+
+        errorSquares += e * e;
+        referenceSquares += r * r;
+        maxError = std::max (maxError, e);
+        maxReference = std::max (maxReference, r);
+    }
+
+    return {(double) (maxError / maxReference), (double) sqrtl (errorSquares / referenceSquares)};
+}
+
+/* Compare real outputs with the reference. */
+static Error realError (const std::vector <atfft_sample> &y, const Signal &reference)
+{
+    long double errorSquares = 0.0L, referenceSquares = 0.0L, maxError = 0.0L, maxReference = 0.0L;
+
+    for (size_t i = 0; i < reference.size(); ++i)
+    {
+        long double e = fabsl (y [i] - reference [i]);
+        long double r = fabsl (reference [i]);
+
+        errorSquares += e * e;
+        referenceSquares += r * r;
+        maxError = std::max (maxError, e);
+        maxReference = std::max (maxReference, r);
+    }
+
+    return {(double) (maxError / maxReference), (double) sqrtl (errorSquares / referenceSquares)};
+}
+
+static Signal realParts (const std::vector <Complex> &c)
+{
+    Signal r (c.size());
+
+    for (size_t i = 0; i < c.size(); ++i)
+        r [i] = c [i].real();
+
+    return r;
+}
+
+/* Running transforms ********************************************************/
+
+static atfft_dft* createDft (const Case &c, atfft_direction direction, atfft_format format)
+{
+#ifdef ATFFT_MULTI_BACKEND
+    return atfft_dft_create_with_backend (c.backend.c_str(), c.dims [0], direction, format);
+#else
+    return atfft_dft_create (c.dims [0], direction, format);
+#endif
+}
+
+/* Create a plan, work out its error from one transform of the test signal,
+ * then time it. The error is only worked out the first time the benchmark
+ * runs. */
+static void runDft (benchmark::State &state, Case *c)
+{
+    int size = c->dims [0];
+    bool complex = c->kind == COMPLEX_FORWARD || c->kind == COMPLEX_BACKWARD;
+    bool forward = c->kind == COMPLEX_FORWARD || c->kind == REAL_FORWARD;
+    atfft_dft *fft = createDft (*c,
+                                forward ? ATFFT_FORWARD : ATFFT_BACKWARD,
+                                complex ? ATFFT_COMPLEX : ATFFT_REAL);
+
+    if (!fft)
+    {
+        state.SkipWithError ("couldn't create plan");
+        return;
+    }
+
+    int halfcomplexSize = atfft_halfcomplex_size (size);
+    std::vector <atfft_sample> in, out;
+    Signal realReference;
+    std::vector <Complex> complexReference;
+
+    switch (c->kind)
+    {
+        case COMPLEX_FORWARD:
+        case COMPLEX_BACKWARD:
+            in = randomSamples (2 * size, size);
+            out.resize (2 * size);
+
+            if (!c->checked)
+                complexReference = referenceDft (toComplex (in), forward ? -1 : 1);
+
+            break;
+
+        case REAL_FORWARD:
+            in = randomSamples (size, size);
+            out.resize (2 * halfcomplexSize);
+
+            if (!c->checked)
+                complexReference = toHalfcomplex (referenceDft (toComplexReal (in), -1), c->dims);
+
+            break;
+
+        default:
+            /* the spectrum of a real signal, rounded to the working precision */
+            in = toSamples (toHalfcomplex (referenceDft (toComplexReal (randomSamples (size, size)), -1), c->dims));
+            out.resize (size);
+
+            if (!c->checked)
+                realReference = realParts (referenceDft (fromHalfcomplex (toComplex (in), c->dims), 1));
+    }
+
+    /* the input is copied each time, as real backward transforms may overwrite it */
+    std::vector <atfft_sample> work (in);
+    auto transform = [&]()
+    {
+        if (complex)
+            atfft_dft_complex_transform (fft, (atfft_complex*) work.data(), (atfft_complex*) out.data());
+        else if (forward)
+            atfft_dft_real_forward_transform (fft, work.data(), (atfft_complex*) out.data());
+        else
+            atfft_dft_real_backward_transform (fft, (atfft_complex*) work.data(), out.data());
+    };
+
+    if (!c->checked)
+    {
+        transform();
+        c->error = complexReference.empty() ? realError (out, realReference) : complexError (out, complexReference);
+        c->checked = true;
+    }
+
+    for (auto _ : state)
+    {
+        transform();
+    }
+
+    atfft_dft_destroy (fft);
+}
+
+static void runDftNd (benchmark::State &state, Case *c)
+{
+    int n_dims = c->dims.size();
+    int size = product (c->dims);
+    int halfcomplexSize = atfft_nd_halfcomplex_size (c->dims.data(), n_dims);
+    bool complex = c->kind == ND_COMPLEX_FORWARD;
+    bool forward = c->kind != ND_REAL_BACKWARD;
+    atfft_dft_nd *fft = atfft_dft_nd_create (c->dims.data(),
+                                             n_dims,
+                                             forward ? ATFFT_FORWARD : ATFFT_BACKWARD,
+                                             complex ? ATFFT_COMPLEX : ATFFT_REAL);
+
+    if (!fft)
+    {
+        state.SkipWithError ("couldn't create plan");
+        return;
+    }
+
+    std::vector <atfft_sample> in, out;
+    Signal realReference;
+    std::vector <Complex> complexReference;
+
+    switch (c->kind)
+    {
+        case ND_COMPLEX_FORWARD:
+            in = randomSamples (2 * size, size);
+            out.resize (2 * size);
+
+            if (!c->checked)
+                complexReference = referenceDftNd (toComplex (in), c->dims, -1);
+
+            break;
+
+        case ND_REAL_FORWARD:
+            in = randomSamples (size, size);
+            out.resize (2 * halfcomplexSize);
+
+            if (!c->checked)
+                complexReference = toHalfcomplex (referenceDftNd (toComplexReal (in), c->dims, -1), c->dims);
+
+            break;
+
+        default:
+            in = toSamples (toHalfcomplex (referenceDftNd (toComplexReal (randomSamples (size, size)), c->dims, -1),
+                                           c->dims));
+            out.resize (size);
+
+            if (!c->checked)
+                realReference = realParts (referenceDftNd (fromHalfcomplex (toComplex (in), c->dims), c->dims, 1));
+    }
+
+    std::vector <atfft_sample> work (in);
+    auto transform = [&]()
+    {
+        if (complex)
+            atfft_dft_nd_complex_transform (fft, (atfft_complex*) work.data(), (atfft_complex*) out.data());
+        else if (forward)
+            atfft_dft_nd_real_forward_transform (fft, work.data(), (atfft_complex*) out.data());
+        else
+            atfft_dft_nd_real_backward_transform (fft, (atfft_complex*) work.data(), out.data());
+    };
+
+    if (!c->checked)
+    {
+        transform();
+        c->error = complexReference.empty() ? realError (out, realReference) : complexError (out, complexReference);
+        c->checked = true;
+    }
+
+    for (auto _ : state)
+    {
+        transform();
+    }
+
+    atfft_dft_nd_destroy (fft);
+}
+
+static void runDct (benchmark::State &state, Case *c)
+{
+    int size = c->dims [0];
+    atfft_dct *dct = atfft_dct_create_type (size, c->dctType);
+
+    if (!dct)
+    {
+        state.SkipWithError ("couldn't create plan");
+        return;
+    }
+
+    std::vector <atfft_sample> in = randomSamples (dctInputSize (c->dctType, size), size);
+    std::vector <atfft_sample> out (dctOutputSize (c->dctType, size));
+
+    if (!c->checked)
+    {
+        atfft_dct_transform (dct, in.data(), out.data());
+        c->error = realError (out, referenceDct (Signal (in.begin(), in.end()), c->dctType, size));
+        c->checked = true;
+    }
+
+    for (auto _ : state)
+    {
+        atfft_dct_transform (dct, in.data(), out.data());
+    }
+
+    atfft_dct_destroy (dct);
+}
+
+/* A batch of DCT-II or DCT-III with truncated outputs, dims holds the size and number of outputs. The signals are
+ * spaced further apart than their length to check the distances are used. */
+static const int dctBatchFrames = 50;
+
+static void runDctBatch (benchmark::State &state, Case *c)
+{
+    int size = c->dims [0];
+    int nOutputs = c->dims [1];
+    int inDist = size + 3;
+    int outDist = nOutputs + 1;
+    atfft_direction direction = c->dctType == ATFFT_DCT_II ? ATFFT_FORWARD : ATFFT_BACKWARD;
+    atfft_dct_batch *batch = atfft_dct_batch_create (size, dctBatchFrames, inDist, outDist, nOutputs, direction);
+
+    if (!batch)
+    {
+        state.SkipWithError ("couldn't create plan");
+        return;
+    }
+
+    std::vector <atfft_sample> in = randomSamples (dctBatchFrames * inDist, size);
+    std::vector <atfft_sample> out (dctBatchFrames * outDist);
+
+    if (!c->checked)
+    {
+        std::vector <atfft_sample> y;
+        Signal reference;
+
+        atfft_dct_batch_transform (batch, in.data(), out.data());
+
+        for (int frame = 0; frame < dctBatchFrames; ++frame)
+        {
+            Signal x (in.begin() + frame * inDist, in.begin() + frame * inDist + size);
+            Signal r = referenceDct (x, c->dctType, size);
+
+            y.insert (y.end(), out.begin() + frame * outDist, out.begin() + frame * outDist + nOutputs);
+            reference.insert (reference.end(), r.begin(), r.begin() + nOutputs);
+        }
+
+        c->error = realError (y, reference);
+        c->checked = true;
+    }
+
+    for (auto _ : state)
+    {
+        atfft_dct_batch_transform (batch, in.data(), out.data());
+    }
+
+    atfft_dct_batch_destroy (batch);
+}
+
+/* The error relative to the precision, failing the case if it is too large. */
+static void reportError (benchmark::State &state, const Case *c)
+{
+    double epsilon = std::numeric_limits <atfft_sample>::epsilon();
+    double ulps = c->error.rms / epsilon;
+    int size = c->kind == DCT_BATCH ? c->dims [0] : product (c->dims);
+
+    state.counters ["max_error"] = c->error.max;
+    state.counters ["rms_error"] = c->error.rms;
+    state.counters ["rms_ulps"] = ulps;
+
+    if (!(ulps <= tolerance * std::max (1.0, std::log2 ((double) size))))
+    {
+        state.SetLabel ("FAIL");
+
+        if (std::find (failures.begin(), failures.end(), c) == failures.end())
+            failures.push_back (c);
+    }
+}
+
+static void runCase (benchmark::State &state, Case *c)
+{
+    switch (c->kind)
+    {
+        case COMPLEX_FORWARD:
+        case COMPLEX_BACKWARD:
+        case REAL_FORWARD:
+        case REAL_BACKWARD:
+            runDft (state, c);
+            break;
+
+        case ND_COMPLEX_FORWARD:
+        case ND_REAL_FORWARD:
+        case ND_REAL_BACKWARD:
+            runDftNd (state, c);
+            break;
+
+        case DCT:
+            runDct (state, c);
+            break;
+
+        case DCT_BATCH:
+            runDctBatch (state, c);
+    }
+
+    if (c->checked)
+        reportError (state, c);
+}
+
+/* Registering cases *********************************************************/
+
+static const int dftSizes [] =
+{
+    /* powers of 2 */
+    16, 64, 256, 1024, 4096, 16384, 65536,
+    /* primes */
+    17, 67, 257, 1031, 4099, 16381, 65537,
+    /* composites */
+    12, 30, 360, 2310, 19683, 27000
+};
+
+static const std::vector <int> ndShapes [] =
+{
+    {64, 64}, {256, 256}, {30, 42}, {17, 31}, {16, 16, 16}, {12, 10, 14}
+};
+
+static const int dctSizes [] =
+{
+    16, 64, 256, 1024, 17, 257, 1031, 30, 360
+};
+
+/* signal lengths and numbers of outputs, e.g. 40 mel bands to 13 MFCCs */
+static const std::vector <int> dctBatchShapes [] =
+{
+    {40, 13}, {40, 40}, {17, 5}, {64, 64}, {256, 32}
+};
+
+static std::vector <Case> cases;
+
+static void addCase (Kind kind, const std::string &backend, const std::vector <int> &dims, atfft_dct_type type)
+{
+    std::string kindName = kind == DCT ? dctTypeNames [type] : kindNames [kind];
+
+    if (kind == DCT_BATCH)
+        kindName += std::string ("_") + (type == ATFFT_DCT_II ? "ii" : "iii");
+    std::string name = kindName + "/" + backend + "/" + dimsString (dims);
+
+    cases.push_back ({kind, backend, dims, type, name, false, {0.0, 0.0}});
+}
+
+static bool isSupportedDft (const std::string &backend, int size, atfft_format format)
+{
+#ifdef ATFFT_MULTI_BACKEND
+    const atfft_dft_backend *b = atfft_dft_find_backend (backend.c_str());
+    return b && (!b->is_supported_size || b->is_supported_size (size, format));
+#else
+    return atfft_dft_is_supported_size (size, format);
+#endif
+}
+
+static bool isSupportedNd (const std::vector <int> &dims, atfft_format format)
+{
+    for (size_t i = 0; i < dims.size(); ++i)
+    {
+        bool last = i == dims.size() - 1;
+
+        if (!atfft_dft_is_supported_size (dims [i], last ? format : ATFFT_COMPLEX))
+            return false;
+    }
+
+    return true;
+}
+
+static void addCases()
+{
+    std::vector <std::string> backends;
+
+#ifdef ATFFT_MULTI_BACKEND
+    for (int i = 0; i < atfft_dft_n_backends(); ++i)
+        backends.push_back (atfft_dft_get_backend (i)->name);
+#else
+    backends.push_back (BENCHMARK_IMPL);
+#endif
+
+    for (const auto &backend : backends)
+    {
+        for (int size : dftSizes)
+        {
+            if (isSupportedDft (backend, size, ATFFT_COMPLEX))
+            {
+                addCase (COMPLEX_FORWARD, backend, {size}, ATFFT_DCT_II);
+                addCase (COMPLEX_BACKWARD, backend, {size}, ATFFT_DCT_II);
+            }
+
+            if (isSupportedDft (backend, size, ATFFT_REAL))
+            {
+                addCase (REAL_FORWARD, backend, {size}, ATFFT_DCT_II);
+                addCase (REAL_BACKWARD, backend, {size}, ATFFT_DCT_II);
+            }
+        }
+    }
+
+    /* n-dimensional transforms and DCTs use the default backend */
+    for (const auto &shape : ndShapes)
+    {
+        if (isSupportedNd (shape, ATFFT_COMPLEX))
+            addCase (ND_COMPLEX_FORWARD, BENCHMARK_IMPL, shape, ATFFT_DCT_II);
+
+        if (isSupportedNd (shape, ATFFT_REAL))
+        {
+            addCase (ND_REAL_FORWARD, BENCHMARK_IMPL, shape, ATFFT_DCT_II);
+            addCase (ND_REAL_BACKWARD, BENCHMARK_IMPL, shape, ATFFT_DCT_II);
+        }
+    }
+
+    for (int type = ATFFT_DCT_I; type <= ATFFT_IMDCT; ++type)
+    {
+        for (int size : dctSizes)
+        {
+            if (atfft_dct_is_supported_type (size, (atfft_dct_type) type))
+                addCase (DCT, BENCHMARK_IMPL, {size}, (atfft_dct_type) type);
+        }
+    }
+
+    /* Short batches are a matrix multiply, longer ones need a DCT plan (see dct_batch.c). */
+    for (const auto &shape : dctBatchShapes)
+    {
+        if (shape [0] <= 64 || atfft_dct_is_supported_size (shape [0]))
+        {
+            addCase (DCT_BATCH, BENCHMARK_IMPL, shape, ATFFT_DCT_II);
+            addCase (DCT_BATCH, BENCHMARK_IMPL, shape, ATFFT_DCT_III);
+        }
+    }
+}
+
+/* Take --tolerance=<value> out of the arguments before
+ * they are passed on to Google Benchmark. */
+static void parseTolerance (int *argc, char **argv)
+{
+    const char *flag = "--tolerance=";
+    int n = 1;
+
+    for (int i = 1; i < *argc; ++i)
+    {
+        if (!strncmp (argv [i], flag, strlen (flag)))
+            tolerance = atof (argv [i] + strlen (flag));
+        else
+            argv [n++] = argv [i];
+    }
+
+    *argc = n;
+}
+
+int main (int argc, char **argv)
+{
+    parseTolerance (&argc, argv);
+    benchmark::Initialize (&argc, argv);
+
+    if (benchmark::ReportUnrecognizedArguments (argc, argv))
+        return 1;
+
+    addCases();
+
+    for (auto &c : cases)
+        benchmark::RegisterBenchmark (c.name.c_str(), runCase, &c);
+
+    benchmark::RunSpecifiedBenchmarks();
+
+    if (!failures.empty())
+    {
+        fprintf (stderr, "\n%d transforms exceeded the error tolerance:\n", (int) failures.size());
+
+        for (const Case *c : failures)
+            fprintf (stderr, "    %s (%.3g ulps rms)\n", c->name.c_str(), c->error.rms / (double) std::numeric_limits <atfft_sample>::epsilon());
+
+        return 1;
+    }
+
+    return 0;
+}
@@ -1,17 +1,59 @@
 #include <cstdlib>
 #include <ctime>
 #include <cmath>
+#include <chrono>
+#include <algorithm>
+#include <vector>
 #include <benchmark/benchmark.h>
 #include <atfft/atfft.h>
+#include <atfft/convolver.h>
+#include <atfft/sliding_dft.h>
+#include <atfft/goertzel.h>
+#include <atfft/channelizer.h>
+
+#if defined(__APPLE__)
+#   include <malloc/malloc.h>
+#elif defined(__GLIBC__)
+#   include <malloc.h>
+#endif
 
 float randomFloat()
 {
     return (float) rand() / (float) RAND_MAX;
 }
 
+/* FFTW's estimate of the number of operations in a transform, 5 N log2 (N)
+ * for complex data and half that for real data, reported as MFLOPS so that
+ * transforms of different sizes and implementations can be compared. */
+static void reportMflops (benchmark::State &state, int size, atfft_format format)
+{
+    double flops = (format == ATFFT_REAL ? 2.5 : 5.0) * size * std::log2 (size);
+
+    state.counters ["mflops"] = benchmark::Counter (flops * state.iterations() / 1e6, benchmark::Counter::kIsRate);
+}
+
+/* Skips transforms of sizes the implementation doesn't support. */
+static bool isSupported (benchmark::State &state, const std::vector <int> &dims, atfft_format format)
+{
+    for (size_t i = 0; i < dims.size(); ++i)
+    {
+        if (!atfft_dft_is_supported_size (dims [i], i == dims.size() - 1 ? format : ATFFT_COMPLEX))
+        {
+            state.SkipWithError ("unsupported size");
+            return false;
+        }
+    }
+
+    return true;
+}
+
 static void complexTransform (benchmark::State &state)
 {
     int size = state.range (0);
+
+    if (!isSupported (state, {size}, ATFFT_COMPLEX))
+        return;
+
     atfft_complex *x = new atfft_complex [size];
     atfft_complex *y = new atfft_complex [size];
     atfft_dft *fft = static_cast <atfft_dft*> (atfft_dft_create (size, ATFFT_FORWARD, ATFFT_COMPLEX));
@@ -29,6 +71,8 @@ static void complexTransform (benchmark::State &state)
         atfft_dft_complex_transform (fft, x, y);
     }
 
+    reportMflops (state, size, ATFFT_COMPLEX);
+
     atfft_dft_destroy (fft);
     delete[] y;
     delete[] x;
@@ -37,6 +81,10 @@ static void complexTransform (benchmark::State &state)
 static void realTransform (benchmark::State &state)
 {
     int size = state.range (0);
+
+    if (!isSupported (state, {size}, ATFFT_REAL))
+        return;
+
     atfft_sample *x = new atfft_sample [size];
     atfft_complex *y = new atfft_complex [atfft_halfcomplex_size(size)];
     atfft_dft *fft = atfft_dft_create (size, ATFFT_FORWARD, ATFFT_REAL);
@@ -53,39 +101,604 @@ static void realTransform (benchmark::State &state)
         atfft_dft_real_forward_transform (fft, x, y);
     }
 
+    reportMflops (state, size, ATFFT_REAL);
+
+    atfft_dft_destroy (fft);
+    delete[] y;
+    delete[] x;
+}
+
+static void realBackwardTransform (benchmark::State &state)
+{
+    int size = state.range (0);
+
+    if (!isSupported (state, {size}, ATFFT_REAL))
+        return;
+
+    int halfcomplexSize = atfft_halfcomplex_size (size);
+    atfft_complex *x = new atfft_complex [halfcomplexSize];
+    atfft_sample *y = new atfft_sample [size];
+    atfft_dft *fft = atfft_dft_create (size, ATFFT_BACKWARD, ATFFT_REAL);
+
+    srand (time (NULL));
+
+    for (int i = 0; i < halfcomplexSize; ++i)
+    {
+        ATFFT_RE (x [i]) = randomFloat();
+        ATFFT_IM (x [i]) = randomFloat();
+    }
+
+    for (auto _ : state)
+    {
+        atfft_dft_real_backward_transform (fft, x, y);
+    }
+
+    reportMflops (state, size, ATFFT_REAL);
+
+    atfft_dft_destroy (fft);
+    delete[] y;
+    delete[] x;
+}
+
+#ifdef BENCHMARK_STRIDE
+/* Transforms reading and writing every stride'th element,
+ * as when transforming one channel of interleaved audio.
+ * Arguments are the size and stride. Only some implementations
+ * provide the strided transforms. */
+static void complexTransformStride (benchmark::State &state)
+{
+    int size = state.range (0);
+    int stride = state.range (1);
+
+    if (!isSupported (state, {size}, ATFFT_COMPLEX))
+        return;
+
+    atfft_complex *x = new atfft_complex [size * stride];
+    atfft_complex *y = new atfft_complex [size * stride];
+    atfft_dft *fft = atfft_dft_create (size, ATFFT_FORWARD, ATFFT_COMPLEX);
+
+    srand (time (NULL));
+
+    for (int i = 0; i < size * stride; ++i)
+    {
+        ATFFT_RE (x [i]) = randomFloat();
+        ATFFT_IM (x [i]) = randomFloat();
+    }
+
+    for (auto _ : state)
+    {
+        atfft_dft_complex_transform_stride (fft, x, stride, y, stride);
+    }
+
+    reportMflops (state, size, ATFFT_COMPLEX);
+
+    atfft_dft_destroy (fft);
+    delete[] y;
+    delete[] x;
+}
+
+static void realTransformStride (benchmark::State &state)
+{
+    int size = state.range (0);
+    int stride = state.range (1);
+
+    if (!isSupported (state, {size}, ATFFT_REAL))
+        return;
+
+    atfft_sample *x = new atfft_sample [size * stride];
+    atfft_complex *y = new atfft_complex [atfft_halfcomplex_size (size) * stride];
+    atfft_dft *fft = atfft_dft_create (size, ATFFT_FORWARD, ATFFT_REAL);
+
+    srand (time (NULL));
+
+    for (int i = 0; i < size * stride; ++i)
+    {
+        x [i] = randomFloat();
+    }
+
+    for (auto _ : state)
+    {
+        atfft_dft_real_forward_transform_stride (fft, x, stride, y, stride);
+    }
+
+    reportMflops (state, size, ATFFT_REAL);
+
     atfft_dft_destroy (fft);
     delete[] y;
     delete[] x;
 }
 
+static void realBackwardTransformStride (benchmark::State &state)
+{
+    int size = state.range (0);
+    int stride = state.range (1);
+
+    if (!isSupported (state, {size}, ATFFT_REAL))
+        return;
+
+    int halfcomplexSize = atfft_halfcomplex_size (size);
+    atfft_complex *x = new atfft_complex [halfcomplexSize * stride];
+    atfft_sample *y = new atfft_sample [size * stride];
+    atfft_dft *fft = atfft_dft_create (size, ATFFT_BACKWARD, ATFFT_REAL);
+
+    srand (time (NULL));
+
+    for (int i = 0; i < halfcomplexSize * stride; ++i)
+    {
+        ATFFT_RE (x [i]) = randomFloat();
+        ATFFT_IM (x [i]) = randomFloat();
+    }
+
+    for (auto _ : state)
+    {
+        atfft_dft_real_backward_transform_stride (fft, x, stride, y, stride);
+    }
+
+    reportMflops (state, size, ATFFT_REAL);
+
+    atfft_dft_destroy (fft);
+    delete[] y;
+    delete[] x;
+}
+
+#endif
+
+/* Square and cubic transforms. Arguments are the length
+ * of each dimension and the number of dimensions. */
+static void ndComplexTransform (benchmark::State &state)
+{
+    std::vector <int> dims (state.range (1), state.range (0));
+
+    if (!isSupported (state, dims, ATFFT_COMPLEX))
+        return;
+
+    int size = std::pow (state.range (0), state.range (1));
+    atfft_complex *x = new atfft_complex [size];
+    atfft_complex *y = new atfft_complex [size];
+    atfft_dft_nd *fft = atfft_dft_nd_create (dims.data(), dims.size(), ATFFT_FORWARD, ATFFT_COMPLEX);
+
+    srand (time (NULL));
+
+    for (int i = 0; i < size; ++i)
+    {
+        ATFFT_RE (x [i]) = randomFloat();
+        ATFFT_IM (x [i]) = randomFloat();
+    }
+
+    for (auto _ : state)
+    {
+        atfft_dft_nd_complex_transform (fft, x, y);
+    }
+
+    reportMflops (state, size, ATFFT_COMPLEX);
+
+    atfft_dft_nd_destroy (fft);
+    delete[] y;
+    delete[] x;
+}
+
+static void ndRealTransform (benchmark::State &state)
+{
+    std::vector <int> dims (state.range (1), state.range (0));
+
+    if (!isSupported (state, dims, ATFFT_REAL))
+        return;
+
+    int size = std::pow (state.range (0), state.range (1));
+    atfft_sample *x = new atfft_sample [size];
+    atfft_complex *y = new atfft_complex [atfft_nd_halfcomplex_size (dims.data(), dims.size())];
+    atfft_dft_nd *fft = atfft_dft_nd_create (dims.data(), dims.size(), ATFFT_FORWARD, ATFFT_REAL);
+
+    srand (time (NULL));
+
+    for (int i = 0; i < size; ++i)
+    {
+        x [i] = randomFloat();
+    }
+
+    for (auto _ : state)
+    {
+        atfft_dft_nd_real_forward_transform (fft, x, y);
+    }
+
+    reportMflops (state, size, ATFFT_REAL);
+
+    atfft_dft_nd_destroy (fft);
+    delete[] y;
+    delete[] x;
+}
+
+static void ndRealBackwardTransform (benchmark::State &state)
+{
+    std::vector <int> dims (state.range (1), state.range (0));
+
+    if (!isSupported (state, dims, ATFFT_REAL))
+        return;
+
+    int size = std::pow (state.range (0), state.range (1));
+    int halfcomplexSize = atfft_nd_halfcomplex_size (dims.data(), dims.size());
+    atfft_complex *x = new atfft_complex [halfcomplexSize];
+    atfft_sample *y = new atfft_sample [size];
+    atfft_dft_nd *fft = atfft_dft_nd_create (dims.data(), dims.size(), ATFFT_BACKWARD, ATFFT_REAL);
+
+    srand (time (NULL));
+
+    for (int i = 0; i < halfcomplexSize; ++i)
+    {
+        ATFFT_RE (x [i]) = randomFloat();
+        ATFFT_IM (x [i]) = randomFloat();
+    }
+
+    for (auto _ : state)
+    {
+        atfft_dft_nd_real_backward_transform (fft, x, y);
+    }
+
+    reportMflops (state, size, ATFFT_REAL);
+
+    atfft_dft_nd_destroy (fft);
+    delete[] y;
+    delete[] x;
+}
+
+/* Arguments are the size and the type of transform. */
+static void dctTransform (benchmark::State &state)
+{
+    int size = state.range (0);
+    atfft_dct_type type = static_cast <atfft_dct_type> (state.range (1));
+
+    if (!atfft_dct_is_supported_type (size, type))
+    {
+        state.SkipWithError ("unsupported size");
+        return;
+    }
+
+    /* big enough for the input of an MDCT or the output of an IMDCT */
+    atfft_sample *x = new atfft_sample [2 * size];
+    atfft_sample *y = new atfft_sample [2 * size];
+    atfft_dct *dct = atfft_dct_create_type (size, type);
+
+    srand (time (NULL));
+
+    for (int i = 0; i < 2 * size; ++i)
+    {
+        x [i] = randomFloat();
+    }
+
+    for (auto _ : state)
+    {
+        atfft_dct_transform (dct, x, y);
+    }
+
+    reportMflops (state, size, ATFFT_REAL);
+
+    atfft_dct_destroy (dct);
+    delete[] y;
+    delete[] x;
+}
+
+/* Arguments are the signal length, the number of outputs kept from each DCT-II
+ * and the number of signals in a batch, e.g. 40 mel bands to 13 MFCCs for
+ * every frame of a spectrogram. */
+static void dctBatch (benchmark::State &state)
+{
+    int size = state.range (0);
+    int nOutputs = state.range (1);
+    int howmany = state.range (2);
+
+    atfft_sample *x = new atfft_sample [size * howmany];
+    atfft_sample *y = new atfft_sample [nOutputs * howmany];
+    atfft_dct_batch *batch = atfft_dct_batch_create (size, howmany, size, nOutputs, nOutputs, ATFFT_FORWARD);
+
+    srand (time (NULL));
+
+    for (int i = 0; i < size * howmany; ++i)
+    {
+        x [i] = randomFloat();
+    }
+
+    for (auto _ : state)
+    {
+        atfft_dct_batch_transform (batch, x, y);
+    }
+
+    state.SetItemsProcessed (state.iterations() * howmany);
+
+    atfft_dct_batch_destroy (batch);
+    delete[] y;
+    delete[] x;
+}
+
+/* The heap memory in use, where the C library can report it. */
+static bool heapInUse (size_t *bytes)
+{
+#if defined(__APPLE__)
+    malloc_statistics_t statistics;
+    malloc_zone_statistics (NULL, &statistics);
+    *bytes = statistics.size_in_use;
+    return true;
+#elif defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    struct mallinfo2 info = mallinfo2();
+    *bytes = info.uordblks + info.hblkhd;
+    return true;
+#else
+    (void) bytes;
+    return false;
+#endif
+}
+
+/* The time taken to create and destroy a plan, and the memory
+ * the plan holds on to. A plan is created before measuring
+ * the memory so that anything an implementation allocates once
+ * and shares between plans (FFTW's wisdom for example) isn't
+ * counted. Arguments are the size and format. */
+static void planCreation (benchmark::State &state)
+{
+    int size = state.range (0);
+    atfft_format format = static_cast <atfft_format> (state.range (1));
+
+    if (!isSupported (state, {size}, format))
+        return;
+
+    size_t before, after;
+
+    atfft_dft_destroy (atfft_dft_create (size, ATFFT_FORWARD, format));
+
+    if (heapInUse (&before))
+    {
+        atfft_dft *fft = atfft_dft_create (size, ATFFT_FORWARD, format);
+        heapInUse (&after);
+        atfft_dft_destroy (fft);
+
+        state.counters ["plan_bytes"] = after - before;
+    }
+
+    for (auto _ : state)
+    {
+        atfft_dft *fft = atfft_dft_create (size, ATFFT_FORWARD, format);
+        benchmark::DoNotOptimize (fft);
+        atfft_dft_destroy (fft);
+    }
+}
+
+/* Runs a convolver a block at a time, reporting the longest time taken
+ * by a single block as well as the average. */
+template <typename Convolver, typename Process>
+static void runConvolver (benchmark::State &state, Convolver *convolver, Process process)
+{
+    int blockSize = state.range (1);
+    atfft_sample *x = new atfft_sample [blockSize];
+    atfft_sample *y = new atfft_sample [blockSize];
+    double worst = 0.0;
+
+    for (int i = 0; i < blockSize; ++i)
+    {
+        x [i] = randomFloat();
+    }
+
+    for (auto _ : state)
+    {
+        auto start = std::chrono::steady_clock::now();
+        process (convolver, x, y);
+        auto end = std::chrono::steady_clock::now();
+
+        worst = std::max (worst, std::chrono::duration <double, std::micro> (end - start).count());
+    }
+
+    state.counters ["worst_us"] = worst;
+
+    delete[] y;
+    delete[] x;
+}
+
+static void uniformConvolver (benchmark::State &state)
+{
+    int kernelSize = state.range (0);
+    int blockSize = state.range (1);
+    atfft_sample *h = new atfft_sample [kernelSize];
+
+    for (int i = 0; i < kernelSize; ++i)
+    {
+        h [i] = randomFloat();
+    }
+
+    atfft_convolver *convolver = atfft_convolver_create (h, kernelSize, blockSize);
+    runConvolver (state, convolver, atfft_convolver_process);
+
+    atfft_convolver_destroy (convolver);
+    delete[] h;
+}
+
+static void zeroLatencyConvolver (benchmark::State &state)
+{
+    int kernelSize = state.range (0);
+    int blockSize = state.range (1);
+    atfft_sample *h = new atfft_sample [kernelSize];
+
+    for (int i = 0; i < kernelSize; ++i)
+    {
+        h [i] = randomFloat();
+    }
+
+    atfft_zero_latency_convolver *convolver = atfft_zero_latency_convolver_create (h, kernelSize, blockSize);
+    runConvolver (state, convolver, atfft_zero_latency_convolver_process);
+
+    atfft_zero_latency_convolver_destroy (convolver);
+    delete[] h;
+}
+
+/* Tracking a few bins of a sliding window, each iteration is one hop.
+ * Arguments are the window size, number of bins and hop size. */
+static int* spreadBins (int size, int nBins)
+{
+    int *bins = new int [nBins];
+
+    for (int i = 0; i < nBins; ++i)
+    {
+        bins [i] = (i * (size / 2)) / nBins + 1;
+    }
+
+    return bins;
+}
+
+static void slidingDft (benchmark::State &state)
+{
+    int size = state.range (0);
+    int nBins = state.range (1);
+    int hop = state.range (2);
+    int *bins = spreadBins (size, nBins);
+    atfft_sample *x = new atfft_sample [hop];
+    atfft_complex *y = new atfft_complex [nBins];
+    atfft_sliding_dft *sdft = atfft_sliding_dft_create (size, bins, nBins);
+
+    for (int i = 0; i < hop; ++i)
+    {
+        x [i] = randomFloat();
+    }
+
+    for (auto _ : state)
+    {
+        atfft_sliding_dft_push (sdft, x, hop);
+        atfft_sliding_dft_get_bins (sdft, y);
+    }
+
+    atfft_sliding_dft_destroy (sdft);
+    delete[] y;
+    delete[] x;
+    delete[] bins;
+}
+
+static void goertzelBank (benchmark::State &state)
+{
+    int size = state.range (0);
+    int nBins = state.range (1);
+    int *bins = spreadBins (size, nBins);
+    atfft_sample *x = new atfft_sample [size];
+    atfft_complex *y = new atfft_complex [nBins];
+    atfft_goertzel *goertzel = atfft_goertzel_create (size, bins, nBins);
+
+    for (int i = 0; i < size; ++i)
+    {
+        x [i] = randomFloat();
+    }
+
+    for (auto _ : state)
+    {
+        atfft_goertzel_transform (goertzel, x, y);
+    }
+
+    atfft_goertzel_destroy (goertzel);
+    delete[] y;
+    delete[] x;
+    delete[] bins;
+}
+
+/* The full transform of each hop's window, for comparison. */
+static void hopTransform (benchmark::State &state)
+{
+    realTransform (state);
+}
+
+/* Reports the input rate in samples per second. */
+static void channelizer (benchmark::State &state)
+{
+    int nChannels = state.range (0);
+    atfft_channelizer_sampling sampling = static_cast <atfft_channelizer_sampling> (state.range (1));
+    int tapsPerChannel = state.range (2);
+    int nFrames = 64;
+    atfft_channelizer *channelizer = atfft_channelizer_create (nChannels, sampling, tapsPerChannel, NULL);
+    int size = nFrames * atfft_channelizer_hop_size (channelizer);
+    atfft_complex *x = new atfft_complex [size];
+    atfft_complex *y = new atfft_complex [nFrames * nChannels];
+
+    for (int i = 0; i < size; ++i)
+    {
+        ATFFT_RE (x [i]) = randomFloat();
+        ATFFT_IM (x [i]) = randomFloat();
+    }
+
+    for (auto _ : state)
+    {
+        atfft_channelizer_transform (channelizer, x, nFrames, y);
+    }
+
+    state.SetItemsProcessed (state.iterations() * size);
+
+    atfft_channelizer_destroy (channelizer);
+    delete[] y;
+    delete[] x;
+}
+
+BENCHMARK (slidingDft)->Args ({1024, 8, 1})->Args ({1024, 8, 16})->Args ({1024, 32, 1})->Args ({1024, 32, 16});
+BENCHMARK (goertzelBank)->Args ({1024, 8, 16})->Args ({1024, 32, 16});
+BENCHMARK (hopTransform)->Args ({1024, 8, 16})->Args ({1024, 32, 16});
+
+BENCHMARK (channelizer)->Args ({1024, ATFFT_CRITICALLY_SAMPLED, 8})->Args ({1024, ATFFT_OVERSAMPLED_2X, 8});
+
+BENCHMARK (dctBatch)->Args ({40, 13, 1000})->Args ({40, 40, 1000})->Args ({256, 32, 1000});
+
+/* two second kernels at 48kHz */
+BENCHMARK (uniformConvolver)->Args ({96000, 64})->Args ({96000, 256})->Args ({96000, 1024});
+BENCHMARK (zeroLatencyConvolver)->Args ({96000, 64})->Args ({96000, 256})->UseRealTime();
+
 #ifdef BENCHMARK_POWERS_OF_2
 BENCHMARK (realTransform)->RangeMultiplier (2)->Range (1 << 5, 1 << 16);
+BENCHMARK (realBackwardTransform)->RangeMultiplier (2)->Range (1 << 5, 1 << 16);
 BENCHMARK (complexTransform)->RangeMultiplier (2)->Range (1 << 5, 1 << 16);
+
+#ifdef BENCHMARK_STRIDE
+BENCHMARK (realTransformStride)->ArgsProduct ({{1 << 8, 1 << 12, 1 << 16}, {2, 16}});
+BENCHMARK (realBackwardTransformStride)->ArgsProduct ({{1 << 8, 1 << 12, 1 << 16}, {2, 16}});
+BENCHMARK (complexTransformStride)->ArgsProduct ({{1 << 8, 1 << 12, 1 << 16}, {2, 16}});
+#endif
+
+BENCHMARK (ndRealTransform)->Args ({32, 2})->Args ({128, 2})->Args ({512, 2})->Args ({16, 3})->Args ({32, 3})->Args ({64, 3});
+BENCHMARK (ndRealBackwardTransform)->Args ({32, 2})->Args ({128, 2})->Args ({512, 2})->Args ({16, 3})->Args ({32, 3})->Args ({64, 3});
+BENCHMARK (ndComplexTransform)->Args ({32, 2})->Args ({128, 2})->Args ({512, 2})->Args ({16, 3})->Args ({32, 3})->Args ({64, 3});
+
+BENCHMARK (dctTransform)->ArgsProduct ({benchmark::CreateRange (1 << 5, 1 << 16, 8),
+                                        {ATFFT_DCT_II, ATFFT_DCT_III, ATFFT_DCT_IV, ATFFT_MDCT, ATFFT_IMDCT}});
+
+BENCHMARK (planCreation)->ArgsProduct ({benchmark::CreateRange (1 << 5, 1 << 16, 8), {ATFFT_COMPLEX, ATFFT_REAL}});
 #endif
 
 #ifdef BENCHMARK_POWERS_OF_3
 BENCHMARK (realTransform)->RangeMultiplier (3)->Range (27, std::pow (3, 10));
+BENCHMARK (realBackwardTransform)->RangeMultiplier (3)->Range (27, std::pow (3, 10));
 BENCHMARK (complexTransform)->RangeMultiplier (3)->Range (27, std::pow (3, 10));
 #endif
 
 #ifdef BENCHMARK_COMPOSITES
 BENCHMARK (realTransform)->RangeMultiplier (30)->Range (30, std::pow (30, 4));
+BENCHMARK (realBackwardTransform)->RangeMultiplier (30)->Range (30, std::pow (30, 4));
 BENCHMARK (complexTransform)->RangeMultiplier (30)->Range (30, std::pow (30, 4));
 #endif
 
 #ifdef BENCHMARK_PRIMES
-//BENCHMARK (realTransform)->Arg (37)
-//                         ->Arg (67)
-//                         ->Arg (131)
-//                         ->Arg (257)
-//                         ->Arg (521)
-//                         ->Arg (1031)
-//                         ->Arg (2053)
-//                         ->Arg (4099)
-//                         ->Arg (8191)
-//                         ->Arg (16381)
-//                         ->Arg (32771)
-//                         ->Arg (65537);
+BENCHMARK (realTransform)->Arg (37)
+                         ->Arg (67)
+                         ->Arg (131)
+                         ->Arg (257)
+                         ->Arg (521)
+                         ->Arg (1031)
+                         ->Arg (2053)
+                         ->Arg (4099)
+                         ->Arg (8191)
+                         ->Arg (16381)
+                         ->Arg (32771)
+                         ->Arg (65537);
+BENCHMARK (realBackwardTransform)->Arg (37)
+                                 ->Arg (67)
+                                 ->Arg (131)
+                                 ->Arg (257)
+                                 ->Arg (521)
+                                 ->Arg (1031)
+                                 ->Arg (2053)
+                                 ->Arg (4099)
+                                 ->Arg (8191)
+                                 ->Arg (16381)
+                                 ->Arg (32771)
+                                 ->Arg (65537);
 BENCHMARK (complexTransform)->Arg (37)
                             ->Arg (67)
                             ->Arg (131)
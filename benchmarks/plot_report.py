@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""Plot a report written by report.py.
+
+For each kind of transform, MFLOPS and rms error are plotted against size, with a line for each
+backend and precision. One PNG per kind is written to the output directory, e.g.
+
+    python3 plot_report.py report.json --out plots --precision double --kind dft_complex_forward
+"""
+
+import argparse
+import json
+import os
+from collections import defaultdict
+
+import matplotlib
+matplotlib.use('Agg')
+import matplotlib.pyplot as plt
+
+
+def points(size):
+    n = 1
+
+    for d in size.split('x'):
+        n *= int(d)
+
+    return n
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('report', help='the JSON report written by report.py')
+    parser.add_argument('--out', default='plots', help='the directory to write the plots to')
+    parser.add_argument('--kind', action='append', help='only plot these kinds of transform')
+    parser.add_argument('--backend', action='append', help='only plot these backends')
+    parser.add_argument('--precision', action='append', help='only plot these precisions')
+    args = parser.parse_args()
+
+    with open(args.report) as f:
+        rows = json.load(f)
+
+    # kind -> (backend, precision) -> rows
+    series = defaultdict(lambda: defaultdict(list))
+
+    for r in rows:
+        if ((args.kind and r['kind'] not in args.kind) or
+                (args.backend and r['backend'] not in args.backend) or
+                (args.precision and r['precision'] not in args.precision)):
+            continue
+
+        series[r['kind']][(r['backend'], r['precision'])].append(r)
+
+    os.makedirs(args.out, exist_ok=True)
+
+    for kind, lines in sorted(series.items()):
+        if kind.startswith('plan_'):
+            panels = [('time_ns', 'create time (ns)'), ('plan_bytes', 'plan memory (bytes)')]
+        else:
+            panels = [('mflops', 'MFLOPS (5 N log2 N / t)'), ('rms_ulps', 'rms error (ulps)')]
+
+        figure, axes = plt.subplots(1, len(panels), figsize=(6 * len(panels), 4.5), squeeze=False)
+
+        for axis, (field, title) in zip(axes[0], panels):
+            for (backend, precision), rs in sorted(lines.items()):
+                xy = sorted((points(r['size']), r[field]) for r in rs if r.get(field) not in (None, ''))
+
+                if xy:
+                    axis.plot(*zip(*xy), marker='.', label='{} {}'.format(backend, precision))
+
+            axis.set_xscale('log', base=2)
+
+            if field != 'mflops':
+                axis.set_yscale('log')
+
+            axis.set_xlabel('size (points)')
+            axis.set_title(title)
+            axis.grid(True, which='both', alpha=0.3)
+
+        axes[0][0].legend(fontsize='small')
+        figure.suptitle(kind)
+        figure.tight_layout()
+        figure.savefig(os.path.join(args.out, kind + '.png'))
+        plt.close(figure)
+
+
+if __name__ == '__main__':
+    main()
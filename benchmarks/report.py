@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+"""Merge Google Benchmark JSON output from benchmark and accuracy into one report.
+
+Each input file should be named <IMPL>_<TYPE>_benchmark.json or <IMPL>_<TYPE>_accuracy.json,
+as written by `make report`. The report has one row for each backend, precision, kind of
+transform and size, giving the time per transform, MFLOPS, plan memory and error, where measured.
+"""
+
+import argparse
+import csv
+import json
+import os
+import re
+import sys
+
+FIELDS = ['backend', 'precision', 'kind', 'size',
+          'time_ns', 'mflops', 'plan_bytes',
+          'max_error', 'rms_error', 'rms_ulps', 'accuracy_fail']
+
+DCT_TYPES = ['dct_i', 'dct_ii', 'dct_iii', 'dct_iv', 'dst_i', 'dst_ii', 'dst_iii', 'dst_iv', 'mdct', 'imdct']
+
+# benchmark.cpp function names, and the kinds they measure in accuracy.cpp's terms
+BENCHMARK_KINDS = {
+    'complexTransform': 'dft_complex_forward',
+    'realTransform': 'dft_real_forward',
+    'realBackwardTransform': 'dft_real_backward',
+    'complexTransformStride': 'dft_complex_forward_stride',
+    'realTransformStride': 'dft_real_forward_stride',
+    'realBackwardTransformStride': 'dft_real_backward_stride',
+    'ndComplexTransform': 'dft_nd_complex_forward',
+    'ndRealTransform': 'dft_nd_real_forward',
+    'ndRealBackwardTransform': 'dft_nd_real_backward',
+}
+
+TIME_UNITS = {'ns': 1.0, 'us': 1e3, 'ms': 1e6, 's': 1e9}
+
+
+def benchmark_key(name):
+    """The kind and size measured by a benchmark.cpp benchmark, or None for other benchmarks."""
+    function, *args = name.split('/')
+    args = [a for a in args if not a.startswith(('min_time', 'real_time'))]
+
+    if function in BENCHMARK_KINDS:
+        kind = BENCHMARK_KINDS[function]
+
+        if function.startswith('nd'):
+            return kind, 'x'.join([args[0]] * int(args[1]))
+
+        if function.endswith('Stride'):
+            return '{}{}'.format(kind, args[1]), args[0]
+
+        return kind, args[0]
+
+    if function == 'dctTransform':
+        return DCT_TYPES[int(args[1])], args[0]
+
+    if function == 'dctBatch':
+        return 'dct_batch_ii', '{}x{}'.format(args[0], args[1])
+
+    if function == 'planCreation':
+        return 'plan_' + ('complex' if int(args[1]) == 0 else 'real'), args[0]
+
+    return None
+
+
+def read_results(path):
+    try:
+        with open(path) as f:
+            results = json.load(f)
+    except ValueError:
+        print('Skipping {}, it is incomplete'.format(path), file=sys.stderr)
+        return []
+
+    # only keep the fastest repetition of each benchmark
+    runs = {}
+
+    for run in results.get('benchmarks', []):
+        if run.get('run_type') == 'aggregate' or run.get('error_occurred'):
+            continue
+
+        best = runs.get(run['name'])
+
+        if best is None or run['cpu_time'] < best['cpu_time']:
+            runs[run['name']] = run
+
+    return runs.values()
+
+
+def merge(paths):
+    rows = {}
+
+    def row(backend, precision, kind, size):
+        key = (backend, precision, kind, size)
+        return rows.setdefault(key, dict(zip(FIELDS, key)))
+
+    for path in paths:
+        match = re.match(r'(.+)_(FLOAT|DOUBLE|LONG_DOUBLE)_(benchmark|accuracy)\.json$', os.path.basename(path))
+
+        if not match:
+            print('Skipping {}, not named <IMPL>_<TYPE>_<benchmark|accuracy>.json'.format(path), file=sys.stderr)
+            continue
+
+        impl, precision, program = match.groups()
+
+        for run in read_results(path):
+            if program == 'accuracy':
+                # accuracy.cpp names its runs kind/backend/size
+                kind, backend, size = run['name'].split('/')[:3]
+                r = row(backend, precision.lower(), kind, size)
+                r['time_ns'] = r.get('time_ns', run['cpu_time'] * TIME_UNITS[run['time_unit']])
+
+                for field in ('max_error', 'rms_error', 'rms_ulps'):
+                    r[field] = run.get(field)
+
+                r['accuracy_fail'] = int(run.get('label') == 'FAIL')
+            else:
+                key = benchmark_key(run['name'])
+
+                if key is None:
+                    continue
+
+                r = row(impl.lower(), precision.lower(), *key)
+
+                # benchmark.cpp's timings take precedence over accuracy.cpp's shorter runs
+                r['time_ns'] = run['cpu_time'] * TIME_UNITS[run['time_unit']]
+
+                for field in ('mflops', 'plan_bytes'):
+                    if field in run:
+                        r[field] = run[field]
+
+    def order(r):
+        size = [int(d) for d in r['size'].split('x')]
+        return r['backend'], r['precision'], r['kind'], len(size), size
+
+    return sorted(rows.values(), key=order)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('results', nargs='+', help='Google Benchmark JSON output files')
+    parser.add_argument('--csv', help='write the report as CSV to this file')
+    parser.add_argument('--json', help='write the report as JSON to this file')
+    args = parser.parse_args()
+
+    rows = merge(args.results)
+
+    if args.json:
+        with open(args.json, 'w') as f:
+            json.dump(rows, f, indent=2)
+
+    if args.csv or not args.json:
+        f = open(args.csv, 'w', newline='') if args.csv else sys.stdout
+        writer = csv.DictWriter(f, fieldnames=FIELDS, restval='')
+        writer.writeheader()
+        writer.writerows(rows)
+
+        if args.csv:
+            f.close()
+
+    failures = [r for r in rows if r.get('accuracy_fail')]
+
+    if failures:
+        print('{} transforms exceeded the error tolerance, see the accuracy_fail column'.format(len(failures)),
+              file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Only built with IMPL=MULTI, e.g. make IMPL=MULTI BACKENDS="PFFFT OOURA" auto_backend */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <atfft/atfft.h>
+
+int main (int argc, char **argv)
+{
+    /* powers of two, primes and highly composite sizes */
+    int sizes [] = {256, 4096, 1021, 4099, 900, 27000};
+    int nSizes = sizeof (sizes) / sizeof (sizes [0]);
+    int i = 0;
+
+    printf ("Available backends:\n");
+
+    for (i = 0; i < atfft_dft_n_backends(); ++i)
+        printf ("%s\n", atfft_dft_get_backend (i)->name);
+
+    /* remember the choices between runs if given a file */
+    if (argc > 1)
+        atfft_dft_auto_set_wisdom_file (argv [1]);
+
+    /* make every plan, including those created by the other modules, use the fastest backend */
+    atfft_dft_set_default_backend (ATFFT_DFT_AUTO_BACKEND);
+
+    printf ("\nFastest backends:\n");
+
+    for (i = 0; i < nSizes; ++i)
+    {
+        struct atfft_dft *complexPlan = atfft_dft_create (sizes [i], ATFFT_FORWARD, ATFFT_COMPLEX);
+        struct atfft_dft *realPlan = atfft_dft_create (sizes [i], ATFFT_FORWARD, ATFFT_REAL);
+
+        printf ("%d: complex %s, real %s\n",
+                sizes [i],
+                atfft_dft_get_plan_backend (complexPlan)->name,
+                atfft_dft_get_plan_backend (realPlan)->name);
+
+        atfft_dft_destroy (realPlan);
+        atfft_dft_destroy (complexPlan);
+    }
+
+    return 0;
+}
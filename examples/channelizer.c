@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <atfft/atfft.h>
+
+#ifndef M_PI
+#   define M_PI 3.14159265358979323846
+#endif
+
+int main()
+{
+    int nChannels = 8;
+    int tapsPerChannel = 8;
+    int nFrames = 32;
+    int hopSize = 0;
+    atfft_complex *signal, *channels;
+    struct atfft_channelizer *channelizer;
+    int i = 0, k = 0;
+
+    /* split a stream into 8 channels, each output at twice the critically sampled rate */
+    channelizer = atfft_channelizer_create (nChannels, ATFFT_OVERSAMPLED_2X, tapsPerChannel, NULL);
+    hopSize = atfft_channelizer_hop_size (channelizer);
+
+    signal = malloc (nFrames * hopSize * sizeof (*signal));
+    channels = malloc (nFrames * nChannels * sizeof (*channels));
+
+    /* construct a stream with a tone at the centre of channel 2 and a weaker one at the centre of channel 6 */
+    for (i = 0; i < nFrames * hopSize; ++i)
+    {
+        atfft_sample x = 2.0 * M_PI * i / nChannels;
+
+        ATFFT_RE (signal [i]) = cos (2.0 * x) + 0.25 * cos (6.0 * x);
+        ATFFT_IM (signal [i]) = sin (2.0 * x) + 0.25 * sin (6.0 * x);
+    }
+
+    /* the stream can be passed in pieces of any number of hops */
+    atfft_channelizer_transform (channelizer, signal, nFrames / 2, channels);
+    atfft_channelizer_transform (channelizer,
+                                 signal + nFrames / 2 * hopSize,
+                                 nFrames / 2,
+                                 channels + nFrames / 2 * nChannels);
+
+    /* print the magnitude of each channel once the filter history is full */
+    printf ("Channel magnitudes of the last frame:\n");
+
+    for (k = 0; k < nChannels; ++k)
+    {
+#ifdef ATFFT_TYPE_LONG_DOUBLE
+        printf ("  channel %d: %Lf\n", k, atfft_abs (channels [(nFrames - 1) * nChannels + k]));
+#else
+        printf ("  channel %d: %f\n", k, atfft_abs (channels [(nFrames - 1) * nChannels + k]));
+#endif
+    }
+
+    /* free everything */
+    atfft_channelizer_destroy (channelizer);
+    free (channels);
+    free (signal);
+
+    return 0;
+}
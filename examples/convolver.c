@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <atfft/atfft.h>
+#include <atfft/convolver.h>
+
+void printSampleArray (atfft_sample *data, int size)
+{
+    int i = 0;
+
+#ifdef ATFFT_TYPE_LONG_DOUBLE
+    printf ("%Lf", data [i]);
+#else
+    printf ("%f", data [i]);
+#endif
+
+    for (i = 1; i < size; ++i)
+    {
+#ifdef ATFFT_TYPE_LONG_DOUBLE
+        printf (", %Lf", data [i]);
+#else
+        printf (", %f", data [i]);
+#endif
+    }
+
+    printf ("\n");
+}
+
+int main()
+{
+    int kernelSize = 1000;
+    int blockSize = 16;
+    int nBlocks = 4;
+    atfft_sample *kernel, *signal;
+    struct atfft_convolver *convolver;
+    int i = 0;
+
+    /* allocate some memory for the signals */
+    kernel = malloc (kernelSize * sizeof (*kernel));
+    signal = calloc (nBlocks * blockSize, sizeof (*signal));
+
+    /* construct a decaying kernel */
+    for (i = 0; i < kernelSize; ++i)
+    {
+        kernel [i] = exp (-0.1 * i);
+    }
+
+    /* the input is an impulse followed by silence */
+    signal [0] = 1.0;
+
+    /* create a convolver */
+    convolver = atfft_convolver_create (kernel, kernelSize, blockSize);
+
+    /* process the signal a block at a time, in place */
+    for (i = 0; i < nBlocks; ++i)
+    {
+        atfft_convolver_process (convolver, signal + i * blockSize, signal + i * blockSize);
+    }
+
+    printf ("Impulse Response:\n");
+    printSampleArray (signal, nBlocks * blockSize);
+
+    /* free everything */
+    atfft_convolver_destroy (convolver);
+    free (signal);
+    free (kernel);
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <atfft/atfft.h>
+
+#ifndef M_PI
+#   define M_PI 3.14159265358979323846
+#endif
+
+void printBlock (atfft_sample *data, int blockSize)
+{
+    int i, j;
+
+    for (i = 0; i < blockSize; ++i)
+    {
+        for (j = 0; j < blockSize; ++j)
+        {
+#ifdef ATFFT_TYPE_LONG_DOUBLE
+            printf ("%8.3Lf", data [i * blockSize + j]);
+#else
+            printf ("%8.3f", data [i * blockSize + j]);
+#endif
+        }
+
+        printf ("\n");
+    }
+}
+
+int main()
+{
+    int blockSize = 8;
+    int nBlocks = 4;
+    int blockLength = blockSize * blockSize;
+    atfft_sample *image, *transform;
+    int b, i, j;
+
+    /* allocate some memory for the blocks */
+    image = malloc (nBlocks * blockLength * sizeof (*image));
+    transform = malloc (nBlocks * blockLength * sizeof (*transform));
+
+    /* construct some blocks */
+    for (b = 0; b < nBlocks; ++b)
+    {
+        for (i = 0; i < blockSize; ++i)
+        {
+            for (j = 0; j < blockSize; ++j)
+            {
+                atfft_sample x = M_PI * j / blockSize;
+                atfft_sample y = M_PI * i / blockSize;
+
+                image [b * blockLength + i * blockSize + j] = 0.5 + 0.3 * cos ((b + 1) * x) * cos (2.0 * y);
+            }
+        }
+    }
+
+    printf ("Original Block:\n");
+    printBlock (image + blockLength, blockSize);
+
+    /* apply the forward transform to all the blocks */
+    atfft_dct2d_blocks (ATFFT_DCT_II, blockSize, nBlocks, image, transform);
+    printf ("\nFrequency Domain:\n");
+    printBlock (transform + blockLength, blockSize);
+
+    /* apply the backward transform */
+    atfft_dct2d_blocks (ATFFT_DCT_III, blockSize, nBlocks, transform, image);
+    atfft_normalise_dct2d (image, blockSize, nBlocks);
+    printf ("\nReconstructed Block:\n");
+    printBlock (image + blockLength, blockSize);
+
+    /* free everything */
+    free (transform);
+    free (image);
+
+    return 0;
+}
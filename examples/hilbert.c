@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <atfft/atfft.h>
+
+#ifndef M_PI
+#   define M_PI 3.14159265358979323846
+#endif
+
+void printSamples (atfft_sample *data, int size)
+{
+    for (int i = 0; i < size; ++i)
+    {
+#ifdef ATFFT_TYPE_LONG_DOUBLE
+        printf ("%Lf, ", data [i]);
+#else
+        printf ("%f, ", data [i]);
+#endif
+    }
+
+    printf ("\n");
+}
+
+int main()
+{
+    int size = 64;
+    int blockSize = 16;
+    int filterSize = 31;
+    atfft_sample *signal, *envelope;
+    struct atfft_hilbert *hilbert;
+    struct atfft_hilbert_stream *stream;
+    int i = 0;
+
+    signal = malloc (size * sizeof (*signal));
+    envelope = malloc (size * sizeof (*envelope));
+
+    /* construct an amplitude modulated tone which fits the block exactly */
+    for (i = 0; i < size; ++i)
+    {
+        atfft_sample x = 2.0 * M_PI * i / size;
+
+        signal [i] = (1.0 + 0.5 * cos (x)) * cos (8.0 * x);
+    }
+
+    printf ("Original Signal:\n");
+    printSamples (signal, size);
+
+    /* find the envelope of the whole block */
+    hilbert = atfft_hilbert_create (size);
+    atfft_hilbert_envelope (hilbert, signal, envelope);
+
+    printf ("\nBlock Envelope:\n");
+    printSamples (envelope, size);
+
+    /* find the envelope of the same signal as a stream, a block at a time */
+    stream = atfft_hilbert_stream_create (blockSize, filterSize);
+
+    for (i = 0; i < size; i += blockSize)
+        atfft_hilbert_stream_envelope (stream, signal + i, blockSize, envelope + i);
+
+    printf ("\nStreaming Envelope (delayed by %d samples):\n", atfft_hilbert_stream_latency (stream));
+    printSamples (envelope, size);
+
+    /* free everything */
+    atfft_hilbert_stream_destroy (stream);
+    atfft_hilbert_destroy (hilbert);
+    free (envelope);
+    free (signal);
+
+    return 0;
+}
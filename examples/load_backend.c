@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Only built with IMPL=MULTI. Build a backend as a shared library, then load it into a program it wasn't compiled
+ * into, e.g.
+ *
+ *     make IMPL=MULTI load_backend libatfft_ooura.so
+ *     ./load_backend ooura ./libatfft_ooura.so
+ *
+ * Without a path the library is searched for in the usual locations (e.g. LD_LIBRARY_PATH).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <atfft/atfft.h>
+
+#ifndef M_PI
+#   define M_PI 3.14159265358979323846
+#endif
+
+int main (int argc, char **argv)
+{
+    const char *name = argc > 1 ? argv [1] : "ooura";
+    const char *path = argc > 2 ? argv [2] : NULL;
+    int nSamples = 64;
+    int nBins = atfft_halfcomplex_size (nSamples);
+    atfft_sample *signal;
+    atfft_complex *loaded, *native;
+    struct atfft_dft *loadedFft, *nativeFft;
+    double maxError = 0.0;
+    int i = 0;
+
+    if (atfft_dft_find_backend (name))
+        printf ("The %s backend is already available, nothing needs loading.\n", name);
+
+    if (!atfft_dft_load_backend (name, path))
+    {
+        fprintf (stderr, "Couldn't load the %s backend from %s\n", name, path ? path : "the default library path");
+        return 1;
+    }
+
+    printf ("Available backends:\n");
+
+    for (i = 0; i < atfft_dft_n_backends(); ++i)
+        printf ("%s\n", atfft_dft_get_backend (i)->name);
+
+    /* transform the same signal with the loaded backend and the native one */
+    loadedFft = atfft_dft_create_with_backend (name, nSamples, ATFFT_FORWARD, ATFFT_REAL);
+    nativeFft = atfft_dft_create_with_backend ("native", nSamples, ATFFT_FORWARD, ATFFT_REAL);
+
+    if (!loadedFft || !nativeFft)
+    {
+        fprintf (stderr, "Couldn't create a %d point real DFT with the %s backend\n", nSamples, name);
+        atfft_dft_destroy (nativeFft);
+        atfft_dft_destroy (loadedFft);
+        return 1;
+    }
+
+    signal = malloc (nSamples * sizeof (*signal));
+    loaded = malloc (nBins * sizeof (*loaded));
+    native = malloc (nBins * sizeof (*native));
+
+    for (i = 0; i < nSamples; ++i)
+    {
+        atfft_sample x = 2.0 * M_PI * i / nSamples;
+
+        signal [i] = 0.3 + 0.6 * cos (2.0 * x - 0.3)
+                         + 0.3 * cos (5.0 * x + 0.2)
+                         + 0.1 * cos (8.0 * x - 0.8);
+    }
+
+    atfft_dft_real_forward_transform (loadedFft, signal, loaded);
+    atfft_dft_real_forward_transform (nativeFft, signal, native);
+
+    for (i = 0; i < nBins; ++i)
+    {
+        double error = hypot (ATFFT_RE (loaded [i]) - ATFFT_RE (native [i]),
+                              ATFFT_IM (loaded [i]) - ATFFT_IM (native [i]));
+
+        if (error > maxError)
+            maxError = error;
+    }
+
+    printf ("\nThe plan uses the %s backend, maximum difference from the native DFT: %g\n",
+            atfft_dft_get_plan_backend (loadedFft)->name,
+            maxError);
+
+    atfft_dft_destroy (nativeFft);
+    atfft_dft_destroy (loadedFft);
+    free (native);
+    free (loaded);
+    free (signal);
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <atfft/atfft.h>
+
+#ifndef M_PI
+#   define M_PI 3.14159265358979323846
+#endif
+
+void printSampleArray (atfft_sample *data, int size)
+{
+    int i = 0;
+
+#ifdef ATFFT_TYPE_LONG_DOUBLE
+    printf ("%Lf", data [i]);
+#else
+    printf ("%f", data [i]);
+#endif
+
+    for (i = 1; i < size; ++i)
+    {
+#ifdef ATFFT_TYPE_LONG_DOUBLE
+        printf (", %Lf", data [i]);
+#else
+        printf (", %f", data [i]);
+#endif
+    }
+
+    printf ("\n");
+}
+
+int main()
+{
+    int nCoefficients = 16;
+    int nFrames = 4;
+    int nSamples = (nFrames + 1) * nCoefficients;
+    atfft_sample *signal, *reconstructed, *window, *coefficients, *frame;
+    struct atfft_dct *mdct, *imdct;
+    int i = 0, f = 0;
+
+    /* allocate some memory for the signals */
+    signal = calloc (nSamples, sizeof (*signal));
+    reconstructed = calloc (nSamples, sizeof (*reconstructed));
+    window = malloc (2 * nCoefficients * sizeof (*window));
+    coefficients = malloc (nCoefficients * sizeof (*coefficients));
+    frame = malloc (2 * nCoefficients * sizeof (*frame));
+
+    /* construct some signal, leaving the first and last
+     * frames empty as they are only covered once */
+    for (i = nCoefficients; i < nSamples - nCoefficients; ++i)
+    {
+        atfft_sample x = 2.0 * M_PI * i / nCoefficients;
+
+        signal [i] = 0.3 + 0.6 * cos (2.0 * x - 0.3)
+                         + 0.3 * cos (5.0 * x + 0.2)
+                         + 0.1 * cos (8.0 * x - 0.8);
+    }
+
+    printf ("Original Signal:\n");
+    printSampleArray (signal, nSamples);
+
+    /* create an MDCT and IMDCT, both using a sine window */
+    mdct = atfft_dct_create_type (nCoefficients, ATFFT_MDCT);
+    imdct = atfft_dct_create_type (nCoefficients, ATFFT_IMDCT);
+
+    atfft_sine_window (window, 2 * nCoefficients);
+    atfft_dct_set_window (mdct, window);
+    atfft_dct_set_window (imdct, window);
+
+    /* transform overlapping frames and overlap-add the results */
+    for (f = 0; f < nFrames; ++f)
+    {
+        atfft_dct_transform (mdct, signal + f * nCoefficients, coefficients);
+        printf ("\nFrame %d Coefficients:\n", f);
+        printSampleArray (coefficients, nCoefficients);
+
+        atfft_dct_transform (imdct, coefficients, frame);
+        atfft_normalise_dct_type (frame, nCoefficients, ATFFT_IMDCT);
+
+        for (i = 0; i < 2 * nCoefficients; ++i)
+        {
+            reconstructed [f * nCoefficients + i] += frame [i];
+        }
+    }
+
+    printf ("\nReconstructed Signal:\n");
+    printSampleArray (reconstructed, nSamples);
+
+    /* free everything */
+    atfft_dct_destroy (imdct);
+    atfft_dct_destroy (mdct);
+    free (frame);
+    free (coefficients);
+    free (window);
+    free (reconstructed);
+    free (signal);
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <atfft/atfft.h>
+
+#ifndef M_PI
+#   define M_PI 3.14159265358979323846
+#endif
+
+void printMagnitudes (atfft_complex *data, int first, int size)
+{
+    for (int i = first; i < first + size; ++i)
+    {
+        atfft_sample magnitude = sqrt (ATFFT_RE (data [i]) * ATFFT_RE (data [i]) +
+                                       ATFFT_IM (data [i]) * ATFFT_IM (data [i]));
+
+#ifdef ATFFT_TYPE_LONG_DOUBLE
+        printf ("%d: %Lf\n", i, magnitude);
+#else
+        printf ("%d: %f\n", i, magnitude);
+#endif
+    }
+}
+
+int main()
+{
+    int nSamples = 32;
+    int fftSize = 1024;
+    int firstBin = 100;
+    int nBins = 24;
+    atfft_sample *signal;
+    atfft_complex *freqDomain;
+    struct atfft_dft *fft;
+    int i = 0;
+
+    /* allocate some memory for the signals, the signal is zero padded to the fft size */
+    signal = calloc (fftSize, sizeof (*signal));
+    freqDomain = malloc (atfft_halfcomplex_size (fftSize) * sizeof (*freqDomain));
+
+    /* construct a sinusoid between two bins of an nSamples long DFT */
+    for (i = 0; i < nSamples; ++i)
+    {
+        signal [i] = cos (2.0 * M_PI * 3.4 * i / nSamples);
+    }
+
+    /* create a pruned fft that knows only the first nSamples are non-zero
+     * and that only computes the bins around the sinusoid */
+    fft = atfft_dft_create_pruned (fftSize, ATFFT_FORWARD, ATFFT_REAL, nSamples, firstBin, nBins);
+
+    /* apply the transform */
+    atfft_dft_real_forward_transform (fft, signal, freqDomain);
+    printf ("Interpolated Spectrum:\n");
+    printMagnitudes (freqDomain, firstBin, nBins);
+
+    /* free everything */
+    atfft_dft_destroy (fft);
+    free (freqDomain);
+    free (signal);
+
+    return 0;
+}
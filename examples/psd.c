@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <atfft/atfft.h>
+
+#ifndef M_PI
+#   define M_PI 3.14159265358979323846
+#endif
+
+int main()
+{
+    int size = 4096;
+    int segmentSize = 256;
+    int hopSize = 128;
+    int nBins = atfft_halfcomplex_size (segmentSize);
+    atfft_sample *signal, *psd;
+    struct atfft_psd *estimator;
+    int peak = 0;
+    int i = 0;
+
+    signal = malloc (size * sizeof (*signal));
+    psd = malloc (nBins * sizeof (*psd));
+
+    /* construct a tone in bin 32 with a DC offset and some noise */
+    for (i = 0; i < size; ++i)
+    {
+        atfft_sample noise = 0.1 * (2.0 * rand() / RAND_MAX - 1.0);
+
+        signal [i] = 1.0 + cos (2.0 * M_PI * 32 * i / segmentSize) + noise;
+    }
+
+    /* estimate the power spectral density using Hann windowed segments with 50% overlap,
+     * removing the mean of each segment and spreading the work over 2 threads */
+    estimator = atfft_psd_create (segmentSize,
+                                  hopSize,
+                                  segmentSize,
+                                  ATFFT_HANN_WINDOW,
+                                  ATFFT_PSD_CONSTANT_DETREND,
+                                  2);
+
+    atfft_psd_transform (estimator, signal, size, psd);
+
+    for (i = 1; i < nBins; ++i)
+    {
+        if (psd [i] > psd [peak])
+            peak = i;
+    }
+
+    printf ("Averaged %d segments.\n", atfft_psd_n_segments (estimator, size));
+
+#ifdef ATFFT_TYPE_LONG_DOUBLE
+    printf ("DC: %Lf, peak in bin %d: %Lf, bin %d: %Lf\n", psd [0], peak, psd [peak], nBins / 2, psd [nBins / 2]);
+#else
+    printf ("DC: %f, peak in bin %d: %f, bin %d: %f\n", psd [0], peak, psd [peak], nBins / 2, psd [nBins / 2]);
+#endif
+
+    /* free everything */
+    atfft_psd_destroy (estimator);
+    free (psd);
+    free (signal);
+
+    return 0;
+}
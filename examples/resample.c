@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <atfft/atfft.h>
+
+#ifndef M_PI
+#   define M_PI 3.14159265358979323846
+#endif
+
+void printSamples (atfft_sample *data, int size)
+{
+    for (int i = 0; i < size; ++i)
+    {
+#ifdef ATFFT_TYPE_LONG_DOUBLE
+        printf ("%Lf, ", data [i]);
+#else
+        printf ("%f, ", data [i]);
+#endif
+    }
+
+    printf ("\n");
+}
+
+int main()
+{
+    int inSize = 16;
+    int outSize = 24;
+    int nBlocks = 4;
+    atfft_sample block [16], upsampled [24];
+    atfft_sample *signal, *converted;
+    struct atfft_resample *resample;
+    struct atfft_resample_stream *stream;
+    int inHop = 0, outHop = 0;
+    int i = 0;
+
+    /* resample one period of a periodic signal from 16 to 24 samples */
+    for (i = 0; i < inSize; ++i)
+        block [i] = cos (2.0 * M_PI * i / inSize) + 0.5 * sin (2.0 * M_PI * 3 * i / inSize);
+
+    resample = atfft_resample_create (inSize, outSize);
+    printf ("Block:\n");
+    printSamples (block, inSize);
+
+    if (resample)
+    {
+        atfft_resample_transform (resample, block, upsampled);
+        printf ("\nResampled Block:\n");
+        printSamples (upsampled, outSize);
+        atfft_resample_destroy (resample);
+    }
+    else
+    {
+        printf ("\nThe DFT implementation doesn't support blocks of %d and %d samples.\n", inSize, outSize);
+    }
+
+    /* convert a stream of a 1kHz tone from 44.1kHz to 48kHz */
+    stream = atfft_resample_stream_create (44100, 48000, 255);
+
+    if (!stream)
+    {
+        printf ("\nThe DFT implementation doesn't support a block length for converting 44.1kHz to 48kHz.\n");
+        return 0;
+    }
+
+    inHop = atfft_resample_stream_in_hop_size (stream);
+    outHop = atfft_resample_stream_out_hop_size (stream);
+
+    signal = malloc (nBlocks * inHop * sizeof (*signal));
+    converted = malloc (nBlocks * outHop * sizeof (*converted));
+
+    for (i = 0; i < nBlocks * inHop; ++i)
+        signal [i] = sin (2.0 * M_PI * 1000.0 * i / 44100.0);
+
+    atfft_resample_stream_transform (stream, signal, nBlocks, converted);
+
+    printf ("\nConverted %d samples at 44.1kHz to %d at 48kHz with a latency of %d samples, the first after it:\n",
+            nBlocks * inHop,
+            nBlocks * outHop,
+            atfft_resample_stream_latency (stream));
+
+    printSamples (converted + atfft_resample_stream_latency (stream), 16);
+
+    /* free everything */
+    atfft_resample_stream_destroy (stream);
+    free (converted);
+    free (signal);
+
+    return 0;
+}
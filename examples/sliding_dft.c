@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <atfft/atfft.h>
+
+#ifndef M_PI
+#   define M_PI 3.14159265358979323846
+#endif
+
+void printMagnitudes (atfft_complex *data, const int *bins, int size)
+{
+    for (int i = 0; i < size; ++i)
+    {
+        atfft_sample magnitude = sqrt (ATFFT_RE (data [i]) * ATFFT_RE (data [i]) +
+                                       ATFFT_IM (data [i]) * ATFFT_IM (data [i]));
+
+#ifdef ATFFT_TYPE_LONG_DOUBLE
+        printf ("  bin %d: %Lf\n", bins [i], magnitude);
+#else
+        printf ("  bin %d: %f\n", bins [i], magnitude);
+#endif
+    }
+}
+
+int main()
+{
+    int windowSize = 64;
+    int hopSize = 16;
+    int nSamples = 256;
+    int bins [] = {4, 8, 12};
+    int nBins = 3;
+    atfft_sample *signal;
+    atfft_complex out [3];
+    struct atfft_sliding_dft *sdft;
+    struct atfft_goertzel *goertzel;
+    int i = 0;
+
+    signal = malloc (nSamples * sizeof (*signal));
+
+    /* construct a signal which switches from bin 4 to bin 12 half way through */
+    for (i = 0; i < nSamples; ++i)
+    {
+        atfft_sample x = 2.0 * M_PI * i / windowSize;
+
+        signal [i] = i < nSamples / 2 ? cos (4.0 * x) : cos (12.0 * x);
+    }
+
+    /* create a sliding dft and a goertzel filter bank tracking the same bins */
+    sdft = atfft_sliding_dft_create (windowSize, bins, nBins);
+    goertzel = atfft_goertzel_create (windowSize, bins, nBins);
+
+    /* slide along the signal a hop at a time */
+    for (i = 0; i + hopSize <= nSamples; i += hopSize)
+    {
+        atfft_sliding_dft_push (sdft, signal + i, hopSize);
+        atfft_sliding_dft_get_bins (sdft, out);
+
+        printf ("Sliding DFT of the %d samples before sample %d:\n", windowSize, i + hopSize);
+        printMagnitudes (out, bins, nBins);
+    }
+
+    /* compute the same bins of the last window in one go */
+    atfft_goertzel_transform (goertzel, signal + nSamples - windowSize, out);
+    printf ("\nGoertzel filter bank of the last %d samples:\n", windowSize);
+    printMagnitudes (out, bins, nBins);
+
+    /* free everything */
+    atfft_goertzel_destroy (goertzel);
+    atfft_sliding_dft_destroy (sdft);
+    free (signal);
+
+    return 0;
+}
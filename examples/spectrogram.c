@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <atfft/atfft.h>
+
+#ifndef M_PI
+#   define M_PI 3.14159265358979323846
+#endif
+
+void printFrames (atfft_sample *data, int nFrames, int nBands)
+{
+    for (int f = 0; f < nFrames; ++f)
+    {
+        for (int b = 0; b < nBands; ++b)
+        {
+#ifdef ATFFT_TYPE_LONG_DOUBLE
+            printf ("%6.2Lf ", data [f * nBands + b]);
+#else
+            printf ("%6.2f ", data [f * nBands + b]);
+#endif
+        }
+
+        printf ("\n");
+    }
+}
+
+int main()
+{
+    atfft_sample sampleRate = 8000;
+    int size = 8000;
+    int hopSize = 1024;
+    int nMelBands = 16;
+    int nCqtBands = 24;
+    int nFrames = 0;
+    atfft_sample *signal, *out;
+    struct atfft_spectrogram *mel, *cqt;
+    int i = 0;
+
+    signal = malloc (size * sizeof (*signal));
+
+    /* construct a sweep from 110 Hz to 440 Hz */
+    for (i = 0; i < size; ++i)
+    {
+        atfft_sample t = i / sampleRate;
+
+        signal [i] = sin (2.0 * M_PI * 110.0 * (pow (4.0, t) - 1.0) / log (4.0));
+    }
+
+    /* a log-mel spectrogram of 16 bands from 0 to 1000 Hz */
+    mel = atfft_spectrogram_create_mel (1024, hopSize, 1024, ATFFT_HANN_WINDOW, sampleRate, nMelBands, 0, 1000);
+    atfft_spectrogram_set_log_offset (mel, 1e-3);
+
+    nFrames = 1 + (size - atfft_spectrogram_frame_size (mel)) / hopSize;
+    out = malloc (nFrames * nMelBands * sizeof (*out));
+    atfft_spectrogram_transform (mel, signal, nFrames, out);
+
+    printf ("Log-Mel Spectrogram (one frame per line):\n");
+    printFrames (out, nFrames, nMelBands);
+    free (out);
+
+    /* a constant-Q spectrogram of 2 octaves from 110 Hz, with 12 bands per octave */
+    cqt = atfft_spectrogram_create_cqt (2048, hopSize, sampleRate, 110, 12, nCqtBands);
+    atfft_spectrogram_set_log_offset (cqt, 1e-3);
+
+    nFrames = 1 + (size - atfft_spectrogram_frame_size (cqt)) / hopSize;
+    out = malloc (nFrames * nCqtBands * sizeof (*out));
+    atfft_spectrogram_transform (cqt, signal, nFrames, out);
+
+    printf ("\nLog Constant-Q Spectrogram (one frame per line):\n");
+    printFrames (out, nFrames, nCqtBands);
+    free (out);
+
+    /* free everything */
+    atfft_spectrogram_destroy (cqt);
+    atfft_spectrogram_destroy (mel);
+    free (signal);
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <atfft/atfft.h>
+#include <atfft/stft.h>
+
+#ifndef M_PI
+#   define M_PI 3.14159265358979323846
+#endif
+
+int main()
+{
+    int nSamples = 4096;
+    int frameSize = 512;
+    int hopSize = 128;
+    int fftSize = 1024;
+    int blockSize = 300;
+    atfft_sample *signal, *output;
+    atfft_complex *spectrum;
+    struct atfft_stft *stft;
+    struct atfft_istft *istft;
+    atfft_sample error = 0.0;
+    int nFrames = 0;
+    int i = 0;
+
+    /* allocate some memory for the signals */
+    signal = malloc (nSamples * sizeof (*signal));
+    output = calloc (nSamples, sizeof (*output));
+    spectrum = malloc (atfft_halfcomplex_size (fftSize) * sizeof (*spectrum));
+
+    /* construct a chirp */
+    for (i = 0; i < nSamples; ++i)
+    {
+        atfft_sample t = (atfft_sample) i / nSamples;
+        signal [i] = sin (2.0 * M_PI * (20.0 + 200.0 * t) * t * 10.0);
+    }
+
+    /* create an stft and its inverse */
+    stft = atfft_stft_create (frameSize, hopSize, fftSize, ATFFT_HANN_WINDOW);
+    istft = atfft_istft_create (frameSize, hopSize, fftSize, ATFFT_HANN_WINDOW);
+
+    /* push the signal through a block at a time */
+    for (i = 0; i < nSamples; i += blockSize)
+    {
+        const atfft_sample *in = signal + i;
+        int size = ATFFT_MIN (blockSize, nSamples - i);
+
+        while (size > 0)
+        {
+            int n = atfft_stft_push (stft, in, size);
+            in += n;
+            size -= n;
+
+            while (atfft_stft_pull (stft, spectrum))
+            {
+                /* find the loudest bin in each frame */
+                int peak = 0;
+                int k = 0;
+
+                for (k = 1; k < atfft_halfcomplex_size (fftSize); ++k)
+                {
+                    if (atfft_abs (spectrum [k]) > atfft_abs (spectrum [peak]))
+                        peak = k;
+                }
+
+                if (nFrames % 4 == 0)
+                    printf ("Frame %d peak bin: %d\n", nFrames, peak);
+
+                atfft_istft_transform (istft, spectrum, output + nFrames * hopSize);
+                ++nFrames;
+            }
+        }
+    }
+
+    /* compare the reconstruction with the original */
+    for (i = frameSize - hopSize; i < nFrames * hopSize; ++i)
+    {
+        error = ATFFT_MAX (error, fabs (output [i] - signal [i]));
+    }
+
+#ifdef ATFFT_TYPE_LONG_DOUBLE
+    printf ("\nMaximum reconstruction error: %Lg\n", error);
+#else
+    printf ("\nMaximum reconstruction error: %g\n", error);
+#endif
+
+    /* free everything */
+    atfft_istft_destroy (istft);
+    atfft_stft_destroy (stft);
+    free (spectrum);
+    free (output);
+    free (signal);
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <atfft/atfft.h>
+#include <atfft/dft_unordered.h>
+
+int main()
+{
+    int size = 64;
+    atfft_sample *a, *b, *out, *spectrumA, *spectrumB, *spectrumAB;
+    struct atfft_dft_unordered *dft;
+    atfft_sample maxError = 0;
+    int i = 0, j = 0;
+
+    /* create an unordered DFT, spectra may be stored in any order */
+    dft = atfft_dft_unordered_create (size, ATFFT_REAL);
+
+    /* allocate some memory for the signals and spectra */
+    a = malloc (size * sizeof (*a));
+    b = malloc (size * sizeof (*b));
+    out = malloc (size * sizeof (*out));
+    spectrumA = malloc (atfft_dft_unordered_spectrum_size (dft) * sizeof (*spectrumA));
+    spectrumB = malloc (atfft_dft_unordered_spectrum_size (dft) * sizeof (*spectrumB));
+    spectrumAB = calloc (atfft_dft_unordered_spectrum_size (dft), sizeof (*spectrumAB));
+
+    /* a decaying exponential and a short ramp */
+    for (i = 0; i < size; ++i)
+    {
+        a [i] = exp (-0.1 * i);
+        b [i] = i < 8 ? i : 0;
+    }
+
+    /* multiply the spectra, normalising the result, and transform back */
+    atfft_dft_unordered_real_forward (dft, a, spectrumA);
+    atfft_dft_unordered_real_forward (dft, b, spectrumB);
+    atfft_dft_unordered_convolve_accumulate (dft, spectrumA, spectrumB, 1.0 / size, spectrumAB);
+    atfft_dft_unordered_real_backward (dft, spectrumAB, out);
+
+    /* compare with a direct circular convolution */
+    for (i = 0; i < size; ++i)
+    {
+        atfft_sample expected = 0;
+
+        for (j = 0; j < size; ++j)
+        {
+            expected += a [j] * b [(i - j + size) % size];
+        }
+
+        maxError = fmax (maxError, fabs (out [i] - expected));
+    }
+
+    printf ("Maximum error of circular convolution: %g\n", (double) maxError);
+
+    /* free everything */
+    free (spectrumAB);
+    free (spectrumB);
+    free (spectrumA);
+    free (out);
+    free (b);
+    free (a);
+    atfft_dft_unordered_destroy (dft);
+
+    return 0;
+}
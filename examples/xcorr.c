@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <atfft/atfft.h>
+#include <atfft/xcorr.h>
+
+int main()
+{
+    int nSamples = 1024;
+    int nChannels = 4;
+    int delays [] = {0, 5, -12, 30};
+    int nPairs = nChannels * (nChannels - 1) / 2;
+    int sourceSize = nSamples + 100;
+    atfft_sample *source, *signals, *lags;
+    struct atfft_xcorr *xcorr;
+    int a, b, i, pair = 0;
+
+    /* allocate some memory for the signals */
+    source = malloc (sourceSize * sizeof (*source));
+    signals = malloc (nChannels * nSamples * sizeof (*signals));
+    lags = malloc (nPairs * sizeof (*lags));
+
+    /* construct some noise and delay it by a different amount for each channel */
+    for (i = 0; i < sourceSize; ++i)
+    {
+        source [i] = (atfft_sample) rand() / RAND_MAX - 0.5;
+    }
+
+    for (a = 0; a < nChannels; ++a)
+    {
+        for (i = 0; i < nSamples; ++i)
+        {
+            signals [a * nSamples + i] = source [50 + i - delays [a]];
+        }
+    }
+
+    /* find the delay between each pair of channels with GCC-PHAT */
+    xcorr = atfft_xcorr_create (nSamples, nChannels, ATFFT_XCORR_PHAT);
+    atfft_xcorr_set_signals (xcorr, signals, nSamples);
+    atfft_xcorr_peak_lags (xcorr, 50, 1, lags, NULL);
+
+    for (a = 0; a < nChannels; ++a)
+    {
+        for (b = a + 1; b < nChannels; ++b)
+        {
+            printf ("Channels %d and %d: lag %.2f (actual %d)\n", a, b, (double) lags [pair], delays [a] - delays [b]);
+            ++pair;
+        }
+    }
+
+    /* free everything */
+    atfft_xcorr_destroy (xcorr);
+    free (lags);
+    free (signals);
+    free (source);
+
+    return 0;
+}
@@ -24,6 +24,22 @@
 #include <atfft/dft_util.h>
 #include <atfft/dft_nd.h>
 #include <atfft/dft_nd_util.h>
+#include <atfft/dft_backend.h>
+#include <atfft/dft_auto.h>
+#include <atfft/dft_planner.h>
+#include <atfft/dft_unordered.h>
 #include <atfft/dct.h>
 #include <atfft/dct_util.h>
+#include <atfft/dct2d.h>
+#include <atfft/dct_batch.h>
 #include <atfft/windows.h>
+#include <atfft/stft.h>
+#include <atfft/convolver.h>
+#include <atfft/xcorr.h>
+#include <atfft/sliding_dft.h>
+#include <atfft/goertzel.h>
+#include <atfft/hilbert.h>
+#include <atfft/psd.h>
+#include <atfft/spectrogram.h>
+#include <atfft/channelizer.h>
+#include <atfft/resample.h>
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/** @file
+ * struct and functions for splitting a complex stream into uniformly spaced channels with a polyphase filter bank.
+ */
+
+#ifndef ATFFT_CHANNELIZER_H_INCLUDED
+#define ATFFT_CHANNELIZER_H_INCLUDED
+
+#include <atfft/types.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** An enum to represent the output sample rate of a channelizer's channels. */
+enum atfft_channelizer_sampling
+{
+    ATFFT_CRITICALLY_SAMPLED, /**< Each channel is output at the input rate divided by the number of channels. */
+    ATFFT_OVERSAMPLED_2X /**< Each channel is output at twice the critically sampled rate. */
+};
+
+/**
+ * A structure to hold the state of a polyphase filter bank channelizer.
+ *
+ * A stream with a sample rate \f$ f_s \f$ is split into M channels, channel k being centred on \f$ k f_s / M \f$
+ * (channels above M / 2 holding the negative frequencies) and output at baseband. Every hop of D samples, where D is
+ * M for critically sampled channels or M / 2 for 2x oversampled channels, the last L = P M input samples
+ * \f$ x [t_0], \dots, x [t_0 + L - 1] \f$ give one output sample for each channel
+ *
+ * \f[ y_k = \sum_{i = 0}^{L - 1} h [i] x [t_0 + i] e^{-2 \pi j k (t_0 + i) / M} \f]
+ *
+ * where h is the prototype lowpass filter. This is computed with a weighted overlap-add structure. The windowed
+ * samples are folded into M polyphase sums, which are rotated by \f$ t_0 \bmod M \f$ so the phase of every channel is
+ * referred to the absolute time, and transformed with an M point complex DFT.
+ *
+ * Frames are processed in batches. The polyphase sums of a whole batch are computed, then the DFTs of the batch are
+ * taken one after another with the same plan. All the working space is allocated when the channelizer is created.
+ */
+struct atfft_channelizer;
+
+/**
+ * Create a channelizer structure.
+ *
+ * @param n_channels the number of channels, M (should be even for 2x oversampled channels)
+ * @param sampling the output sample rate of the channels
+ * @param taps_per_channel the length of the prototype filter divided by the number of channels, P
+ * @param prototype the prototype filter (should contain @p n_channels * @p taps_per_channel elements), or NULL to use
+ *                  a Blackman windowed sinc lowpass filter with a cutoff of half the channel spacing and a gain of one,
+ *                  so a tone at the centre of a channel appears in that channel with its own amplitude
+ */
+struct atfft_channelizer* atfft_channelizer_create (int n_channels,
+                                                    enum atfft_channelizer_sampling sampling,
+                                                    int taps_per_channel,
+                                                    const atfft_sample *prototype);
+
+/**
+ * Free a channelizer structure.
+ *
+ * @param channelizer the structure to free
+ */
+void atfft_channelizer_destroy (struct atfft_channelizer *channelizer);
+
+/**
+ * Get the number of input samples consumed for each output sample of each channel.
+ *
+ * @param channelizer a valid channelizer structure
+ */
+int atfft_channelizer_hop_size (struct atfft_channelizer *channelizer);
+
+/**
+ * Channelize the next samples of a stream.
+ *
+ * The first outputs use the zeros the history is initialised with in place of the samples before the stream starts.
+ *
+ * @param channelizer a valid channelizer structure
+ * @param in the next samples (should contain @p n_frames * hop_size elements)
+ * @param n_frames the number of output samples to compute for each channel
+ * @param out the channel outputs, the output of channel k for frame f being written to
+ *            @p out [f * n_channels + k] (should have space for @p n_frames * n_channels elements)
+ */
+void atfft_channelizer_transform (struct atfft_channelizer *channelizer,
+                                  atfft_complex *in,
+                                  int n_frames,
+                                  atfft_complex *out);
+
+/**
+ * Clear the history of a channelizer structure.
+ *
+ * @param channelizer a valid channelizer structure
+ */
+void atfft_channelizer_reset (struct atfft_channelizer *channelizer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATFFT_CHANNELIZER_H_INCLUDED */
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/** @file
+ * struct and functions for convolving a stream of samples with a long kernel.
+ */
+
+#ifndef ATFFT_CONVOLVER_H_INCLUDED
+#define ATFFT_CONVOLVER_H_INCLUDED
+
+#include <atfft/types.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * A structure to hold the state of a partitioned convolution.
+ *
+ * The kernel is split into partitions of the block size whose spectra are computed when the structure is created.
+ * Each block of input is then transformed once and multiplied with every partition spectrum against a delay line of
+ * past input spectra (uniformly partitioned overlap-save), so the latency is one block and the cost per block is
+ * one forward and one inverse real DFT plus a complex multiply-accumulate per partition.
+ */
+struct atfft_convolver;
+
+/**
+ * Create a convolver structure.
+ *
+ * @param kernel the kernel to convolve with (should contain @p kernel_size elements)
+ * @param kernel_size the length of the kernel
+ * @param block_size the number of samples processed by each call to atfft_convolver_process()
+ */
+struct atfft_convolver* atfft_convolver_create (const atfft_sample *kernel, int kernel_size, int block_size);
+
+/**
+ * Free a convolver structure.
+ *
+ * @param convolver the structure to free
+ */
+void atfft_convolver_destroy (struct atfft_convolver *convolver);
+
+/**
+ * Convolve the next block of a stream.
+ *
+ * @param convolver a valid convolver structure
+ * @param in the next block of input (should contain block_size elements)
+ * @param out the next block of output (should have space for block_size elements), this may be the same as @p in
+ */
+void atfft_convolver_process (struct atfft_convolver *convolver, const atfft_sample *in, atfft_sample *out);
+
+/**
+ * Clear the history of a convolver structure.
+ *
+ * After this the output will be as if no input had been processed yet.
+ *
+ * @param convolver a valid convolver structure
+ */
+void atfft_convolver_reset (struct atfft_convolver *convolver);
+
+/**
+ * A structure to hold the state of a zero latency partitioned convolution.
+ *
+ * The kernel is split into partitions which grow in size along the kernel (non-uniform partitioning). The first
+ * block of the kernel is applied directly and the next few blocks by a uniformly partitioned convolver in the
+ * calling thread, so the output of each call includes the response to its own input. The rest of the kernel is
+ * covered by stages whose block size doubles each time. Each of these stages runs its own convolver on a worker
+ * thread and has one of its blocks worth of time to finish before its output is needed. The worker threads use
+ * pthreads, so it is only available where they are (and must be linked with -lpthread where that is separate).
+ */
+struct atfft_zero_latency_convolver;
+
+/**
+ * Create a zero_latency_convolver structure.
+ *
+ * This starts a worker thread for each of the background stages.
+ *
+ * @param kernel the kernel to convolve with (should contain @p kernel_size elements)
+ * @param kernel_size the length of the kernel
+ * @param block_size the number of samples processed by each call to atfft_zero_latency_convolver_process()
+ */
+struct atfft_zero_latency_convolver* atfft_zero_latency_convolver_create (const atfft_sample *kernel,
+                                                                          int kernel_size,
+                                                                          int block_size);
+
+/**
+ * Free a zero_latency_convolver structure, stopping its worker threads.
+ *
+ * @param convolver the structure to free
+ */
+void atfft_zero_latency_convolver_destroy (struct atfft_zero_latency_convolver *convolver);
+
+/**
+ * Convolve the next block of a stream with no latency.
+ *
+ * This does not allocate memory so is suitable for a real-time thread. It only locks a stage's mutex for long enough
+ * to hand a block to the worker or check it has finished, it only waits if a worker thread has missed the deadline for
+ * its stage, in which case it blocks until that stage is finished.
+ *
+ * @param convolver a valid zero_latency_convolver structure
+ * @param in the next block of input (should contain block_size elements)
+ * @param out the next block of output (should have space for block_size elements), this may be the same as @p in
+ */
+void atfft_zero_latency_convolver_process (struct atfft_zero_latency_convolver *convolver,
+                                           const atfft_sample *in,
+                                           atfft_sample *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATFFT_CONVOLVER_H_INCLUDED */
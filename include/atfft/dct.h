@@ -34,6 +34,38 @@ extern "C"
 {
 #endif
 
+/**
+ * An enum to represent the type of a cosine or sine transform.
+ *
+ * The definitions used are those of FFTW's real-to-real transforms scaled by 1/2, e.g. the DCT-II of a signal
+ * \f$ x \f$ of length \f$ N \f$ is
+ * \f$ X_{k} = \sum_{n=0}^{N-1} x_{n} \cos \left( \frac{\pi}{N} \left( n + \frac{1}{2} \right) k \right) \f$.
+ *
+ * The MDCT of size \f$ N \f$ takes \f$ 2N \f$ samples to \f$ N \f$ coefficients:
+ * \f$ X_{k} = \sum_{n=0}^{2N-1} x_{n} \cos \left( \frac{\pi}{N} \left( n + \frac{1}{2} + \frac{N}{2} \right)
+ * \left( k + \frac{1}{2} \right) \right) \f$,
+ * the IMDCT of size \f$ N \f$ takes \f$ N \f$ coefficients back to \f$ 2N \f$ samples using the same kernel.
+ *
+ * Each type is inverted by its partner (DCT-II by DCT-III, MDCT by IMDCT), or by itself for types I and IV,
+ * followed by atfft_normalise_dct_type().
+ *
+ * Every type is available with every implementation. Types which an implementation's own DCT does not provide are
+ * computed from its DFT, as are sizes it does not support when the plan is made with atfft_dct_create_type().
+ */
+enum atfft_dct_type
+{
+    ATFFT_DCT_I, /**< DCT-I, the signal length must be at least 2. */
+    ATFFT_DCT_II, /**< DCT-II, the same as a forward transform created with atfft_dct_create(). */
+    ATFFT_DCT_III, /**< DCT-III, the same as a backward transform created with atfft_dct_create(). */
+    ATFFT_DCT_IV, /**< DCT-IV. */
+    ATFFT_DST_I, /**< DST-I. */
+    ATFFT_DST_II, /**< DST-II. */
+    ATFFT_DST_III, /**< DST-III. */
+    ATFFT_DST_IV, /**< DST-IV. */
+    ATFFT_MDCT, /**< Modified DCT, the size must be even. */
+    ATFFT_IMDCT /**< Inverse modified DCT, the size must be even. */
+};
+
 /** 
  * A Structure to hold internal FFT implementation.
  * 
@@ -50,15 +82,33 @@ struct atfft_dct;
  */
 int atfft_dct_is_supported_size (int size);
 
+/**
+ * Check whether a given signal length is supported by the current DCT implementation for the given transform type.
+ *
+ * @param size the signal length to check (the number of coefficients for the MDCT and IMDCT)
+ * @param type the type of transform
+ */
+int atfft_dct_is_supported_type (int size, enum atfft_dct_type type);
+
 /**
  * Create a dct structure.
  *
+ * A forward transform is a DCT-II and a backward transform a DCT-III.
+ *
  * @param size the signal length the dct should operate on
  * @param direction the direction of the transform
- * @param format the type of transform (real or complex)
  */
 struct atfft_dct* atfft_dct_create (int size, enum atfft_direction direction);
 
+/**
+ * Create a dct structure for a specific type of cosine or sine transform.
+ *
+ * @param size the signal length the transform should operate on
+ *             (the number of coefficients for the MDCT and IMDCT)
+ * @param type the type of transform
+ */
+struct atfft_dct* atfft_dct_create_type (int size, enum atfft_dct_type type);
+
 /**
  * Free a dct structure.
  *
@@ -67,19 +117,34 @@ struct atfft_dct* atfft_dct_create (int size, enum atfft_direction direction);
 void atfft_dct_destroy (struct atfft_dct *dct);
 
 /**
- * Perform a complex DCT.
+ * Perform a DCT.
  *
  * Performs a forward or inverse transform depending on what the dct
  * structure passed was created for.
  *
  * @param dct a valid dct structure 
  * @param in the input signal 
- *           (should have the number of samples the dct was created for)
+ *           (should have the number of samples the dct was created for, twice that for an MDCT)
  * @param out the output signal 
- *            (should have the number of samples the dct was created for)
+ *            (should have the number of samples the dct was created for, twice that for an IMDCT)
  */
 void atfft_dct_transform (struct atfft_dct *dct, const atfft_sample *in, atfft_sample *out);
 
+/**
+ * Set the window applied by an MDCT or IMDCT.
+ *
+ * The MDCT multiplies its input by the window before transforming, the IMDCT multiplies its output by the window.
+ * For time domain aliasing cancellation the window should satisfy the Princen-Bradley condition
+ * \f$ w_{n}^{2} + w_{n+N}^{2} = 1 \f$, as atfft_sine_window() and atfft_kaiser_bessel_derived_window() do.
+ *
+ * @param dct a valid dct structure (should have been created with a type of ATFFT_MDCT or ATFFT_IMDCT)
+ * @param window the window to apply (should contain 2 * size elements, where size is the size @p dct was created for),
+ *               or NULL to remove any window
+ *
+ * @return 0 on success, -1 if the window could not be stored
+ */
+int atfft_dct_set_window (struct atfft_dct *dct, const atfft_sample *window);
+
 #ifdef __cplusplus
 }
 #endif
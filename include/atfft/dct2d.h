@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/** @file
+ * functions for performing two dimensional DCTs on many small square blocks at once.
+ */
+
+#ifndef ATFFT_DCT2D_H_INCLUDED
+#define ATFFT_DCT2D_H_INCLUDED
+
+#include <atfft/types.h>
+#include <atfft/dct.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * Check whether a block size and transform type are supported by atfft_dct2d_blocks().
+ *
+ * Block sizes of 8, 16 and 32 are supported for the ATFFT_DCT_II and ATFFT_DCT_III types.
+ *
+ * @param block_size the width (and height) of the blocks
+ * @param type the type of transform
+ */
+int atfft_dct2d_is_supported (int block_size, enum atfft_dct_type type);
+
+/**
+ * Perform two dimensional DCTs on a sequence of square blocks.
+ *
+ * Each block is stored contiguously in row major order, one after the other. A DCT of the given type is applied to
+ * the rows and columns of each block, using the same definitions as atfft_dct_create_type(). Blocks are transformed
+ * several at a time using fixed factorised kernels, so no plan is needed.
+ *
+ * The input and output may point to the same memory.
+ *
+ * A DCT-III of the output of a DCT-II will give back the input multiplied by (@p block_size / 2)^2, this can be
+ * undone with atfft_normalise_dct2d().
+ *
+ * @param type the type of transform (ATFFT_DCT_II or ATFFT_DCT_III)
+ * @param block_size the width (and height) of the blocks (8, 16 or 32)
+ * @param n_blocks the number of blocks to transform
+ * @param in the input blocks (should contain @p n_blocks * @p block_size * @p block_size elements)
+ * @param out the output blocks (should contain @p n_blocks * @p block_size * @p block_size elements)
+ */
+void atfft_dct2d_blocks (enum atfft_dct_type type,
+                         int block_size,
+                         int n_blocks,
+                         const atfft_sample *in,
+                         atfft_sample *out);
+
+/**
+ * Perform two dimensional DCTs on a sequence of square blocks of single precision floats.
+ *
+ * This is the same as atfft_dct2d_blocks() but always operates in single precision, whatever type \ref atfft_sample
+ * is.
+ *
+ * @param type the type of transform (ATFFT_DCT_II or ATFFT_DCT_III)
+ * @param block_size the width (and height) of the blocks (8, 16 or 32)
+ * @param n_blocks the number of blocks to transform
+ * @param in the input blocks (should contain @p n_blocks * @p block_size * @p block_size elements)
+ * @param out the output blocks (should contain @p n_blocks * @p block_size * @p block_size elements)
+ */
+void atfft_dct2d_blocks_float (enum atfft_dct_type type,
+                               int block_size,
+                               int n_blocks,
+                               const float *in,
+                               float *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATFFT_DCT2D_H_INCLUDED */
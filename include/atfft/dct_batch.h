@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/** @file
+ * struct and functions for performing DCTs on many signals at once.
+ */
+
+#ifndef ATFFT_DCT_BATCH_H_INCLUDED
+#define ATFFT_DCT_BATCH_H_INCLUDED
+
+#include <atfft/types.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * A structure to hold the state for transforming a batch of signals.
+ *
+ * This is created with atfft_dct_batch_create() and passed to atfft_dct_batch_transform() to compute the DCT of
+ * each signal in the batch.
+ */
+struct atfft_dct_batch;
+
+/**
+ * Create a dct_batch structure.
+ *
+ * A forward transform is a DCT-II and a backward transform a DCT-III, using the same definitions as
+ * atfft_dct_create().
+ *
+ * Short transforms are computed as a matrix multiplication over several signals at a time, which avoids the cost of
+ * a DFT per signal and only computes the outputs which are asked for. Longer transforms fall back on a dct structure
+ * for each signal.
+ *
+ * @param size the signal length each DCT should operate on
+ * @param howmany the number of signals in a batch
+ * @param in_dist the distance between the first samples of consecutive input signals
+ * @param out_dist the distance between the first samples of consecutive output signals
+ * @param n_outputs the number of outputs to compute for each signal,
+ *                  only the first @p n_outputs values of each transform will be written (at most @p size)
+ * @param direction the direction of the transform
+ */
+struct atfft_dct_batch* atfft_dct_batch_create (int size,
+                                                int howmany,
+                                                int in_dist,
+                                                int out_dist,
+                                                int n_outputs,
+                                                enum atfft_direction direction);
+
+/**
+ * Free a dct_batch structure.
+ *
+ * @param batch the structure to free
+ */
+void atfft_dct_batch_destroy (struct atfft_dct_batch *batch);
+
+/**
+ * Perform the DCTs of a batch of signals.
+ *
+ * @param batch a valid dct_batch structure
+ * @param in the input signals
+ *           (should contain at least (howmany - 1) * in_dist + size elements)
+ * @param out the output signals
+ *            (should contain at least (howmany - 1) * out_dist + n_outputs elements)
+ */
+void atfft_dct_batch_transform (struct atfft_dct_batch *batch, const atfft_sample *in, atfft_sample *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATFFT_DCT_BATCH_H_INCLUDED */
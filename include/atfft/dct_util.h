@@ -28,6 +28,7 @@
 #define ATFFT_DCT_UTIL_H_INCLUDED
 
 #include <atfft/types.h>
+#include <atfft/dct.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -44,6 +45,34 @@ extern "C"
  */
 void atfft_normalise_dct (atfft_sample *data, int size);
 
+/**
+ * Normalise the output of a cosine or sine transform.
+ *
+ * Applies the scaling which makes a transform and its inverse return the original signal. This is 2 / @p size for
+ * most types, 2 / (@p size - 1) for the DCT-I and 2 / (@p size + 1) for the DST-I.
+ *
+ * For the IMDCT the 2 / @p size scaling is applied to all 2 * @p size output samples, giving perfect reconstruction
+ * when overlap-adding frames which were windowed by a window satisfying the Princen-Bradley condition (see
+ * atfft_dct_set_window()) on both the MDCT and IMDCT.
+ *
+ * @param data the signal to normalise
+ *             (should contain at least @p size elements, or 2 * @p size for an IMDCT)
+ * @param size the size the transform was created for
+ * @param type the type of the transform which produced @p data
+ */
+void atfft_normalise_dct_type (atfft_sample *data, int size, enum atfft_dct_type type);
+
+/**
+ * Normalise the output of atfft_dct2d_blocks().
+ *
+ * Applies 4 / (@p block_size * @p block_size) scaling to every sample of every block.
+ *
+ * @param data the blocks to normalise (should contain at least @p n_blocks * @p block_size * @p block_size elements)
+ * @param block_size the width (and height) of the blocks
+ * @param n_blocks the number of blocks
+ */
+void atfft_normalise_dct2d (atfft_sample *data, int block_size, int n_blocks);
+
 #ifdef __cplusplus
 }
 #endif
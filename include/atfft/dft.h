@@ -87,6 +87,40 @@ int atfft_dft_is_supported_size (int size, enum atfft_format format);
  */
 struct atfft_dft* atfft_dft_create (int size, enum atfft_direction direction, enum atfft_format format);
 
+/**
+ * Create a pruned DFT plan.
+ *
+ * A pruned plan is for signals where only the first @p n_inputs elements of the input may be non-zero, and where only
+ * the outputs from @p first_output to (@p first_output + @p n_outputs - 1) are required. This is the case when
+ * zero-padding short frames for spectral interpolation, or when only a band of bins is of interest. The plan is used
+ * with the same transform functions as one created with atfft_dft_create(), but is able to skip the butterflies which
+ * only operate on zeros or only contribute to unused outputs.
+ *
+ * The input passed to the transform functions should still contain the full number of elements, with those from
+ * @p n_inputs onwards set to zero, though the plan need not read them. The output should also contain the full number
+ * of elements, the values outside the requested range are undefined.
+ *
+ * Pruning is a hint, depending on the signal length and the DFT implementation, some or all of the full transform may
+ * still be computed.
+ *
+ * @param size the signal length the DFT should operate on
+ * @param direction the direction of the transform
+ * @param format the type of time domain signal the transform will apply to (real or complex)
+ * @param n_inputs the number of leading inputs which may be non-zero
+ *                 (for ATFFT_REAL backward transforms this counts halfcomplex bins)
+ * @param first_output the index of the first output required
+ * @param n_outputs the number of outputs required
+ *                  (for ATFFT_REAL forward transforms these index halfcomplex bins)
+ *
+ * @return the plan, or NULL if the pruning parameters are invalid (see atfft_dft_is_valid_pruning())
+ */
+struct atfft_dft* atfft_dft_create_pruned (int size,
+                                           enum atfft_direction direction,
+                                           enum atfft_format format,
+                                           int n_inputs,
+                                           int first_output,
+                                           int n_outputs);
+
 /**
  * Free a DFT plan.
  *
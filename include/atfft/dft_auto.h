@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/** @file
+ * This header provides the functions controlling the "auto" DFT backend, available when ATFFT is built with
+ * ATFFT_MULTI_BACKEND (see atfft/dft_backend.h).
+ *
+ * No single DFT implementation is fastest for every size: one may win on powers of two, another on primes or on sizes
+ * with many small factors. The first time the auto backend is asked for a plan of a given size, direction and format
+ * it times the transforms of every available backend, including the variants of the native planner, and remembers the
+ * fastest. Later plans for the same transform use that backend straight away.
+ *
+ * The auto backend is used by passing "auto" as the name of the backend to atfft_dft_create_with_backend(), or by
+ * making it the default with atfft_dft_set_default_backend() so that atfft_dft_create(), and everything built on it,
+ * uses it.
+ *
+ * The choices made, known as wisdom, can be saved to a file and loaded in later runs, so the timing only happens once.
+ * The file is plain text, each line holding the size, direction, format and the name of the chosen backend:
+ *
+ *     1024 forward complex pffft
+ *     1021 backward real native_rader
+ *
+ * Lines starting with '#' are ignored, and where several lines describe the same transform the last one is used.
+ *
+ * None of these functions are thread safe.
+ */
+
+#ifndef ATFFT_DFT_AUTO_H_INCLUDED
+#define ATFFT_DFT_AUTO_H_INCLUDED
+
+#include <atfft/types.h>
+#include <atfft/dft_backend.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * The name of the auto backend.
+ */
+#define ATFFT_DFT_AUTO_BACKEND "auto"
+
+/**
+ * Find the fastest backend for a transform.
+ *
+ * The wisdom is consulted first, if it has no entry for the transform, or the entry names a backend which isn't
+ * available, each backend is timed and the result recorded.
+ *
+ * @param size the signal length of the DFT
+ * @param direction the direction of the transform
+ * @param format the type of time domain signal the transform will apply to (real or complex)
+ *
+ * @return the fastest backend, or NULL if no backend can create the transform
+ */
+const struct atfft_dft_backend* atfft_dft_auto_select (int size,
+                                                       enum atfft_direction direction,
+                                                       enum atfft_format format);
+
+/**
+ * Load wisdom from a file, adding to or replacing the choices already made.
+ *
+ * @param path the file to read
+ *
+ * @return non-zero on success, zero if the file couldn't be read
+ */
+int atfft_dft_auto_import_wisdom (const char *path);
+
+/**
+ * Save the current wisdom to a file.
+ *
+ * @param path the file to write
+ *
+ * @return non-zero on success, zero if the file couldn't be written
+ */
+int atfft_dft_auto_export_wisdom (const char *path);
+
+/**
+ * Keep the wisdom in a file.
+ *
+ * Any wisdom already in the file is loaded (the file need not exist yet), then each new choice is appended to it as
+ * soon as it is made.
+ *
+ * Until this is called the auto backend uses the wisdom file set with atfft_dft_set_wisdom_file(), once it is called
+ * that file is no longer followed.
+ *
+ * @param path the file to use, or NULL to stop saving choices
+ *
+ * @return non-zero on success, zero if memory couldn't be allocated
+ */
+int atfft_dft_auto_set_wisdom_file (const char *path);
+
+/**
+ * Forget all the choices made so far, so each transform is timed again when next planned.
+ */
+void atfft_dft_auto_forget_wisdom (void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATFFT_DFT_AUTO_H_INCLUDED */
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/** @file
+ * This header provides a registry of DFT implementations which can be used side by side in a single build.
+ *
+ * By default ATFFT is built against exactly one DFT implementation, chosen with the IMPL variable in the makefiles. When
+ * it is instead built with ATFFT_MULTI_BACKEND defined, each wrapped implementation exports a table of its functions
+ * (a struct atfft_dft_backend) under the name atfft_<name>_dft_backend, and the functions in atfft/dft.h become thin
+ * dispatchers which forward each call to the backend a plan was created with through a single indirect call.
+ *
+ * The backends compiled into the library are always available. Others can be registered at run time, either from a
+ * table provided by the application, or by loading a shared library exporting one with atfft_dft_load_backend().
+ *
+ * atfft_dft_create() uses the default backend, if one has been set with atfft_dft_set_default_backend() and it
+ * supports the requested size. Otherwise it uses the first backend which does, trying those registered at run time in
+ * the order they were registered, followed by those compiled in. The native implementation is compiled into every
+ * multi-backend build and is tried last, so every size is supported. atfft_dft_create_with_backend() creates a plan
+ * with a specific backend.
+ *
+ * As well as the backends themselves the name "auto" may be used, which times the available backends and picks the
+ * fastest for each transform (see atfft/dft_auto.h).
+ *
+ * Registering backends is not thread safe, it should be done before any plans are created.
+ */
+
+#ifndef ATFFT_DFT_BACKEND_H_INCLUDED
+#define ATFFT_DFT_BACKEND_H_INCLUDED
+
+#include <stdio.h>
+#include <atfft/types.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+struct atfft_dft;
+
+/**
+ * @struct atfft_dft_backend_plan atfft/dft_backend.h
+ *
+ * An opaque struct holding a plan created by one of the backends.
+ */
+struct atfft_dft_backend_plan;
+
+/**
+ * The functions implementing a DFT backend.
+ *
+ * Each function has the same meaning as its counterpart in atfft/dft.h. The strided transforms, print_plan and
+ * is_supported_size may be NULL if the wrapped library doesn't provide them. The strided transforms then gather and
+ * scatter through contiguous buffers, and the backend is assumed to support the sizes it can create plans for.
+ */
+struct atfft_dft_backend
+{
+    const char *name;
+
+    int (*is_supported_size) (int size, enum atfft_format format);
+
+    struct atfft_dft_backend_plan* (*create) (int size,
+                                              enum atfft_direction direction,
+                                              enum atfft_format format);
+
+    struct atfft_dft_backend_plan* (*create_pruned) (int size,
+                                                     enum atfft_direction direction,
+                                                     enum atfft_format format,
+                                                     int n_inputs,
+                                                     int first_output,
+                                                     int n_outputs);
+
+    void (*destroy) (struct atfft_dft_backend_plan *plan);
+
+    void (*complex_transform) (struct atfft_dft_backend_plan *plan, atfft_complex *in, atfft_complex *out);
+
+    void (*complex_transform_stride) (struct atfft_dft_backend_plan *plan,
+                                      atfft_complex *in,
+                                      int in_stride,
+                                      atfft_complex *out,
+                                      int out_stride);
+
+    void (*real_forward_transform) (struct atfft_dft_backend_plan *plan, const atfft_sample *in, atfft_complex *out);
+
+    void (*real_forward_transform_stride) (struct atfft_dft_backend_plan *plan,
+                                           const atfft_sample *in,
+                                           int in_stride,
+                                           atfft_complex *out,
+                                           int out_stride);
+
+    void (*real_backward_transform) (struct atfft_dft_backend_plan *plan, atfft_complex *in, atfft_sample *out);
+
+    void (*real_backward_transform_stride) (struct atfft_dft_backend_plan *plan,
+                                            atfft_complex *in,
+                                            int in_stride,
+                                            atfft_sample *out,
+                                            int out_stride);
+
+    void (*print_plan) (struct atfft_dft_backend_plan *plan, FILE *stream);
+};
+
+/**
+ * Register a DFT backend.
+ *
+ * The backend is tried by atfft_dft_create() before any registered after it and before those compiled into the library.
+ *
+ * @param backend the backend's function table (must remain valid for the life of the program)
+ *
+ * @return non-zero on success, zero if a backend with the same name is already registered or the registry is full
+ */
+int atfft_dft_register_backend (const struct atfft_dft_backend *backend);
+
+/**
+ * Load a DFT backend from a shared library and register it.
+ *
+ * The library should have been built from the backend's wrapper with ATFFT_MULTI_BACKEND defined, it must export the
+ * table atfft_<name>_dft_backend. It should also contain the atfft helpers the wrapper calls (from types.c and
+ * dft_util.c), as the program loading it may not export its own copies. The examples makefile builds such libraries,
+ * e.g. make IMPL=MULTI libatfft_ooura.so, and examples/load_backend.c loads one. The library must be built with the
+ * same sample type as the program. It stays loaded for the life of the program.
+ *
+ * @param name the name of the backend
+ * @param path the path of the shared library, or NULL to search the usual locations for libatfft_<name>.so
+ *
+ * @return the backend, or NULL if it couldn't be loaded
+ *         (the backend is returned without loading anything if it is already registered)
+ */
+const struct atfft_dft_backend* atfft_dft_load_backend (const char *name, const char *path);
+
+/**
+ * Find a registered or built-in DFT backend.
+ *
+ * @param name the name of the backend
+ *
+ * @return the backend, or NULL if there is none by that name
+ */
+const struct atfft_dft_backend* atfft_dft_find_backend (const char *name);
+
+/**
+ * Set the backend atfft_dft_create() and atfft_dft_create_pruned() try first.
+ *
+ * @param name the name of the backend, "auto" to choose the fastest backend for each transform,
+ *             or NULL to go back to trying the backends in order
+ *
+ * @return non-zero on success, zero if there is no backend by that name
+ */
+int atfft_dft_set_default_backend (const char *name);
+
+/**
+ * Get the number of available DFT backends.
+ */
+int atfft_dft_n_backends (void);
+
+/**
+ * Get one of the available DFT backends, in the order atfft_dft_create() tries them.
+ *
+ * @param index the index of the backend (should be less than atfft_dft_n_backends())
+ */
+const struct atfft_dft_backend* atfft_dft_get_backend (int index);
+
+/**
+ * Create a DFT plan using a specific backend.
+ *
+ * The plan is used and freed with the functions in atfft/dft.h.
+ *
+ * @param name the name of the backend, or "auto" to use the fastest
+ * @param size the signal length the DFT should operate on
+ * @param direction the direction of the transform
+ * @param format the type of time domain signal the transform will apply to (real or complex)
+ *
+ * @return the plan, or NULL if the backend isn't available or can't create the plan
+ */
+struct atfft_dft* atfft_dft_create_with_backend (const char *name,
+                                                 int size,
+                                                 enum atfft_direction direction,
+                                                 enum atfft_format format);
+
+/**
+ * Create a pruned DFT plan (see atfft_dft_create_pruned()) using a specific backend.
+ *
+ * @param name the name of the backend, or "auto" to use the fastest for the unpruned transform
+ * @param size the signal length the DFT should operate on
+ * @param direction the direction of the transform
+ * @param format the type of time domain signal the transform will apply to (real or complex)
+ * @param n_inputs the number of leading inputs which may be non-zero
+ * @param first_output the index of the first output required
+ * @param n_outputs the number of outputs required
+ *
+ * @return the plan, or NULL if the backend isn't available or can't create the plan
+ */
+struct atfft_dft* atfft_dft_create_pruned_with_backend (const char *name,
+                                                        int size,
+                                                        enum atfft_direction direction,
+                                                        enum atfft_format format,
+                                                        int n_inputs,
+                                                        int first_output,
+                                                        int n_outputs);
+
+/**
+ * Get the backend a DFT plan was created with.
+ *
+ * @param plan a valid DFT plan
+ */
+const struct atfft_dft_backend* atfft_dft_get_plan_backend (struct atfft_dft *plan);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATFFT_DFT_BACKEND_H_INCLUDED */
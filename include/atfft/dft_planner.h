@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/** @file
+ * functions for configuring how DFT plans are made.
+ */
+
+#ifndef ATFFT_DFT_PLANNER_H_INCLUDED
+#define ATFFT_DFT_PLANNER_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * How much effort should be spent finding a fast plan.
+ *
+ * These correspond to FFTW's planner flags. Implementations without a choice of plans ignore them.
+ */
+enum atfft_planning_effort
+{
+    ATFFT_ESTIMATE, /**< pick a plan without running any transforms */
+    ATFFT_MEASURE, /**< time a few candidate plans */
+    ATFFT_PATIENT, /**< time a wider range of plans */
+    ATFFT_EXHAUSTIVE /**< time every plan available */
+};
+
+/**
+ * The options below apply to every DFT plan created after they are set, including the plans used inside other
+ * structures (dct, convolver, etc.).
+ *
+ * Each implementation uses the options it supports:
+ * - FFTW maps the effort onto its planner flags. It plans with the given number of threads if atfft was built with
+ *   ATFFT_FFTW_THREADS. It keeps its wisdom in the wisdom file with the name of the FFTW library appended
+ *   (".fftw", ".fftwf" or ".fftwl").
+ * - the native implementation times Rader's and Bluestein's algorithms for large prime sizes when the effort is
+ *   ATFFT_MEASURE or above, instead of choosing between them by size.
+ * - the auto backend (see atfft/dft_auto.h) keeps its choices in the wisdom file itself, unless
+ *   atfft_dft_auto_set_wisdom_file() has given it a different one.
+ *
+ * None of these functions are thread safe, they should be called before plans are created.
+ */
+
+/**
+ * Set the planning effort.
+ *
+ * The default is ATFFT_ESTIMATE, or ATFFT_DFT_PLANNING_EFFORT if that is defined when atfft is compiled.
+ *
+ * @param effort the effort to spend on future plans
+ */
+void atfft_dft_set_planning_effort (enum atfft_planning_effort effort);
+
+/**
+ * Get the planning effort.
+ *
+ * @return the effort which will be spent on future plans
+ */
+enum atfft_planning_effort atfft_dft_get_planning_effort (void);
+
+/**
+ * Set the number of threads each transform may use.
+ *
+ * The default is 1.
+ *
+ * @param n_threads the number of threads (should be at least 1)
+ */
+void atfft_dft_set_n_threads (int n_threads);
+
+/**
+ * Get the number of threads each transform may use.
+ *
+ * @return the number of threads
+ */
+int atfft_dft_get_n_threads (void);
+
+/**
+ * Keep wisdom about plans in files with the given path.
+ *
+ * Existing wisdom is loaded from the files when the next plan is created (they need not exist yet). New wisdom is
+ * saved to them as plans are made, so later runs can skip the measurements.
+ *
+ * @param path the path of the wisdom file, or NULL to stop using one
+ *
+ * @return 1 on success, 0 if memory couldn't be allocated
+ */
+int atfft_dft_set_wisdom_file (const char *path);
+
+/**
+ * Get the wisdom file path.
+ *
+ * @return the path given to atfft_dft_set_wisdom_file(), or NULL if there isn't one
+ */
+const char* atfft_dft_get_wisdom_file (void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATFFT_DFT_PLANNER_H_INCLUDED */
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/** @file
+ * struct and functions for computing DFTs whose spectra are stored in an implementation defined order.
+ */
+
+#ifndef ATFFT_DFT_UNORDERED_H_INCLUDED
+#define ATFFT_DFT_UNORDERED_H_INCLUDED
+
+#include <atfft/types.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * A structure to hold the state for computing unordered DFTs.
+ *
+ * Some implementations produce their spectra in an internal order and need an extra pass to put the bins in the usual
+ * order. When the spectra are only multiplied together and transformed back, as in fast convolution and correlation,
+ * that pass can be skipped.
+ *
+ * The spectra produced by atfft_dft_unordered_complex_forward() and atfft_dft_unordered_real_forward() should be
+ * treated as opaque. They can be passed to atfft_dft_unordered_convolve_accumulate() and transformed back with
+ * atfft_dft_unordered_complex_backward() or atfft_dft_unordered_real_backward() of a structure with the same size and
+ * format.
+ *
+ * Implementations without an unordered transform use ordered DFTs, so their spectra are interleaved complex numbers
+ * in the usual order (halfcomplex for real transforms).
+ */
+struct atfft_dft_unordered;
+
+/**
+ * Check if a size is supported for unordered DFTs.
+ *
+ * @param size the signal length
+ * @param format the format of the signals
+ *
+ * @return 1 if @p size is supported, 0 otherwise
+ */
+int atfft_dft_unordered_is_supported_size (int size, enum atfft_format format);
+
+/**
+ * Create a dft_unordered structure.
+ *
+ * One structure computes both forward and backward transforms.
+ *
+ * @param size the signal length each DFT should operate on
+ * @param format the format of the signals
+ */
+struct atfft_dft_unordered* atfft_dft_unordered_create (int size, enum atfft_format format);
+
+/**
+ * Free a dft_unordered structure.
+ *
+ * @param dft the structure to free
+ */
+void atfft_dft_unordered_destroy (struct atfft_dft_unordered *dft);
+
+/**
+ * Get the number of samples in a spectrum.
+ *
+ * @param dft a valid dft_unordered structure
+ *
+ * @return the number of atfft_sample values needed to store one spectrum
+ */
+int atfft_dft_unordered_spectrum_size (struct atfft_dft_unordered *dft);
+
+/**
+ * Perform a forward complex DFT into an unordered spectrum.
+ *
+ * @param dft a valid dft_unordered structure with a complex format
+ * @param in the input signal (should contain size elements)
+ * @param spectrum the output spectrum (should contain atfft_dft_unordered_spectrum_size() elements)
+ */
+void atfft_dft_unordered_complex_forward (struct atfft_dft_unordered *dft, atfft_complex *in, atfft_sample *spectrum);
+
+/**
+ * Perform a backward complex DFT of an unordered spectrum.
+ *
+ * As with atfft_dft_complex_transform() the output is not normalised.
+ *
+ * @param dft a valid dft_unordered structure with a complex format
+ * @param spectrum the input spectrum (should contain atfft_dft_unordered_spectrum_size() elements)
+ * @param out the output signal (should contain size elements)
+ */
+void atfft_dft_unordered_complex_backward (struct atfft_dft_unordered *dft, atfft_sample *spectrum, atfft_complex *out);
+
+/**
+ * Perform a forward real DFT into an unordered spectrum.
+ *
+ * @param dft a valid dft_unordered structure with a real format
+ * @param in the input signal (should contain size elements)
+ * @param spectrum the output spectrum (should contain atfft_dft_unordered_spectrum_size() elements)
+ */
+void atfft_dft_unordered_real_forward (struct atfft_dft_unordered *dft, const atfft_sample *in, atfft_sample *spectrum);
+
+/**
+ * Perform a backward real DFT of an unordered spectrum.
+ *
+ * As with atfft_dft_real_backward_transform() the output is not normalised.
+ *
+ * @param dft a valid dft_unordered structure with a real format
+ * @param spectrum the input spectrum (should contain atfft_dft_unordered_spectrum_size() elements)
+ * @param out the output signal (should contain size elements)
+ */
+void atfft_dft_unordered_real_backward (struct atfft_dft_unordered *dft, atfft_sample *spectrum, atfft_sample *out);
+
+/**
+ * Multiply two unordered spectra and add the result to a third.
+ *
+ * Computes ab += a * b * scale for each bin. The arrays may alias.
+ *
+ * @param dft a valid dft_unordered structure
+ * @param a the first spectrum
+ * @param b the second spectrum
+ * @param scale a factor to apply to each product, e.g. 1 / size to normalise a convolution
+ * @param ab the spectrum to accumulate into
+ */
+void atfft_dft_unordered_convolve_accumulate (struct atfft_dft_unordered *dft,
+                                              const atfft_sample *a,
+                                              const atfft_sample *b,
+                                              atfft_sample scale,
+                                              atfft_sample *ab);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATFFT_DFT_UNORDERED_H_INCLUDED */
@@ -40,6 +40,43 @@ extern "C"
  */
 int atfft_halfcomplex_size (int size);
 
+/**
+ * Check whether a DFT size is fast.
+ *
+ * Sizes whose only prime factors are 2, 3 and 5 are decomposed by the built-in Cooley-Tukey plans without resorting to
+ * slow radices or Rader's and Bluestein's algorithms, and are also the sizes the wrapped libraries handle best.
+ * Code which is free to choose a transform size (for example the block length of an overlap-save filter) should
+ * pick one of these.
+ *
+ * @param size the signal length of the DFT
+ */
+int atfft_dft_is_fast_size (int size);
+
+/**
+ * Find the smallest fast DFT size (see atfft_dft_is_fast_size()) which is at least a given size.
+ *
+ * @param min_size the smallest size allowed (should be greater than 0)
+ */
+int atfft_dft_next_fast_size (int min_size);
+
+/**
+ * Check whether a set of pruning parameters is valid for a DFT of a given size, direction and format
+ * (see atfft_dft_create_pruned()).
+ *
+ * @param size the signal length of the DFT
+ * @param direction the direction of the DFT
+ * @param format the format of the DFT
+ * @param n_inputs the number of leading inputs which may be non-zero
+ * @param first_output the first output required
+ * @param n_outputs the number of outputs required
+ */
+int atfft_dft_is_valid_pruning (int size,
+                                enum atfft_direction direction,
+                                enum atfft_format format,
+                                int n_inputs,
+                                int first_output,
+                                int n_outputs);
+
 /**
  * Create a complex signal from a halfcomplex signal.
  *
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/** @file
+ * struct and functions for computing a small set of DFT bins of a block of samples with a bank of Goertzel filters.
+ */
+
+#ifndef ATFFT_GOERTZEL_H_INCLUDED
+#define ATFFT_GOERTZEL_H_INCLUDED
+
+#include <atfft/types.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * A structure to hold a bank of Goertzel filters.
+ *
+ * Each filter is a second order resonator tuned to one bin, run over the block with one multiply and two adds per
+ * sample. The filters for all the bins are run side by side, so the per sample update is vectorised across bins.
+ * This is cheaper than a full DFT when only a few bins are needed, and needs no history between blocks, so it suits
+ * hopping over a stream where atfft_sliding_dft would have to be updated for every sample in between.
+ */
+struct atfft_goertzel;
+
+/**
+ * Create a Goertzel filter bank.
+ *
+ * @param size the length of the blocks to transform
+ * @param bins the indices of the bins to compute (should contain @p n_bins elements, each between 0 and @p size - 1)
+ * @param n_bins the number of bins to compute
+ */
+struct atfft_goertzel* atfft_goertzel_create (int size, const int *bins, int n_bins);
+
+/**
+ * Free a Goertzel filter bank.
+ *
+ * @param goertzel the structure to free
+ */
+void atfft_goertzel_destroy (struct atfft_goertzel *goertzel);
+
+/**
+ * Compute the bins of the forward DFT of a block.
+ *
+ * @param goertzel a valid Goertzel filter bank
+ * @param in the block (should contain size elements)
+ * @param out the bins, in the order they were given to atfft_goertzel_create()
+ *            (should have space for n_bins elements)
+ */
+void atfft_goertzel_transform (struct atfft_goertzel *goertzel, const atfft_sample *in, atfft_complex *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATFFT_GOERTZEL_H_INCLUDED */
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/** @file
+ * structs and functions for computing analytic signals (Hilbert transforms) and envelopes of real signals.
+ */
+
+#ifndef ATFFT_HILBERT_H_INCLUDED
+#define ATFFT_HILBERT_H_INCLUDED
+
+#include <atfft/types.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * A structure to hold a plan for computing the analytic signal of a block of samples.
+ *
+ * The analytic signal \f$ z = x + j \mathcal{H} \{ x \} \f$ is found by taking the real DFT of the block, doubling the
+ * positive frequency bins and inverse transforming. The halfcomplex spectrum is written straight into the first half
+ * of the inverse transform's input and scaled in place, the negative frequencies are never touched and the inverse
+ * transform is pruned to skip them. The transform is circular, so samples near the ends of the block are affected by
+ * the other end.
+ */
+struct atfft_hilbert;
+
+/**
+ * A structure to hold the state of a streaming analytic signal computation.
+ *
+ * The imaginary part is computed by convolving the stream with a windowed Hilbert transformer (a Blackman windowed
+ * ideal impulse response) using atfft_convolver, and the real part is the input delayed to match. This gives an
+ * output delayed by (filter_size - 1) / 2 samples, which is accurate away from DC and Nyquist, the transition bands
+ * getting narrower as the filter gets longer.
+ */
+struct atfft_hilbert_stream;
+
+/**
+ * Create a hilbert structure.
+ *
+ * @param size the length of the blocks to transform
+ */
+struct atfft_hilbert* atfft_hilbert_create (int size);
+
+/**
+ * Free a hilbert structure.
+ *
+ * @param hilbert the structure to free
+ */
+void atfft_hilbert_destroy (struct atfft_hilbert *hilbert);
+
+/**
+ * Compute the analytic signal of a block.
+ *
+ * The output is normalised, so its real part is the input.
+ *
+ * @param hilbert a valid hilbert structure
+ * @param in the block (should contain size elements)
+ * @param out the analytic signal (should have space for size elements)
+ */
+void atfft_hilbert_transform (struct atfft_hilbert *hilbert, const atfft_sample *in, atfft_complex *out);
+
+/**
+ * Compute the envelope (the magnitude of the analytic signal) of a block.
+ *
+ * @param hilbert a valid hilbert structure
+ * @param in the block (should contain size elements)
+ * @param envelope the envelope (should have space for size elements), this may be the same as @p in
+ */
+void atfft_hilbert_envelope (struct atfft_hilbert *hilbert, const atfft_sample *in, atfft_sample *envelope);
+
+/**
+ * Create a hilbert_stream structure.
+ *
+ * @param block_size the stream is processed in blocks of this many samples
+ * @param filter_size the length of the Hilbert transformer (should be odd and at least 3)
+ */
+struct atfft_hilbert_stream* atfft_hilbert_stream_create (int block_size, int filter_size);
+
+/**
+ * Free a hilbert_stream structure.
+ *
+ * @param stream the structure to free
+ */
+void atfft_hilbert_stream_destroy (struct atfft_hilbert_stream *stream);
+
+/**
+ * Get the delay, in samples, between the input and output of a hilbert_stream.
+ *
+ * @param stream a valid hilbert_stream structure
+ */
+int atfft_hilbert_stream_latency (struct atfft_hilbert_stream *stream);
+
+/**
+ * Compute the analytic signal of the next samples of a stream.
+ *
+ * @param stream a valid hilbert_stream structure
+ * @param in the next samples (should contain @p size elements)
+ * @param size the number of samples, this should be a multiple of the block size and any number of blocks
+ *             can be processed in one call
+ * @param out the analytic signal, delayed by atfft_hilbert_stream_latency() samples
+ *            (should have space for @p size elements)
+ */
+void atfft_hilbert_stream_transform (struct atfft_hilbert_stream *stream,
+                                     const atfft_sample *in,
+                                     int size,
+                                     atfft_complex *out);
+
+/**
+ * Compute the envelope of the next samples of a stream.
+ *
+ * @param stream a valid hilbert_stream structure
+ * @param in the next samples (should contain @p size elements)
+ * @param size the number of samples, this should be a multiple of the block size
+ * @param envelope the envelope, delayed by atfft_hilbert_stream_latency() samples
+ *                 (should have space for @p size elements), this may be the same as @p in
+ */
+void atfft_hilbert_stream_envelope (struct atfft_hilbert_stream *stream,
+                                    const atfft_sample *in,
+                                    int size,
+                                    atfft_sample *envelope);
+
+/**
+ * Clear the history of a hilbert_stream structure.
+ *
+ * @param stream a valid hilbert_stream structure
+ */
+void atfft_hilbert_stream_reset (struct atfft_hilbert_stream *stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATFFT_HILBERT_H_INCLUDED */
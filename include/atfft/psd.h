@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/** @file
+ * struct and functions for estimating power spectral densities with Welch's method.
+ */
+
+#ifndef ATFFT_PSD_H_INCLUDED
+#define ATFFT_PSD_H_INCLUDED
+
+#include <atfft/types.h>
+#include <atfft/windows.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** An enum to represent the trend removed from each segment before it is windowed. */
+enum atfft_psd_detrend
+{
+    ATFFT_PSD_NO_DETREND, /**< Leave the segments as they are. */
+    ATFFT_PSD_CONSTANT_DETREND, /**< Remove the mean of each segment. */
+    ATFFT_PSD_LINEAR_DETREND /**< Remove the least squares straight line fit of each segment. */
+};
+
+/**
+ * A structure to hold a plan for estimating power spectral densities with Welch's method.
+ *
+ * The signal is split into overlapping segments, each is detrended, windowed, zero padded and transformed with a real
+ * DFT, and the squared magnitudes of the spectra are averaged. The window is applied as the segment is copied into
+ * the DFT input, the trend is found in the same pass and removed from the spectrum using the precomputed spectra of the
+ * window and of the window times a ramp. Squared magnitudes are accumulated without taking square roots and the
+ * scaling is applied once, after all the segments have been accumulated.
+ */
+struct atfft_psd;
+
+/**
+ * Create a psd structure.
+ *
+ * When @p n_threads is more than 1 the segments are split into contiguous runs, one per thread, each of which is
+ * accumulated with its own DFT plan and buffers. The partial sums are added once all the threads have finished.
+ *
+ * @param segment_size the number of samples in each segment
+ * @param hop_size the number of samples between the starts of consecutive segments
+ *                 (should be greater than 0 and no more than @p segment_size)
+ * @param fft_size the size of DFT to take of each segment (should be at least @p segment_size)
+ * @param window the type of window to apply to each segment
+ * @param detrend the trend to remove from each segment
+ * @param n_threads the number of threads to accumulate segments on (should be at least 1)
+ */
+struct atfft_psd* atfft_psd_create (int segment_size,
+                                    int hop_size,
+                                    int fft_size,
+                                    enum atfft_window_type window,
+                                    enum atfft_psd_detrend detrend,
+                                    int n_threads);
+
+/**
+ * Free a psd structure.
+ *
+ * @param psd the structure to free
+ */
+void atfft_psd_destroy (struct atfft_psd *psd);
+
+/**
+ * Get the number of segments a signal of a given length is split into.
+ *
+ * @param psd a valid psd structure
+ * @param size the length of the signal
+ *
+ * @return the number of whole segments which fit in the signal, samples after the last of these are ignored
+ */
+int atfft_psd_n_segments (struct atfft_psd *psd, int size);
+
+/**
+ * Estimate the power spectral density of a signal.
+ *
+ * The estimate is one-sided, so the power of the bins which have a negative frequency counterpart is doubled, and
+ * normalised by the sum of the squared window, so dividing it by the sample rate gives a density in units
+ * squared per Hz.
+ *
+ * @param psd a valid psd structure
+ * @param in the signal (should contain @p size elements)
+ * @param size the length of the signal (should be at least segment_size)
+ * @param out the estimate (should have space for atfft_halfcomplex_size (fft_size) elements)
+ */
+void atfft_psd_transform (struct atfft_psd *psd, const atfft_sample *in, int size, atfft_sample *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATFFT_PSD_H_INCLUDED */
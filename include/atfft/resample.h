@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/** @file
+ * structs and functions for changing the sample rate of real signals in the frequency domain.
+ */
+
+#ifndef ATFFT_RESAMPLE_H_INCLUDED
+#define ATFFT_RESAMPLE_H_INCLUDED
+
+#include <atfft/types.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * A structure to hold a plan for resampling blocks of samples.
+ *
+ * A block is treated as one period of a periodic signal, transformed with a real DFT, its spectrum truncated or zero
+ * padded and transformed back with a real DFT of the new length. The result is the band-limited interpolation of the
+ * periodic signal at the new rate. Only the halfcomplex spectra are ever formed, and the Nyquist bin is split or
+ * folded as the signal is upsampled or downsampled so the output stays real.
+ */
+struct atfft_resample;
+
+/**
+ * A structure to hold the state of a streaming sample rate converter.
+ *
+ * The conversion is by a rational factor, L / M, and uses overlap-save. Each block of input is transformed with a
+ * real DFT, multiplied by the frequency response of a zero-phase lowpass filter, truncated or zero padded and
+ * transformed back with a real DFT L / M times the length. The outputs near the ends of the block, which are
+ * affected by the circular wrap, are discarded and the next block overlaps the current one to replace them.
+ *
+ * The block length is chosen as a multiple of M whose multiplier is a fast size (see atfft_dft_is_fast_size()),
+ * picking the one which minimises the cost per output sample. Any prime factors other than 2, 3 and 5 in L or M
+ * can't be avoided and are left to the DFT plans.
+ *
+ * The filter is a Blackman windowed sinc whose transition band ends at the lower of the two Nyquist frequencies, so
+ * the accuracy and the width of the passband both improve as it gets longer.
+ */
+struct atfft_resample_stream;
+
+/**
+ * Create a resample structure.
+ *
+ * @param in_size the length of the input blocks (this and @p out_size should be supported by the DFT implementation,
+ *                see atfft_dft_is_supported_size())
+ * @param out_size the length of the output blocks
+ *
+ * @return a resample structure, or NULL if the DFT implementation doesn't support either length
+ */
+struct atfft_resample* atfft_resample_create (int in_size, int out_size);
+
+/**
+ * Free a resample structure.
+ *
+ * @param resample the structure to free
+ */
+void atfft_resample_destroy (struct atfft_resample *resample);
+
+/**
+ * Resample a block.
+ *
+ * @param resample a valid resample structure
+ * @param in the block (should contain in_size elements)
+ * @param out the resampled block (should have space for out_size elements), sample n of which lies at
+ *            n * in_size / out_size samples into the input block
+ */
+void atfft_resample_transform (struct atfft_resample *resample, const atfft_sample *in, atfft_sample *out);
+
+/**
+ * Create a resample_stream structure.
+ *
+ * The rates are reduced by their greatest common divisor to give the conversion factor L / M.
+ *
+ * @param in_rate the sample rate of the input
+ * @param out_rate the sample rate of the output
+ * @param filter_size the length of the lowpass filter (should be odd and at least 11 times the larger of 1 and M / L)
+ *
+ * @return a resample_stream structure, or NULL if the DFT implementation doesn't support any suitable block length
+ */
+struct atfft_resample_stream* atfft_resample_stream_create (int in_rate, int out_rate, int filter_size);
+
+/**
+ * Free a resample_stream structure.
+ *
+ * @param stream the structure to free
+ */
+void atfft_resample_stream_destroy (struct atfft_resample_stream *stream);
+
+/**
+ * Get the number of input samples consumed by each block of a resample_stream.
+ *
+ * @param stream a valid resample_stream structure
+ */
+int atfft_resample_stream_in_hop_size (struct atfft_resample_stream *stream);
+
+/**
+ * Get the number of output samples produced by each block of a resample_stream.
+ *
+ * @param stream a valid resample_stream structure
+ */
+int atfft_resample_stream_out_hop_size (struct atfft_resample_stream *stream);
+
+/**
+ * Get the delay, in output samples, of a resample_stream.
+ *
+ * Output sample n lies at n * M / L input samples, less the delay converted to input samples.
+ *
+ * @param stream a valid resample_stream structure
+ */
+int atfft_resample_stream_latency (struct atfft_resample_stream *stream);
+
+/**
+ * Resample the next samples of a stream.
+ *
+ * @param stream a valid resample_stream structure
+ * @param in the next samples (should contain @p n_blocks * in_hop_size elements)
+ * @param n_blocks the number of blocks to process
+ * @param out the resampled samples (should have space for @p n_blocks * out_hop_size elements)
+ */
+void atfft_resample_stream_transform (struct atfft_resample_stream *stream,
+                                      const atfft_sample *in,
+                                      int n_blocks,
+                                      atfft_sample *out);
+
+/**
+ * Clear the history of a resample_stream structure.
+ *
+ * @param stream a valid resample_stream structure
+ */
+void atfft_resample_stream_reset (struct atfft_resample_stream *stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATFFT_RESAMPLE_H_INCLUDED */
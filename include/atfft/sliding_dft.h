@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/** @file
+ * struct and functions for tracking a small set of DFT bins over a sliding window, one sample at a time.
+ */
+
+#ifndef ATFFT_SLIDING_DFT_H_INCLUDED
+#define ATFFT_SLIDING_DFT_H_INCLUDED
+
+#include <atfft/types.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * A structure to hold the state of a sliding DFT.
+ *
+ * A sliding DFT gives selected bins of the forward DFT of the most recent samples of a stream, updating them with
+ * each new sample at a cost proportional to the number of bins. The modulated form of the recurrence is used: each
+ * bin accumulates its input multiplied by an exact twiddle factor from a table rather than by a recursively rotated
+ * one, so rounding errors are not amplified as the stream goes on.
+ */
+struct atfft_sliding_dft;
+
+/**
+ * Create a sliding DFT structure.
+ *
+ * The window is initially filled with zeros.
+ *
+ * @param size the length of the window
+ * @param bins the indices of the bins to track (should contain @p n_bins elements, each between 0 and @p size - 1)
+ * @param n_bins the number of bins to track
+ */
+struct atfft_sliding_dft* atfft_sliding_dft_create (int size, const int *bins, int n_bins);
+
+/**
+ * Free a sliding DFT structure.
+ *
+ * @param sdft the structure to free
+ */
+void atfft_sliding_dft_destroy (struct atfft_sliding_dft *sdft);
+
+/**
+ * Slide the window along a number of samples.
+ *
+ * @param sdft a valid sliding DFT structure
+ * @param in the new samples (should contain @p n_samples elements)
+ * @param n_samples the number of samples
+ */
+void atfft_sliding_dft_push (struct atfft_sliding_dft *sdft, const atfft_sample *in, int n_samples);
+
+/**
+ * Get the bins of the DFT of the current window.
+ *
+ * @param sdft a valid sliding DFT structure
+ * @param out the bins, in the order they were given to atfft_sliding_dft_create()
+ *            (should have space for n_bins elements)
+ */
+void atfft_sliding_dft_get_bins (struct atfft_sliding_dft *sdft, atfft_complex *out);
+
+/**
+ * Empty the window.
+ *
+ * @param sdft a valid sliding DFT structure
+ */
+void atfft_sliding_dft_reset (struct atfft_sliding_dft *sdft);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATFFT_SLIDING_DFT_H_INCLUDED */
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/** @file
+ * struct and functions for computing mel and constant-Q spectrograms.
+ */
+
+#ifndef ATFFT_SPECTROGRAM_H_INCLUDED
+#define ATFFT_SPECTROGRAM_H_INCLUDED
+
+#include <atfft/types.h>
+#include <atfft/windows.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * A structure to hold a plan for computing the spectrogram of a signal on a mel or constant-Q frequency scale.
+ *
+ * Each frame is windowed, transformed with a real DFT and multiplied by a sparse kernel matrix to give the power in
+ * each band. Every row of the kernel is stored as a contiguous run of bins, trimmed to where its weights are
+ * significant, and all the runs are packed into one array.
+ *
+ * Frames are processed in batches, with the spectra of a batch interleaved bin by bin so the kernel weights of a band
+ * are applied to every frame of the batch in the same vectorised loop.
+ */
+struct atfft_spectrogram;
+
+/**
+ * Create a spectrogram structure with a mel frequency scale.
+ *
+ * The bands are triangular filters on the power spectrum, with a peak of one, whose centres are equally spaced on
+ * the mel scale \f$ m = 2595 \log_{10} (1 + f / 700) \f$. Each band starts at the centre of the band below and ends at
+ * the centre of the band above.
+ *
+ * @param frame_size the number of samples in each frame
+ * @param hop_size the number of samples between the starts of consecutive frames (should be greater than 0)
+ * @param fft_size the size of DFT to take of each frame (should be at least @p frame_size)
+ * @param window the type of window to apply to each frame
+ * @param sample_rate the sample rate of the signal
+ * @param n_bands the number of mel bands
+ * @param min_frequency the frequency at which the lowest band starts
+ * @param max_frequency the frequency at which the highest band ends (should be no more than @p sample_rate / 2)
+ */
+struct atfft_spectrogram* atfft_spectrogram_create_mel (int frame_size,
+                                                        int hop_size,
+                                                        int fft_size,
+                                                        enum atfft_window_type window,
+                                                        atfft_sample sample_rate,
+                                                        int n_bands,
+                                                        atfft_sample min_frequency,
+                                                        atfft_sample max_frequency);
+
+/**
+ * Create a spectrogram structure with a constant-Q frequency scale.
+ *
+ * This uses the method of Brown and Puckette, "An efficient algorithm for the calculation of a constant Q transform".
+ * Band k has a centre frequency of \f$ f_k = f_{min} 2^{k / b} \f$ and a temporal kernel of
+ * \f$ N_k = \lceil Q f_s / f_k \rceil \f$ samples, a Hamming windowed complex exponential at \f$ f_k \f$, where
+ * \f$ Q = 1 / (2^{1 / b} - 1) \f$. The kernels are centred in a frame of @p fft_size samples and transformed to give
+ * the spectral kernels, which are sparse as the temporal kernels are narrowband. The power in each band is the squared
+ * magnitude of the product of the frame's spectrum and the band's spectral kernel.
+ *
+ * The frames are not windowed, as the temporal kernels are. Trimming the spectral kernels and ignoring their negative
+ * frequencies makes the band powers an approximation, typically within 1% of the largest band power.
+ *
+ * @param fft_size the number of samples in each frame and the size of DFT to take of them
+ *                 (should be at least the length of the longest kernel, \f$ Q f_s / f_{min} \f$)
+ * @param hop_size the number of samples between the starts of consecutive frames (should be greater than 0)
+ * @param sample_rate the sample rate of the signal
+ * @param min_frequency the centre frequency of the lowest band
+ * @param bins_per_octave the number of bands per octave, b
+ * @param n_bands the number of bands (the highest centre frequency should be below @p sample_rate / 2)
+ *
+ * @return a spectrogram structure, or NULL if the longest kernel doesn't fit in @p fft_size samples
+ */
+struct atfft_spectrogram* atfft_spectrogram_create_cqt (int fft_size,
+                                                        int hop_size,
+                                                        atfft_sample sample_rate,
+                                                        atfft_sample min_frequency,
+                                                        int bins_per_octave,
+                                                        int n_bands);
+
+/**
+ * Free a spectrogram structure.
+ *
+ * @param spectrogram the structure to free
+ */
+void atfft_spectrogram_destroy (struct atfft_spectrogram *spectrogram);
+
+/**
+ * Get the number of samples in each frame of a spectrogram.
+ *
+ * @param spectrogram a valid spectrogram structure
+ */
+int atfft_spectrogram_frame_size (struct atfft_spectrogram *spectrogram);
+
+/**
+ * Get the number of bands in a spectrogram.
+ *
+ * @param spectrogram a valid spectrogram structure
+ */
+int atfft_spectrogram_n_bands (struct atfft_spectrogram *spectrogram);
+
+/**
+ * Set the log compression of a spectrogram.
+ *
+ * When the offset is greater than zero each band's power, p, is output as \f$ \ln (p + offset) \f$, the logarithm
+ * being taken as the band is computed. By default the offset is zero and the power is output as it is.
+ *
+ * @param spectrogram a valid spectrogram structure
+ * @param offset the offset to add before taking the logarithm, or zero to output the power
+ */
+void atfft_spectrogram_set_log_offset (struct atfft_spectrogram *spectrogram, atfft_sample offset);
+
+/**
+ * Compute the spectrogram of a number of frames.
+ *
+ * @param spectrogram a valid spectrogram structure
+ * @param in the signal, frame f starting at @p in + f * hop_size
+ *           (should contain at least (@p n_frames - 1) * hop_size + frame_size elements)
+ * @param n_frames the number of frames to compute
+ * @param out the band powers, band b of frame f being written to @p out [f * n_bands + b]
+ *            (should have space for @p n_frames * n_bands elements)
+ */
+void atfft_spectrogram_transform (struct atfft_spectrogram *spectrogram,
+                                  const atfft_sample *in,
+                                  int n_frames,
+                                  atfft_sample *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATFFT_SPECTROGRAM_H_INCLUDED */
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/** @file
+ * structs and functions for computing short-time Fourier transforms of streams of samples.
+ */
+
+#ifndef ATFFT_STFT_H_INCLUDED
+#define ATFFT_STFT_H_INCLUDED
+
+#include <atfft/types.h>
+#include <atfft/windows.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * A structure to hold the state of a short-time Fourier transform.
+ *
+ * Samples are pushed into the structure in blocks of any length with atfft_stft_push(),
+ * the spectra of the windowed frames are then taken out with atfft_stft_pull().
+ */
+struct atfft_stft;
+
+/**
+ * A structure to hold the state of an inverse short-time Fourier transform.
+ *
+ * Spectra are passed to atfft_istft_transform(), which overlap-adds them to reconstruct a signal.
+ */
+struct atfft_istft;
+
+/**
+ * Create an stft structure.
+ *
+ * Each frame of @p frame_size samples is multiplied by a periodic window of the given type,
+ * zero padded to @p fft_size samples and transformed with a real DFT.
+ *
+ * @param frame_size the number of samples in each frame
+ * @param hop_size the number of samples between the starts of consecutive frames
+ *                 (should be greater than 0 and no more than @p frame_size)
+ * @param fft_size the size of DFT to take of each frame (should be at least @p frame_size)
+ * @param window the type of window to apply to each frame
+ */
+struct atfft_stft* atfft_stft_create (int frame_size,
+                                      int hop_size,
+                                      int fft_size,
+                                      enum atfft_window_type window);
+
+/**
+ * Free an stft structure.
+ *
+ * @param stft the structure to free
+ */
+void atfft_stft_destroy (struct atfft_stft *stft);
+
+/**
+ * Push samples into an stft structure.
+ *
+ * The samples are stored in a ring buffer which can hold at least @p frame_size + @p hop_size samples.
+ * Once a whole frame is buffered samples will only be accepted after frames have been taken out with
+ * atfft_stft_pull(), so a stream would be processed with a loop like:
+ *
+ * \code
+ * while (size > 0)
+ * {
+ *     int n = atfft_stft_push (stft, in, size);
+ *     in += n;
+ *     size -= n;
+ *
+ *     while (atfft_stft_pull (stft, spectrum))
+ *         do_something_with (spectrum);
+ * }
+ * \endcode
+ *
+ * @param stft a valid stft structure
+ * @param in the samples to push (should contain at least @p size elements)
+ * @param size the number of samples to push
+ *
+ * @return the number of samples which were accepted
+ */
+int atfft_stft_push (struct atfft_stft *stft, const atfft_sample *in, int size);
+
+/**
+ * Take the spectrum of the next frame out of an stft structure.
+ *
+ * @param stft a valid stft structure
+ * @param spectrum the halfcomplex spectrum of the frame
+ *                 (should have space for atfft_halfcomplex_size (fft_size) elements)
+ *
+ * @return 1 if a frame was available and its spectrum written to @p spectrum, 0 otherwise
+ */
+int atfft_stft_pull (struct atfft_stft *stft, atfft_complex *spectrum);
+
+/**
+ * Create an istft structure.
+ *
+ * The arguments should match those of the stft which produced the spectra.
+ *
+ * Each spectrum is inverse transformed, the first @p frame_size samples multiplied by a synthesis window and
+ * overlap-added to the output. The synthesis window is the analysis window scaled so that the overlapping
+ * products of the analysis and synthesis windows sum to one, giving perfect reconstruction of an unmodified
+ * signal. This needs the squared window, summed over the frames overlapping each position within a hop, to be
+ * non-zero everywhere, which it isn't for a periodic Hann window with @p hop_size equal to @p frame_size for example.
+ *
+ * @param frame_size the number of samples in each frame
+ * @param hop_size the number of samples between the starts of consecutive frames
+ *                 (should be greater than 0 and no more than @p frame_size)
+ * @param fft_size the size of the DFT each spectrum was taken with (should be at least @p frame_size)
+ * @param window the type of window applied to each frame
+ *
+ * @return the istft structure, or NULL if the window leaves some position within a hop at zero in every frame
+ *         covering it (so the signal couldn't be reconstructed there) or memory couldn't be allocated
+ */
+struct atfft_istft* atfft_istft_create (int frame_size,
+                                        int hop_size,
+                                        int fft_size,
+                                        enum atfft_window_type window);
+
+/**
+ * Free an istft structure.
+ *
+ * @param istft the structure to free
+ */
+void atfft_istft_destroy (struct atfft_istft *istft);
+
+/**
+ * Overlap-add the next frame of an inverse short-time Fourier transform.
+ *
+ * Each call completes @p hop_size output samples. Output sample n lines up with sample n of the signal pushed into
+ * the stft, the first @p frame_size - @p hop_size samples are incomplete as no frames precede them.
+ *
+ * @param istft a valid istft structure
+ * @param spectrum the halfcomplex spectrum of the frame
+ *                 (should contain atfft_halfcomplex_size (fft_size) elements, this will be overwritten by some DFT
+ *                 implementations)
+ * @param out the completed output samples (should have space for @p hop_size elements)
+ */
+void atfft_istft_transform (struct atfft_istft *istft, atfft_complex *spectrum, atfft_sample *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATFFT_STFT_H_INCLUDED */
@@ -41,6 +41,30 @@ enum atfft_window_symmetry
     ATFFT_PERIODIC /**< Create a periodic window. */
 };
 
+/** An enum to represent the shape of a window function. */
+enum atfft_window_type
+{
+    ATFFT_RECTANGULAR_WINDOW, /**< A rectangular window (all ones). */
+    ATFFT_BARTLETT_WINDOW, /**< A Bartlett window, see atfft_bartlett_window(). */
+    ATFFT_HANN_WINDOW, /**< A Hann window, see atfft_hann_window(). */
+    ATFFT_HAMMING_WINDOW, /**< A Hamming window, see atfft_hamming_window(). */
+    ATFFT_BLACKMAN_WINDOW, /**< A Blackman window, see atfft_blackman_window(). */
+    ATFFT_SINE_WINDOW /**< A sine window, see atfft_sine_window(). */
+};
+
+/**
+ * Generate a window of a given type
+ *
+ * @param window an array to generate the window in
+ * @param size the length of the window
+ * @param type the shape of the window
+ * @param symmetry the symmetry of the window (ignored for the rectangular and sine windows)
+ */
+void atfft_window (atfft_sample *window,
+                   int size,
+                   enum atfft_window_type type,
+                   enum atfft_window_symmetry symmetry);
+
 /**
  * Generate a Bartlett window
  *
@@ -77,6 +101,28 @@ void atfft_hamming_window (atfft_sample *window, int size, enum atfft_window_sym
  */
 void atfft_blackman_window (atfft_sample *window, int size, enum atfft_window_symmetry symmetry);
 
+/**
+ * Generate a sine window
+ *
+ * This is the window \f$ w_{n} = \sin \left( \frac{\pi}{N} \left( n + \frac{1}{2} \right) \right) \f$
+ * which satisfies the Princen-Bradley condition when @p size is even, making it suitable for use with the MDCT.
+ *
+ * @param window an array to generate the window in
+ * @param size the length of the window
+ */
+void atfft_sine_window (atfft_sample *window, int size);
+
+/**
+ * Generate a Kaiser-Bessel-derived window
+ *
+ * This window satisfies the Princen-Bradley condition, making it suitable for use with the MDCT.
+ *
+ * @param window an array to generate the window in
+ * @param size the length of the window (should be even)
+ * @param alpha the shape parameter of the underlying Kaiser window, larger values give a narrower window
+ */
+void atfft_kaiser_bessel_derived_window (atfft_sample *window, int size, atfft_sample alpha);
+
 #ifdef __cplusplus
 }
 #endif
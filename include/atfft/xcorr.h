@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/** @file
+ * struct and functions for cross-correlating multichannel signals and estimating time delays.
+ */
+
+#ifndef ATFFT_XCORR_H_INCLUDED
+#define ATFFT_XCORR_H_INCLUDED
+
+#include <atfft/types.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** An enum to represent the weighting applied to cross-spectra before they are inverse transformed. */
+enum atfft_xcorr_weighting
+{
+    ATFFT_XCORR_NONE, /**< No weighting, giving the plain cross-correlation. */
+    ATFFT_XCORR_PHAT /**< Phase transform weighting (GCC-PHAT), each cross-spectrum bin is normalised to unit magnitude. */
+};
+
+/**
+ * A structure to hold the spectra of a set of channels for cross-correlating them.
+ *
+ * The spectrum of each channel is taken once by atfft_xcorr_set_signals(), correlations between any pair of channels
+ * are then found from these without transforming the channels again.
+ */
+struct atfft_xcorr;
+
+/**
+ * Create an xcorr structure.
+ *
+ * The signals are zero padded to a power of 2 of at least twice their length, so the correlations are linear rather
+ * than circular.
+ *
+ * @param size the length of each channel's signal
+ * @param n_channels the number of channels
+ * @param weighting the weighting to apply to the cross-spectra
+ */
+struct atfft_xcorr* atfft_xcorr_create (int size, int n_channels, enum atfft_xcorr_weighting weighting);
+
+/**
+ * Free an xcorr structure.
+ *
+ * @param xcorr the structure to free
+ */
+void atfft_xcorr_destroy (struct atfft_xcorr *xcorr);
+
+/**
+ * Take the spectra of a new set of signals.
+ *
+ * @param xcorr a valid xcorr structure
+ * @param signals the signals, channel c starts at @p signals + c * @p distance
+ * @param distance the distance between the first samples of consecutive channels
+ */
+void atfft_xcorr_set_signals (struct atfft_xcorr *xcorr, const atfft_sample *signals, int distance);
+
+/**
+ * Find the cross-correlation of two channels.
+ *
+ * The correlation at lag \f$ \tau \f$ is \f$ \sum_{n} x_{a} [n + \tau] x_{b} [n] \f$, so a positive lag means
+ * channel @p a is delayed relative to channel @p b.
+ *
+ * @param xcorr a valid xcorr structure, atfft_xcorr_set_signals() should have been called
+ * @param a the first channel
+ * @param b the second channel
+ * @param max_lag the largest lag to return (should be less than the signal length)
+ * @param correlation the correlation at lags -@p max_lag to @p max_lag
+ *                    (should have space for 2 * @p max_lag + 1 elements)
+ */
+void atfft_xcorr_correlation (struct atfft_xcorr *xcorr,
+                              int a,
+                              int b,
+                              int max_lag,
+                              atfft_sample *correlation);
+
+/**
+ * Find the lag at which the cross-correlation of every pair of channels peaks.
+ *
+ * Pairs are ordered (0, 1), (0, 2) ... (0, M - 1), (1, 2) ... (M - 2, M - 1) for M channels, the lags follow
+ * the convention of atfft_xcorr_correlation(). Each pair's cross-spectrum is computed and inverse transformed in
+ * turn, one real DFT per pair, reusing the channel spectra from atfft_xcorr_set_signals().
+ *
+ * @param xcorr a valid xcorr structure, atfft_xcorr_set_signals() should have been called
+ * @param max_lag the largest lag to search (should be less than the signal length)
+ * @param interpolate if non-zero the peak is refined to a fraction of a sample by fitting a parabola through it and
+ *                    its neighbours
+ * @param lags the lag of each pair's peak (should have space for M * (M - 1) / 2 elements)
+ * @param peaks the correlation at each peak (should have space for M * (M - 1) / 2 elements), or NULL
+ */
+void atfft_xcorr_peak_lags (struct atfft_xcorr *xcorr,
+                            int max_lag,
+                            int interpolate,
+                            atfft_sample *lags,
+                            atfft_sample *peaks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATFFT_XCORR_H_INCLUDED */
@@ -20,6 +20,9 @@
  * SOFTWARE.
  */
 
+#define ATFFT_DFT_BACKEND native
+#include "dft_backend_internal.h"
+
 #include "atfft_internal.h"
 #include <atfft/dft.h>
 #include <math.h>
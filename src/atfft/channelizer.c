@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+#include <atfft/dft.h>
+#include <atfft/windows.h>
+#include <atfft/channelizer.h>
+#include "constants.h"
+
+/* The number of frames whose polyphase sums are computed before their DFTs are taken. */
+#define ATFFT_CHANNELIZER_BATCH 8
+
+/* The number of polyphase sums accumulated together in local arrays. */
+#define ATFFT_CHANNELIZER_BLOCK 16
+
+/* The input buffer holds the last filter_size - hop_size samples of the
+ * previous call followed by a batch of new samples, frame f of the batch
+ * starting at buffer + f * hop_size. The polyphase sums of a batch are
+ * stored one frame after another and are the inputs of the DFTs.
+ *
+ * phase is the absolute time of the first sample of the next frame,
+ * modulo the number of channels. */
+struct atfft_channelizer
+{
+    int n_channels, hop_size, taps_per_channel, filter_size, history_size;
+    int phase;
+    struct atfft_dft *dft;
+    atfft_sample *filter;
+
+    /* working space */
+    atfft_complex *buffer;
+    atfft_complex *sums;
+};
+
+static void atfft_channelizer_design_prototype (atfft_sample *filter, int n_channels, int size)
+{
+    atfft_sample centre = (size - 1) / 2.0;
+    atfft_sample sum = 0.0;
+
+    atfft_blackman_window (filter, size, ATFFT_SYMMETRIC);
+
+    for (int i = 0; i < size; ++i)
+    {
+        atfft_sample x = M_PI * (i - centre) / n_channels;
+
+        if (x != 0.0)
+            filter [i] *= sin (x) / x;
+
+        sum += filter [i];
+    }
+
+    atfft_scale_real (filter, size, 1.0 / sum);
+}
+
+struct atfft_channelizer* atfft_channelizer_create (int n_channels,
+                                                    enum atfft_channelizer_sampling sampling,
+                                                    int taps_per_channel,
+                                                    const atfft_sample *prototype)
+{
+    assert (n_channels > 0 && taps_per_channel > 0);
+    assert (sampling == ATFFT_CRITICALLY_SAMPLED || atfft_is_even (n_channels));
+
+    struct atfft_channelizer *channelizer;
+    int hop_size = sampling == ATFFT_CRITICALLY_SAMPLED ? n_channels : n_channels / 2;
+    int filter_size = n_channels * taps_per_channel;
+
+    if (!(channelizer = calloc (1, sizeof (*channelizer))))
+        return NULL;
+
+    channelizer->n_channels = n_channels;
+    channelizer->hop_size = hop_size;
+    channelizer->taps_per_channel = taps_per_channel;
+    channelizer->filter_size = filter_size;
+    channelizer->history_size = filter_size - hop_size;
+
+    channelizer->dft = atfft_dft_create (n_channels, ATFFT_FORWARD, ATFFT_COMPLEX);
+    channelizer->filter = malloc (filter_size * sizeof (*(channelizer->filter)));
+    channelizer->buffer = malloc ((channelizer->history_size + ATFFT_CHANNELIZER_BATCH * hop_size) *
+                                  sizeof (*(channelizer->buffer)));
+    channelizer->sums = malloc (ATFFT_CHANNELIZER_BATCH * n_channels * sizeof (*(channelizer->sums)));
+
+    if (!(channelizer->dft && channelizer->filter && channelizer->buffer && channelizer->sums))
+        goto failed;
+
+    if (prototype)
+        memcpy (channelizer->filter, prototype, filter_size * sizeof (*prototype));
+    else
+        atfft_channelizer_design_prototype (channelizer->filter, n_channels, filter_size);
+
+    atfft_channelizer_reset (channelizer);
+    return channelizer;
+
+failed:
+    atfft_channelizer_destroy (channelizer);
+    return NULL;
+}
+
+void atfft_channelizer_destroy (struct atfft_channelizer *channelizer)
+{
+    if (channelizer)
+    {
+        free (channelizer->sums);
+        free (channelizer->buffer);
+        free (channelizer->filter);
+        atfft_dft_destroy (channelizer->dft);
+        free (channelizer);
+    }
+}
+
+int atfft_channelizer_hop_size (struct atfft_channelizer *channelizer)
+{
+    return channelizer->hop_size;
+}
+
+void atfft_channelizer_reset (struct atfft_channelizer *channelizer)
+{
+    int n_channels = channelizer->n_channels;
+
+    memset (channelizer->buffer, 0, channelizer->history_size * sizeof (*(channelizer->buffer)));
+
+    /* The first frame ends with the first sample of the stream. */
+    channelizer->phase = ((channelizer->hop_size - channelizer->filter_size) % n_channels + n_channels) % n_channels;
+}
+
+/* Compute the polyphase sums of a batch of frames, rotating each frame's
+ * sums so sum r lands at (r + phase) mod n_channels. The sums are built up
+ * a block at a time in local arrays, and each block is done for every
+ * frame of the batch before moving on, so the taps of the block and the
+ * samples the frames share stay in cache. */
+static void atfft_channelizer_fold (struct atfft_channelizer *channelizer, int n_frames)
+{
+    int n_channels = channelizer->n_channels;
+    int hop_size = channelizer->hop_size;
+    int taps_per_channel = channelizer->taps_per_channel;
+    int phases [ATFFT_CHANNELIZER_BATCH];
+    int r = 0;
+
+    for (int f = 0; f < n_frames; ++f)
+    {
+        phases [f] = channelizer->phase;
+        channelizer->phase = (channelizer->phase + hop_size) % n_channels;
+    }
+
+    for (; r + ATFFT_CHANNELIZER_BLOCK <= n_channels; r += ATFFT_CHANNELIZER_BLOCK)
+    {
+        for (int f = 0; f < n_frames; ++f)
+        {
+            const atfft_sample *h = channelizer->filter + r;
+            atfft_complex *x = channelizer->buffer + f * hop_size + r;
+            atfft_complex *sums = channelizer->sums + f * n_channels;
+            atfft_sample re [ATFFT_CHANNELIZER_BLOCK] = {0};
+            atfft_sample im [ATFFT_CHANNELIZER_BLOCK] = {0};
+
+            for (int p = 0; p < taps_per_channel; ++p)
+            {
+                for (int i = 0; i < ATFFT_CHANNELIZER_BLOCK; ++i)
+                {
+                    re [i] += h [i] * ATFFT_RE (x [i]);
+                    im [i] += h [i] * ATFFT_IM (x [i]);
+                }
+
+                h += n_channels;
+                x += n_channels;
+            }
+
+            for (int i = 0; i < ATFFT_CHANNELIZER_BLOCK; ++i)
+            {
+                int j = r + i + phases [f];
+
+                j -= j >= n_channels ? n_channels : 0;
+                ATFFT_RE (sums [j]) = re [i];
+                ATFFT_IM (sums [j]) = im [i];
+            }
+        }
+    }
+
+    for (; r < n_channels; ++r)
+    {
+        for (int f = 0; f < n_frames; ++f)
+        {
+            const atfft_sample *h = channelizer->filter + r;
+            atfft_complex *x = channelizer->buffer + f * hop_size + r;
+            atfft_complex *sums = channelizer->sums + f * n_channels;
+            atfft_sample re = 0.0, im = 0.0;
+            int j = r + phases [f];
+
+            for (int p = 0; p < taps_per_channel; ++p)
+            {
+                re += h [p * n_channels] * ATFFT_RE (x [p * n_channels]);
+                im += h [p * n_channels] * ATFFT_IM (x [p * n_channels]);
+            }
+
+            j -= j >= n_channels ? n_channels : 0;
+            ATFFT_RE (sums [j]) = re;
+            ATFFT_IM (sums [j]) = im;
+        }
+    }
+}
+
+void atfft_channelizer_transform (struct atfft_channelizer *channelizer,
+                                  atfft_complex *in,
+                                  int n_frames,
+                                  atfft_complex *out)
+{
+    int n_channels = channelizer->n_channels;
+    int hop_size = channelizer->hop_size;
+    int history_size = channelizer->history_size;
+
+    while (n_frames > 0)
+    {
+        int n = ATFFT_MIN (n_frames, ATFFT_CHANNELIZER_BATCH);
+
+        memcpy (channelizer->buffer + history_size, in, n * hop_size * sizeof (*in));
+
+        atfft_channelizer_fold (channelizer, n);
+
+        for (int f = 0; f < n; ++f)
+            atfft_dft_complex_transform (channelizer->dft, channelizer->sums + f * n_channels, out + f * n_channels);
+
+        memmove (channelizer->buffer, channelizer->buffer + n * hop_size, history_size * sizeof (*in));
+
+        in += n * hop_size;
+        out += n * n_channels;
+        n_frames -= n;
+    }
+}
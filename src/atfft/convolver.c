@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <atfft/dft.h>
+#include <atfft/dft_util.h>
+#include <atfft/convolver.h>
+
+/* Spectra are stored with their real and imaginary parts in separate
+ * arrays, so the multiply-accumulate over the partitions is a plain loop
+ * over contiguous values which the compiler can vectorise.
+ *
+ * The delay line holds the spectra of the last n_partitions input blocks
+ * in a ring, partition p is multiplied with the spectrum from p blocks
+ * ago. The DFT normalisation is folded into the partition spectra. */
+struct atfft_convolver
+{
+    int block_size, fft_size, n_bins, n_partitions;
+    struct atfft_dft *forward, *backward;
+
+    /* n_partitions spectra of n_bins values each */
+    atfft_sample *kernel_re, *kernel_im;
+    atfft_sample *delay_re, *delay_im;
+    int delay_position;
+
+    /* working space */
+    atfft_sample *signal, *output, *accumulator_re, *accumulator_im;
+    atfft_complex *spectrum;
+};
+
+static void atfft_convolver_split (atfft_complex *in, atfft_sample *re, atfft_sample *im, int size)
+{
+    for (int i = 0; i < size; ++i)
+    {
+        re [i] = ATFFT_RE (in [i]);
+        im [i] = ATFFT_IM (in [i]);
+    }
+}
+
+static void atfft_convolver_join (const atfft_sample *re, const atfft_sample *im, atfft_complex *out, int size)
+{
+    for (int i = 0; i < size; ++i)
+    {
+        ATFFT_RE (out [i]) = re [i];
+        ATFFT_IM (out [i]) = im [i];
+    }
+}
+
+static void atfft_convolver_init_kernel (struct atfft_convolver *convolver,
+                                         const atfft_sample *kernel,
+                                         int kernel_size)
+{
+    int block_size = convolver->block_size;
+    int n_bins = convolver->n_bins;
+
+    for (int p = 0; p < convolver->n_partitions; ++p)
+    {
+        int start = p * block_size;
+        int size = ATFFT_MIN (block_size, kernel_size - start);
+
+        /* Each partition is zero padded to the DFT size. */
+        memset (convolver->signal, 0, convolver->fft_size * sizeof (*(convolver->signal)));
+        memcpy (convolver->signal, kernel + start, size * sizeof (*kernel));
+        atfft_scale_real (convolver->signal, size, 1.0 / convolver->fft_size);
+
+        atfft_dft_real_forward_transform (convolver->forward, convolver->signal, convolver->spectrum);
+        atfft_convolver_split (convolver->spectrum,
+                               convolver->kernel_re + p * n_bins,
+                               convolver->kernel_im + p * n_bins,
+                               n_bins);
+    }
+}
+
+struct atfft_convolver* atfft_convolver_create (const atfft_sample *kernel, int kernel_size, int block_size)
+{
+    assert (kernel_size > 0 && block_size > 0);
+
+    struct atfft_convolver *convolver;
+    int n_spectra;
+
+    if (!(convolver = calloc (1, sizeof (*convolver))))
+        return NULL;
+
+    convolver->block_size = block_size;
+    convolver->fft_size = 2 * block_size;
+    convolver->n_bins = atfft_halfcomplex_size (convolver->fft_size);
+    convolver->n_partitions = (kernel_size + block_size - 1) / block_size;
+    n_spectra = convolver->n_partitions * convolver->n_bins;
+
+    convolver->forward = atfft_dft_create (convolver->fft_size, ATFFT_FORWARD, ATFFT_REAL);
+    convolver->backward = atfft_dft_create (convolver->fft_size, ATFFT_BACKWARD, ATFFT_REAL);
+    convolver->kernel_re = malloc (n_spectra * sizeof (*(convolver->kernel_re)));
+    convolver->kernel_im = malloc (n_spectra * sizeof (*(convolver->kernel_im)));
+    convolver->delay_re = calloc (n_spectra, sizeof (*(convolver->delay_re)));
+    convolver->delay_im = calloc (n_spectra, sizeof (*(convolver->delay_im)));
+    convolver->signal = calloc (convolver->fft_size, sizeof (*(convolver->signal)));
+    convolver->output = malloc (convolver->fft_size * sizeof (*(convolver->output)));
+    convolver->accumulator_re = malloc (convolver->n_bins * sizeof (*(convolver->accumulator_re)));
+    convolver->accumulator_im = malloc (convolver->n_bins * sizeof (*(convolver->accumulator_im)));
+    convolver->spectrum = malloc (convolver->n_bins * sizeof (*(convolver->spectrum)));
+
+    if (!(convolver->forward && convolver->backward &&
+          convolver->kernel_re && convolver->kernel_im &&
+          convolver->delay_re && convolver->delay_im &&
+          convolver->signal && convolver->output && convolver->accumulator_re && convolver->accumulator_im &&
+          convolver->spectrum))
+        goto failed;
+
+    atfft_convolver_init_kernel (convolver, kernel, kernel_size);
+    atfft_convolver_reset (convolver);
+    return convolver;
+
+failed:
+    atfft_convolver_destroy (convolver);
+    return NULL;
+}
+
+void atfft_convolver_destroy (struct atfft_convolver *convolver)
+{
+    if (convolver)
+    {
+        free (convolver->spectrum);
+        free (convolver->accumulator_im);
+        free (convolver->accumulator_re);
+        free (convolver->output);
+        free (convolver->signal);
+        free (convolver->delay_im);
+        free (convolver->delay_re);
+        free (convolver->kernel_im);
+        free (convolver->kernel_re);
+        atfft_dft_destroy (convolver->backward);
+        atfft_dft_destroy (convolver->forward);
+        free (convolver);
+    }
+}
+
+void atfft_convolver_reset (struct atfft_convolver *convolver)
+{
+    int n_spectra = convolver->n_partitions * convolver->n_bins;
+
+    memset (convolver->delay_re, 0, n_spectra * sizeof (*(convolver->delay_re)));
+    memset (convolver->delay_im, 0, n_spectra * sizeof (*(convolver->delay_im)));
+    memset (convolver->signal, 0, convolver->fft_size * sizeof (*(convolver->signal)));
+    convolver->delay_position = 0;
+}
+
+static void atfft_convolver_multiply_accumulate (const atfft_sample *x_re,
+                                                 const atfft_sample *x_im,
+                                                 const atfft_sample *h_re,
+                                                 const atfft_sample *h_im,
+                                                 atfft_sample *y_re,
+                                                 atfft_sample *y_im,
+                                                 int size)
+{
+    for (int i = 0; i < size; ++i)
+    {
+        y_re [i] += x_re [i] * h_re [i] - x_im [i] * h_im [i];
+        y_im [i] += x_re [i] * h_im [i] + x_im [i] * h_re [i];
+    }
+}
+
+void atfft_convolver_process (struct atfft_convolver *convolver, const atfft_sample *in, atfft_sample *out)
+{
+    int block_size = convolver->block_size;
+    int n_bins = convolver->n_bins;
+    int n_partitions = convolver->n_partitions;
+    int position = convolver->delay_position;
+
+    /* Slide the input along by a block and transform the newest two blocks
+     * into the current slot of the delay line. */
+    memmove (convolver->signal, convolver->signal + block_size, block_size * sizeof (*(convolver->signal)));
+    memcpy (convolver->signal + block_size, in, block_size * sizeof (*in));
+
+    atfft_dft_real_forward_transform (convolver->forward, convolver->signal, convolver->spectrum);
+    atfft_convolver_split (convolver->spectrum,
+                           convolver->delay_re + position * n_bins,
+                           convolver->delay_im + position * n_bins,
+                           n_bins);
+
+    memset (convolver->accumulator_re, 0, n_bins * sizeof (*(convolver->accumulator_re)));
+    memset (convolver->accumulator_im, 0, n_bins * sizeof (*(convolver->accumulator_im)));
+
+    for (int p = 0; p < n_partitions; ++p)
+    {
+        int slot = position - p;
+
+        if (slot < 0)
+            slot += n_partitions;
+
+        atfft_convolver_multiply_accumulate (convolver->delay_re + slot * n_bins,
+                                             convolver->delay_im + slot * n_bins,
+                                             convolver->kernel_re + p * n_bins,
+                                             convolver->kernel_im + p * n_bins,
+                                             convolver->accumulator_re,
+                                             convolver->accumulator_im,
+                                             n_bins);
+    }
+
+    convolver->delay_position = position + 1 < n_partitions ? position + 1 : 0;
+
+    /* The first half of the inverse transform is circularly aliased,
+     * the second half is the output. */
+    atfft_convolver_join (convolver->accumulator_re, convolver->accumulator_im, convolver->spectrum, n_bins);
+    atfft_dft_real_backward_transform (convolver->backward, convolver->spectrum, convolver->output);
+    memcpy (out, convolver->output + block_size, block_size * sizeof (*out));
+}
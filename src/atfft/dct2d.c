@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <assert.h>
+#include <atfft/dct2d.h>
+
+/* number of samples in each group of blocks transformed together */
+#define ATFFT_DCT2D_GROUP 1024
+#define ATFFT_DCT2D_HALF_GROUP (ATFFT_DCT2D_GROUP / 2)
+
+/* 2 cos (pi (2n + 1) / 4N) for the DCT-IV of size N */
+static const long double atfft_dct2d_iv_scales_8 [] =
+{
+    1.990369453344393772489674L,
+    1.913880671464417729871596L,
+    1.763842528696710059425514L,
+    1.546020906725473921621813L,
+    1.268786568327290996430343L,
+    0.942793473651995297112775L,
+    0.580569354508924735272385L,
+    0.196034280659121203988391L
+};
+
+static const long double atfft_dct2d_iv_scales_16 [] =
+{
+    1.997590912410344785429543L,
+    1.978353019929561946903347L,
+    1.940062506389087985207968L,
+    1.883088130366041556825019L,
+    1.807978586246886663172401L,
+    1.715457220000544139804540L,
+    1.606415062961289819613353L,
+    1.481902250709918182351234L,
+    1.343117909694036801250754L,
+    1.191398608984866686934073L,
+    1.028205488386443453187388L,
+    0.855110186860564188641934L,
+    0.673779706784440101378506L,
+    0.485960359806527779896548L,
+    0.293460948910723503317700L,
+    0.098135348654836028509910L
+};
+
+#define ATFFT_DCT2D_TYPE float
+#define ATFFT_DCT2D_NAME(name) name##_float
+#include "dct2d_kernels.h"
+#undef ATFFT_DCT2D_NAME
+#undef ATFFT_DCT2D_TYPE
+
+#ifndef ATFFT_TYPE_FLOAT
+#   define ATFFT_DCT2D_TYPE atfft_sample
+#   define ATFFT_DCT2D_NAME(name) name##_sample
+#   include "dct2d_kernels.h"
+#   undef ATFFT_DCT2D_NAME
+#   undef ATFFT_DCT2D_TYPE
+#endif
+
+int atfft_dct2d_is_supported (int block_size, enum atfft_dct_type type)
+{
+    return (block_size == 8 || block_size == 16 || block_size == 32) &&
+           (type == ATFFT_DCT_II || type == ATFFT_DCT_III);
+}
+
+void atfft_dct2d_blocks (enum atfft_dct_type type,
+                         int block_size,
+                         int n_blocks,
+                         const atfft_sample *in,
+                         atfft_sample *out)
+{
+    assert (atfft_dct2d_is_supported (block_size, type));
+
+#ifdef ATFFT_TYPE_FLOAT
+    atfft_dct2d_blocks_type_float (type, block_size, n_blocks, in, out);
+#else
+    atfft_dct2d_blocks_type_sample (type, block_size, n_blocks, in, out);
+#endif
+}
+
+void atfft_dct2d_blocks_float (enum atfft_dct_type type,
+                               int block_size,
+                               int n_blocks,
+                               const float *in,
+                               float *out)
+{
+    assert (atfft_dct2d_is_supported (block_size, type));
+    atfft_dct2d_blocks_type_float (type, block_size, n_blocks, in, out);
+}
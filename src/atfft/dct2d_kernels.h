@@ -0,0 +1,389 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Kernels for the block DCTs in dct2d.c.
+ *
+ * This file is included once for each sample type with ATFFT_DCT2D_TYPE set
+ * to the type and ATFFT_DCT2D_NAME(name) giving a name for the functions
+ * operating on that type.
+ *
+ * Every kernel transforms the columns of a matrix with one row per sample,
+ * so the loops over the width of the matrix operate on contiguous memory
+ * and are left for the compiler to vectorise. The 8 point transforms use
+ * Loeffler's factorisation. Larger transforms are split into a half length
+ * DCT of the sums of the samples from either end of the signal and a half
+ * length DCT-IV of their differences, the DCT-IV being computed from a DCT-II
+ * of a pre-scaled signal followed by a recursion over the outputs.
+ */
+
+#define T ATFFT_DCT2D_TYPE
+#define NAME(name) ATFFT_DCT2D_NAME(name)
+
+static void NAME(atfft_dct2d_dct_ii_8) (const T *x, int x_stride, T *y, int y_stride, int width)
+{
+    int w;
+
+    for (w = 0; w < width; ++w)
+    {
+        const T *xw = x + w;
+        T *yw = y + w;
+        T s0, s1, s2, s3, d0, d1, d2, d3;
+        T e0, e1, f0, f1, z, z1, z2, z3, z4, z5;
+
+        s0 = xw [0] + xw [7 * x_stride];
+        s1 = xw [x_stride] + xw [6 * x_stride];
+        s2 = xw [2 * x_stride] + xw [5 * x_stride];
+        s3 = xw [3 * x_stride] + xw [4 * x_stride];
+        d0 = xw [0] - xw [7 * x_stride];
+        d1 = xw [x_stride] - xw [6 * x_stride];
+        d2 = xw [2 * x_stride] - xw [5 * x_stride];
+        d3 = xw [3 * x_stride] - xw [4 * x_stride];
+
+        /* even part */
+        e0 = s0 + s3;
+        e1 = s1 + s2;
+        f0 = s0 - s3;
+        f1 = s1 - s2;
+
+        yw [0] = e0 + e1;
+        yw [4 * y_stride] = (e0 - e1) * (T) 0.707106781186547524400844L;
+
+        z = (f0 + f1) * (T) 0.382683432365089771728460L;
+        yw [2 * y_stride] = z + f0 * (T) 0.541196100146196984399723L;
+        yw [6 * y_stride] = z - f1 * (T) 1.306562964876376527856643L;
+
+        /* odd part */
+        z1 = d3 + d0;
+        z2 = d2 + d1;
+        z3 = d3 + d1;
+        z4 = d2 + d0;
+        z5 = (z3 + z4) * (T) 0.831469612302545237078788L;
+
+        d3 *= (T) 0.211164242902788744847152L;
+        d2 *= (T) 1.451774981702301729310425L;
+        d1 *= (T) 2.172734803709249643099517L;
+        d0 *= (T) 1.061594337670045193613855L;
+        z1 *= (T) -0.636379290286416969230504L;
+        z2 *= (T) -1.812254892705775686204971L;
+        z3 = z3 * (T) -1.387039845322147461821619L + z5;
+        z4 = z4 * (T) -0.275899379282943012335958L + z5;
+
+        yw [7 * y_stride] = d3 + z1 + z3;
+        yw [5 * y_stride] = d2 + z2 + z4;
+        yw [3 * y_stride] = d1 + z2 + z3;
+        yw [y_stride] = d0 + z1 + z4;
+    }
+}
+
+static void NAME(atfft_dct2d_dct_iii_8) (const T *x, int x_stride, T *y, int y_stride, int width)
+{
+    int w;
+
+    for (w = 0; w < width; ++w)
+    {
+        const T *xw = x + w;
+        T *yw = y + w;
+        T s0, s1, s2, s3, d0, d1, d2, d3, o0, o1, o2, o3;
+        T e0, e1, f0, f1, z, z1, z2, z3, z4, z5;
+
+        /* even part */
+        e0 = xw [0] * (T) 0.5;
+        e1 = xw [4 * x_stride] * (T) 0.707106781186547524400844L;
+        f0 = xw [2 * x_stride];
+        f1 = xw [6 * x_stride];
+
+        z = (f0 + f1) * (T) 0.382683432365089771728460L;
+        f0 = z + f0 * (T) 0.541196100146196984399723L;
+        f1 = z - f1 * (T) 1.306562964876376527856643L;
+
+        s0 = e0 + e1 + f0;
+        s3 = e0 + e1 - f0;
+        s1 = e0 - e1 + f1;
+        s2 = e0 - e1 - f1;
+
+        /* odd part, the DCT-IV is its own transpose */
+        d0 = xw [x_stride];
+        d1 = xw [3 * x_stride];
+        d2 = xw [5 * x_stride];
+        d3 = xw [7 * x_stride];
+
+        z1 = d3 + d0;
+        z2 = d2 + d1;
+        z3 = d3 + d1;
+        z4 = d2 + d0;
+        z5 = (z3 + z4) * (T) 0.831469612302545237078788L;
+
+        d3 *= (T) 0.211164242902788744847152L;
+        d2 *= (T) 1.451774981702301729310425L;
+        d1 *= (T) 2.172734803709249643099517L;
+        d0 *= (T) 1.061594337670045193613855L;
+        z1 *= (T) -0.636379290286416969230504L;
+        z2 *= (T) -1.812254892705775686204971L;
+        z3 = z3 * (T) -1.387039845322147461821619L + z5;
+        z4 = z4 * (T) -0.275899379282943012335958L + z5;
+
+        o0 = d0 + z1 + z4;
+        o1 = d1 + z2 + z3;
+        o2 = d2 + z2 + z4;
+        o3 = d3 + z1 + z3;
+
+        yw [0] = s0 + o0;
+        yw [7 * y_stride] = s0 - o0;
+        yw [y_stride] = s1 + o1;
+        yw [6 * y_stride] = s1 - o1;
+        yw [2 * y_stride] = s2 + o2;
+        yw [5 * y_stride] = s2 - o2;
+        yw [3 * y_stride] = s3 + o3;
+        yw [4 * y_stride] = s3 - o3;
+    }
+}
+
+static void NAME(atfft_dct2d_dct_ii_16) (const T *x, int x_stride, T *y, int y_stride, int width);
+
+/* DCT-IV of size 8 or 16: the signal is scaled by 2 cos (pi (2n + 1) / 4N)
+ * and put through a DCT-II, whose bins are the sums of adjacent DCT-IV bins.
+ * The scaled signal is stored in the output, which must not overlap the
+ * input. */
+static void NAME(atfft_dct2d_dct_iv) (const T *x, int x_stride, T *y, int y_stride, int width, int size)
+{
+    T v [ATFFT_DCT2D_HALF_GROUP];
+    const long double *scales = size == 8 ? atfft_dct2d_iv_scales_8 : atfft_dct2d_iv_scales_16;
+    int n, w;
+
+    for (n = 0; n < size; ++n)
+    {
+        T scale = scales [n];
+
+        for (w = 0; w < width; ++w)
+            y [n * y_stride + w] = x [n * x_stride + w] * scale;
+    }
+
+    if (size == 8)
+        NAME(atfft_dct2d_dct_ii_8) (y, y_stride, v, width, width);
+    else
+        NAME(atfft_dct2d_dct_ii_16) (y, y_stride, v, width, width);
+
+    for (w = 0; w < width; ++w)
+        y [w] = v [w] * (T) 0.5;
+
+    for (n = 1; n < size; ++n)
+    {
+        for (w = 0; w < width; ++w)
+            y [n * y_stride + w] = v [n * width + w] - y [(n - 1) * y_stride + w];
+    }
+}
+
+/* Split a signal into the sums and differences of samples from either end. */
+static void NAME(atfft_dct2d_fold) (const T *x, int x_stride, T *s, T *d, int width, int size)
+{
+    int half = size / 2;
+    int n, w;
+
+    for (n = 0; n < half; ++n)
+    {
+        const T *a = x + n * x_stride;
+        const T *b = x + (size - 1 - n) * x_stride;
+
+        for (w = 0; w < width; ++w)
+        {
+            s [n * width + w] = a [w] + b [w];
+            d [n * width + w] = a [w] - b [w];
+        }
+    }
+}
+
+/* The inverse of atfft_dct2d_fold(), without the factor of 2. */
+static void NAME(atfft_dct2d_unfold) (const T *e, const T *o, T *y, int y_stride, int width, int size)
+{
+    int half = size / 2;
+    int n, w;
+
+    for (n = 0; n < half; ++n)
+    {
+        T *a = y + n * y_stride;
+        T *b = y + (size - 1 - n) * y_stride;
+
+        for (w = 0; w < width; ++w)
+        {
+            a [w] = e [n * width + w] + o [n * width + w];
+            b [w] = e [n * width + w] - o [n * width + w];
+        }
+    }
+}
+
+static void NAME(atfft_dct2d_dct_ii_16) (const T *x, int x_stride, T *y, int y_stride, int width)
+{
+    T s [ATFFT_DCT2D_HALF_GROUP], d [ATFFT_DCT2D_HALF_GROUP];
+
+    NAME(atfft_dct2d_fold) (x, x_stride, s, d, width, 16);
+    NAME(atfft_dct2d_dct_ii_8) (s, width, y, 2 * y_stride, width);
+    NAME(atfft_dct2d_dct_iv) (d, width, y + y_stride, 2 * y_stride, width, 8);
+}
+
+static void NAME(atfft_dct2d_dct_iii_16) (const T *x, int x_stride, T *y, int y_stride, int width)
+{
+    T e [ATFFT_DCT2D_HALF_GROUP], o [ATFFT_DCT2D_HALF_GROUP];
+
+    NAME(atfft_dct2d_dct_iii_8) (x, 2 * x_stride, e, width, width);
+    NAME(atfft_dct2d_dct_iv) (x + x_stride, 2 * x_stride, o, width, width, 8);
+    NAME(atfft_dct2d_unfold) (e, o, y, y_stride, width, 16);
+}
+
+static void NAME(atfft_dct2d_dct_ii_32) (const T *x, int x_stride, T *y, int y_stride, int width)
+{
+    T s [ATFFT_DCT2D_HALF_GROUP], d [ATFFT_DCT2D_HALF_GROUP];
+
+    NAME(atfft_dct2d_fold) (x, x_stride, s, d, width, 32);
+    NAME(atfft_dct2d_dct_ii_16) (s, width, y, 2 * y_stride, width);
+    NAME(atfft_dct2d_dct_iv) (d, width, y + y_stride, 2 * y_stride, width, 16);
+}
+
+static void NAME(atfft_dct2d_dct_iii_32) (const T *x, int x_stride, T *y, int y_stride, int width)
+{
+    T e [ATFFT_DCT2D_HALF_GROUP], o [ATFFT_DCT2D_HALF_GROUP];
+
+    NAME(atfft_dct2d_dct_iii_16) (x, 2 * x_stride, e, width, width);
+    NAME(atfft_dct2d_dct_iv) (x + x_stride, 2 * x_stride, o, width, width, 16);
+    NAME(atfft_dct2d_unfold) (e, o, y, y_stride, width, 32);
+}
+
+/* Transform the columns of a block_size x width matrix. */
+static void NAME(atfft_dct2d_columns) (enum atfft_dct_type type,
+                                       int block_size,
+                                       const T *x,
+                                       T *y,
+                                       int width)
+{
+    if (type == ATFFT_DCT_II)
+    {
+        switch (block_size)
+        {
+            case 8:
+                NAME(atfft_dct2d_dct_ii_8) (x, width, y, width, width);
+                break;
+
+            case 16:
+                NAME(atfft_dct2d_dct_ii_16) (x, width, y, width, width);
+                break;
+
+            default:
+                NAME(atfft_dct2d_dct_ii_32) (x, width, y, width, width);
+        }
+    }
+    else
+    {
+        switch (block_size)
+        {
+            case 8:
+                NAME(atfft_dct2d_dct_iii_8) (x, width, y, width, width);
+                break;
+
+            case 16:
+                NAME(atfft_dct2d_dct_iii_16) (x, width, y, width, width);
+                break;
+
+            default:
+                NAME(atfft_dct2d_dct_iii_32) (x, width, y, width, width);
+        }
+    }
+}
+
+/* Transpose a block_size x block_size block, four rows and columns at a time. */
+static void NAME(atfft_dct2d_transpose) (const T *x, int x_stride, T *y, int y_stride, int block_size)
+{
+    int i, j;
+
+    for (i = 0; i < block_size; i += 4)
+    {
+        for (j = 0; j < block_size; j += 4)
+        {
+            const T *a = x + i * x_stride + j;
+            T *b = y + j * y_stride + i;
+
+            b [0] = a [0];
+            b [1] = a [x_stride];
+            b [2] = a [2 * x_stride];
+            b [3] = a [3 * x_stride];
+            b [y_stride] = a [1];
+            b [y_stride + 1] = a [x_stride + 1];
+            b [y_stride + 2] = a [2 * x_stride + 1];
+            b [y_stride + 3] = a [3 * x_stride + 1];
+            b [2 * y_stride] = a [2];
+            b [2 * y_stride + 1] = a [x_stride + 2];
+            b [2 * y_stride + 2] = a [2 * x_stride + 2];
+            b [2 * y_stride + 3] = a [3 * x_stride + 2];
+            b [3 * y_stride] = a [3];
+            b [3 * y_stride + 1] = a [x_stride + 3];
+            b [3 * y_stride + 2] = a [2 * x_stride + 3];
+            b [3 * y_stride + 3] = a [3 * x_stride + 3];
+        }
+    }
+}
+
+/* Blocks are transformed in groups laid side by side in a matrix of
+ * ATFFT_DCT2D_GROUP samples. The blocks are transposed into the matrix so
+ * transforming its columns transforms the rows of each block, then the
+ * blocks are transposed back and their columns transformed. */
+static void NAME(atfft_dct2d_blocks_type) (enum atfft_dct_type type,
+                                           int block_size,
+                                           int n_blocks,
+                                           const T *in,
+                                           T *out)
+{
+    T a [ATFFT_DCT2D_GROUP], b [ATFFT_DCT2D_GROUP];
+    int block_length = block_size * block_size;
+    int group_blocks = ATFFT_DCT2D_GROUP / block_length;
+    int i;
+
+    while (n_blocks > 0)
+    {
+        int n = ATFFT_MIN (n_blocks, group_blocks);
+        int width = n * block_size;
+
+        for (i = 0; i < n; ++i)
+            NAME(atfft_dct2d_transpose) (in + i * block_length, block_size, a + i * block_size, width, block_size);
+
+        NAME(atfft_dct2d_columns) (type, block_size, a, b, width);
+
+        for (i = 0; i < n; ++i)
+            NAME(atfft_dct2d_transpose) (b + i * block_size, width, a + i * block_size, width, block_size);
+
+        NAME(atfft_dct2d_columns) (type, block_size, a, b, width);
+
+        for (i = 0; i < block_size; ++i)
+        {
+            int j;
+
+            for (j = 0; j < n; ++j)
+                memcpy (out + j * block_length + i * block_size,
+                        b + i * width + j * block_size,
+                        block_size * sizeof (*b));
+        }
+
+        in += n * block_length;
+        out += n * block_length;
+        n_blocks -= n;
+    }
+}
+
+#undef NAME
+#undef T
@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+#include <atfft/dct.h>
+#include <atfft/dct_batch.h>
+#include "constants.h"
+
+/* Signals up to this length are transformed by matrix multiplication. */
+#define ATFFT_DCT_BATCH_MAX_DIRECT_SIZE 64
+
+/* The number of signals transformed together by the matrix multiplication. */
+#define ATFFT_DCT_BATCH_TILE 16
+
+/* The number of signals accumulated at once within a tile. */
+#define ATFFT_DCT_BATCH_LANES 8
+
+/* For short signals a tile of signals is stored with one row per sample
+ * index, so each multiply-accumulate runs across the signals in the tile.
+ *
+ * The forward transform first folds each signal into the sums and
+ * differences of samples from either end: the even DCT-II bins only depend
+ * on the sums and the odd bins on the differences, halving the work. */
+struct atfft_dct_batch
+{
+    int size, howmany, in_dist, out_dist, n_outputs;
+    enum atfft_direction direction;
+
+    /* matrix multiplication */
+    int n_columns;
+    atfft_sample *matrix;
+    atfft_sample *signals, *results;
+
+    /* one transform at a time */
+    struct atfft_dct *dct;
+    atfft_sample *scratch;
+};
+
+/* cos (pi * m / 2N), with m reduced modulo 4N first so that the
+ * argument, and the rounding of pi in it, stays small. */
+static atfft_sample atfft_dct_batch_cos (int m, int size)
+{
+    return cos (M_PI * (m % (4 * size)) / (2.0 * size));
+}
+
+static void atfft_dct_batch_init_matrix (struct atfft_dct_batch *batch)
+{
+    int size = batch->size;
+
+    for (int k = 0; k < batch->n_outputs; ++k)
+    {
+        atfft_sample *row = batch->matrix + k * batch->n_columns;
+
+        if (batch->direction == ATFFT_FORWARD)
+        {
+            for (int n = 0; n < batch->n_columns; ++n)
+                row [n] = atfft_dct_batch_cos ((2 * n + 1) * k, size);
+        }
+        else
+        {
+            for (int n = 0; n < batch->n_columns; ++n)
+                row [n] = atfft_dct_batch_cos (n * (2 * k + 1), size);
+
+            row [0] *= 0.5;
+        }
+    }
+}
+
+struct atfft_dct_batch* atfft_dct_batch_create (int size,
+                                                int howmany,
+                                                int in_dist,
+                                                int out_dist,
+                                                int n_outputs,
+                                                enum atfft_direction direction)
+{
+    assert (size > 0 && howmany > 0);
+    assert (n_outputs > 0 && n_outputs <= size);
+
+    struct atfft_dct_batch *batch;
+
+    if (!(batch = calloc (1, sizeof (*batch))))
+        return NULL;
+
+    batch->size = size;
+    batch->howmany = howmany;
+    batch->in_dist = in_dist;
+    batch->out_dist = out_dist;
+    batch->n_outputs = n_outputs;
+    batch->direction = direction;
+
+    if (size <= ATFFT_DCT_BATCH_MAX_DIRECT_SIZE)
+    {
+        batch->n_columns = direction == ATFFT_FORWARD ? (size + 1) / 2 : size;
+        batch->matrix = malloc (n_outputs * batch->n_columns * sizeof (*(batch->matrix)));
+        batch->signals = calloc (size * ATFFT_DCT_BATCH_TILE, sizeof (*(batch->signals)));
+        batch->results = malloc (n_outputs * ATFFT_DCT_BATCH_TILE * sizeof (*(batch->results)));
+
+        if (!(batch->matrix && batch->signals && batch->results))
+            goto failed;
+
+        atfft_dct_batch_init_matrix (batch);
+    }
+    else
+    {
+        batch->dct = atfft_dct_create (size, direction);
+        batch->scratch = malloc (size * sizeof (*(batch->scratch)));
+
+        if (!(batch->dct && batch->scratch))
+            goto failed;
+    }
+
+    return batch;
+
+failed:
+    atfft_dct_batch_destroy (batch);
+    return NULL;
+}
+
+void atfft_dct_batch_destroy (struct atfft_dct_batch *batch)
+{
+    if (batch)
+    {
+        free (batch->scratch);
+        atfft_dct_destroy (batch->dct);
+        free (batch->results);
+        free (batch->signals);
+        free (batch->matrix);
+        free (batch);
+    }
+}
+
+/******************************************
+ * Matrix multiplication
+ ******************************************/
+static void atfft_dct_batch_fold (struct atfft_dct_batch *batch, const atfft_sample *in, int n_signals)
+{
+    int size = batch->size;
+    int half = size / 2;
+    atfft_sample *sums = batch->signals;
+    atfft_sample *differences = batch->signals + batch->n_columns * ATFFT_DCT_BATCH_TILE;
+
+    for (int i = 0; i < n_signals; ++i)
+    {
+        const atfft_sample *x = in + i * batch->in_dist;
+
+        for (int n = 0; n < half; ++n)
+        {
+            sums [n * ATFFT_DCT_BATCH_TILE + i] = x [n] + x [size - 1 - n];
+            differences [n * ATFFT_DCT_BATCH_TILE + i] = x [n] - x [size - 1 - n];
+        }
+
+        if (atfft_is_odd (size))
+            sums [half * ATFFT_DCT_BATCH_TILE + i] = x [half];
+    }
+}
+
+static void atfft_dct_batch_gather (struct atfft_dct_batch *batch, const atfft_sample *in, int n_signals)
+{
+    for (int i = 0; i < n_signals; ++i)
+    {
+        const atfft_sample *x = in + i * batch->in_dist;
+
+        for (int n = 0; n < batch->size; ++n)
+            batch->signals [n * ATFFT_DCT_BATCH_TILE + i] = x [n];
+    }
+}
+
+static void atfft_dct_batch_multiply_row (const atfft_sample *row,
+                                          const atfft_sample *signals,
+                                          int n_columns,
+                                          atfft_sample *result)
+{
+    for (int j = 0; j < ATFFT_DCT_BATCH_TILE; j += ATFFT_DCT_BATCH_LANES)
+    {
+        /* accumulate locally so the compiler knows the sums
+         * don't alias the signals and can keep them in registers */
+        atfft_sample sums [ATFFT_DCT_BATCH_LANES] = {0.0};
+        int i;
+
+        for (int n = 0; n < n_columns; ++n)
+        {
+            atfft_sample c = row [n];
+            const atfft_sample *x = signals + n * ATFFT_DCT_BATCH_TILE + j;
+
+            for (i = 0; i < ATFFT_DCT_BATCH_LANES; ++i)
+                sums [i] += c * x [i];
+        }
+
+        for (i = 0; i < ATFFT_DCT_BATCH_LANES; ++i)
+            result [j + i] = sums [i];
+    }
+}
+
+static void atfft_dct_batch_multiply (struct atfft_dct_batch *batch)
+{
+    int n_columns = batch->n_columns;
+
+    for (int k = 0; k < batch->n_outputs; ++k)
+    {
+        const atfft_sample *row = batch->matrix + k * n_columns;
+        atfft_sample *result = batch->results + k * ATFFT_DCT_BATCH_TILE;
+
+        if (batch->direction == ATFFT_BACKWARD)
+            atfft_dct_batch_multiply_row (row, batch->signals, n_columns, result);
+        else if (atfft_is_even (k))
+            atfft_dct_batch_multiply_row (row, batch->signals, n_columns, result);
+        else
+            atfft_dct_batch_multiply_row (row,
+                                          batch->signals + n_columns * ATFFT_DCT_BATCH_TILE,
+                                          batch->size / 2,
+                                          result);
+    }
+}
+
+static void atfft_dct_batch_scatter (struct atfft_dct_batch *batch, atfft_sample *out, int n_signals)
+{
+    for (int i = 0; i < n_signals; ++i)
+    {
+        atfft_sample *y = out + i * batch->out_dist;
+
+        for (int k = 0; k < batch->n_outputs; ++k)
+            y [k] = batch->results [k * ATFFT_DCT_BATCH_TILE + i];
+    }
+}
+
+static void atfft_dct_batch_direct_transform (struct atfft_dct_batch *batch,
+                                              const atfft_sample *in,
+                                              atfft_sample *out)
+{
+    for (int i = 0; i < batch->howmany; i += ATFFT_DCT_BATCH_TILE)
+    {
+        int n_signals = ATFFT_MIN (ATFFT_DCT_BATCH_TILE, batch->howmany - i);
+
+        if (batch->direction == ATFFT_FORWARD)
+            atfft_dct_batch_fold (batch, in + i * batch->in_dist, n_signals);
+        else
+            atfft_dct_batch_gather (batch, in + i * batch->in_dist, n_signals);
+
+        atfft_dct_batch_multiply (batch);
+        atfft_dct_batch_scatter (batch, out + i * batch->out_dist, n_signals);
+    }
+}
+
+/******************************************
+ * One transform at a time
+ ******************************************/
+static void atfft_dct_batch_single_transform (struct atfft_dct_batch *batch,
+                                              const atfft_sample *in,
+                                              atfft_sample *out)
+{
+    for (int i = 0; i < batch->howmany; ++i)
+    {
+        atfft_dct_transform (batch->dct, in + i * batch->in_dist, batch->scratch);
+        memcpy (out + i * batch->out_dist, batch->scratch, batch->n_outputs * sizeof (*out));
+    }
+}
+
+void atfft_dct_batch_transform (struct atfft_dct_batch *batch, const atfft_sample *in, atfft_sample *out)
+{
+    if (batch->dct)
+        atfft_dct_batch_single_transform (batch, in, out);
+    else
+        atfft_dct_batch_direct_transform (batch, in, out);
+}
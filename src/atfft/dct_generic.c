@@ -0,0 +1,794 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+#include <atfft/dft.h>
+#include <atfft/dft_util.h>
+#include "constants.h"
+#include "dct_generic.h"
+
+/* Each transform type is computed with one of the following DFTs:
+ *
+ *  - DCT-II/III (and DST-II/III): Makhoul's method. The even samples of the
+ *    signal are followed by the odd samples in reverse order, an N point
+ *    real DFT of this sequence gives a halfcomplex spectrum from which the
+ *    DCT bins can be taken by rotating each bin by a quarter of its angle.
+ *    For even N the real DFT is computed as an N/2 point complex DFT of the
+ *    rearranged sequence packed into complex pairs. The rearrangement is done
+ *    while packing, and the rotation while splitting the complex spectrum into
+ *    its halfcomplex bins, so there is one pass either side of the DFT.
+ *
+ *  - DCT-IV (and DST-IV, MDCT, IMDCT): for even N, pairs of samples from
+ *    either end of the signal are combined into an N/2 point complex
+ *    signal, this is pre-twiddled, transformed and post-twiddled. For odd N
+ *    the pre-twiddled signal is zero padded and a 2N point complex DFT taken.
+ *
+ *  - DCT-I/DST-I: a real DFT of the signal's even or odd extension.
+ *
+ * The sine transforms are computed from their cosine counterparts by
+ * reversing the input or output and alternating signs.
+ */
+struct atfft_dct_generic
+{
+    int size;
+    enum atfft_dct_type type;
+    struct atfft_dft *dft;
+
+    /* sinusoids for DCT-II/III */
+    atfft_sample *cosins, *sins;
+
+    /* twiddle factors for DCT-IV, post_twiddles also
+     * splits the packed spectrum for even DCT-II/III */
+    atfft_complex *pre_twiddles, *post_twiddles;
+
+    /* working space */
+    atfft_sample *signal, *scratch;
+    atfft_complex *spectrum, *dft_in;
+
+    /* MDCT/IMDCT window */
+    atfft_sample *window;
+};
+
+static enum atfft_dct_type atfft_dct_base_type (enum atfft_dct_type type)
+{
+    switch (type)
+    {
+        case ATFFT_DST_II:
+            return ATFFT_DCT_II;
+        case ATFFT_DST_III:
+            return ATFFT_DCT_III;
+        case ATFFT_DST_IV:
+        case ATFFT_MDCT:
+        case ATFFT_IMDCT:
+            return ATFFT_DCT_IV;
+        default:
+            return type;
+    }
+}
+
+int atfft_dct_generic_is_supported_type (int size, enum atfft_dct_type type)
+{
+    switch (type)
+    {
+        case ATFFT_DCT_I:
+            return size >= 2 && atfft_dft_is_supported_size (2 * (size - 1), ATFFT_REAL);
+        case ATFFT_DST_I:
+            return size >= 1 && atfft_dft_is_supported_size (2 * (size + 1), ATFFT_REAL);
+        case ATFFT_DCT_IV:
+        case ATFFT_DST_IV:
+            if (size <= 0)
+                return 0;
+            else if (atfft_is_even (size))
+                return atfft_dft_is_supported_size (size / 2, ATFFT_COMPLEX);
+            else
+                return atfft_dft_is_supported_size (2 * size, ATFFT_COMPLEX);
+        case ATFFT_MDCT:
+        case ATFFT_IMDCT:
+            return size > 0 &&
+                   atfft_is_even (size) &&
+                   atfft_dft_is_supported_size (size / 2, ATFFT_COMPLEX);
+        default:
+            return atfft_dft_is_supported_size (size, ATFFT_REAL) ||
+                   (size > 0 &&
+                    atfft_is_even (size) &&
+                    atfft_dft_is_supported_size (size / 2, ATFFT_COMPLEX));
+    }
+}
+
+/******************************************
+ * Plan initialisation.
+ ******************************************/
+static void atfft_dct_init_sins (atfft_sample *cosins,
+                                 atfft_sample *sins,
+                                 int n_sins,
+                                 int size,
+                                 atfft_sample scale)
+{
+    for (int i = 0; i < n_sins; ++i)
+    {
+        atfft_sample x = i * M_PI / (2.0 * size);
+        cosins [i] = scale * cos (x);
+        sins [i] = scale * sin (x);
+    }
+}
+
+static void atfft_dct_init_twiddle (atfft_sample x, atfft_complex *t)
+{
+    ATFFT_RE (*t) = cos (x);
+    ATFFT_IM (*t) = -sin (x);
+}
+
+static int atfft_dct_init_makhoul_packed (struct atfft_dct_generic *dct, enum atfft_direction direction)
+{
+    int size = dct->size;
+    int half = size / 2;
+
+    dct->dft = atfft_dft_create (half, direction, ATFFT_COMPLEX);
+    dct->cosins = malloc ((half + 1) * sizeof (*(dct->cosins)));
+    dct->sins = malloc ((half + 1) * sizeof (*(dct->sins)));
+    dct->post_twiddles = malloc ((half + 1) * sizeof (*(dct->post_twiddles)));
+    dct->dft_in = malloc (half * sizeof (*(dct->dft_in)));
+    dct->spectrum = malloc (half * sizeof (*(dct->spectrum)));
+
+    if (!(dct->dft && dct->cosins && dct->sins && dct->post_twiddles && dct->dft_in && dct->spectrum))
+        return 0;
+
+    /* Splitting the packed spectrum doubles each bin and the
+     * backward transform halves its input, fold that into the
+     * sinusoids for both directions. */
+    atfft_dct_init_sins (dct->cosins, dct->sins, half + 1, size, 0.5);
+
+    for (int k = 0; k <= half; ++k)
+    {
+        atfft_sample x = 2.0 * M_PI * k / size;
+        atfft_dct_init_twiddle (direction == ATFFT_FORWARD ? x : -x, dct->post_twiddles + k);
+    }
+
+    return 1;
+}
+
+static int atfft_dct_init_makhoul (struct atfft_dct_generic *dct, enum atfft_direction direction)
+{
+    int size = dct->size;
+    int n_bins = atfft_halfcomplex_size (size);
+
+    if (atfft_is_even (size) && atfft_dft_is_supported_size (size / 2, ATFFT_COMPLEX))
+        return atfft_dct_init_makhoul_packed (dct, direction);
+
+    dct->dft = atfft_dft_create (size, direction, ATFFT_REAL);
+    dct->cosins = malloc (n_bins * sizeof (*(dct->cosins)));
+    dct->sins = malloc (n_bins * sizeof (*(dct->sins)));
+    dct->signal = malloc (size * sizeof (*(dct->signal)));
+    dct->spectrum = malloc (n_bins * sizeof (*(dct->spectrum)));
+
+    if (!(dct->dft && dct->cosins && dct->sins && dct->signal && dct->spectrum))
+        return 0;
+
+    /* The backward transform halves its input,
+     * fold that into the sinusoids. */
+    atfft_dct_init_sins (dct->cosins,
+                         dct->sins,
+                         n_bins,
+                         size,
+                         direction == ATFFT_FORWARD ? 1.0 : 0.5);
+
+    return 1;
+}
+
+static int atfft_dct_init_iv (struct atfft_dct_generic *dct)
+{
+    int size = dct->size;
+    int dft_size = atfft_is_even (size) ? size / 2 : 2 * size;
+    int n_pre = atfft_is_even (size) ? size / 2 : size;
+
+    dct->dft = atfft_dft_create (dft_size, ATFFT_FORWARD, ATFFT_COMPLEX);
+    dct->pre_twiddles = malloc (n_pre * sizeof (*(dct->pre_twiddles)));
+    dct->post_twiddles = malloc (n_pre * sizeof (*(dct->post_twiddles)));
+    dct->dft_in = calloc (dft_size, sizeof (*(dct->dft_in)));
+    dct->spectrum = malloc (dft_size * sizeof (*(dct->spectrum)));
+
+    if (!(dct->dft && dct->pre_twiddles && dct->post_twiddles && dct->dft_in && dct->spectrum))
+        return 0;
+
+    if (atfft_is_even (size))
+    {
+        for (int i = 0; i < n_pre; ++i)
+        {
+            atfft_dct_init_twiddle (M_PI * (4.0 * i + 1.0) / (4.0 * size), dct->pre_twiddles + i);
+            atfft_dct_init_twiddle (M_PI * i / size, dct->post_twiddles + i);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < n_pre; ++i)
+        {
+            atfft_dct_init_twiddle (M_PI * i / (2.0 * size), dct->pre_twiddles + i);
+            atfft_dct_init_twiddle (M_PI * (2.0 * i + 1.0) / (4.0 * size), dct->post_twiddles + i);
+        }
+    }
+
+    return 1;
+}
+
+static int atfft_dct_init_extension (struct atfft_dct_generic *dct, int extended_size)
+{
+    dct->dft = atfft_dft_create (extended_size, ATFFT_FORWARD, ATFFT_REAL);
+    dct->signal = malloc (extended_size * sizeof (*(dct->signal)));
+    dct->spectrum = malloc (atfft_halfcomplex_size (extended_size) * sizeof (*(dct->spectrum)));
+
+    return dct->dft && dct->signal && dct->spectrum;
+}
+
+struct atfft_dct_generic* atfft_dct_generic_create (int size, enum atfft_dct_type type)
+{
+    assert (atfft_dct_generic_is_supported_type (size, type));
+
+    struct atfft_dct_generic *dct;
+    int initialised = 0;
+
+    if (!(dct = calloc (1, sizeof (*dct))))
+        return NULL;
+
+    dct->size = size;
+    dct->type = type;
+
+    switch (atfft_dct_base_type (type))
+    {
+        case ATFFT_DCT_I:
+            initialised = atfft_dct_init_extension (dct, 2 * (size - 1));
+            break;
+        case ATFFT_DST_I:
+            initialised = atfft_dct_init_extension (dct, 2 * (size + 1));
+            break;
+        case ATFFT_DCT_II:
+            initialised = atfft_dct_init_makhoul (dct, ATFFT_FORWARD);
+            break;
+        case ATFFT_DCT_III:
+            initialised = atfft_dct_init_makhoul (dct, ATFFT_BACKWARD);
+            break;
+        default:
+            initialised = atfft_dct_init_iv (dct);
+    }
+
+    if (!initialised)
+        goto failed;
+
+    /* The sine transforms need space to rearrange their input,
+     * as does the folding and unfolding for the MDCT. */
+    if (type == ATFFT_DST_II || type == ATFFT_DST_III || type == ATFFT_DST_IV ||
+        type == ATFFT_MDCT || type == ATFFT_IMDCT)
+    {
+        dct->scratch = malloc (size * sizeof (*(dct->scratch)));
+
+        if (!dct->scratch)
+            goto failed;
+    }
+
+    return dct;
+
+failed:
+    atfft_dct_generic_destroy (dct);
+    return NULL;
+}
+
+void atfft_dct_generic_destroy (struct atfft_dct_generic *dct)
+{
+    if (dct)
+    {
+        free (dct->window);
+        free (dct->dft_in);
+        free (dct->spectrum);
+        free (dct->scratch);
+        free (dct->signal);
+        free (dct->post_twiddles);
+        free (dct->pre_twiddles);
+        free (dct->sins);
+        free (dct->cosins);
+        atfft_dft_destroy (dct->dft);
+        free (dct);
+    }
+}
+
+int atfft_dct_generic_set_window (struct atfft_dct_generic *dct, const atfft_sample *window)
+{
+    /* Only to be used with MDCTs. */
+    assert (dct->type == ATFFT_MDCT || dct->type == ATFFT_IMDCT);
+
+    if (!window)
+    {
+        free (dct->window);
+        dct->window = NULL;
+        return 0;
+    }
+
+    if (!dct->window)
+    {
+        dct->window = malloc (2 * dct->size * sizeof (*(dct->window)));
+
+        if (!dct->window)
+            return -1;
+    }
+
+    memcpy (dct->window, window, 2 * dct->size * sizeof (*(dct->window)));
+    return 0;
+}
+
+/******************************************
+ * DCT-II and DCT-III
+ ******************************************/
+static int atfft_dct_rearranged_index (int i, int size)
+{
+    /* Even samples first, then the odd samples in reverse. */
+    return i < (size + 1) / 2 ? 2 * i : 2 * (size - i) - 1;
+}
+
+static void atfft_dct_rearrange_forward (const atfft_sample *in, atfft_sample *out, int size)
+{
+    int half = (size + 1) / 2;
+
+    for (int i = 0; i < half; ++i)
+    {
+        out [i] = in [2 * i];
+    }
+
+    for (int i = half; i < size; ++i)
+    {
+        out [i] = in [2 * (size - i) - 1];
+    }
+}
+
+static void atfft_dct_scale_forward (struct atfft_dct_generic *dct, atfft_sample *out)
+{
+    int size = dct->size;
+    int n_bins = atfft_halfcomplex_size (size);
+
+    out [0] = ATFFT_RE (dct->spectrum [0]);
+
+    /* Bins k and N - k both come from the kth bin of the halfcomplex
+     * spectrum as X[N - k] = conj (X[k]). */
+    for (int k = 1; k < n_bins; ++k)
+    {
+        atfft_sample re = ATFFT_RE (dct->spectrum [k]);
+        atfft_sample im = ATFFT_IM (dct->spectrum [k]);
+
+        out [k] = re * dct->cosins [k] + im * dct->sins [k];
+
+        if (k != size - k)
+            out [size - k] = re * dct->sins [k] - im * dct->cosins [k];
+    }
+}
+
+static void atfft_dct_ii_packed_transform (struct atfft_dct_generic *dct, const atfft_sample *in, atfft_sample *out)
+{
+    int size = dct->size;
+    int half = size / 2;
+
+    /* Pack the rearranged signal v into z[m] = v[2m] + j v[2m + 1]. */
+    for (int m = 0; m < half; ++m)
+    {
+        ATFFT_RE (dct->dft_in [m]) = in [atfft_dct_rearranged_index (2 * m, size)];
+        ATFFT_IM (dct->dft_in [m]) = in [atfft_dct_rearranged_index (2 * m + 1, size)];
+    }
+
+    atfft_dft_complex_transform (dct->dft, dct->dft_in, dct->spectrum);
+
+    /* Split Z into the spectra of the even and odd samples of v,
+     * 2E[k] = Z[k] + conj (Z[N/2 - k]) and
+     * 2O[k] = -j (Z[k] - conj (Z[N/2 - k])),
+     * combine them into the kth bin of v's real DFT,
+     * 2V[k] = 2E[k] + W^k 2O[k], and rotate that into
+     * DCT bins k and N - k as atfft_dct_scale_forward () does. */
+    for (int k = 0; k <= half; ++k)
+    {
+        atfft_sample *z = dct->spectrum [k == half ? 0 : k];
+        atfft_sample *zc = dct->spectrum [k == 0 ? 0 : half - k];
+        atfft_sample *t = dct->post_twiddles [k];
+
+        atfft_sample e_re = ATFFT_RE (z) + ATFFT_RE (zc);
+        atfft_sample e_im = ATFFT_IM (z) - ATFFT_IM (zc);
+        atfft_sample o_re = ATFFT_IM (z) + ATFFT_IM (zc);
+        atfft_sample o_im = ATFFT_RE (zc) - ATFFT_RE (z);
+
+        atfft_sample re = e_re + o_re * ATFFT_RE (t) - o_im * ATFFT_IM (t);
+        atfft_sample im = e_im + o_re * ATFFT_IM (t) + o_im * ATFFT_RE (t);
+
+        out [k] = re * dct->cosins [k] + im * dct->sins [k];
+
+        if (k != 0 && k != half)
+            out [size - k] = re * dct->sins [k] - im * dct->cosins [k];
+    }
+}
+
+static void atfft_dct_ii_transform (struct atfft_dct_generic *dct, const atfft_sample *in, atfft_sample *out)
+{
+    if (dct->dft_in)
+    {
+        atfft_dct_ii_packed_transform (dct, in, out);
+        return;
+    }
+
+    atfft_dct_rearrange_forward (in, dct->signal, dct->size);
+    atfft_dft_real_forward_transform (dct->dft, dct->signal, dct->spectrum);
+    atfft_dct_scale_forward (dct, out);
+}
+
+static void atfft_dct_scale_backward (struct atfft_dct_generic *dct, const atfft_sample *in)
+{
+    int size = dct->size;
+    int n_bins = atfft_halfcomplex_size (size);
+
+    ATFFT_RE (dct->spectrum [0]) = in [0] * dct->cosins [0];
+    ATFFT_IM (dct->spectrum [0]) = 0.0;
+
+    /* Only the halfcomplex part of the spectrum is needed
+     * as the rearranged signal is real. */
+    for (int k = 1; k < n_bins; ++k)
+    {
+        atfft_sample a = in [k];
+        atfft_sample b = in [size - k];
+
+        ATFFT_RE (dct->spectrum [k]) = a * dct->cosins [k] + b * dct->sins [k];
+        ATFFT_IM (dct->spectrum [k]) = a * dct->sins [k] - b * dct->cosins [k];
+    }
+}
+
+static void atfft_dct_rearrange_backward (const atfft_sample *in, atfft_sample *out, int size)
+{
+    int half = (size + 1) / 2;
+
+    for (int i = 0; i < half; ++i)
+    {
+        out [2 * i] = in [i];
+    }
+
+    for (int i = half; i < size; ++i)
+    {
+        out [2 * (size - i) - 1] = in [i];
+    }
+}
+
+static void atfft_dct_scaled_bin (struct atfft_dct_generic *dct, const atfft_sample *in, int k, atfft_complex x)
+{
+    atfft_sample a = in [k];
+    atfft_sample b = k == 0 ? 0.0 : in [dct->size - k];
+
+    ATFFT_RE (x) = a * dct->cosins [k] + b * dct->sins [k];
+    ATFFT_IM (x) = a * dct->sins [k] - b * dct->cosins [k];
+}
+
+static void atfft_dct_pack_bin (struct atfft_dct_generic *dct, atfft_complex v, atfft_complex vc, int k)
+{
+    atfft_sample *t = dct->post_twiddles [k];
+    atfft_sample d_re = ATFFT_RE (v) - ATFFT_RE (vc);
+    atfft_sample d_im = ATFFT_IM (v) + ATFFT_IM (vc);
+
+    ATFFT_RE (dct->dft_in [k]) = ATFFT_RE (v) + ATFFT_RE (vc)
+                                 - d_re * ATFFT_IM (t) - d_im * ATFFT_RE (t);
+    ATFFT_IM (dct->dft_in [k]) = ATFFT_IM (v) - ATFFT_IM (vc)
+                                 + d_re * ATFFT_RE (t) - d_im * ATFFT_IM (t);
+}
+
+static void atfft_dct_iii_packed_transform (struct atfft_dct_generic *dct, const atfft_sample *in, atfft_sample *out)
+{
+    int size = dct->size;
+    int half = size / 2;
+
+    /* Rotate the input into bins k and N/2 - k of the rearranged
+     * signal's spectrum V, as atfft_dct_scale_backward () does, and
+     * combine them into the spectrum of the packed signal,
+     * Z[k] = (V[k] + conj (V[N/2 - k])) + j W^-k (V[k] - conj (V[N/2 - k])).
+     * Both Z[k] and Z[N/2 - k] come from the same pair of bins. */
+    for (int k = 0; k <= half / 2; ++k)
+    {
+        atfft_complex v, vc;
+
+        atfft_dct_scaled_bin (dct, in, k, v);
+        atfft_dct_scaled_bin (dct, in, half - k, vc);
+
+        atfft_dct_pack_bin (dct, v, vc, k);
+
+        if (k != 0 && k != half - k)
+            atfft_dct_pack_bin (dct, vc, v, half - k);
+    }
+
+    atfft_dft_complex_transform (dct->dft, dct->dft_in, dct->spectrum);
+
+    /* Unpack z[m] = v[2m] + j v[2m + 1] and undo the rearrangement. */
+    for (int m = 0; m < half; ++m)
+    {
+        out [atfft_dct_rearranged_index (2 * m, size)] = ATFFT_RE (dct->spectrum [m]);
+        out [atfft_dct_rearranged_index (2 * m + 1, size)] = ATFFT_IM (dct->spectrum [m]);
+    }
+}
+
+static void atfft_dct_iii_transform (struct atfft_dct_generic *dct, const atfft_sample *in, atfft_sample *out)
+{
+    if (dct->dft_in)
+    {
+        atfft_dct_iii_packed_transform (dct, in, out);
+        return;
+    }
+
+    atfft_dct_scale_backward (dct, in);
+    atfft_dft_real_backward_transform (dct->dft, dct->spectrum, dct->signal);
+    atfft_dct_rearrange_backward (dct->signal, out, dct->size);
+}
+
+/******************************************
+ * DCT-IV
+ ******************************************/
+static void atfft_dct_iv_even_transform (struct atfft_dct_generic *dct, const atfft_sample *in, atfft_sample *out)
+{
+    int size = dct->size;
+    int half = size / 2;
+
+    for (int i = 0; i < half; ++i)
+    {
+        atfft_sample a = in [2 * i];
+        atfft_sample b = in [size - 1 - 2 * i];
+        atfft_sample *t = dct->pre_twiddles [i];
+
+        /* (a + jb) * t */
+        ATFFT_RE (dct->dft_in [i]) = a * ATFFT_RE (t) - b * ATFFT_IM (t);
+        ATFFT_IM (dct->dft_in [i]) = a * ATFFT_IM (t) + b * ATFFT_RE (t);
+    }
+
+    atfft_dft_complex_transform (dct->dft, dct->dft_in, dct->spectrum);
+
+    for (int i = 0; i < half; ++i)
+    {
+        atfft_sample *x = dct->spectrum [i];
+        atfft_sample *t = dct->post_twiddles [i];
+
+        out [2 * i] = ATFFT_RE (x) * ATFFT_RE (t) - ATFFT_IM (x) * ATFFT_IM (t);
+        out [size - 1 - 2 * i] = - (ATFFT_RE (x) * ATFFT_IM (t) + ATFFT_IM (x) * ATFFT_RE (t));
+    }
+}
+
+static void atfft_dct_iv_odd_transform (struct atfft_dct_generic *dct, const atfft_sample *in, atfft_sample *out)
+{
+    int size = dct->size;
+
+    /* dft_in was zero padded on creation, only the first half is written. */
+    for (int i = 0; i < size; ++i)
+    {
+        ATFFT_RE (dct->dft_in [i]) = in [i] * ATFFT_RE (dct->pre_twiddles [i]);
+        ATFFT_IM (dct->dft_in [i]) = in [i] * ATFFT_IM (dct->pre_twiddles [i]);
+    }
+
+    atfft_dft_complex_transform (dct->dft, dct->dft_in, dct->spectrum);
+
+    for (int i = 0; i < size; ++i)
+    {
+        atfft_sample *x = dct->spectrum [i];
+        atfft_sample *t = dct->post_twiddles [i];
+
+        out [i] = ATFFT_RE (x) * ATFFT_RE (t) - ATFFT_IM (x) * ATFFT_IM (t);
+    }
+}
+
+static void atfft_dct_iv_transform (struct atfft_dct_generic *dct, const atfft_sample *in, atfft_sample *out)
+{
+    if (atfft_is_even (dct->size))
+        atfft_dct_iv_even_transform (dct, in, out);
+    else
+        atfft_dct_iv_odd_transform (dct, in, out);
+}
+
+/******************************************
+ * DCT-I and DST-I
+ ******************************************/
+static void atfft_dct_i_transform (struct atfft_dct_generic *dct, const atfft_sample *in, atfft_sample *out)
+{
+    int size = dct->size;
+    int extended_size = 2 * (size - 1);
+
+    /* even extension: x0, x1, ..., x(N-1), x(N-2), ..., x1 */
+    memcpy (dct->signal, in, size * sizeof (*(dct->signal)));
+
+    for (int i = 1; i < size - 1; ++i)
+    {
+        dct->signal [extended_size - i] = in [i];
+    }
+
+    atfft_dft_real_forward_transform (dct->dft, dct->signal, dct->spectrum);
+
+    for (int k = 0; k < size; ++k)
+    {
+        out [k] = 0.5 * ATFFT_RE (dct->spectrum [k]);
+    }
+}
+
+static void atfft_dst_i_transform (struct atfft_dct_generic *dct, const atfft_sample *in, atfft_sample *out)
+{
+    int size = dct->size;
+    int extended_size = 2 * (size + 1);
+
+    /* odd extension: 0, x0, ..., x(N-1), 0, -x(N-1), ..., -x0 */
+    dct->signal [0] = 0.0;
+    dct->signal [size + 1] = 0.0;
+
+    for (int i = 0; i < size; ++i)
+    {
+        dct->signal [i + 1] = in [i];
+        dct->signal [extended_size - 1 - i] = -in [i];
+    }
+
+    atfft_dft_real_forward_transform (dct->dft, dct->signal, dct->spectrum);
+
+    for (int k = 0; k < size; ++k)
+    {
+        out [k] = -0.5 * ATFFT_IM (dct->spectrum [k + 1]);
+    }
+}
+
+/******************************************
+ * Sine transforms
+ ******************************************/
+static void atfft_dct_reverse (const atfft_sample *in, atfft_sample *out, int size)
+{
+    for (int i = 0; i < size; ++i)
+    {
+        out [i] = in [size - 1 - i];
+    }
+}
+
+static void atfft_dct_reverse_in_place (atfft_sample *data, int size)
+{
+    for (int i = 0, j = size - 1; i < j; ++i, --j)
+    {
+        atfft_sample temp = data [i];
+        data [i] = data [j];
+        data [j] = temp;
+    }
+}
+
+static void atfft_dct_negate_odd (atfft_sample *data, int size)
+{
+    for (int i = 1; i < size; i += 2)
+    {
+        data [i] = -data [i];
+    }
+}
+
+static void atfft_dst_ii_transform (struct atfft_dct_generic *dct, const atfft_sample *in, atfft_sample *out)
+{
+    /* DST-II(x)[k] = DCT-II((-1)^n x[n])[N - 1 - k] */
+    memcpy (dct->scratch, in, dct->size * sizeof (*(dct->scratch)));
+    atfft_dct_negate_odd (dct->scratch, dct->size);
+    atfft_dct_ii_transform (dct, dct->scratch, out);
+    atfft_dct_reverse_in_place (out, dct->size);
+}
+
+static void atfft_dst_iii_transform (struct atfft_dct_generic *dct, const atfft_sample *in, atfft_sample *out)
+{
+    /* DST-III(x)[k] = (-1)^k DCT-III(x[N - 1 - n])[k] */
+    atfft_dct_reverse (in, dct->scratch, dct->size);
+    atfft_dct_iii_transform (dct, dct->scratch, out);
+    atfft_dct_negate_odd (out, dct->size);
+}
+
+static void atfft_dst_iv_transform (struct atfft_dct_generic *dct, const atfft_sample *in, atfft_sample *out)
+{
+    /* DST-IV(x)[k] = (-1)^k DCT-IV(x[N - 1 - n])[k] */
+    atfft_dct_reverse (in, dct->scratch, dct->size);
+    atfft_dct_iv_transform (dct, dct->scratch, out);
+    atfft_dct_negate_odd (out, dct->size);
+}
+
+/******************************************
+ * MDCT and IMDCT
+ ******************************************/
+static atfft_sample atfft_dct_windowed (const struct atfft_dct_generic *dct, const atfft_sample *in, int i)
+{
+    return dct->window ? dct->window [i] * in [i] : in [i];
+}
+
+static void atfft_mdct_transform (struct atfft_dct_generic *dct, const atfft_sample *in, atfft_sample *out)
+{
+    int size = dct->size;
+    int half = size / 2;
+
+    /* Split the 2N input into quarters (a, b, c, d) and fold
+     * them into N samples (-c_r - d, a - b_r), where _r denotes
+     * reversal. The MDCT is the DCT-IV of the folded signal. */
+    for (int i = 0; i < half; ++i)
+    {
+        dct->scratch [i] = - atfft_dct_windowed (dct, in, 3 * half - 1 - i)
+                           - atfft_dct_windowed (dct, in, 3 * half + i);
+        dct->scratch [half + i] = atfft_dct_windowed (dct, in, i)
+                                  - atfft_dct_windowed (dct, in, size - 1 - i);
+    }
+
+    atfft_dct_iv_transform (dct, dct->scratch, out);
+}
+
+static void atfft_imdct_transform (struct atfft_dct_generic *dct, const atfft_sample *in, atfft_sample *out)
+{
+    int size = dct->size;
+    int half = size / 2;
+
+    atfft_dct_iv_transform (dct, in, dct->scratch);
+
+    /* Unfold the DCT-IV output (p, q) into 2N samples (q, -q_r, -p_r, -p). */
+    for (int i = 0; i < half; ++i)
+    {
+        atfft_sample p = dct->scratch [i];
+        atfft_sample q = dct->scratch [half + i];
+
+        out [i] = q;
+        out [size - 1 - i] = -q;
+        out [3 * half - 1 - i] = -p;
+        out [3 * half + i] = -p;
+    }
+
+    if (dct->window)
+    {
+        for (int i = 0; i < 2 * size; ++i)
+        {
+            out [i] *= dct->window [i];
+        }
+    }
+}
+
+/******************************************
+ * Apply Transform
+ ******************************************/
+void atfft_dct_generic_transform (struct atfft_dct_generic *dct, const atfft_sample *in, atfft_sample *out)
+{
+    switch (dct->type)
+    {
+        case ATFFT_DCT_I:
+            atfft_dct_i_transform (dct, in, out);
+            break;
+        case ATFFT_DCT_II:
+            atfft_dct_ii_transform (dct, in, out);
+            break;
+        case ATFFT_DCT_III:
+            atfft_dct_iii_transform (dct, in, out);
+            break;
+        case ATFFT_DCT_IV:
+            atfft_dct_iv_transform (dct, in, out);
+            break;
+        case ATFFT_DST_I:
+            atfft_dst_i_transform (dct, in, out);
+            break;
+        case ATFFT_DST_II:
+            atfft_dst_ii_transform (dct, in, out);
+            break;
+        case ATFFT_DST_III:
+            atfft_dst_iii_transform (dct, in, out);
+            break;
+        case ATFFT_DST_IV:
+            atfft_dst_iv_transform (dct, in, out);
+            break;
+        case ATFFT_MDCT:
+            atfft_mdct_transform (dct, in, out);
+            break;
+        case ATFFT_IMDCT:
+            atfft_imdct_transform (dct, in, out);
+            break;
+    }
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Cosine and sine transforms of every type built from the 1-D transforms in
+ * atfft/dft.h, see dct_generic.c for how each type is computed.
+ *
+ * This is the DCT implementation for the native transforms, and the fallback
+ * for libraries which only wrap some transform types or sizes.
+ */
+
+#ifndef ATFFT_DCT_GENERIC_H_INCLUDED
+#define ATFFT_DCT_GENERIC_H_INCLUDED
+
+#include <atfft/dct.h>
+
+struct atfft_dct_generic;
+
+int atfft_dct_generic_is_supported_type (int size, enum atfft_dct_type type);
+
+struct atfft_dct_generic* atfft_dct_generic_create (int size, enum atfft_dct_type type);
+
+void atfft_dct_generic_destroy (struct atfft_dct_generic *dct);
+
+void atfft_dct_generic_transform (struct atfft_dct_generic *dct, const atfft_sample *in, atfft_sample *out);
+
+int atfft_dct_generic_set_window (struct atfft_dct_generic *dct, const atfft_sample *window);
+
+#endif /* ATFFT_DCT_GENERIC_H_INCLUDED */
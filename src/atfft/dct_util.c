@@ -26,3 +26,31 @@ void atfft_normalise_dct (atfft_sample *data, int size)
 {
     atfft_scale_real (data, size, 2.0 / size);
 }
+
+void atfft_normalise_dct_type (atfft_sample *data, int size, enum atfft_dct_type type)
+{
+    switch (type)
+    {
+        case ATFFT_DCT_I:
+            atfft_scale_real (data, size, 2.0 / (size - 1));
+            break;
+
+        case ATFFT_DST_I:
+            atfft_scale_real (data, size, 2.0 / (size + 1));
+            break;
+
+        case ATFFT_IMDCT:
+            atfft_scale_real (data, 2 * size, 2.0 / size);
+            break;
+
+        default:
+            atfft_normalise_dct (data, size);
+    }
+}
+
+void atfft_normalise_dct2d (atfft_sample *data, int block_size, int n_blocks)
+{
+    int block_length = block_size * block_size;
+
+    atfft_scale_real (data, n_blocks * block_length, 4.0 / block_length);
+}
@@ -20,12 +20,17 @@
  * SOFTWARE.
  */
 
+#define ATFFT_DFT_BACKEND native
+#include "dft_backend_internal.h"
+
 #include <stdlib.h>
 #include <assert.h>
 #include <math.h>
 #include <limits.h>
+#include <time.h>
 #include <atfft/dft.h>
 #include <atfft/dft_util.h>
+#include <atfft/dft_planner.h>
 #include "atfft_internal.h"
 #include "dft_cooley_tukey.h"
 #include "dft_rader.h"
@@ -37,6 +42,13 @@
 #define ATFFT_PRIME_TRANSFORM_THRESHOLD 7
 #endif /* ATFFT_PRIME_TRANSFORM_THRESHOLD */
 
+/* When the planning effort is ATFFT_MEASURE or above, prime sizes time
+ * Rader's and Bluestein's algorithms over batches of transforms lasting at
+ * least ATFFT_DFT_MEASURE_TIME. The batches stop growing at
+ * ATFFT_DFT_MEASURE_MAX_TRANSFORMS in case the clock doesn't advance. */
+#define ATFFT_DFT_MEASURE_TIME (CLOCKS_PER_SEC / 500)
+#define ATFFT_DFT_MEASURE_MAX_TRANSFORMS (1L << 24)
+
 static void atfft_init_even_real_sinusoids (atfft_complex *sinusoids,
                                             int sinusoids_size,
                                             int dft_size,
@@ -67,13 +79,111 @@ struct atfft_dft
     int is_even_real;
     atfft_complex *real_in, *real_out;
     atfft_complex *sinusoids;
+
+    /* leading non-zero inputs and range of required outputs */
+    int n_inputs;
+    int first_output;
+    int n_outputs;
 };
 
+int atfft_dft_is_supported_size (int size, enum atfft_format format)
+{
+    return size > 0;
+}
+
+static void atfft_even_real_output_range (int first_output,
+                                          int n_outputs,
+                                          int internal_size,
+                                          int *internal_first,
+                                          int *internal_n)
+{
+    /* Bin k of an even length real transform is calculated from
+     * bins k and (N/2 - k) of the internal complex transform. Fold
+     * the required bins onto the range [0, N/4], then take the shorter
+     * of the two internal ranges containing both halves, either the
+     * one around DC or the one around Nyquist. */
+    int last_output = first_output + n_outputs - 1;
+    int low = internal_size - last_output;
+    int high = internal_size - first_output;
+
+    if (first_output < low)
+        low = first_output;
+
+    if (last_output < high)
+        high = last_output;
+
+    if (internal_size / 2 < high)
+        high = internal_size / 2;
+
+    int dc_n = 2 * high + 1;
+    int nyquist_n = internal_size - 2 * low + 1;
+
+    if (dc_n >= internal_size && nyquist_n >= internal_size)
+    {
+        *internal_first = 0;
+        *internal_n = internal_size;
+    }
+    else if (dc_n < nyquist_n)
+    {
+        *internal_first = (internal_size - high) % internal_size;
+        *internal_n = dc_n;
+    }
+    else
+    {
+        *internal_first = low;
+        *internal_n = nyquist_n;
+    }
+}
+
+/* The pruning parameters of an unpruned plan. */
+static void atfft_dft_full_range (int size,
+                                  enum atfft_direction direction,
+                                  enum atfft_format format,
+                                  int *n_inputs,
+                                  int *n_outputs)
+{
+    *n_inputs = size;
+    *n_outputs = size;
+
+    if (format == ATFFT_REAL)
+    {
+        if (direction == ATFFT_FORWARD)
+            *n_outputs = atfft_halfcomplex_size (size);
+        else
+            *n_inputs = atfft_halfcomplex_size (size);
+    }
+}
+
+/* The size of the complex transform used internally. */
+static int atfft_dft_internal_size (int size, enum atfft_format format)
+{
+    return format == ATFFT_REAL && atfft_is_even (size) ? size / 2 : size;
+}
+
 struct atfft_dft* atfft_dft_create (int size, enum atfft_direction direction, enum atfft_format format)
+{
+    int n_inputs, n_outputs;
+
+    atfft_dft_full_range (size, direction, format, &n_inputs, &n_outputs);
+    return atfft_dft_create_pruned (size, direction, format, n_inputs, 0, n_outputs);
+}
+
+/* Create a plan whose internal complex transform uses the given algorithm,
+ * ATFFT_BASE chooses one based on the size. */
+static struct atfft_dft* atfft_dft_create_with_algorithm (int size,
+                                                          enum atfft_direction direction,
+                                                          enum atfft_format format,
+                                                          int n_inputs,
+                                                          int first_output,
+                                                          int n_outputs,
+                                                          enum atfft_dft_algorithm algorithm)
 {
     struct atfft_dft *fft;
     int sinusoids_size = 0;
 
+    if (!atfft_dft_is_valid_pruning (size, direction, format, n_inputs, first_output, n_outputs))
+        return NULL;
+
     if (!(fft = calloc (1, sizeof (*fft))))
         return NULL;
 
@@ -82,16 +192,31 @@ struct atfft_dft* atfft_dft_create (int size, enum atfft_direction direction, en
     fft->internal_dft_size = size;
     fft->direction = direction;
     fft->format = format;
+    fft->n_inputs = n_inputs;
+    fft->first_output = first_output;
+    fft->n_outputs = n_outputs;
+
+    /* pruning of the internal complex transform */
+    int internal_n_inputs = n_inputs;
+    int internal_first_output = first_output;
+    int internal_n_outputs = n_outputs;
 
     if (format == ATFFT_REAL)
     {
         /* Even length real transforms can be computed as a complex
          * transform of half the length. */
-        if (atfft_is_even(size) && direction == ATFFT_FORWARD)
+        if (atfft_is_even(size))
         {
             fft->is_even_real = 1;
             fft->internal_dft_size = size / 2;
             sinusoids_size = fft->internal_dft_size - 1;
+
+            internal_n_inputs = (n_inputs + 1) / 2;
+            atfft_even_real_output_range (first_output,
+                                          n_outputs,
+                                          fft->internal_dft_size,
+                                          &internal_first_output,
+                                          &internal_n_outputs);
         }
         else
         {
@@ -111,28 +236,63 @@ struct atfft_dft* atfft_dft_create (int size, enum atfft_direction direction, en
                                         direction);
     }
 
-    if (fft->internal_dft_size > ATFFT_PRIME_TRANSFORM_THRESHOLD &&
-        atfft_is_prime (fft->internal_dft_size))
+    /* The real backward transform mixes its inputs before the
+     * internal transform so can't be pruned. */
+    if (format == ATFFT_REAL && direction == ATFFT_BACKWARD)
     {
-        if (atfft_dft_ct_is_fast_size (fft->internal_dft_size - 1))
+        fft->n_inputs = fft->n_outputs = size;
+        fft->first_output = 0;
+        internal_n_inputs = internal_n_outputs = fft->internal_dft_size;
+        internal_first_output = 0;
+    }
+
+    if (algorithm == ATFFT_BASE)
+    {
+        if (fft->internal_dft_size > ATFFT_PRIME_TRANSFORM_THRESHOLD &&
+            atfft_is_prime (fft->internal_dft_size))
         {
-            /* Use Rader's algorithm */
-            fft->fft = atfft_dft_rader_create (fft->internal_dft_size, direction, ATFFT_COMPLEX);
-            fft->complex_transform = atfft_dft_rader_complex_transform;
-            fft->fft_destroy = atfft_dft_rader_destroy;
+            if (atfft_dft_ct_is_fast_size (fft->internal_dft_size - 1))
+                algorithm = ATFFT_RADER;
+            else
+                algorithm = ATFFT_BLUESTEIN;
         }
         else
         {
-            /* Use Bluestein's algorithm */
-            fft->fft = atfft_dft_bluestein_create (fft->internal_dft_size, direction, ATFFT_COMPLEX);
-            fft->complex_transform = atfft_dft_bluestein_complex_transform;
-            fft->fft_destroy = atfft_dft_bluestein_destroy;
+            algorithm = ATFFT_COOLEY_TUKEY;
         }
     }
+
+    if (algorithm != ATFFT_COOLEY_TUKEY)
+    {
+        /* Only Cooley-Tukey transforms are pruned. */
+        fft->n_inputs = size;
+        fft->first_output = 0;
+        fft->n_outputs = format == ATFFT_REAL && direction == ATFFT_FORWARD ? atfft_halfcomplex_size (size) : size;
+    }
+
+    if (algorithm == ATFFT_RADER)
+    {
+        /* Use Rader's algorithm */
+        fft->fft = atfft_dft_rader_create (fft->internal_dft_size, direction, ATFFT_COMPLEX);
+        fft->complex_transform = atfft_dft_rader_complex_transform;
+        fft->fft_destroy = atfft_dft_rader_destroy;
+    }
+    else if (algorithm == ATFFT_BLUESTEIN)
+    {
+        /* Use Bluestein's algorithm */
+        fft->fft = atfft_dft_bluestein_create (fft->internal_dft_size, direction, ATFFT_COMPLEX);
+        fft->complex_transform = atfft_dft_bluestein_complex_transform;
+        fft->fft_destroy = atfft_dft_bluestein_destroy;
+    }
     else
     {
         /* Use Cooley-Tukey */
-        fft->fft = atfft_dft_ct_create (fft->internal_dft_size, direction, ATFFT_COMPLEX, ATFFT_DFT_CT_ITERATIVE);
+        fft->fft = atfft_dft_ct_create_pruned (fft->internal_dft_size,
+                                               direction,
+                                               ATFFT_COMPLEX,
+                                               internal_n_inputs,
+                                               internal_first_output,
+                                               internal_n_outputs);
         fft->complex_transform = atfft_dft_ct_complex_transform;
         fft->fft_destroy = atfft_dft_ct_destroy;
     }
@@ -147,6 +307,117 @@ failed:
     return NULL;
 }
 
+static void atfft_dft_run (struct atfft_dft *fft, atfft_complex *in, atfft_complex *out)
+{
+    if (fft->format == ATFFT_COMPLEX)
+        atfft_dft_complex_transform (fft, in, out);
+    else if (fft->direction == ATFFT_FORWARD)
+        atfft_dft_real_forward_transform (fft, (atfft_sample*) in, out);
+    else
+        atfft_dft_real_backward_transform (fft, in, (atfft_sample*) out);
+}
+
+/* The time taken per transform by a plan. */
+static double atfft_dft_time (struct atfft_dft *fft, atfft_complex *in, atfft_complex *out)
+{
+    long n_transforms = 1;
+
+    while (1)
+    {
+        clock_t start = clock();
+
+        for (long i = 0; i < n_transforms; ++i)
+            atfft_dft_run (fft, in, out);
+
+        clock_t elapsed = clock() - start;
+
+        if (elapsed >= ATFFT_DFT_MEASURE_TIME || n_transforms >= ATFFT_DFT_MEASURE_MAX_TRANSFORMS)
+            return (double) elapsed / n_transforms;
+
+        n_transforms *= 2;
+    }
+}
+
+/* Create plans with Rader's and Bluestein's algorithms and keep the faster. */
+static struct atfft_dft* atfft_dft_create_measured (int size,
+                                                    enum atfft_direction direction,
+                                                    enum atfft_format format,
+                                                    int n_inputs,
+                                                    int first_output,
+                                                    int n_outputs)
+{
+    struct atfft_dft *rader, *bluestein;
+    atfft_complex *in, *out;
+
+    rader = atfft_dft_create_with_algorithm (size,
+                                             direction,
+                                             format,
+                                             n_inputs,
+                                             first_output,
+                                             n_outputs,
+                                             ATFFT_RADER);
+    bluestein = atfft_dft_create_with_algorithm (size,
+                                                 direction,
+                                                 format,
+                                                 n_inputs,
+                                                 first_output,
+                                                 n_outputs,
+                                                 ATFFT_BLUESTEIN);
+    in = calloc (size, sizeof (*in));
+    out = calloc (size, sizeof (*out));
+
+    /* Without all of them there is nothing to measure. */
+    if (rader && bluestein && in && out)
+    {
+        if (atfft_dft_time (rader, in, out) <= atfft_dft_time (bluestein, in, out))
+        {
+            atfft_dft_destroy (bluestein);
+            bluestein = NULL;
+        }
+        else
+        {
+            atfft_dft_destroy (rader);
+            rader = NULL;
+        }
+    }
+    else if (rader && bluestein)
+    {
+        atfft_dft_destroy (bluestein);
+        bluestein = NULL;
+    }
+
+    free (out);
+    free (in);
+    return rader ? rader : bluestein;
+}
+
+struct atfft_dft* atfft_dft_create_pruned (int size,
+                                           enum atfft_direction direction,
+                                           enum atfft_format format,
+                                           int n_inputs,
+                                           int first_output,
+                                           int n_outputs)
+{
+    int internal_size = atfft_dft_internal_size (size, format);
+
+    /* Measure the choice between prime size algorithms if asked to. */
+    if (atfft_dft_get_planning_effort() != ATFFT_ESTIMATE &&
+        internal_size > ATFFT_PRIME_TRANSFORM_THRESHOLD &&
+        atfft_is_prime (internal_size) &&
+        atfft_dft_is_valid_pruning (size, direction, format, n_inputs, first_output, n_outputs))
+    {
+        return atfft_dft_create_measured (size, direction, format, n_inputs, first_output, n_outputs);
+    }
+
+    return atfft_dft_create_with_algorithm (size,
+                                            direction,
+                                            format,
+                                            n_inputs,
+                                            first_output,
+                                            n_outputs,
+                                            ATFFT_BASE);
+}
+
 void atfft_dft_destroy (struct atfft_dft *fft)
 {
     if (fft)
@@ -184,17 +455,34 @@ static void atfft_dft_even_real_forward_transform (struct atfft_dft *fft,
                                                    atfft_complex *out,
                                                    int out_stride)
 {
-    for (int i = 0; i < fft->size / 2; ++i)
+    int n_pairs = fft->n_inputs / 2;
+    int first = fft->first_output > 1 ? fft->first_output : 1;
+    int end = fft->first_output + fft->n_outputs;
+
+    for (int i = 0; i < n_pairs; ++i)
     {
         ATFFT_RE (fft->real_in [i]) = in [2 * i * in_stride];
         ATFFT_IM (fft->real_in [i]) = in [(2 * i + 1) * in_stride];
     }
 
+    if (atfft_is_odd (fft->n_inputs))
+    {
+        ATFFT_RE (fft->real_in [n_pairs]) = in [2 * n_pairs * in_stride];
+        ATFFT_IM (fft->real_in [n_pairs]) = 0.0;
+    }
+
     fft->complex_transform (fft->fft, fft->real_in, 1, fft->real_out, 1);
 
-    ATFFT_RE (out [0]) = ATFFT_RE (fft->real_out [0]) + ATFFT_IM (fft->real_out [0]);
+    if (fft->first_output == 0)
+    {
+        ATFFT_RE (out [0]) = ATFFT_RE (fft->real_out [0]) + ATFFT_IM (fft->real_out [0]);
+        ATFFT_IM (out [0]) = 0.0;
+    }
+
+    if (end > fft->internal_dft_size)
+        end = fft->internal_dft_size;
 
-    for (int i = 1; i < fft->internal_dft_size; ++i)
+    for (int i = first; i < end; ++i)
     {
         atfft_complex E, O;
 
@@ -209,10 +497,14 @@ static void atfft_dft_even_real_forward_transform (struct atfft_dft *fft,
                         ATFFT_RE (fft->real_out [i])) / 2;
 
         atfft_multiply_by_complex (&O, fft->sinusoids [i - 1]);
-        atfft_sum_complex (E, O, out + i);
+        atfft_sum_complex (E, O, out + i * out_stride);
     }
 
-    ATFFT_RE (out [fft->size / 2]) = ATFFT_RE (fft->real_out [0]) - ATFFT_IM (fft->real_out [0]);
+    if (fft->first_output + fft->n_outputs > fft->internal_dft_size)
+    {
+        ATFFT_RE (out [fft->internal_dft_size * out_stride]) = ATFFT_RE (fft->real_out [0]) - ATFFT_IM (fft->real_out [0]);
+        ATFFT_IM (out [fft->internal_dft_size * out_stride]) = 0.0;
+    }
 }
 
 static void atfft_dft_trivial_real_forward_transform (struct atfft_dft *fft,
@@ -221,7 +513,7 @@ static void atfft_dft_trivial_real_forward_transform (struct atfft_dft *fft,
                                                       atfft_complex *out,
                                                       int out_stride)
 {
-    atfft_real_to_complex_stride (in, in_stride, fft->real_in, 1, fft->size);
+    atfft_real_to_complex_stride (in, in_stride, fft->real_in, 1, fft->n_inputs);
     fft->complex_transform (fft->fft, fft->real_in, 1, fft->real_out, 1);
     atfft_complex_to_halfcomplex_stride (fft->real_out, 1, out, out_stride, fft->size);
 }
@@ -259,14 +551,77 @@ void atfft_dft_real_forward_transform_stride (struct atfft_dft *fft,
     atfft_perform_real_forward_dft (fft, in, in_stride, out, out_stride);
 }
 
+static void atfft_dft_even_real_backward_transform (struct atfft_dft *fft,
+                                                    atfft_complex *in,
+                                                    int in_stride,
+                                                    atfft_sample *out,
+                                                    int out_stride)
+{
+    int n = fft->internal_dft_size;
+
+    /* Combine the spectra of the even and odd samples into a single
+     * half length spectrum:
+     *
+     *     Z[k] = (X[k] + X[k + N/2]) + j(X[k] - X[k + N/2])e^(2*pi*j*k/N)
+     *
+     * The inverse of Z has the even samples in its real part and
+     * the odd samples in its imaginary part. */
+    ATFFT_RE (fft->real_in [0]) = ATFFT_RE (in [0]) + ATFFT_RE (in [n * in_stride]);
+    ATFFT_IM (fft->real_in [0]) = ATFFT_RE (in [0]) - ATFFT_RE (in [n * in_stride]);
+
+    for (int i = 1; i < n; ++i)
+    {
+        atfft_complex E, O;
+
+        /* X[k + N/2] = conj (X[N/2 - k]) */
+        ATFFT_RE (E) = ATFFT_RE (in [i * in_stride]) + ATFFT_RE (in [(n - i) * in_stride]);
+        ATFFT_IM (E) = ATFFT_IM (in [i * in_stride]) - ATFFT_IM (in [(n - i) * in_stride]);
+
+        ATFFT_RE (O) = ATFFT_RE (in [i * in_stride]) - ATFFT_RE (in [(n - i) * in_stride]);
+        ATFFT_IM (O) = ATFFT_IM (in [i * in_stride]) + ATFFT_IM (in [(n - i) * in_stride]);
+
+        atfft_multiply_by_complex (&O, fft->sinusoids [i - 1]);
+        atfft_sum_a_jb_complex (E, O, fft->real_in + i);
+    }
+
+    fft->complex_transform (fft->fft, fft->real_in, 1, fft->real_out, 1);
+
+    for (int i = 0; i < n; ++i)
+    {
+        out [2 * i * out_stride] = ATFFT_RE (fft->real_out [i]);
+        out [(2 * i + 1) * out_stride] = ATFFT_IM (fft->real_out [i]);
+    }
+}
+
+static void atfft_dft_trivial_real_backward_transform (struct atfft_dft *fft,
+                                                       atfft_complex *in,
+                                                       int in_stride,
+                                                       atfft_sample *out,
+                                                       int out_stride)
+{
+    atfft_halfcomplex_to_complex_stride (in, in_stride, fft->real_in, 1, fft->size);
+    fft->complex_transform (fft->fft, fft->real_in, 1, fft->real_out, 1);
+    atfft_real_stride (fft->real_out, 1, out, out_stride, fft->size);
+}
+
+static void atfft_perform_real_backward_dft (struct atfft_dft *fft,
+                                             atfft_complex *in,
+                                             int in_stride,
+                                             atfft_sample *out,
+                                             int out_stride)
+{
+    if (fft->is_even_real)
+        atfft_dft_even_real_backward_transform (fft, in, in_stride, out, out_stride);
+    else
+        atfft_dft_trivial_real_backward_transform (fft, in, in_stride, out, out_stride);
+}
+
 void atfft_dft_real_backward_transform (struct atfft_dft *fft, atfft_complex *in, atfft_sample *out)
 {
     /* Only to be used for backward real FFTs. */
     assert ((fft->format == ATFFT_REAL) && (fft->direction == ATFFT_BACKWARD));
 
-    atfft_halfcomplex_to_complex (in, fft->real_in, fft->size);
-    fft->complex_transform (fft->fft, fft->real_in, 1, fft->real_out, 1);
-    atfft_real (fft->real_out, out, fft->size);
+    atfft_perform_real_backward_dft (fft, in, 1, out, 1);
 }
 
 void atfft_dft_real_backward_transform_stride (struct atfft_dft *fft,
@@ -278,9 +633,7 @@ void atfft_dft_real_backward_transform_stride (struct atfft_dft *fft,
     /* Only to be used for backward real FFTs. */
     assert ((fft->format == ATFFT_REAL) && (fft->direction == ATFFT_BACKWARD));
 
-    atfft_halfcomplex_to_complex_stride (in, in_stride, fft->real_in, 1, fft->size);
-    fft->complex_transform (fft->fft, fft->real_in, 1, fft->real_out, 1);
-    atfft_real_stride (fft->real_out, 1, out, out_stride, fft->size);
+    atfft_perform_real_backward_dft (fft, in, in_stride, out, out_stride);
 }
 
 cJSON* atfft_dft_base_get_plan (struct atfft_dft *fft)
@@ -344,3 +697,126 @@ succeeded:
     cJSON_Delete (plan_structure);
     free (plan_json);
 }
+
+#ifdef ATFFT_MULTI_BACKEND
+const struct atfft_dft_backend ATFFT_DFT_BACKEND_SYMBOL (backend) =
+{
+    .name = ATFFT_DFT_BACKEND_NAME,
+    .is_supported_size = atfft_dft_is_supported_size,
+    .create = atfft_dft_create,
+    .create_pruned = atfft_dft_create_pruned,
+    .destroy = atfft_dft_destroy,
+    .complex_transform = atfft_dft_complex_transform,
+    .complex_transform_stride = atfft_dft_complex_transform_stride,
+    .real_forward_transform = atfft_dft_real_forward_transform,
+    .real_forward_transform_stride = atfft_dft_real_forward_transform_stride,
+    .real_backward_transform = atfft_dft_real_backward_transform,
+    .real_backward_transform_stride = atfft_dft_real_backward_transform_stride,
+    .print_plan = atfft_dft_print_plan
+};
+
+/* Variants of the native planner which always use Rader's or Bluestein's
+ * algorithm for the internal complex transform, so the auto backend can time
+ * them against the default choice. */
+static int atfft_dft_rader_is_supported_size (int size, enum atfft_format format)
+{
+    int internal_size = atfft_dft_internal_size (size, format);
+
+    return internal_size > ATFFT_PRIME_TRANSFORM_THRESHOLD && atfft_is_prime (internal_size);
+}
+
+static int atfft_dft_bluestein_is_supported_size (int size, enum atfft_format format)
+{
+    return atfft_dft_internal_size (size, format) > ATFFT_PRIME_TRANSFORM_THRESHOLD;
+}
+
+static struct atfft_dft* atfft_dft_rader_variant_create_pruned (int size,
+                                                                enum atfft_direction direction,
+                                                                enum atfft_format format,
+                                                                int n_inputs,
+                                                                int first_output,
+                                                                int n_outputs)
+{
+    if (!atfft_dft_rader_is_supported_size (size, format))
+        return NULL;
+
+    return atfft_dft_create_with_algorithm (size,
+                                            direction,
+                                            format,
+                                            n_inputs,
+                                            first_output,
+                                            n_outputs,
+                                            ATFFT_RADER);
+}
+
+static struct atfft_dft* atfft_dft_rader_variant_create (int size,
+                                                         enum atfft_direction direction,
+                                                         enum atfft_format format)
+{
+    int n_inputs, n_outputs;
+
+    atfft_dft_full_range (size, direction, format, &n_inputs, &n_outputs);
+    return atfft_dft_rader_variant_create_pruned (size, direction, format, n_inputs, 0, n_outputs);
+}
+
+static struct atfft_dft* atfft_dft_bluestein_variant_create_pruned (int size,
+                                                                    enum atfft_direction direction,
+                                                                    enum atfft_format format,
+                                                                    int n_inputs,
+                                                                    int first_output,
+                                                                    int n_outputs)
+{
+    if (!atfft_dft_bluestein_is_supported_size (size, format))
+        return NULL;
+
+    return atfft_dft_create_with_algorithm (size,
+                                            direction,
+                                            format,
+                                            n_inputs,
+                                            first_output,
+                                            n_outputs,
+                                            ATFFT_BLUESTEIN);
+}
+
+static struct atfft_dft* atfft_dft_bluestein_variant_create (int size,
+                                                             enum atfft_direction direction,
+                                                             enum atfft_format format)
+{
+    int n_inputs, n_outputs;
+
+    atfft_dft_full_range (size, direction, format, &n_inputs, &n_outputs);
+    return atfft_dft_bluestein_variant_create_pruned (size, direction, format, n_inputs, 0, n_outputs);
+}
+
+const struct atfft_dft_backend atfft_native_rader_dft_backend =
+{
+    .name = "native_rader",
+    .is_supported_size = atfft_dft_rader_is_supported_size,
+    .create = atfft_dft_rader_variant_create,
+    .create_pruned = atfft_dft_rader_variant_create_pruned,
+    .destroy = atfft_dft_destroy,
+    .complex_transform = atfft_dft_complex_transform,
+    .complex_transform_stride = atfft_dft_complex_transform_stride,
+    .real_forward_transform = atfft_dft_real_forward_transform,
+    .real_forward_transform_stride = atfft_dft_real_forward_transform_stride,
+    .real_backward_transform = atfft_dft_real_backward_transform,
+    .real_backward_transform_stride = atfft_dft_real_backward_transform_stride,
+    .print_plan = atfft_dft_print_plan
+};
+
+const struct atfft_dft_backend atfft_native_bluestein_dft_backend =
+{
+    .name = "native_bluestein",
+    .is_supported_size = atfft_dft_bluestein_is_supported_size,
+    .create = atfft_dft_bluestein_variant_create,
+    .create_pruned = atfft_dft_bluestein_variant_create_pruned,
+    .destroy = atfft_dft_destroy,
+    .complex_transform = atfft_dft_complex_transform,
+    .complex_transform_stride = atfft_dft_complex_transform_stride,
+    .real_forward_transform = atfft_dft_real_forward_transform,
+    .real_forward_transform_stride = atfft_dft_real_forward_transform_stride,
+    .real_backward_transform = atfft_dft_real_backward_transform,
+    .real_backward_transform_stride = atfft_dft_real_backward_transform_stride,
+    .print_plan = atfft_dft_print_plan
+};
+#endif
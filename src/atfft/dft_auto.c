@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <atfft/dft.h>
+#include <atfft/dft_util.h>
+#include <atfft/dft_backend.h>
+#include <atfft/dft_auto.h>
+#include <atfft/dft_planner.h>
+
+/* Each backend is timed over batches of transforms lasting at least
+ * ATFFT_DFT_AUTO_MIN_TIME, keeping the fastest of ATFFT_DFT_AUTO_N_TRIALS.
+ * The batches stop growing at ATFFT_DFT_AUTO_MAX_TRANSFORMS in case the
+ * clock doesn't advance. */
+#define ATFFT_DFT_AUTO_MIN_TIME (CLOCKS_PER_SEC / 500)
+#define ATFFT_DFT_AUTO_N_TRIALS 3
+#define ATFFT_DFT_AUTO_MAX_TRANSFORMS (1L << 24)
+
+/* The longest backend name stored in the wisdom. */
+#define ATFFT_DFT_AUTO_MAX_NAME 64
+
+struct atfft_dft_auto_choice
+{
+    int size;
+    enum atfft_direction direction;
+    enum atfft_format format;
+    char backend [ATFFT_DFT_AUTO_MAX_NAME];
+};
+
+static struct atfft_dft_auto_choice *atfft_dft_auto_choices = NULL;
+static int atfft_dft_auto_n_choices = 0;
+static int atfft_dft_auto_max_choices = 0;
+static char *atfft_dft_auto_wisdom_file = NULL;
+
+/* Set when atfft_dft_auto_set_wisdom_file() has been called, otherwise
+ * the wisdom file from atfft/dft_planner.h is followed. */
+static int atfft_dft_auto_has_own_wisdom_file = 0;
+
+static struct atfft_dft_auto_choice* atfft_dft_auto_find_choice (int size,
+                                                                 enum atfft_direction direction,
+                                                                 enum atfft_format format)
+{
+    for (int i = 0; i < atfft_dft_auto_n_choices; ++i)
+    {
+        struct atfft_dft_auto_choice *choice = atfft_dft_auto_choices + i;
+
+        if (choice->size == size && choice->direction == direction && choice->format == format)
+            return choice;
+    }
+
+    return NULL;
+}
+
+/* Record a choice, replacing any earlier one for the same transform. */
+static int atfft_dft_auto_add_choice (int size,
+                                      enum atfft_direction direction,
+                                      enum atfft_format format,
+                                      const char *backend)
+{
+    struct atfft_dft_auto_choice *choice = atfft_dft_auto_find_choice (size, direction, format);
+
+    if (strlen (backend) >= ATFFT_DFT_AUTO_MAX_NAME)
+        return 0;
+
+    if (!choice)
+    {
+        if (atfft_dft_auto_n_choices == atfft_dft_auto_max_choices)
+        {
+            int max_choices = atfft_dft_auto_max_choices ? 2 * atfft_dft_auto_max_choices : 16;
+            struct atfft_dft_auto_choice *choices = realloc (atfft_dft_auto_choices,
+                                                             max_choices * sizeof (*choices));
+
+            if (!choices)
+                return 0;
+
+            atfft_dft_auto_choices = choices;
+            atfft_dft_auto_max_choices = max_choices;
+        }
+
+        choice = atfft_dft_auto_choices + atfft_dft_auto_n_choices++;
+        choice->size = size;
+        choice->direction = direction;
+        choice->format = format;
+    }
+
+    strcpy (choice->backend, backend);
+    return 1;
+}
+
+static void atfft_dft_auto_write_choice (FILE *file, const struct atfft_dft_auto_choice *choice)
+{
+    fprintf (file,
+             "%d %s %s %s\n",
+             choice->size,
+             choice->direction == ATFFT_FORWARD ? "forward" : "backward",
+             choice->format == ATFFT_COMPLEX ? "complex" : "real",
+             choice->backend);
+}
+
+static void atfft_dft_auto_execute (struct atfft_dft *plan,
+                                    enum atfft_direction direction,
+                                    enum atfft_format format,
+                                    atfft_complex *in,
+                                    atfft_complex *out)
+{
+    if (format == ATFFT_COMPLEX)
+        atfft_dft_complex_transform (plan, in, out);
+    else if (direction == ATFFT_FORWARD)
+        atfft_dft_real_forward_transform (plan, (atfft_sample*) in, out);
+    else
+        atfft_dft_real_backward_transform (plan, in, (atfft_sample*) out);
+}
+
+/* The time taken by one transform, in clock ticks. */
+static double atfft_dft_auto_time (struct atfft_dft *plan,
+                                   enum atfft_direction direction,
+                                   enum atfft_format format,
+                                   atfft_complex *in,
+                                   atfft_complex *out)
+{
+    double best = -1.0;
+
+    for (int trial = 0; trial < ATFFT_DFT_AUTO_N_TRIALS; ++trial)
+    {
+        long n_transforms = 1;
+        clock_t elapsed;
+
+        while (1)
+        {
+            clock_t start = clock();
+
+            for (long i = 0; i < n_transforms; ++i)
+                atfft_dft_auto_execute (plan, direction, format, in, out);
+
+            elapsed = clock() - start;
+
+            if (elapsed >= ATFFT_DFT_AUTO_MIN_TIME || n_transforms >= ATFFT_DFT_AUTO_MAX_TRANSFORMS)
+                break;
+
+            n_transforms *= 2;
+        }
+
+        double time = (double) elapsed / n_transforms;
+
+        if (best < 0.0 || time < best)
+            best = time;
+    }
+
+    return best;
+}
+
+static const struct atfft_dft_backend* atfft_dft_auto_measure (int size,
+                                                               enum atfft_direction direction,
+                                                               enum atfft_format format)
+{
+    const struct atfft_dft_backend *best = NULL;
+    double best_time = 0.0;
+    atfft_complex *in = malloc (size * sizeof (*in));
+    atfft_complex *out = malloc (size * sizeof (*out));
+
+    if (!(in && out))
+        goto finished;
+
+    /* Any input will do, as long as it isn't full of denormals. */
+    for (int i = 0; i < size; ++i)
+    {
+        ATFFT_RE (in [i]) = (i % 7) - 3.0;
+        ATFFT_IM (in [i]) = (i % 5) - 2.0;
+    }
+
+    for (int i = 0; i < atfft_dft_n_backends(); ++i)
+    {
+        const struct atfft_dft_backend *backend = atfft_dft_get_backend (i);
+        struct atfft_dft *plan = atfft_dft_create_with_backend (backend->name, size, direction, format);
+
+        if (plan)
+        {
+            double time = atfft_dft_auto_time (plan, direction, format, in, out);
+
+            if (!best || time < best_time)
+            {
+                best = backend;
+                best_time = time;
+            }
+
+            atfft_dft_destroy (plan);
+        }
+    }
+
+finished:
+    free (out);
+    free (in);
+    return best;
+}
+
+static int atfft_dft_auto_use_wisdom_file (const char *path)
+{
+    char *wisdom_file = NULL;
+
+    if (path)
+    {
+        if (!(wisdom_file = malloc (strlen (path) + 1)))
+            return 0;
+
+        strcpy (wisdom_file, path);
+
+        /* A missing file just means there is no wisdom yet. */
+        atfft_dft_auto_import_wisdom (path);
+    }
+
+    free (atfft_dft_auto_wisdom_file);
+    atfft_dft_auto_wisdom_file = wisdom_file;
+    return 1;
+}
+
+/* Switch to the shared wisdom file if it has changed. */
+static void atfft_dft_auto_follow_wisdom_file (void)
+{
+    const char *path = atfft_dft_get_wisdom_file();
+
+    if (atfft_dft_auto_has_own_wisdom_file)
+        return;
+
+    if (path && atfft_dft_auto_wisdom_file && strcmp (path, atfft_dft_auto_wisdom_file) == 0)
+        return;
+
+    if (path || atfft_dft_auto_wisdom_file)
+        atfft_dft_auto_use_wisdom_file (path);
+}
+
+const struct atfft_dft_backend* atfft_dft_auto_select (int size,
+                                                       enum atfft_direction direction,
+                                                       enum atfft_format format)
+{
+    struct atfft_dft_auto_choice *choice;
+    const struct atfft_dft_backend *backend;
+
+    atfft_dft_auto_follow_wisdom_file();
+    choice = atfft_dft_auto_find_choice (size, direction, format);
+
+    if (choice && (backend = atfft_dft_find_backend (choice->backend)))
+        return backend;
+
+    if (!(backend = atfft_dft_auto_measure (size, direction, format)))
+        return NULL;
+
+    /* Failing to remember the choice only means it will be timed again. */
+    if (atfft_dft_auto_add_choice (size, direction, format, backend->name) && atfft_dft_auto_wisdom_file)
+    {
+        FILE *file = fopen (atfft_dft_auto_wisdom_file, "a");
+
+        if (file)
+        {
+            atfft_dft_auto_write_choice (file, atfft_dft_auto_find_choice (size, direction, format));
+            fclose (file);
+        }
+    }
+
+    return backend;
+}
+
+int atfft_dft_auto_import_wisdom (const char *path)
+{
+    FILE *file = fopen (path, "r");
+    char line [256];
+
+    if (!file)
+        return 0;
+
+    while (fgets (line, sizeof (line), file))
+    {
+        char direction [16], format [16], backend [ATFFT_DFT_AUTO_MAX_NAME];
+        int size;
+
+        if (line [0] == '#' || sscanf (line, "%d %15s %15s %63s", &size, direction, format, backend) != 4)
+            continue;
+
+        if (size < 1 ||
+            !(strcmp (direction, "forward") == 0 || strcmp (direction, "backward") == 0) ||
+            !(strcmp (format, "complex") == 0 || strcmp (format, "real") == 0))
+            continue;
+
+        atfft_dft_auto_add_choice (size,
+                                   strcmp (direction, "forward") == 0 ? ATFFT_FORWARD : ATFFT_BACKWARD,
+                                   strcmp (format, "complex") == 0 ? ATFFT_COMPLEX : ATFFT_REAL,
+                                   backend);
+    }
+
+    fclose (file);
+    return 1;
+}
+
+int atfft_dft_auto_export_wisdom (const char *path)
+{
+    FILE *file = fopen (path, "w");
+
+    if (!file)
+        return 0;
+
+    fprintf (file, "# atfft DFT wisdom: size direction format backend\n");
+
+    for (int i = 0; i < atfft_dft_auto_n_choices; ++i)
+        atfft_dft_auto_write_choice (file, atfft_dft_auto_choices + i);
+
+    return fclose (file) == 0;
+}
+
+int atfft_dft_auto_set_wisdom_file (const char *path)
+{
+    atfft_dft_auto_has_own_wisdom_file = 1;
+    return atfft_dft_auto_use_wisdom_file (path);
+}
+
+void atfft_dft_auto_forget_wisdom (void)
+{
+    free (atfft_dft_auto_choices);
+    atfft_dft_auto_choices = NULL;
+    atfft_dft_auto_n_choices = 0;
+    atfft_dft_auto_max_choices = 0;
+}
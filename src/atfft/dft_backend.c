@@ -0,0 +1,514 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <atfft/dft.h>
+#include <atfft/dft_backend.h>
+#include <atfft/dft_auto.h>
+#include <atfft/dft_util.h>
+
+#ifndef ATFFT_NO_DLOPEN
+#   include <dlfcn.h>
+#endif
+
+/* The maximum number of backends which can be registered at run time. */
+#define ATFFT_DFT_MAX_BACKENDS 32
+
+/* The longest backend name accepted by atfft_dft_load_backend(). */
+#define ATFFT_DFT_MAX_BACKEND_NAME 64
+
+/* Which of the wrapped implementations are compiled in is decided by the
+ * build, each defines ATFFT_DFT_BACKEND_<NAME>. */
+extern const struct atfft_dft_backend atfft_fftw_dft_backend;
+extern const struct atfft_dft_backend atfft_mkl_dft_backend;
+extern const struct atfft_dft_backend atfft_ipp_dft_backend;
+extern const struct atfft_dft_backend atfft_ffts_dft_backend;
+extern const struct atfft_dft_backend atfft_gsl_dft_backend;
+extern const struct atfft_dft_backend atfft_kiss_dft_backend;
+extern const struct atfft_dft_backend atfft_vdsp_dft_backend;
+extern const struct atfft_dft_backend atfft_ffmpeg_dft_backend;
+extern const struct atfft_dft_backend atfft_pffft_dft_backend;
+extern const struct atfft_dft_backend atfft_ooura_dft_backend;
+extern const struct atfft_dft_backend atfft_kfr_dft_backend;
+extern const struct atfft_dft_backend atfft_native_dft_backend;
+extern const struct atfft_dft_backend atfft_native_rader_dft_backend;
+extern const struct atfft_dft_backend atfft_native_bluestein_dft_backend;
+
+/* The native implementation comes last so it catches every size
+ * the others don't support. Its variants follow it so they are only
+ * used when asked for by name or chosen by the auto backend. */
+static const struct atfft_dft_backend *atfft_dft_builtin_backends [] =
+{
+#ifdef ATFFT_DFT_BACKEND_FFTW
+    &atfft_fftw_dft_backend,
+#endif
+#ifdef ATFFT_DFT_BACKEND_MKL
+    &atfft_mkl_dft_backend,
+#endif
+#ifdef ATFFT_DFT_BACKEND_IPP
+    &atfft_ipp_dft_backend,
+#endif
+#ifdef ATFFT_DFT_BACKEND_FFTS
+    &atfft_ffts_dft_backend,
+#endif
+#ifdef ATFFT_DFT_BACKEND_GSL
+    &atfft_gsl_dft_backend,
+#endif
+#ifdef ATFFT_DFT_BACKEND_KISS
+    &atfft_kiss_dft_backend,
+#endif
+#ifdef ATFFT_DFT_BACKEND_VDSP
+    &atfft_vdsp_dft_backend,
+#endif
+#ifdef ATFFT_DFT_BACKEND_FFMPEG
+    &atfft_ffmpeg_dft_backend,
+#endif
+#ifdef ATFFT_DFT_BACKEND_PFFFT
+    &atfft_pffft_dft_backend,
+#endif
+#ifdef ATFFT_DFT_BACKEND_OOURA
+    &atfft_ooura_dft_backend,
+#endif
+#ifdef ATFFT_DFT_BACKEND_KFR
+    &atfft_kfr_dft_backend,
+#endif
+    &atfft_native_dft_backend,
+    &atfft_native_rader_dft_backend,
+    &atfft_native_bluestein_dft_backend
+};
+
+#define ATFFT_DFT_N_BUILTIN_BACKENDS \
+    ((int) (sizeof (atfft_dft_builtin_backends) / sizeof (atfft_dft_builtin_backends [0])))
+
+static const struct atfft_dft_backend *atfft_dft_registered_backends [ATFFT_DFT_MAX_BACKENDS];
+static int atfft_dft_n_registered_backends = 0;
+
+/* The backend atfft_dft_create() tries first, if any. */
+static const struct atfft_dft_backend *atfft_dft_default_backend = NULL;
+static int atfft_dft_default_is_auto = 0;
+
+/* The plan handed out to the user pairs the backend's plan with its function
+ * table, so each transform is one indirect call. Backends without strided
+ * transforms gather and scatter through the working space. */
+struct atfft_dft
+{
+    const struct atfft_dft_backend *backend;
+    struct atfft_dft_backend_plan *plan;
+    int size;
+
+    /* working space */
+    atfft_complex *in, *out;
+};
+
+int atfft_dft_n_backends (void)
+{
+    return atfft_dft_n_registered_backends + ATFFT_DFT_N_BUILTIN_BACKENDS;
+}
+
+const struct atfft_dft_backend* atfft_dft_get_backend (int index)
+{
+    assert (index >= 0 && index < atfft_dft_n_backends());
+
+    if (index < atfft_dft_n_registered_backends)
+        return atfft_dft_registered_backends [index];
+
+    return atfft_dft_builtin_backends [index - atfft_dft_n_registered_backends];
+}
+
+const struct atfft_dft_backend* atfft_dft_find_backend (const char *name)
+{
+    for (int i = 0; i < atfft_dft_n_backends(); ++i)
+    {
+        const struct atfft_dft_backend *backend = atfft_dft_get_backend (i);
+
+        if (strcmp (backend->name, name) == 0)
+            return backend;
+    }
+
+    return NULL;
+}
+
+/* Find a backend by name, choosing one for the transform if the name is "auto". */
+static const struct atfft_dft_backend* atfft_dft_resolve_backend (const char *name,
+                                                                  int size,
+                                                                  enum atfft_direction direction,
+                                                                  enum atfft_format format)
+{
+    if (strcmp (name, ATFFT_DFT_AUTO_BACKEND) == 0)
+        return atfft_dft_auto_select (size, direction, format);
+
+    return atfft_dft_find_backend (name);
+}
+
+int atfft_dft_set_default_backend (const char *name)
+{
+    const struct atfft_dft_backend *backend = NULL;
+    int is_auto = name && strcmp (name, ATFFT_DFT_AUTO_BACKEND) == 0;
+
+    if (name && !is_auto && !(backend = atfft_dft_find_backend (name)))
+        return 0;
+
+    atfft_dft_default_backend = backend;
+    atfft_dft_default_is_auto = is_auto;
+    return 1;
+}
+
+int atfft_dft_register_backend (const struct atfft_dft_backend *backend)
+{
+    if (atfft_dft_find_backend (backend->name) ||
+        atfft_dft_n_registered_backends == ATFFT_DFT_MAX_BACKENDS)
+        return 0;
+
+    atfft_dft_registered_backends [atfft_dft_n_registered_backends++] = backend;
+    return 1;
+}
+
+const struct atfft_dft_backend* atfft_dft_load_backend (const char *name, const char *path)
+{
+    const struct atfft_dft_backend *backend = atfft_dft_find_backend (name);
+
+    if (backend)
+        return backend;
+
+#ifdef ATFFT_NO_DLOPEN
+    (void) path;
+    return NULL;
+#else
+    char library [ATFFT_DFT_MAX_BACKEND_NAME + 32];
+    char symbol [ATFFT_DFT_MAX_BACKEND_NAME + 32];
+    void *handle;
+
+    if (strlen (name) > ATFFT_DFT_MAX_BACKEND_NAME)
+        return NULL;
+
+#ifdef __APPLE__
+    sprintf (library, "libatfft_%s.dylib", name);
+#else
+    sprintf (library, "libatfft_%s.so", name);
+#endif
+    sprintf (symbol, "atfft_%s_dft_backend", name);
+
+    if (!(handle = dlopen (path ? path : library, RTLD_NOW | RTLD_LOCAL)))
+        return NULL;
+
+    backend = dlsym (handle, symbol);
+
+    if (!(backend && strcmp (backend->name, name) == 0 && atfft_dft_register_backend (backend)))
+    {
+        dlclose (handle);
+        return NULL;
+    }
+
+    return backend;
+#endif
+}
+
+static int atfft_dft_backend_supports (const struct atfft_dft_backend *backend,
+                                       int size,
+                                       enum atfft_format format)
+{
+    return !backend->is_supported_size || backend->is_supported_size (size, format);
+}
+
+int atfft_dft_is_supported_size (int size, enum atfft_format format)
+{
+    for (int i = 0; i < atfft_dft_n_backends(); ++i)
+    {
+        if (atfft_dft_backend_supports (atfft_dft_get_backend (i), size, format))
+            return 1;
+    }
+
+    return 0;
+}
+
+/* Take ownership of a backend's plan, NULL if there isn't one. */
+static struct atfft_dft* atfft_dft_wrap_plan (const struct atfft_dft_backend *backend,
+                                              struct atfft_dft_backend_plan *backend_plan,
+                                              int size)
+{
+    struct atfft_dft *plan;
+
+    if (!backend_plan)
+        return NULL;
+
+    if (!(plan = calloc (1, sizeof (*plan))))
+    {
+        backend->destroy (backend_plan);
+        return NULL;
+    }
+
+    plan->backend = backend;
+    plan->plan = backend_plan;
+    plan->size = size;
+
+    if (!(backend->complex_transform_stride &&
+          backend->real_forward_transform_stride &&
+          backend->real_backward_transform_stride))
+    {
+        plan->in = malloc (size * sizeof (*(plan->in)));
+        plan->out = malloc (size * sizeof (*(plan->out)));
+
+        if (!(plan->in && plan->out))
+            goto failed;
+    }
+
+    return plan;
+
+failed:
+    atfft_dft_destroy (plan);
+    return NULL;
+}
+
+static struct atfft_dft* atfft_dft_backend_create (const struct atfft_dft_backend *backend,
+                                                   int size,
+                                                   enum atfft_direction direction,
+                                                   enum atfft_format format,
+                                                   int n_inputs,
+                                                   int first_output,
+                                                   int n_outputs)
+{
+    struct atfft_dft_backend_plan *backend_plan;
+
+    if (!atfft_dft_backend_supports (backend, size, format))
+        return NULL;
+
+    if (n_inputs < 0)
+        backend_plan = backend->create (size, direction, format);
+    else
+        backend_plan = backend->create_pruned (size, direction, format, n_inputs, first_output, n_outputs);
+
+    return atfft_dft_wrap_plan (backend, backend_plan, size);
+}
+
+/* Try the default backend, then each backend in turn,
+ * a negative n_inputs means an unpruned plan. */
+static struct atfft_dft* atfft_dft_create_any (int size,
+                                               enum atfft_direction direction,
+                                               enum atfft_format format,
+                                               int n_inputs,
+                                               int first_output,
+                                               int n_outputs)
+{
+    const struct atfft_dft_backend *backend = atfft_dft_default_backend;
+
+    if (atfft_dft_default_is_auto)
+        backend = atfft_dft_auto_select (size, direction, format);
+
+    if (backend)
+    {
+        struct atfft_dft *plan = atfft_dft_backend_create (backend,
+                                                           size,
+                                                           direction,
+                                                           format,
+                                                           n_inputs,
+                                                           first_output,
+                                                           n_outputs);
+
+        if (plan)
+            return plan;
+    }
+
+    for (int i = 0; i < atfft_dft_n_backends(); ++i)
+    {
+        struct atfft_dft *plan = atfft_dft_backend_create (atfft_dft_get_backend (i),
+                                                           size,
+                                                           direction,
+                                                           format,
+                                                           n_inputs,
+                                                           first_output,
+                                                           n_outputs);
+
+        if (plan)
+            return plan;
+    }
+
+    return NULL;
+}
+
+struct atfft_dft* atfft_dft_create (int size, enum atfft_direction direction, enum atfft_format format)
+{
+    return atfft_dft_create_any (size, direction, format, -1, 0, 0);
+}
+
+struct atfft_dft* atfft_dft_create_pruned (int size,
+                                           enum atfft_direction direction,
+                                           enum atfft_format format,
+                                           int n_inputs,
+                                           int first_output,
+                                           int n_outputs)
+{
+    if (!atfft_dft_is_valid_pruning (size, direction, format, n_inputs, first_output, n_outputs))
+        return NULL;
+
+    return atfft_dft_create_any (size, direction, format, n_inputs, first_output, n_outputs);
+}
+
+struct atfft_dft* atfft_dft_create_with_backend (const char *name,
+                                                 int size,
+                                                 enum atfft_direction direction,
+                                                 enum atfft_format format)
+{
+    const struct atfft_dft_backend *backend = atfft_dft_resolve_backend (name, size, direction, format);
+
+    if (!backend)
+        return NULL;
+
+    return atfft_dft_backend_create (backend, size, direction, format, -1, 0, 0);
+}
+
+struct atfft_dft* atfft_dft_create_pruned_with_backend (const char *name,
+                                                        int size,
+                                                        enum atfft_direction direction,
+                                                        enum atfft_format format,
+                                                        int n_inputs,
+                                                        int first_output,
+                                                        int n_outputs)
+{
+    const struct atfft_dft_backend *backend = atfft_dft_resolve_backend (name, size, direction, format);
+
+    if (!(backend && atfft_dft_is_valid_pruning (size, direction, format, n_inputs, first_output, n_outputs)))
+        return NULL;
+
+    return atfft_dft_backend_create (backend, size, direction, format, n_inputs, first_output, n_outputs);
+}
+
+void atfft_dft_destroy (struct atfft_dft *plan)
+{
+    if (plan)
+    {
+        free (plan->out);
+        free (plan->in);
+        plan->backend->destroy (plan->plan);
+        free (plan);
+    }
+}
+
+const struct atfft_dft_backend* atfft_dft_get_plan_backend (struct atfft_dft *plan)
+{
+    return plan->backend;
+}
+
+void atfft_dft_complex_transform (struct atfft_dft *plan, atfft_complex *in, atfft_complex *out)
+{
+    plan->backend->complex_transform (plan->plan, in, out);
+}
+
+void atfft_dft_complex_transform_stride (struct atfft_dft *plan,
+                                         atfft_complex *in,
+                                         int in_stride,
+                                         atfft_complex *out,
+                                         int out_stride)
+{
+    if (plan->backend->complex_transform_stride)
+    {
+        plan->backend->complex_transform_stride (plan->plan, in, in_stride, out, out_stride);
+        return;
+    }
+
+    for (int i = 0; i < plan->size; ++i)
+    {
+        ATFFT_RE (plan->in [i]) = ATFFT_RE (in [i * in_stride]);
+        ATFFT_IM (plan->in [i]) = ATFFT_IM (in [i * in_stride]);
+    }
+
+    plan->backend->complex_transform (plan->plan, plan->in, plan->out);
+
+    for (int i = 0; i < plan->size; ++i)
+    {
+        ATFFT_RE (out [i * out_stride]) = ATFFT_RE (plan->out [i]);
+        ATFFT_IM (out [i * out_stride]) = ATFFT_IM (plan->out [i]);
+    }
+}
+
+void atfft_dft_real_forward_transform (struct atfft_dft *plan, const atfft_sample *in, atfft_complex *out)
+{
+    plan->backend->real_forward_transform (plan->plan, in, out);
+}
+
+void atfft_dft_real_forward_transform_stride (struct atfft_dft *plan,
+                                              const atfft_sample *in,
+                                              int in_stride,
+                                              atfft_complex *out,
+                                              int out_stride)
+{
+    atfft_sample *samples = (atfft_sample*) plan->in;
+    int n_bins = atfft_halfcomplex_size (plan->size);
+
+    if (plan->backend->real_forward_transform_stride)
+    {
+        plan->backend->real_forward_transform_stride (plan->plan, in, in_stride, out, out_stride);
+        return;
+    }
+
+    for (int i = 0; i < plan->size; ++i)
+        samples [i] = in [i * in_stride];
+
+    plan->backend->real_forward_transform (plan->plan, samples, plan->out);
+
+    for (int i = 0; i < n_bins; ++i)
+    {
+        ATFFT_RE (out [i * out_stride]) = ATFFT_RE (plan->out [i]);
+        ATFFT_IM (out [i * out_stride]) = ATFFT_IM (plan->out [i]);
+    }
+}
+
+void atfft_dft_real_backward_transform (struct atfft_dft *plan, atfft_complex *in, atfft_sample *out)
+{
+    plan->backend->real_backward_transform (plan->plan, in, out);
+}
+
+void atfft_dft_real_backward_transform_stride (struct atfft_dft *plan,
+                                               atfft_complex *in,
+                                               int in_stride,
+                                               atfft_sample *out,
+                                               int out_stride)
+{
+    atfft_sample *samples = (atfft_sample*) plan->out;
+    int n_bins = atfft_halfcomplex_size (plan->size);
+
+    if (plan->backend->real_backward_transform_stride)
+    {
+        plan->backend->real_backward_transform_stride (plan->plan, in, in_stride, out, out_stride);
+        return;
+    }
+
+    for (int i = 0; i < n_bins; ++i)
+    {
+        ATFFT_RE (plan->in [i]) = ATFFT_RE (in [i * in_stride]);
+        ATFFT_IM (plan->in [i]) = ATFFT_IM (in [i * in_stride]);
+    }
+
+    plan->backend->real_backward_transform (plan->plan, plan->in, samples);
+
+    for (int i = 0; i < plan->size; ++i)
+        out [i * out_stride] = samples [i];
+}
+
+void atfft_dft_print_plan (struct atfft_dft *plan, FILE *stream)
+{
+    if (plan->backend->print_plan)
+        plan->backend->print_plan (plan->plan, stream);
+    else
+        fprintf (stream, "{\n\t\"Backend\":\t\"%s\"\n}\n", plan->backend->name);
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Each DFT implementation includes this header before any other, with
+ * ATFFT_DFT_BACKEND defined as the name of the backend.
+ *
+ * In a multi-backend build (ATFFT_MULTI_BACKEND) the symbols from
+ * atfft/dft.h are renamed atfft_<name>_dft_*, and struct atfft_dft becomes
+ * struct atfft_dft_backend_plan, so that several implementations can be
+ * linked into one program. The public functions are then provided by
+ * dft_backend.c, which forwards them to the table each implementation
+ * defines with ATFFT_DFT_BACKEND_SYMBOL (backend).
+ *
+ * Otherwise this header does nothing.
+ */
+
+#ifndef ATFFT_DFT_BACKEND_INTERNAL_H_INCLUDED
+#define ATFFT_DFT_BACKEND_INTERNAL_H_INCLUDED
+
+#ifdef ATFFT_MULTI_BACKEND
+
+#ifndef ATFFT_DFT_BACKEND
+#   error ATFFT_DFT_BACKEND must be defined before including dft_backend_internal.h
+#endif
+
+#include <atfft/dft_backend.h>
+
+#define ATFFT_DFT_BACKEND_PASTE(name, function) atfft_ ## name ## _dft_ ## function
+#define ATFFT_DFT_BACKEND_EXPAND(name, function) ATFFT_DFT_BACKEND_PASTE (name, function)
+#define ATFFT_DFT_BACKEND_SYMBOL(function) ATFFT_DFT_BACKEND_EXPAND (ATFFT_DFT_BACKEND, function)
+
+#define ATFFT_DFT_BACKEND_STRING(name) #name
+#define ATFFT_DFT_BACKEND_EXPAND_STRING(name) ATFFT_DFT_BACKEND_STRING (name)
+#define ATFFT_DFT_BACKEND_NAME ATFFT_DFT_BACKEND_EXPAND_STRING (ATFFT_DFT_BACKEND)
+
+#define atfft_dft atfft_dft_backend_plan
+#define atfft_dft_is_supported_size ATFFT_DFT_BACKEND_SYMBOL (is_supported_size)
+#define atfft_dft_create ATFFT_DFT_BACKEND_SYMBOL (create)
+#define atfft_dft_create_pruned ATFFT_DFT_BACKEND_SYMBOL (create_pruned)
+#define atfft_dft_destroy ATFFT_DFT_BACKEND_SYMBOL (destroy)
+#define atfft_dft_complex_transform ATFFT_DFT_BACKEND_SYMBOL (complex_transform)
+#define atfft_dft_complex_transform_stride ATFFT_DFT_BACKEND_SYMBOL (complex_transform_stride)
+#define atfft_dft_real_forward_transform ATFFT_DFT_BACKEND_SYMBOL (real_forward_transform)
+#define atfft_dft_real_forward_transform_stride ATFFT_DFT_BACKEND_SYMBOL (real_forward_transform_stride)
+#define atfft_dft_real_backward_transform ATFFT_DFT_BACKEND_SYMBOL (real_backward_transform)
+#define atfft_dft_real_backward_transform_stride ATFFT_DFT_BACKEND_SYMBOL (real_backward_transform_stride)
+#define atfft_dft_print_plan ATFFT_DFT_BACKEND_SYMBOL (print_plan)
+
+#endif /* ATFFT_MULTI_BACKEND */
+
+#endif /* ATFFT_DFT_BACKEND_INTERNAL_H_INCLUDED */
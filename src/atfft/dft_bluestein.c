@@ -20,6 +20,9 @@
  * SOFTWARE.
  */
 
+#define ATFFT_DFT_BACKEND native
+#include "dft_backend_internal.h"
+
 #include <stdlib.h>
 #include <atfft/dft.h>
 #include <atfft/dft_util.h>
@@ -89,7 +92,7 @@ static int atfft_init_bluestein_convolution_dft (int size,
     /* produce convolution sequence */
     for (int i = 0; i < size; ++i)
     {
-        int index = (i * i) % (2 * size);
+        int index = (int) (((long long) i * i) % (2 * size));
         atfft_copy_complex (sin_table [index], &sequence [i]);
     }
 
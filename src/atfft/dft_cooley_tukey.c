@@ -20,10 +20,14 @@
  * SOFTWARE.
  */
 
+#define ATFFT_DFT_BACKEND native
+#include "dft_backend_internal.h"
+
 #include <stdlib.h>
 #include <assert.h>
 #include <math.h>
 #include <atfft/dft.h>
+#include <atfft/dft_util.h>
 #include "dft_cooley_tukey.h"
 #include "atfft_internal.h"
 #include "constants.h"
@@ -63,6 +67,15 @@ struct atfft_dft_ct
     int n_sub_transforms;
     struct atfft_dft **sub_transforms;
     struct atfft_dft *radix_sub_transforms [MAX_INT_FACTORS];
+
+    /* pruning: the number of leading non-zero inputs and the range of required outputs */
+    int n_inputs;
+    int first_output;
+    int n_outputs;
+
+    /* number of sub-transforms with non-zero inputs in each butterfly of a stage
+     * (NULL for stages where every sub-transform may be non-zero) */
+    int *n_live_sub_transforms [MAX_INT_FACTORS];
 };
 
 /******************************************
@@ -290,6 +303,9 @@ struct atfft_dft_ct* atfft_dft_ct_create (int size,
     fft->direction = direction;
     fft->format = format;
     fft->method = method;
+    fft->n_inputs = size;
+    fft->first_output = 0;
+    fft->n_outputs = size;
 
     /* calculate radices */
     int max_r = 0;
@@ -344,12 +360,90 @@ failed:
     return NULL;
 }
 
+static int* atfft_init_live_sub_transforms (const struct atfft_dft_ct *fft, int stage)
+{
+    int R = fft->radices [stage];
+    int block_size = R * fft->sub_sizes [stage];
+    int n_blocks = fft->size / block_size;
+
+    /* Each butterfly in this stage combines R sub-transforms of the inputs
+     * offset + r * step, where step is the product of the radices of the
+     * earlier stages. */
+    int step = n_blocks;
+    int *n_live = malloc (n_blocks * sizeof (*n_live));
+
+    if (!n_live)
+        return NULL;
+
+    for (int b = 0; b < n_blocks; ++b)
+    {
+        /* Recover the input offset from the position of the
+         * butterfly in the decimated output. */
+        int position = b * block_size;
+        int offset = 0;
+        int p = 1;
+
+        for (int s = 0; s < stage; ++s)
+        {
+            offset += (position / fft->sub_sizes [s]) * p;
+            position %= fft->sub_sizes [s];
+            p *= fft->radices [s];
+        }
+
+        int live = offset < fft->n_inputs ? (fft->n_inputs - offset + step - 1) / step : 0;
+        n_live [b] = live < R ? live : R;
+    }
+
+    return n_live;
+}
+
+struct atfft_dft_ct* atfft_dft_ct_create_pruned (int size,
+                                                 enum atfft_direction direction,
+                                                 enum atfft_format format,
+                                                 int n_inputs,
+                                                 int first_output,
+                                                 int n_outputs)
+{
+    struct atfft_dft_ct *fft = atfft_dft_ct_create (size, direction, format, ATFFT_DFT_CT_ITERATIVE);
+
+    if (!fft)
+        return NULL;
+
+    fft->n_inputs = n_inputs;
+    fft->first_output = first_output;
+    fft->n_outputs = n_outputs;
+
+    for (int i = 0; i < fft->n_radices; ++i)
+    {
+        /* Stages are only pruned where some of the sub-transforms
+         * can be entirely zero. */
+        if (size / fft->sub_sizes [i] > n_inputs)
+        {
+            fft->n_live_sub_transforms [i] = atfft_init_live_sub_transforms (fft, i);
+
+            if (!fft->n_live_sub_transforms [i])
+                goto failed;
+        }
+    }
+
+    return fft;
+
+failed:
+    atfft_dft_ct_destroy (fft);
+    return NULL;
+}
+
 void atfft_dft_ct_destroy (void *fft)
 {
     struct atfft_dft_ct *t = fft;
 
     if (t)
     {
+        for (int i = 0; i < t->n_radices; ++i)
+        {
+            free (t->n_live_sub_transforms [i]);
+        }
+
         atfft_free_sub_transforms (t->sub_transforms, t->n_sub_transforms);
         free (t->work_space);
         atfft_free_twiddle_factors (t->t_factors, t->n_radices);
@@ -819,11 +913,18 @@ static inline int atfft_apply_twiddle_factors (atfft_complex *out,
                                                                             int stride,\
                                                                             int radix,\
                                                                             int sub_size,\
+                                                                            int first,\
+                                                                            int count,\
                                                                             atfft_complex *t_factors,\
                                                                             enum atfft_direction direction)\
 { \
-    int i = sub_size;\
+    int i = count;\
     int dft_stride = sub_size * stride;\
+\
+    out += first * stride;\
+\
+    if (t_factors)\
+        t_factors += first * (radix - 1);\
 \
     while (i--)\
     {\
@@ -849,12 +950,19 @@ static void atfft_butterfly_sub_transform (atfft_complex *out,
                                            int stride,
                                            int radix,
                                            int sub_size,
+                                           int first,
+                                           int count,
                                            atfft_complex *t_factors,
                                            struct atfft_dft *sub_transform)
 {
-    int i = sub_size;
+    int i = count;
     int dft_stride = sub_size * stride;
 
+    out += first * stride;
+
+    if (t_factors)
+        t_factors += first * (radix - 1);
+
     while (i--)
     {
         if (t_factors)
@@ -872,6 +980,8 @@ static void atfft_butterfly_slow (atfft_complex *out,
                                   int stride,
                                   int radix,
                                   int sub_size,
+                                  int first,
+                                  int count,
                                   atfft_complex *sinusoids,
                                   int n_sinusoids,
                                   int sin_stride,
@@ -881,8 +991,8 @@ static void atfft_butterfly_slow (atfft_complex *out,
      * into one DTF of size (radix * sub_size).
      */
 
-    /* Loop over the bins in each of the sub-transforms. */
-    for (int i = 0; i < sub_size; ++i)
+    /* Loop over the required bins in each of the sub-transforms. */
+    for (int i = first; i < first + count; ++i)
     {
         /* Copy ith bin from each sub-transform into work_space. */
         for (int n = 0; n < radix; ++n)
@@ -939,6 +1049,8 @@ static void atfft_butterfly (const struct atfft_dft_ct *fft,
                              int stride,
                              int radix,
                              int sub_size,
+                             int first,
+                             int count,
                              atfft_complex *t_factors,
                              int sin_stride,
                              struct atfft_dft *sub_transform)
@@ -946,28 +1058,29 @@ static void atfft_butterfly (const struct atfft_dft_ct *fft,
     switch (radix)
     {
         case 2:
-            atfft_butterfly_2 (out, stride, radix, sub_size, t_factors, fft->direction);
+            atfft_butterfly_2 (out, stride, radix, sub_size, first, count, t_factors, fft->direction);
             break;
         case 3:
-            atfft_butterfly_3 (out, stride, radix, sub_size, t_factors, fft->direction);
+            atfft_butterfly_3 (out, stride, radix, sub_size, first, count, t_factors, fft->direction);
             break;
         case 4:
-            atfft_butterfly_4 (out, stride, radix, sub_size, t_factors, fft->direction);
+            atfft_butterfly_4 (out, stride, radix, sub_size, first, count, t_factors, fft->direction);
             break;
         case 5:
-            atfft_butterfly_5 (out, stride, radix, sub_size, t_factors, fft->direction);
+            atfft_butterfly_5 (out, stride, radix, sub_size, first, count, t_factors, fft->direction);
             break;
         case 7:
-            atfft_butterfly_7 (out, stride, radix, sub_size, t_factors, fft->direction);
+            atfft_butterfly_7 (out, stride, radix, sub_size, first, count, t_factors, fft->direction);
             break;
         case 8:
-            atfft_butterfly_8 (out, stride, radix, sub_size, t_factors, fft->direction);
+            atfft_butterfly_8 (out, stride, radix, sub_size, first, count, t_factors, fft->direction);
             break;
         default:
             if (sub_transform)
-                atfft_butterfly_sub_transform (out, stride, radix, sub_size, t_factors, sub_transform);
+                atfft_butterfly_sub_transform (out, stride, radix, sub_size, first, count, t_factors, sub_transform);
             else
-                atfft_butterfly_slow (out, stride, radix, sub_size, fft->sinusoids, fft->size, sin_stride, fft->work_space);
+                atfft_butterfly_slow (out, stride, radix, sub_size, first, count,
+                                      fft->sinusoids, fft->size, sin_stride, fft->work_space);
     }
 }
 
@@ -1024,6 +1137,8 @@ static void atfft_compute_dft_recursive (const struct atfft_dft_ct *fft,
                      out_stride,
                      R,
                      sub_size,
+                     0,
+                     sub_size,
                      fft->t_factors [stage],
                      sin_stride,
                      fft->radix_sub_transforms [stage]);
@@ -1038,32 +1153,139 @@ static void atfft_decimate_in_time (const struct atfft_dft_ct *fft,
                                     atfft_complex *out,
                                     int out_stride)
 {
-    for (int i = 0; i < fft->size; ++i)
+    if (fft->n_inputs < fft->size)
     {
-        atfft_copy_complex (in [fft->permutation [i] * in_stride], out + i * out_stride);
+        /* Inputs past n_inputs are known to be zero, don't read them. */
+        for (int i = 0; i < fft->size; ++i)
+        {
+            int p = fft->permutation [i];
+
+            if (p < fft->n_inputs)
+                atfft_copy_complex (in [p * in_stride], out + i * out_stride);
+            else
+                ATFFT_RE (out [i * out_stride]) = ATFFT_IM (out [i * out_stride]) = 0.0;
+        }
+    }
+    else
+    {
+        for (int i = 0; i < fft->size; ++i)
+        {
+            atfft_copy_complex (in [fft->permutation [i] * in_stride], out + i * out_stride);
+        }
+    }
+}
+
+static void atfft_replicate_sub_transform (atfft_complex *out,
+                                           int stride,
+                                           int radix,
+                                           int sub_size,
+                                           int first,
+                                           int count)
+{
+    /* When only the first of the sub-transforms in a butterfly is non-zero
+     * the butterfly just repeats its bins across the whole output. */
+    for (int i = first; i < first + count; ++i)
+    {
+        for (int r = 1; r < radix; ++r)
+        {
+            atfft_copy_complex (out [i * stride], out + (r * sub_size + i) * stride);
+        }
+    }
+}
+
+static void atfft_apply_butterflies (const struct atfft_dft_ct *fft,
+                                     atfft_complex *out,
+                                     int stride,
+                                     int radix,
+                                     int sub_size,
+                                     int first,
+                                     int count,
+                                     atfft_complex *t_factors,
+                                     int sin_stride,
+                                     struct atfft_dft *sub_transform,
+                                     const int *n_live)
+{
+    if (!n_live)
+    {
+        for (int i = 0; i < fft->size; i += radix * sub_size)
+        {
+            /* Apply butterfly for this stage of the transform. */
+            atfft_butterfly (fft,
+                             out + i * stride,
+                             stride,
+                             radix,
+                             sub_size,
+                             first,
+                             count,
+                             t_factors,
+                             sin_stride,
+                             sub_transform);
+        }
+
+        return;
+    }
+
+    for (int i = 0, b = 0; i < fft->size; i += radix * sub_size, ++b)
+    {
+        /* Butterflies with no non-zero sub-transforms are skipped and
+         * those with only one need no arithmetic. */
+        if (n_live [b] > 1)
+        {
+            atfft_butterfly (fft,
+                             out + i * stride,
+                             stride,
+                             radix,
+                             sub_size,
+                             first,
+                             count,
+                             t_factors,
+                             sin_stride,
+                             sub_transform);
+        }
+        else if (n_live [b])
+        {
+            atfft_replicate_sub_transform (out + i * stride, stride, radix, sub_size, first, count);
+        }
     }
 }
 
 static void atfft_apply_dft_stage (const struct atfft_dft_ct *fft,
                                    atfft_complex *out,
                                    int stride,
-                                   int radix,
-                                   int sub_size,
-                                   atfft_complex *t_factors,
-                                   int sin_stride,
-                                   struct atfft_dft *sub_transform)
+                                   int stage,
+                                   int sin_stride)
 {
-    for (int i = 0; i < fft->size; i += radix * sub_size)
+    int R = fft->radices [stage];
+    int sub_size = fft->sub_sizes [stage];
+    atfft_complex *t_factors = fft->t_factors [stage];
+    struct atfft_dft *sub_transform = fft->radix_sub_transforms [stage];
+    const int *n_live = fft->n_live_sub_transforms [stage];
+
+    /* The required outputs only depend on the bins
+     * first_output % sub_size onwards (cyclically)
+     * of each sub-transform in this stage. */
+    int first = 0;
+    int count = sub_size;
+
+    if (fft->n_outputs < sub_size)
+    {
+        first = fft->first_output % sub_size;
+        count = fft->n_outputs;
+    }
+
+    int wrapped = first + count - sub_size;
+
+    if (wrapped > 0)
     {
-        /* Apply butterfly for this stage of the transform. */
-        atfft_butterfly (fft,
-                         out + i * stride,
-                         stride,
-                         radix,
-                         sub_size,
-                         t_factors,
-                         sin_stride,
-                         sub_transform);
+        atfft_apply_butterflies (fft, out, stride, R, sub_size, first, count - wrapped,
+                                 t_factors, sin_stride, sub_transform, n_live);
+        atfft_apply_butterflies (fft, out, stride, R, sub_size, 0, wrapped,
+                                 t_factors, sin_stride, sub_transform, n_live);
+    }
+    else
+    {
+        atfft_apply_butterflies (fft, out, stride, R, sub_size, first, count,
+                                 t_factors, sin_stride, sub_transform, n_live);
     }
 }
 
@@ -1081,21 +1303,13 @@ static void atfft_compute_dft_iterative (const struct atfft_dft_ct *fft,
 
     while (stage--)
     {
-        int R = fft->radices [stage];
-        int sub_size = fft->sub_sizes [stage];
-        atfft_complex *t_factors = fft->t_factors [stage];
-        struct atfft_dft *sub_transform = fft->radix_sub_transforms [stage];
-
-        sine_stride = sine_stride / R;
+        sine_stride = sine_stride / fft->radices [stage];
 
         atfft_apply_dft_stage (fft,
                                out,
                                out_stride,
-                               R,
-                               sub_size,
-                               t_factors,
-                               sine_stride,
-                               sub_transform);
+                               stage,
+                               sine_stride);
     }
 }
 
@@ -1131,16 +1345,7 @@ void atfft_dft_ct_complex_transform (void *fft,
 
 int atfft_dft_ct_is_fast_size (int size)
 {
-    while (!(size % 2))
-        size /= 2;
-
-    while (!(size % 3))
-        size /= 3;
-
-    while (!(size % 5))
-        size /= 5;
-
-    return size == 1;
+    return atfft_dft_is_fast_size (size);
 }
 
 /******************************************
@@ -1220,6 +1425,16 @@ cJSON* atfft_dft_ct_get_plan (struct atfft_dft_ct *fft)
     if (!(alg && size))
         goto failed;
 
+    if (fft->n_inputs < fft->size || fft->n_outputs < fft->size)
+    {
+        cJSON *n_inputs = cJSON_AddNumberToObject (plan_structure, "Non-Zero Inputs", fft->n_inputs);
+        cJSON *first_output = cJSON_AddNumberToObject (plan_structure, "First Output", fft->first_output);
+        cJSON *n_outputs = cJSON_AddNumberToObject (plan_structure, "Outputs", fft->n_outputs);
+
+        if (!(n_inputs && first_output && n_outputs))
+            goto failed;
+    }
+
     stages = atfft_get_plan_stages (fft);
 
     if (!stages)
@@ -44,6 +44,13 @@ struct atfft_dft_ct* atfft_dft_ct_create (int size,
                                           enum atfft_format format,
                                           enum atfft_dft_ct_method);
 
+struct atfft_dft_ct* atfft_dft_ct_create_pruned (int size,
+                                                 enum atfft_direction direction,
+                                                 enum atfft_format format,
+                                                 int n_inputs,
+                                                 int first_output,
+                                                 int n_outputs);
+
 void atfft_dft_ct_destroy (void *fft);
 
 void atfft_dft_ct_complex_transform (void *fft,
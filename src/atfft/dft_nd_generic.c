@@ -0,0 +1,485 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define ATFFT_DFT_BACKEND native
+#include "dft_backend_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <atfft/dft.h>
+#include <atfft/dft_nd_util.h>
+#include <atfft/dft_util.h>
+#include "atfft_internal.h"
+#include "dft_nd_generic.h"
+
+/* The number of rows transformed before each transpose. Each transpose then
+ * reads or writes this many consecutive elements at a time. */
+#ifndef ATFFT_DFT_ND_BLOCK_SIZE
+#define ATFFT_DFT_ND_BLOCK_SIZE 16
+#endif /* ATFFT_DFT_ND_BLOCK_SIZE */
+
+struct atfft_dft_nd_generic
+{
+    int *dims;
+    int n_dims;
+    enum atfft_direction direction;
+    enum atfft_format format;
+
+    /* plans for dimension sub-transforms */
+    int n_sub_transforms;
+    struct atfft_dft **sub_transforms;
+    struct atfft_dft **dim_sub_transforms;
+
+    /* additional plan for real transforms */
+    struct atfft_dft *real_transform;
+
+    atfft_complex *work_area, *real_backward_work_area;
+    int *strides;
+
+    /* a block of rows waiting to be transposed */
+    atfft_complex *block;
+};
+
+static void* alloc_and_copy_array (const void *array,
+                                   size_t size)
+{
+    void *copy = malloc (size);
+
+    if (!copy)
+        return NULL;
+
+    memcpy (copy, array, size);
+
+    return copy;
+}
+
+static int* init_strides (const int *dims, int n_dims, int data_size, enum atfft_format format)
+{
+    int *strides = malloc (n_dims * sizeof (*strides));
+
+    if (!strides)
+        return NULL;
+
+    int i = 0;
+
+    for (; i < n_dims - 1; ++i)
+    {
+        strides [i] = data_size / dims [i];
+    }
+
+    if (format == ATFFT_REAL)
+        strides [i] = data_size / atfft_halfcomplex_size (dims [i]);
+    else
+        strides [i] = data_size / dims [i];
+
+    return strides;
+}
+
+static int max_dim (const int *dims, int n_dims)
+{
+    int max = 0;
+
+    for (int i = 0; i < n_dims; ++i)
+    {
+        if (dims [i] > max)
+            max = dims [i];
+    }
+
+    return max;
+}
+
+struct atfft_dft_nd_generic* atfft_dft_nd_generic_create (const int *dims,
+                                                          int n_dims,
+                                                          enum atfft_direction direction,
+                                                          enum atfft_format format)
+{
+    struct atfft_dft_nd_generic *fft;
+
+    if (!(fft = calloc (1, sizeof (*fft))))
+        return NULL;
+
+    fft->direction = direction;
+    fft->format = format;
+    fft->n_dims = n_dims;
+
+    /* copy dims array */
+    fft->dims = alloc_and_copy_array (dims, n_dims * sizeof (*(fft->dims)));
+    fft->dim_sub_transforms = calloc (n_dims, sizeof (*(fft->dim_sub_transforms)));
+
+    if (!(fft->dims && fft->dim_sub_transforms))
+        goto failed;
+
+    /* allocate fft structs for each dimension */
+    int n_complex_transforms = n_dims;
+    int data_size = 0;
+
+    if (format == ATFFT_REAL)
+    {
+        /* for real transforms we will use a 1d real transform
+         * for the (n_dims - 1)th dimension */
+        fft->real_transform = atfft_dft_create (dims [n_dims - 1],
+                                                direction,
+                                                ATFFT_REAL);
+
+        n_complex_transforms = n_dims - 1;
+
+        if (!fft->real_transform)
+            goto failed;
+
+        /* work space will be smaller for real transforms */
+        data_size = atfft_nd_halfcomplex_size (dims, n_dims);
+    }
+    else
+    {
+        data_size = atfft_int_array_product (dims, n_dims);
+    }
+
+    fft->sub_transforms = atfft_init_sub_transforms (dims,
+                                                     n_complex_transforms,
+                                                     &(fft->n_sub_transforms),
+                                                     fft->dim_sub_transforms,
+                                                     direction,
+                                                     ATFFT_COMPLEX,
+                                                     0);
+
+    if (!fft->sub_transforms && n_complex_transforms > 0)
+        goto failed;
+
+    /* allocate work space, the halfcomplex rows of a real
+     * transform are never longer than the longest dimension */
+    fft->work_area = malloc (data_size * sizeof (*(fft->work_area)));
+    fft->strides = init_strides (dims, n_dims, data_size, format);
+    fft->block = malloc (ATFFT_DFT_ND_BLOCK_SIZE * max_dim (dims, n_dims) * sizeof (*(fft->block)));
+
+    if (!(fft->work_area && fft->strides && fft->block))
+        goto failed;
+
+    /* for backward real transforms we need an additional working area,
+     * to avoid overwriting the input signal */
+    if (direction == ATFFT_BACKWARD && format == ATFFT_REAL)
+    {
+        fft->real_backward_work_area = malloc (data_size * sizeof (*(fft->work_area)));
+
+        if (!fft->real_backward_work_area)
+            goto failed;
+    }
+
+    return fft;
+
+failed:
+    atfft_dft_nd_generic_destroy (fft);
+    return NULL;
+}
+
+void atfft_dft_nd_generic_destroy (struct atfft_dft_nd_generic *fft)
+{
+    if (fft)
+    {
+        free (fft->block);
+        free (fft->strides);
+        free (fft->real_backward_work_area);
+        free (fft->work_area);
+        atfft_dft_destroy (fft->real_transform);
+        atfft_free_sub_transforms (fft->sub_transforms, fft->n_sub_transforms);
+        free (fft->dim_sub_transforms);
+        free (fft->dims);
+        free (fft);
+    }
+}
+
+static int block_rows (int row, int n_rows)
+{
+    return n_rows - row < ATFFT_DFT_ND_BLOCK_SIZE ? n_rows - row : ATFFT_DFT_ND_BLOCK_SIZE;
+}
+
+/* Write n_rows rows of length size from block into the
+ * columns of out, which are stride elements apart.
+ */
+static void transpose_block_left (atfft_complex *block,
+                                  int n_rows,
+                                  int size,
+                                  atfft_complex *out,
+                                  int stride)
+{
+    for (int i = 0; i < size; ++i)
+    {
+        for (int r = 0; r < n_rows; ++r)
+        {
+            atfft_copy_complex (block [r * size + i], out + r);
+        }
+
+        out += stride;
+    }
+}
+
+/* Read n_columns columns of length size from in, which
+ * are stride elements apart, into the rows of block.
+ */
+static void transpose_block_right (atfft_complex *in,
+                                   int stride,
+                                   atfft_complex *block,
+                                   int n_columns,
+                                   int size)
+{
+    for (int i = 0; i < size; ++i)
+    {
+        for (int c = 0; c < n_columns; ++c)
+        {
+            atfft_copy_complex (in [c], block + c * size + i);
+        }
+
+        in += stride;
+    }
+}
+
+static void complex_transform_and_transpose_left (struct atfft_dft *fft,
+                                                  atfft_complex *in,
+                                                  atfft_complex *out,
+                                                  int size,
+                                                  int stride,
+                                                  atfft_complex *block)
+{
+    for (int i = 0; i < stride; i += ATFFT_DFT_ND_BLOCK_SIZE)
+    {
+        int n_rows = block_rows (i, stride);
+
+        for (int r = 0; r < n_rows; ++r)
+        {
+            atfft_dft_complex_transform (fft, in, block + r * size);
+            in += size;
+        }
+
+        transpose_block_left (block, n_rows, size, out + i, stride);
+    }
+}
+
+static void nd_complex_transform_left (int *dims,
+                                       int *strides,
+                                       struct atfft_dft **sub_transforms,
+                                       int n_dims,
+                                       atfft_complex *in,
+                                       atfft_complex *work_area,
+                                       atfft_complex *block,
+                                       atfft_complex *out)
+{
+    atfft_complex *work_areas[] = {work_area, out};
+    int w = atfft_is_odd (n_dims);
+
+    atfft_complex *current_in = in;
+    atfft_complex *current_out = work_areas [w];
+
+    for (int d = n_dims - 1; d >= 0; --d)
+    {
+        int size = dims [d];
+        int stride = strides [d];
+        struct atfft_dft *sub_transform = sub_transforms [d];
+
+        complex_transform_and_transpose_left (sub_transform,
+                                              current_in,
+                                              current_out,
+                                              size,
+                                              stride,
+                                              block);
+
+        current_in = work_areas [w];
+        w = 1 - w;
+        current_out = work_areas [w];
+    }
+}
+
+static void real_forward_transform_and_transpose_left (struct atfft_dft *fft,
+                                                       const atfft_sample *in,
+                                                       atfft_complex *out,
+                                                       int size,
+                                                       int stride,
+                                                       atfft_complex *block)
+{
+    int halfcomplex_size = atfft_halfcomplex_size (size);
+
+    for (int i = 0; i < stride; i += ATFFT_DFT_ND_BLOCK_SIZE)
+    {
+        int n_rows = block_rows (i, stride);
+
+        for (int r = 0; r < n_rows; ++r)
+        {
+            atfft_dft_real_forward_transform (fft, in, block + r * halfcomplex_size);
+            in += size;
+        }
+
+        transpose_block_left (block, n_rows, halfcomplex_size, out + i, stride);
+    }
+}
+
+static void complex_transform_and_transpose_right (struct atfft_dft *fft,
+                                                   atfft_complex *in,
+                                                   atfft_complex *out,
+                                                   int size,
+                                                   int stride,
+                                                   atfft_complex *block)
+{
+    for (int i = 0; i < stride; i += ATFFT_DFT_ND_BLOCK_SIZE)
+    {
+        int n_columns = block_rows (i, stride);
+
+        transpose_block_right (in + i, stride, block, n_columns, size);
+
+        for (int c = 0; c < n_columns; ++c)
+        {
+            atfft_dft_complex_transform (fft, block + c * size, out);
+            out += size;
+        }
+    }
+}
+
+static void nd_complex_transform_right (int *dims,
+                                        int *strides,
+                                        struct atfft_dft **sub_transforms,
+                                        int n_dims,
+                                        atfft_complex *in,
+                                        atfft_complex *work_area,
+                                        atfft_complex *block,
+                                        atfft_complex *out)
+{
+    atfft_complex *work_areas[] = {work_area, out};
+    int w = atfft_is_odd (n_dims);
+
+    atfft_complex *current_in = in;
+    atfft_complex *current_out = work_areas [w];
+
+    for (int d = 0; d < n_dims; ++d)
+    {
+        int size = dims [d];
+        int stride = strides [d];
+        struct atfft_dft *sub_transform = sub_transforms [d];
+
+        complex_transform_and_transpose_right (sub_transform,
+                                               current_in,
+                                               current_out,
+                                               size,
+                                               stride,
+                                               block);
+
+        current_in = work_areas [w];
+        w = 1 - w;
+        current_out = work_areas [w];
+    }
+}
+
+static void real_backward_transform_and_transpose_right (struct atfft_dft *fft,
+                                                         atfft_complex *in,
+                                                         atfft_sample *out,
+                                                         int size,
+                                                         int stride,
+                                                         atfft_complex *block)
+{
+    int halfcomplex_size = atfft_halfcomplex_size (size);
+
+    for (int i = 0; i < stride; i += ATFFT_DFT_ND_BLOCK_SIZE)
+    {
+        int n_columns = block_rows (i, stride);
+
+        transpose_block_right (in + i, stride, block, n_columns, halfcomplex_size);
+
+        for (int c = 0; c < n_columns; ++c)
+        {
+            atfft_dft_real_backward_transform (fft, block + c * halfcomplex_size, out);
+            out += size;
+        }
+    }
+}
+
+void atfft_dft_nd_generic_complex_transform (struct atfft_dft_nd_generic *fft,
+                                             atfft_complex *in,
+                                             atfft_complex *out)
+{
+    /* Only to be used with complex FFTs. */
+    assert (fft->format == ATFFT_COMPLEX);
+
+    nd_complex_transform_right (fft->dims,
+                                fft->strides,
+                                fft->dim_sub_transforms,
+                                fft->n_dims,
+                                in,
+                                fft->work_area,
+                                fft->block,
+                                out);
+}
+
+void atfft_dft_nd_generic_real_forward_transform (struct atfft_dft_nd_generic *fft,
+                                                  const atfft_sample *in,
+                                                  atfft_complex *out)
+{
+    /* Only to be used for forward real FFTs. */
+    assert ((fft->format == ATFFT_REAL) && (fft->direction == ATFFT_FORWARD));
+
+    /* perform a real transform on the last dimension */
+    atfft_complex *real_transform_out = atfft_is_odd (fft->n_dims) ? out : fft->work_area;
+    int last_dim = fft->n_dims - 1;
+
+    real_forward_transform_and_transpose_left (fft->real_transform,
+                                               in,
+                                               real_transform_out,
+                                               fft->dims [last_dim],
+                                               fft->strides [last_dim],
+                                               fft->block);
+
+    /* do complex transforms for the remaining dimensions */
+    nd_complex_transform_left (fft->dims,
+                               fft->strides,
+                               fft->dim_sub_transforms,
+                               fft->n_dims - 1,
+                               real_transform_out,
+                               fft->work_area,
+                               fft->block,
+                               out);
+}
+
+void atfft_dft_nd_generic_real_backward_transform (struct atfft_dft_nd_generic *fft,
+                                                   atfft_complex *in,
+                                                   atfft_sample *out)
+{
+    /* Only to be used for backward real FFTs. */
+    assert ((fft->format == ATFFT_REAL) && (fft->direction == ATFFT_BACKWARD));
+
+    /* do complex transforms on the first n_dims - 1 dimensions */
+    nd_complex_transform_right (fft->dims,
+                                fft->strides,
+                                fft->dim_sub_transforms,
+                                fft->n_dims - 1,
+                                in,
+                                fft->work_area,
+                                fft->block,
+                                fft->real_backward_work_area);
+
+    /* finally, perform the real transform on the last dimension,
+     * reading the input directly if there were no other dimensions */
+    atfft_complex *real_transform_in = fft->n_dims > 1 ? fft->real_backward_work_area : in;
+    int last_dim = fft->n_dims - 1;
+
+    real_backward_transform_and_transpose_right (fft->real_transform,
+                                                 real_transform_in,
+                                                 out,
+                                                 fft->dims [last_dim],
+                                                 fft->strides [last_dim],
+                                                 fft->block);
+}
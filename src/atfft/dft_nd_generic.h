@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* An n-dimensional DFT built from the 1-D transforms in atfft/dft.h.
+ *
+ * Each dimension is transformed in turn, a block of rows at a time, with
+ * the results transposed into place a tile at a time so that neither the
+ * reads nor the writes stride through memory one element at a time. This
+ * is the n-dimensional implementation for the native transforms and for any
+ * library without one of its own, and the fallback for libraries which only
+ * support some shapes.
+ */
+
+#ifndef ATFFT_DFT_ND_GENERIC_H_INCLUDED
+#define ATFFT_DFT_ND_GENERIC_H_INCLUDED
+
+#include <atfft/types.h>
+
+struct atfft_dft_nd_generic;
+
+struct atfft_dft_nd_generic* atfft_dft_nd_generic_create (const int *dims,
+                                                          int n_dims,
+                                                          enum atfft_direction direction,
+                                                          enum atfft_format format);
+
+void atfft_dft_nd_generic_destroy (struct atfft_dft_nd_generic *fft);
+
+void atfft_dft_nd_generic_complex_transform (struct atfft_dft_nd_generic *fft,
+                                             atfft_complex *in,
+                                             atfft_complex *out);
+
+void atfft_dft_nd_generic_real_forward_transform (struct atfft_dft_nd_generic *fft,
+                                                  const atfft_sample *in,
+                                                  atfft_complex *out);
+
+void atfft_dft_nd_generic_real_backward_transform (struct atfft_dft_nd_generic *fft,
+                                                   atfft_complex *in,
+                                                   atfft_sample *out);
+
+#endif /* ATFFT_DFT_ND_GENERIC_H_INCLUDED */
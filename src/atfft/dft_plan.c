@@ -20,6 +20,9 @@
  * SOFTWARE.
  */
 
+#define ATFFT_DFT_BACKEND native
+#include "dft_backend_internal.h"
+
 #include <stdlib.h>
 #include "atfft_internal.h"
 #include "dft_plan.h"
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <atfft/dft_planner.h>
+
+#ifndef ATFFT_DFT_PLANNING_EFFORT
+#define ATFFT_DFT_PLANNING_EFFORT ATFFT_ESTIMATE
+#endif
+
+static enum atfft_planning_effort atfft_dft_planning_effort = ATFFT_DFT_PLANNING_EFFORT;
+static int atfft_dft_n_threads = 1;
+static char *atfft_dft_wisdom_file = NULL;
+
+void atfft_dft_set_planning_effort (enum atfft_planning_effort effort)
+{
+    atfft_dft_planning_effort = effort;
+}
+
+enum atfft_planning_effort atfft_dft_get_planning_effort (void)
+{
+    return atfft_dft_planning_effort;
+}
+
+void atfft_dft_set_n_threads (int n_threads)
+{
+    assert (n_threads > 0);
+    atfft_dft_n_threads = n_threads;
+}
+
+int atfft_dft_get_n_threads (void)
+{
+    return atfft_dft_n_threads;
+}
+
+int atfft_dft_set_wisdom_file (const char *path)
+{
+    char *wisdom_file = NULL;
+
+    if (path)
+    {
+        if (!(wisdom_file = malloc (strlen (path) + 1)))
+            return 0;
+
+        strcpy (wisdom_file, path);
+    }
+
+    free (atfft_dft_wisdom_file);
+    atfft_dft_wisdom_file = wisdom_file;
+    return 1;
+}
+
+const char* atfft_dft_get_wisdom_file (void)
+{
+    return atfft_dft_wisdom_file;
+}
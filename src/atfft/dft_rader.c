@@ -20,6 +20,9 @@
  * SOFTWARE.
  */
 
+#define ATFFT_DFT_BACKEND native
+#include "dft_backend_internal.h"
+
 #include <math.h>
 #include <stdlib.h>
 #include <assert.h>
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+#include <atfft/dft.h>
+#include <atfft/dft_util.h>
+#include <atfft/dft_unordered.h>
+
+/* Implementations without an unordered transform use ordered DFTs,
+ * spectra are then interleaved complex numbers in the usual order. */
+struct atfft_dft_unordered
+{
+    int size, n_bins;
+    enum atfft_format format;
+    struct atfft_dft *forward, *backward;
+};
+
+int atfft_dft_unordered_is_supported_size (int size, enum atfft_format format)
+{
+    return atfft_dft_is_supported_size (size, format);
+}
+
+struct atfft_dft_unordered* atfft_dft_unordered_create (int size, enum atfft_format format)
+{
+    assert (atfft_dft_unordered_is_supported_size (size, format));
+
+    struct atfft_dft_unordered *dft;
+
+    if (!(dft = calloc (1, sizeof (*dft))))
+        return NULL;
+
+    dft->size = size;
+    dft->format = format;
+    dft->n_bins = format == ATFFT_COMPLEX ? size : atfft_halfcomplex_size (size);
+    dft->forward = atfft_dft_create (size, ATFFT_FORWARD, format);
+    dft->backward = atfft_dft_create (size, ATFFT_BACKWARD, format);
+
+    if (!(dft->forward && dft->backward))
+        goto failed;
+
+    return dft;
+
+failed:
+    atfft_dft_unordered_destroy (dft);
+    return NULL;
+}
+
+void atfft_dft_unordered_destroy (struct atfft_dft_unordered *dft)
+{
+    if (dft)
+    {
+        atfft_dft_destroy (dft->backward);
+        atfft_dft_destroy (dft->forward);
+        free (dft);
+    }
+}
+
+int atfft_dft_unordered_spectrum_size (struct atfft_dft_unordered *dft)
+{
+    return 2 * dft->n_bins;
+}
+
+void atfft_dft_unordered_complex_forward (struct atfft_dft_unordered *dft, atfft_complex *in, atfft_sample *spectrum)
+{
+    assert (dft->format == ATFFT_COMPLEX);
+    atfft_dft_complex_transform (dft->forward, in, (atfft_complex*) spectrum);
+}
+
+void atfft_dft_unordered_complex_backward (struct atfft_dft_unordered *dft, atfft_sample *spectrum, atfft_complex *out)
+{
+    assert (dft->format == ATFFT_COMPLEX);
+    atfft_dft_complex_transform (dft->backward, (atfft_complex*) spectrum, out);
+}
+
+void atfft_dft_unordered_real_forward (struct atfft_dft_unordered *dft, const atfft_sample *in, atfft_sample *spectrum)
+{
+    assert (dft->format == ATFFT_REAL);
+    atfft_dft_real_forward_transform (dft->forward, in, (atfft_complex*) spectrum);
+}
+
+void atfft_dft_unordered_real_backward (struct atfft_dft_unordered *dft, atfft_sample *spectrum, atfft_sample *out)
+{
+    assert (dft->format == ATFFT_REAL);
+    atfft_dft_real_backward_transform (dft->backward, (atfft_complex*) spectrum, out);
+}
+
+void atfft_dft_unordered_convolve_accumulate (struct atfft_dft_unordered *dft,
+                                              const atfft_sample *a,
+                                              const atfft_sample *b,
+                                              atfft_sample scale,
+                                              atfft_sample *ab)
+{
+    for (int i = 0; i < 2 * dft->n_bins; i += 2)
+    {
+        atfft_sample re = a [i] * b [i] - a [i + 1] * b [i + 1];
+        atfft_sample im = a [i] * b [i + 1] + a [i + 1] * b [i];
+
+        ab [i] += re * scale;
+        ab [i + 1] += im * scale;
+    }
+}
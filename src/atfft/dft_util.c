@@ -28,6 +28,54 @@ int atfft_halfcomplex_size (int size)
     return size / 2 + 1;
 }
 
+int atfft_dft_is_fast_size (int size)
+{
+    if (size < 1)
+        return 0;
+
+    while (!(size % 2))
+        size /= 2;
+
+    while (!(size % 3))
+        size /= 3;
+
+    while (!(size % 5))
+        size /= 5;
+
+    return size == 1;
+}
+
+int atfft_dft_next_fast_size (int min_size)
+{
+    while (!atfft_dft_is_fast_size (min_size))
+        ++min_size;
+
+    return min_size;
+}
+
+int atfft_dft_is_valid_pruning (int size,
+                                enum atfft_direction direction,
+                                enum atfft_format format,
+                                int n_inputs,
+                                int first_output,
+                                int n_outputs)
+{
+    int input_size = size;
+    int output_size = size;
+
+    if (format == ATFFT_REAL)
+    {
+        if (direction == ATFFT_FORWARD)
+            output_size = atfft_halfcomplex_size (size);
+        else
+            input_size = atfft_halfcomplex_size (size);
+    }
+
+    return n_inputs > 0 && n_inputs <= input_size &&
+           first_output >= 0 && n_outputs > 0 &&
+           first_output + n_outputs <= output_size;
+}
+
 void atfft_halfcomplex_to_complex (atfft_complex *in, atfft_complex *out, int size)
 {
     int last_bin = atfft_halfcomplex_size (size);
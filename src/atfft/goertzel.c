@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <atfft/goertzel.h>
+#include "atfft_internal.h"
+
+/* The number of filters run side by side in the inner loop. */
+#define ATFFT_GOERTZEL_LANES 16
+
+/* For bin k, with w = 2 pi k / N, each filter runs
+ *
+ *     s (n) = x (n) + 2 cos (w) s (n - 1) - s (n - 2)
+ *
+ * over the block, then X (k) = e^(jw) s (N - 1) - s (N - 2).
+ * The coefficients are padded to a whole number of lanes. */
+struct atfft_goertzel
+{
+    int size, n_bins, n_lanes;
+    atfft_sample *coefficients;
+    atfft_sample *twiddles_re, *twiddles_im;
+};
+
+struct atfft_goertzel* atfft_goertzel_create (int size, const int *bins, int n_bins)
+{
+    assert (size > 0 && n_bins > 0);
+
+    struct atfft_goertzel *goertzel;
+    int n_lanes = ((n_bins + ATFFT_GOERTZEL_LANES - 1) / ATFFT_GOERTZEL_LANES) * ATFFT_GOERTZEL_LANES;
+
+    if (!(goertzel = calloc (1, sizeof (*goertzel))))
+        return NULL;
+
+    goertzel->size = size;
+    goertzel->n_bins = n_bins;
+    goertzel->n_lanes = n_lanes;
+
+    goertzel->coefficients = calloc (n_lanes, sizeof (*(goertzel->coefficients)));
+    goertzel->twiddles_re = malloc (n_bins * sizeof (*(goertzel->twiddles_re)));
+    goertzel->twiddles_im = malloc (n_bins * sizeof (*(goertzel->twiddles_im)));
+
+    if (!(goertzel->coefficients && goertzel->twiddles_re && goertzel->twiddles_im))
+        goto failed;
+
+    for (int b = 0; b < n_bins; ++b)
+    {
+        atfft_complex t;
+
+        assert (bins [b] >= 0 && bins [b] < size);
+
+        atfft_twiddle_factor (bins [b], size, ATFFT_BACKWARD, &t);
+        goertzel->coefficients [b] = 2.0 * ATFFT_RE (t);
+        goertzel->twiddles_re [b] = ATFFT_RE (t);
+        goertzel->twiddles_im [b] = ATFFT_IM (t);
+    }
+
+    return goertzel;
+
+failed:
+    atfft_goertzel_destroy (goertzel);
+    return NULL;
+}
+
+void atfft_goertzel_destroy (struct atfft_goertzel *goertzel)
+{
+    if (goertzel)
+    {
+        free (goertzel->twiddles_im);
+        free (goertzel->twiddles_re);
+        free (goertzel->coefficients);
+        free (goertzel);
+    }
+}
+
+void atfft_goertzel_transform (struct atfft_goertzel *goertzel, const atfft_sample *in, atfft_complex *out)
+{
+    for (int g = 0; g < goertzel->n_lanes; g += ATFFT_GOERTZEL_LANES)
+    {
+        /* Keep the filter states for a group of bins in
+         * local arrays so the sample loop runs in registers. */
+        atfft_sample c [ATFFT_GOERTZEL_LANES];
+        atfft_sample s1 [ATFFT_GOERTZEL_LANES] = {0};
+        atfft_sample s2 [ATFFT_GOERTZEL_LANES] = {0};
+
+        memcpy (c, goertzel->coefficients + g, sizeof (c));
+
+        /* Two samples at a time, alternating which array holds the newest
+         * state to avoid copying. s (n - 2) is subtracted from the input
+         * first to keep it off the dependency chain. */
+        int n = 0;
+
+        for (; n + 1 < goertzel->size; n += 2)
+        {
+            atfft_sample x0 = in [n];
+            atfft_sample x1 = in [n + 1];
+
+            for (int l = 0; l < ATFFT_GOERTZEL_LANES; ++l)
+                s2 [l] = c [l] * s1 [l] + (x0 - s2 [l]);
+
+            for (int l = 0; l < ATFFT_GOERTZEL_LANES; ++l)
+                s1 [l] = c [l] * s2 [l] + (x1 - s1 [l]);
+        }
+
+        if (n < goertzel->size)
+        {
+            for (int l = 0; l < ATFFT_GOERTZEL_LANES; ++l)
+            {
+                atfft_sample s0 = c [l] * s1 [l] + (in [n] - s2 [l]);
+                s2 [l] = s1 [l];
+                s1 [l] = s0;
+            }
+        }
+
+        for (int l = 0; l < ATFFT_GOERTZEL_LANES && g + l < goertzel->n_bins; ++l)
+        {
+            int b = g + l;
+
+            ATFFT_RE (out [b]) = goertzel->twiddles_re [b] * s1 [l] - s2 [l];
+            ATFFT_IM (out [b]) = goertzel->twiddles_im [b] * s1 [l];
+        }
+    }
+}
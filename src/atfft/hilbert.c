@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+#include <atfft/dft.h>
+#include <atfft/dft_util.h>
+#include <atfft/windows.h>
+#include <atfft/convolver.h>
+#include <atfft/hilbert.h>
+#include "constants.h"
+
+/* The spectrum buffer is the input of the inverse complex transform. The
+ * forward real transform only ever writes its first halfcomplex_size bins,
+ * the rest are zeroed once here and stay that way. */
+struct atfft_hilbert
+{
+    int size, n_bins;
+    struct atfft_dft *forward, *backward;
+    atfft_complex *spectrum;
+    atfft_complex *analytic;
+};
+
+struct atfft_hilbert* atfft_hilbert_create (int size)
+{
+    assert (size > 0);
+
+    struct atfft_hilbert *hilbert;
+    int n_bins = atfft_halfcomplex_size (size);
+
+    if (!(hilbert = calloc (1, sizeof (*hilbert))))
+        return NULL;
+
+    hilbert->size = size;
+    hilbert->n_bins = n_bins;
+
+    hilbert->forward = atfft_dft_create (size, ATFFT_FORWARD, ATFFT_REAL);
+    hilbert->backward = atfft_dft_create_pruned (size, ATFFT_BACKWARD, ATFFT_COMPLEX, n_bins, 0, size);
+    hilbert->spectrum = calloc (size, sizeof (*(hilbert->spectrum)));
+    hilbert->analytic = malloc (size * sizeof (*(hilbert->analytic)));
+
+    if (!(hilbert->forward && hilbert->backward && hilbert->spectrum && hilbert->analytic))
+        goto failed;
+
+    return hilbert;
+
+failed:
+    atfft_hilbert_destroy (hilbert);
+    return NULL;
+}
+
+void atfft_hilbert_destroy (struct atfft_hilbert *hilbert)
+{
+    if (hilbert)
+    {
+        free (hilbert->analytic);
+        free (hilbert->spectrum);
+        atfft_dft_destroy (hilbert->backward);
+        atfft_dft_destroy (hilbert->forward);
+        free (hilbert);
+    }
+}
+
+void atfft_hilbert_transform (struct atfft_hilbert *hilbert, const atfft_sample *in, atfft_complex *out)
+{
+    atfft_complex *s = hilbert->spectrum;
+    atfft_sample dc_scale = 1.0 / hilbert->size;
+    atfft_sample scale = 2.0 / hilbert->size;
+    int last = hilbert->n_bins;
+
+    atfft_dft_real_forward_transform (hilbert->forward, in, s);
+
+    /* Double the positive frequencies and normalise, leaving DC
+     * and (for even sizes) Nyquist with their original weight. */
+    ATFFT_RE (s [0]) *= dc_scale;
+    ATFFT_IM (s [0]) *= dc_scale;
+
+    if (atfft_is_even (hilbert->size))
+    {
+        --last;
+        ATFFT_RE (s [last]) *= dc_scale;
+        ATFFT_IM (s [last]) *= dc_scale;
+    }
+
+    for (int k = 1; k < last; ++k)
+    {
+        ATFFT_RE (s [k]) *= scale;
+        ATFFT_IM (s [k]) *= scale;
+    }
+
+    atfft_dft_complex_transform (hilbert->backward, s, out);
+}
+
+void atfft_hilbert_envelope (struct atfft_hilbert *hilbert, const atfft_sample *in, atfft_sample *envelope)
+{
+    atfft_complex *z = hilbert->analytic;
+
+    atfft_hilbert_transform (hilbert, in, z);
+
+    for (int i = 0; i < hilbert->size; ++i)
+    {
+        envelope [i] = sqrt (ATFFT_RE (z [i]) * ATFFT_RE (z [i]) + ATFFT_IM (z [i]) * ATFFT_IM (z [i]));
+    }
+}
+
+/* The real part of the output is the input delayed by half the filter
+ * length, held in a ring buffer, the imaginary part comes from the
+ * convolver a block at a time. */
+struct atfft_hilbert_stream
+{
+    int block_size, latency;
+    struct atfft_convolver *convolver;
+
+    atfft_sample *history;
+    int position;
+
+    /* working space */
+    atfft_sample *real, *imaginary;
+};
+
+static void atfft_hilbert_transformer (atfft_sample *filter, int size)
+{
+    int half = size / 2;
+
+    /* The ideal Hilbert transformer is 2 / (pi n) for odd n and zero
+     * for even n, it is windowed and delayed to make it finite and causal. */
+    atfft_blackman_window (filter, size, ATFFT_SYMMETRIC);
+
+    for (int i = 0; i < size; ++i)
+    {
+        int n = i - half;
+
+        if (atfft_is_odd (n))
+            filter [i] *= 2.0 / (M_PI * n);
+        else
+            filter [i] = 0.0;
+    }
+}
+
+struct atfft_hilbert_stream* atfft_hilbert_stream_create (int block_size, int filter_size)
+{
+    assert (block_size > 0);
+    assert (filter_size >= 3 && atfft_is_odd (filter_size));
+
+    struct atfft_hilbert_stream *stream;
+    atfft_sample *filter = NULL;
+
+    if (!(stream = calloc (1, sizeof (*stream))))
+        return NULL;
+
+    stream->block_size = block_size;
+    stream->latency = filter_size / 2;
+
+    filter = malloc (filter_size * sizeof (*filter));
+    stream->history = malloc (stream->latency * sizeof (*(stream->history)));
+    stream->real = malloc (block_size * sizeof (*(stream->real)));
+    stream->imaginary = malloc (block_size * sizeof (*(stream->imaginary)));
+
+    if (!(filter && stream->history && stream->real && stream->imaginary))
+        goto failed;
+
+    atfft_hilbert_transformer (filter, filter_size);
+    stream->convolver = atfft_convolver_create (filter, filter_size, block_size);
+
+    if (!stream->convolver)
+        goto failed;
+
+    free (filter);
+    atfft_hilbert_stream_reset (stream);
+    return stream;
+
+failed:
+    free (filter);
+    atfft_hilbert_stream_destroy (stream);
+    return NULL;
+}
+
+void atfft_hilbert_stream_destroy (struct atfft_hilbert_stream *stream)
+{
+    if (stream)
+    {
+        free (stream->imaginary);
+        free (stream->real);
+        free (stream->history);
+        atfft_convolver_destroy (stream->convolver);
+        free (stream);
+    }
+}
+
+int atfft_hilbert_stream_latency (struct atfft_hilbert_stream *stream)
+{
+    return stream->latency;
+}
+
+static void atfft_hilbert_stream_block (struct atfft_hilbert_stream *stream, const atfft_sample *in)
+{
+    atfft_convolver_process (stream->convolver, in, stream->imaginary);
+
+    for (int i = 0; i < stream->block_size; ++i)
+    {
+        stream->real [i] = stream->history [stream->position];
+        stream->history [stream->position] = in [i];
+
+        if (++stream->position == stream->latency)
+            stream->position = 0;
+    }
+}
+
+void atfft_hilbert_stream_transform (struct atfft_hilbert_stream *stream,
+                                     const atfft_sample *in,
+                                     int size,
+                                     atfft_complex *out)
+{
+    assert (size % stream->block_size == 0);
+
+    for (int b = 0; b < size; b += stream->block_size)
+    {
+        atfft_hilbert_stream_block (stream, in + b);
+
+        for (int i = 0; i < stream->block_size; ++i)
+        {
+            ATFFT_RE (out [b + i]) = stream->real [i];
+            ATFFT_IM (out [b + i]) = stream->imaginary [i];
+        }
+    }
+}
+
+void atfft_hilbert_stream_envelope (struct atfft_hilbert_stream *stream,
+                                    const atfft_sample *in,
+                                    int size,
+                                    atfft_sample *envelope)
+{
+    assert (size % stream->block_size == 0);
+
+    for (int b = 0; b < size; b += stream->block_size)
+    {
+        atfft_hilbert_stream_block (stream, in + b);
+
+        for (int i = 0; i < stream->block_size; ++i)
+        {
+            envelope [b + i] = sqrt (stream->real [i] * stream->real [i] +
+                                     stream->imaginary [i] * stream->imaginary [i]);
+        }
+    }
+}
+
+void atfft_hilbert_stream_reset (struct atfft_hilbert_stream *stream)
+{
+    atfft_convolver_reset (stream->convolver);
+    memset (stream->history, 0, stream->latency * sizeof (*(stream->history)));
+    stream->position = 0;
+}
@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <atfft/dft.h>
+#include <atfft/dft_util.h>
+#include <atfft/psd.h>
+
+/* Each worker accumulates the power of a run of segments with its own
+ * DFT plan, as plans have working space and can't be shared between
+ * threads. The end of each worker's frame stays zero for padding. */
+struct atfft_psd_worker
+{
+    struct atfft_psd *psd;
+    struct atfft_dft *dft;
+    atfft_sample *frame;
+    atfft_complex *spectrum;
+    atfft_sample *power;
+
+    /* the segments to accumulate */
+    const atfft_sample *in;
+    int first_segment, n_segments;
+};
+
+/* A trend a + b * t, where t is centred on the middle of the segment,
+ * windows to a * w + b * t * w. Its spectrum is therefore
+ * a * window_spectrum + b * ramp_spectrum, which is subtracted from the
+ * spectrum of the windowed segment rather than removing the trend from
+ * the segment in a separate pass. */
+struct atfft_psd
+{
+    int segment_size, hop_size, fft_size, n_bins, n_threads;
+    enum atfft_psd_detrend detrend;
+    atfft_sample *window;
+    atfft_complex *window_spectrum, *ramp_spectrum;
+    atfft_sample ramp_scale, scale;
+
+    struct atfft_psd_worker *workers;
+    pthread_t *threads;
+    int *started;
+};
+
+static atfft_sample atfft_psd_ramp (int i, int segment_size)
+{
+    return i - (segment_size - 1) / 2.0;
+}
+
+/* Take the spectrum of a windowed segment, the first worker's buffers are used. */
+static int atfft_psd_window_spectrum (struct atfft_psd *psd, int ramp, atfft_complex **spectrum)
+{
+    struct atfft_psd_worker *worker = psd->workers;
+
+    if (!(*spectrum = malloc (psd->n_bins * sizeof (**spectrum))))
+        return 0;
+
+    for (int i = 0; i < psd->segment_size; ++i)
+        worker->frame [i] = ramp ? atfft_psd_ramp (i, psd->segment_size) * psd->window [i] : psd->window [i];
+
+    atfft_dft_real_forward_transform (worker->dft, worker->frame, *spectrum);
+    return 1;
+}
+
+struct atfft_psd* atfft_psd_create (int segment_size,
+                                    int hop_size,
+                                    int fft_size,
+                                    enum atfft_window_type window,
+                                    enum atfft_psd_detrend detrend,
+                                    int n_threads)
+{
+    assert (hop_size > 0 && hop_size <= segment_size);
+    assert (fft_size >= segment_size);
+    assert (n_threads > 0);
+
+    struct atfft_psd *psd;
+    atfft_sample window_power = 0.0, ramp_power = 0.0;
+
+    if (!(psd = calloc (1, sizeof (*psd))))
+        return NULL;
+
+    psd->segment_size = segment_size;
+    psd->hop_size = hop_size;
+    psd->fft_size = fft_size;
+    psd->n_bins = atfft_halfcomplex_size (fft_size);
+    psd->n_threads = n_threads;
+    psd->detrend = detrend;
+
+    psd->window = malloc (segment_size * sizeof (*(psd->window)));
+
+    psd->threads = malloc (n_threads * sizeof (*(psd->threads)));
+    psd->started = malloc (n_threads * sizeof (*(psd->started)));
+
+    if (!(psd->window && psd->threads && psd->started &&
+          (psd->workers = calloc (n_threads, sizeof (*(psd->workers))))))
+        goto failed;
+
+    for (int t = 0; t < n_threads; ++t)
+    {
+        struct atfft_psd_worker *worker = psd->workers + t;
+
+        worker->psd = psd;
+        worker->dft = atfft_dft_create (fft_size, ATFFT_FORWARD, ATFFT_REAL);
+        worker->frame = calloc (fft_size, sizeof (*(worker->frame)));
+        worker->spectrum = malloc (psd->n_bins * sizeof (*(worker->spectrum)));
+        worker->power = malloc (psd->n_bins * sizeof (*(worker->power)));
+
+        if (!(worker->dft && worker->frame && worker->spectrum && worker->power))
+            goto failed;
+    }
+
+    atfft_window (psd->window, segment_size, window, ATFFT_PERIODIC);
+
+    for (int i = 0; i < segment_size; ++i)
+    {
+        atfft_sample t = atfft_psd_ramp (i, segment_size);
+
+        window_power += psd->window [i] * psd->window [i];
+        ramp_power += t * t;
+    }
+
+    psd->scale = 1.0 / window_power;
+    psd->ramp_scale = ramp_power > 0.0 ? 1.0 / ramp_power : 0.0;
+
+    if (detrend != ATFFT_PSD_NO_DETREND && !atfft_psd_window_spectrum (psd, 0, &psd->window_spectrum))
+        goto failed;
+
+    if (detrend == ATFFT_PSD_LINEAR_DETREND && !atfft_psd_window_spectrum (psd, 1, &psd->ramp_spectrum))
+        goto failed;
+
+    return psd;
+
+failed:
+    atfft_psd_destroy (psd);
+    return NULL;
+}
+
+void atfft_psd_destroy (struct atfft_psd *psd)
+{
+    if (psd)
+    {
+        if (psd->workers)
+        {
+            for (int t = 0; t < psd->n_threads; ++t)
+            {
+                free (psd->workers [t].power);
+                free (psd->workers [t].spectrum);
+                free (psd->workers [t].frame);
+                atfft_dft_destroy (psd->workers [t].dft);
+            }
+        }
+
+        free (psd->workers);
+        free (psd->started);
+        free (psd->threads);
+        free (psd->ramp_spectrum);
+        free (psd->window_spectrum);
+        free (psd->window);
+        free (psd);
+    }
+}
+
+int atfft_psd_n_segments (struct atfft_psd *psd, int size)
+{
+    return size < psd->segment_size ? 0 : 1 + (size - psd->segment_size) / psd->hop_size;
+}
+
+/* Window a segment into the DFT input, summing the samples and the
+ * samples times the ramp for the detrending as we go. */
+static void atfft_psd_window_segment (struct atfft_psd *psd,
+                                      const atfft_sample *in,
+                                      atfft_sample *frame,
+                                      atfft_sample *sum,
+                                      atfft_sample *ramp_sum)
+{
+    const atfft_sample *window = psd->window;
+    int size = psd->segment_size;
+    atfft_sample s = 0.0, r = 0.0;
+
+    switch (psd->detrend)
+    {
+        case ATFFT_PSD_NO_DETREND:
+            for (int i = 0; i < size; ++i)
+                frame [i] = in [i] * window [i];
+
+            break;
+
+        case ATFFT_PSD_CONSTANT_DETREND:
+            for (int i = 0; i < size; ++i)
+            {
+                frame [i] = in [i] * window [i];
+                s += in [i];
+            }
+
+            break;
+
+        case ATFFT_PSD_LINEAR_DETREND:
+            for (int i = 0; i < size; ++i)
+            {
+                frame [i] = in [i] * window [i];
+                s += in [i];
+                r += atfft_psd_ramp (i, size) * in [i];
+            }
+
+            break;
+    }
+
+    *sum = s;
+    *ramp_sum = r;
+}
+
+static void atfft_psd_accumulate_power (atfft_complex *spectrum, atfft_sample *power, int n_bins)
+{
+    for (int k = 0; k < n_bins; ++k)
+        power [k] += ATFFT_RE (spectrum [k]) * ATFFT_RE (spectrum [k]) +
+                     ATFFT_IM (spectrum [k]) * ATFFT_IM (spectrum [k]);
+}
+
+static void atfft_psd_accumulate_detrended_power (atfft_complex *spectrum,
+                                                  atfft_complex *window_spectrum,
+                                                  atfft_sample offset,
+                                                  atfft_complex *ramp_spectrum,
+                                                  atfft_sample slope,
+                                                  atfft_sample *power,
+                                                  int n_bins)
+{
+    for (int k = 0; k < n_bins; ++k)
+    {
+        atfft_sample re = ATFFT_RE (spectrum [k]) -
+                          offset * ATFFT_RE (window_spectrum [k]) -
+                          slope * ATFFT_RE (ramp_spectrum [k]);
+        atfft_sample im = ATFFT_IM (spectrum [k]) -
+                          offset * ATFFT_IM (window_spectrum [k]) -
+                          slope * ATFFT_IM (ramp_spectrum [k]);
+
+        power [k] += re * re + im * im;
+    }
+}
+
+static void* atfft_psd_run_worker (void *arg)
+{
+    struct atfft_psd_worker *worker = arg;
+    struct atfft_psd *psd = worker->psd;
+    int n_bins = psd->n_bins;
+
+    memset (worker->power, 0, n_bins * sizeof (*(worker->power)));
+
+    for (int s = 0; s < worker->n_segments; ++s)
+    {
+        const atfft_sample *segment = worker->in + (worker->first_segment + s) * psd->hop_size;
+        atfft_sample sum, ramp_sum;
+
+        atfft_psd_window_segment (psd, segment, worker->frame, &sum, &ramp_sum);
+        atfft_dft_real_forward_transform (worker->dft, worker->frame, worker->spectrum);
+
+        if (psd->detrend == ATFFT_PSD_NO_DETREND)
+        {
+            atfft_psd_accumulate_power (worker->spectrum, worker->power, n_bins);
+        }
+        else
+        {
+            /* Without a linear trend the slope is zero, so any spectrum will do for the ramp. */
+            atfft_complex *ramp_spectrum = psd->ramp_spectrum ? psd->ramp_spectrum : psd->window_spectrum;
+
+            atfft_psd_accumulate_detrended_power (worker->spectrum,
+                                                  psd->window_spectrum,
+                                                  sum / psd->segment_size,
+                                                  ramp_spectrum,
+                                                  ramp_sum * psd->ramp_scale,
+                                                  worker->power,
+                                                  n_bins);
+        }
+    }
+
+    return NULL;
+}
+
+void atfft_psd_transform (struct atfft_psd *psd, const atfft_sample *in, int size, atfft_sample *out)
+{
+    int n_segments = atfft_psd_n_segments (psd, size);
+    int n_threads = psd->n_threads;
+    int n_bins = psd->n_bins;
+    int first_segment = 0;
+    atfft_sample scale;
+
+    assert (n_segments > 0);
+
+    /* Split the segments into contiguous runs, one per worker. */
+    for (int t = 0; t < n_threads; ++t)
+    {
+        struct atfft_psd_worker *worker = psd->workers + t;
+
+        worker->in = in;
+        worker->first_segment = first_segment;
+        worker->n_segments = n_segments / n_threads + (t < n_segments % n_threads);
+        first_segment += worker->n_segments;
+    }
+
+    /* The first run is accumulated on this thread, as are any runs
+     * whose thread could not be started. */
+    for (int t = 1; t < n_threads; ++t)
+        psd->started [t] = pthread_create (psd->threads + t, NULL, atfft_psd_run_worker, psd->workers + t) == 0;
+
+    atfft_psd_run_worker (psd->workers);
+
+    for (int t = 1; t < n_threads; ++t)
+    {
+        if (psd->started [t])
+            pthread_join (psd->threads [t], NULL);
+        else
+            atfft_psd_run_worker (psd->workers + t);
+    }
+
+    memcpy (out, psd->workers [0].power, n_bins * sizeof (*out));
+
+    for (int t = 1; t < n_threads; ++t)
+    {
+        for (int k = 0; k < n_bins; ++k)
+            out [k] += psd->workers [t].power [k];
+    }
+
+    /* Average, normalise and fold the negative frequencies onto the positive ones. */
+    scale = psd->scale / n_segments;
+
+    for (int k = 0; k < n_bins; ++k)
+        out [k] *= k == 0 || 2 * k == psd->fft_size ? scale : 2.0 * scale;
+}
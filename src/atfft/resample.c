@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+#include <atfft/dft.h>
+#include <atfft/dft_util.h>
+#include <atfft/windows.h>
+#include <atfft/resample.h>
+#include "constants.h"
+
+/* The halfcomplex spectrum of the output is zeroed once, bins above those
+ * shared with the input are never written so stay zero. */
+struct atfft_resample
+{
+    int in_size, out_size, n_bins;
+    struct atfft_dft *forward, *backward;
+    atfft_complex *in_spectrum, *out_spectrum;
+};
+
+/* Each block holds margin_in samples of history, which the first outputs
+ * of the block need, hop_in new samples, whose outputs are kept, and
+ * margin_in samples of lookahead, which the last outputs need. The filter
+ * response is real as the filter is zero-phase, and has the DFT
+ * normalisation folded into it. */
+struct atfft_resample_stream
+{
+    int up, down;
+    int in_size, out_size, n_bins;
+    int margin_in, margin_out, hop_in, hop_out;
+    struct atfft_dft *forward, *backward;
+    atfft_sample *response;
+
+    /* working space */
+    atfft_sample *block, *out_block;
+    atfft_complex *in_spectrum, *out_spectrum;
+};
+
+struct atfft_resample* atfft_resample_create (int in_size, int out_size)
+{
+    assert (in_size > 0 && out_size > 0);
+
+    struct atfft_resample *resample;
+
+    if (!(atfft_dft_is_supported_size (in_size, ATFFT_REAL) && atfft_dft_is_supported_size (out_size, ATFFT_REAL)))
+        return NULL;
+
+    if (!(resample = calloc (1, sizeof (*resample))))
+        return NULL;
+
+    resample->in_size = in_size;
+    resample->out_size = out_size;
+    resample->n_bins = ATFFT_MIN (atfft_halfcomplex_size (in_size), atfft_halfcomplex_size (out_size));
+
+    resample->forward = atfft_dft_create (in_size, ATFFT_FORWARD, ATFFT_REAL);
+    resample->backward = atfft_dft_create (out_size, ATFFT_BACKWARD, ATFFT_REAL);
+    resample->in_spectrum = malloc (atfft_halfcomplex_size (in_size) * sizeof (*(resample->in_spectrum)));
+    resample->out_spectrum = calloc (atfft_halfcomplex_size (out_size), sizeof (*(resample->out_spectrum)));
+
+    if (!(resample->forward && resample->backward && resample->in_spectrum && resample->out_spectrum))
+        goto failed;
+
+    return resample;
+
+failed:
+    atfft_resample_destroy (resample);
+    return NULL;
+}
+
+void atfft_resample_destroy (struct atfft_resample *resample)
+{
+    if (resample)
+    {
+        free (resample->out_spectrum);
+        free (resample->in_spectrum);
+        atfft_dft_destroy (resample->backward);
+        atfft_dft_destroy (resample->forward);
+        free (resample);
+    }
+}
+
+void atfft_resample_transform (struct atfft_resample *resample, const atfft_sample *in, atfft_sample *out)
+{
+    int in_size = resample->in_size;
+    int out_size = resample->out_size;
+    int n_bins = resample->n_bins;
+    atfft_sample scale = 1.0 / in_size;
+
+    atfft_dft_real_forward_transform (resample->forward, in, resample->in_spectrum);
+
+    for (int k = 0; k < n_bins; ++k)
+    {
+        ATFFT_RE (resample->out_spectrum [k]) = ATFFT_RE (resample->in_spectrum [k]) * scale;
+        ATFFT_IM (resample->out_spectrum [k]) = ATFFT_IM (resample->in_spectrum [k]) * scale;
+    }
+
+    /* When downsampling to an even length the output's Nyquist bin gathers
+     * the input bins either side of it, which are conjugates. When
+     * upsampling from an even length the input's Nyquist bin is shared
+     * between the output bins either side of zero. */
+    if (out_size < in_size && atfft_is_even (out_size))
+    {
+        ATFFT_RE (resample->out_spectrum [out_size / 2]) *= 2.0;
+        ATFFT_IM (resample->out_spectrum [out_size / 2]) = 0.0;
+    }
+    else if (in_size < out_size && atfft_is_even (in_size))
+    {
+        ATFFT_RE (resample->out_spectrum [in_size / 2]) *= 0.5;
+        ATFFT_IM (resample->out_spectrum [in_size / 2]) = 0.0;
+    }
+
+    atfft_dft_real_backward_transform (resample->backward, resample->out_spectrum, out);
+}
+
+static int atfft_gcd (int a, int b)
+{
+    while (b)
+    {
+        int r = a % b;
+        a = b;
+        b = r;
+    }
+
+    return a;
+}
+
+/* Choose the block length as a multiple of down, whose multiplier is a
+ * fast size, with the lowest cost per output sample. Lengths the DFT
+ * implementation doesn't support are skipped, 0 is returned if there are
+ * none. */
+static int atfft_resample_block_multiplier (int up, int down, int margin_in)
+{
+    int min_multiplier = (4 * margin_in + down - 1) / down;
+    int best = 0;
+    double best_cost = 0.0;
+
+    for (int k = atfft_dft_next_fast_size (min_multiplier);
+         k <= 4 * min_multiplier;
+         k = atfft_dft_next_fast_size (k + 1))
+    {
+        double in_size = (double) k * down;
+        double out_size = (double) k * up;
+        double hop_out = (in_size - 2 * margin_in) * up / down;
+        double cost = (in_size * log2 (in_size) + out_size * log2 (out_size)) / hop_out;
+
+        if (!(atfft_dft_is_supported_size (k * down, ATFFT_REAL) && atfft_dft_is_supported_size (k * up, ATFFT_REAL)))
+            continue;
+
+        if (!best || cost < best_cost)
+        {
+            best = k;
+            best_cost = cost;
+        }
+    }
+
+    return best;
+}
+
+/* Find the frequency response of a zero-phase Blackman windowed sinc, the
+ * centre tap at the start of the block and the earlier taps wrapped
+ * around to its end. */
+static void atfft_resample_stream_design_filter (struct atfft_resample_stream *stream,
+                                                 int filter_size,
+                                                 atfft_sample cutoff)
+{
+    int half = filter_size / 2;
+    atfft_sample *window = stream->out_block;
+    atfft_sample sum = 0.0;
+
+    atfft_blackman_window (window, filter_size, ATFFT_SYMMETRIC);
+    memset (stream->block, 0, stream->in_size * sizeof (*(stream->block)));
+
+    for (int i = -half; i <= half; ++i)
+    {
+        atfft_sample x = 2.0 * M_PI * cutoff * i;
+        atfft_sample tap = window [i + half] * (i ? sin (x) / x : 1.0);
+
+        stream->block [(i + stream->in_size) % stream->in_size] = tap;
+        sum += tap;
+    }
+
+    atfft_dft_real_forward_transform (stream->forward, stream->block, stream->in_spectrum);
+
+    for (int k = 0; k < stream->n_bins; ++k)
+        stream->response [k] = ATFFT_RE (stream->in_spectrum [k]) / (sum * stream->in_size);
+}
+
+struct atfft_resample_stream* atfft_resample_stream_create (int in_rate, int out_rate, int filter_size)
+{
+    assert (in_rate > 0 && out_rate > 0);
+    assert (atfft_is_odd (filter_size));
+
+    struct atfft_resample_stream *stream;
+    int gcd = atfft_gcd (in_rate, out_rate);
+    int up = out_rate / gcd;
+    int down = in_rate / gcd;
+    int half = filter_size / 2;
+    int multiplier = 0;
+
+    /* The cutoff is placed so the transition band of the window ends at
+     * the lower Nyquist frequency. */
+    atfft_sample cutoff = 0.5 * ATFFT_MIN (1.0, (atfft_sample) up / down) - 2.75 / filter_size;
+
+    assert (cutoff > 0.0);
+
+    if (!(stream = calloc (1, sizeof (*stream))))
+        return NULL;
+
+    stream->up = up;
+    stream->down = down;
+    stream->margin_in = ((half + 1 + down - 1) / down) * down;
+    stream->margin_out = stream->margin_in / down * up;
+
+    if (!(multiplier = atfft_resample_block_multiplier (up, down, stream->margin_in)))
+        goto failed;
+
+    stream->in_size = multiplier * down;
+    stream->out_size = multiplier * up;
+    stream->hop_in = stream->in_size - 2 * stream->margin_in;
+    stream->hop_out = stream->hop_in / down * up;
+    stream->n_bins = ATFFT_MIN (atfft_halfcomplex_size (stream->in_size), atfft_halfcomplex_size (stream->out_size));
+
+    stream->forward = atfft_dft_create (stream->in_size, ATFFT_FORWARD, ATFFT_REAL);
+    stream->backward = atfft_dft_create (stream->out_size, ATFFT_BACKWARD, ATFFT_REAL);
+    stream->response = malloc (stream->n_bins * sizeof (*(stream->response)));
+    stream->block = malloc (stream->in_size * sizeof (*(stream->block)));
+    stream->out_block = malloc (ATFFT_MAX (stream->out_size, filter_size) * sizeof (*(stream->out_block)));
+    stream->in_spectrum = malloc (atfft_halfcomplex_size (stream->in_size) * sizeof (*(stream->in_spectrum)));
+    stream->out_spectrum = calloc (atfft_halfcomplex_size (stream->out_size), sizeof (*(stream->out_spectrum)));
+
+    if (!(stream->forward && stream->backward && stream->response &&
+          stream->block && stream->out_block &&
+          stream->in_spectrum && stream->out_spectrum))
+        goto failed;
+
+    atfft_resample_stream_design_filter (stream, filter_size, cutoff);
+    atfft_resample_stream_reset (stream);
+    return stream;
+
+failed:
+    atfft_resample_stream_destroy (stream);
+    return NULL;
+}
+
+void atfft_resample_stream_destroy (struct atfft_resample_stream *stream)
+{
+    if (stream)
+    {
+        free (stream->out_spectrum);
+        free (stream->in_spectrum);
+        free (stream->out_block);
+        free (stream->block);
+        free (stream->response);
+        atfft_dft_destroy (stream->backward);
+        atfft_dft_destroy (stream->forward);
+        free (stream);
+    }
+}
+
+int atfft_resample_stream_in_hop_size (struct atfft_resample_stream *stream)
+{
+    return stream->hop_in;
+}
+
+int atfft_resample_stream_out_hop_size (struct atfft_resample_stream *stream)
+{
+    return stream->hop_out;
+}
+
+int atfft_resample_stream_latency (struct atfft_resample_stream *stream)
+{
+    return stream->margin_out;
+}
+
+void atfft_resample_stream_reset (struct atfft_resample_stream *stream)
+{
+    memset (stream->block, 0, stream->in_size * sizeof (*(stream->block)));
+}
+
+void atfft_resample_stream_transform (struct atfft_resample_stream *stream,
+                                      const atfft_sample *in,
+                                      int n_blocks,
+                                      atfft_sample *out)
+{
+    int history_size = stream->in_size - stream->hop_in;
+
+    for (int b = 0; b < n_blocks; ++b)
+    {
+        memmove (stream->block, stream->block + stream->hop_in, history_size * sizeof (*in));
+        memcpy (stream->block + history_size, in, stream->hop_in * sizeof (*in));
+
+        atfft_dft_real_forward_transform (stream->forward, stream->block, stream->in_spectrum);
+
+        /* The filter has no response at the Nyquist frequencies, so
+         * unlike the block resampler nothing needs splitting or folding. */
+        for (int k = 0; k < stream->n_bins; ++k)
+        {
+            ATFFT_RE (stream->out_spectrum [k]) = ATFFT_RE (stream->in_spectrum [k]) * stream->response [k];
+            ATFFT_IM (stream->out_spectrum [k]) = ATFFT_IM (stream->in_spectrum [k]) * stream->response [k];
+        }
+
+        atfft_dft_real_backward_transform (stream->backward, stream->out_spectrum, stream->out_block);
+        memcpy (out, stream->out_block + stream->margin_out, stream->hop_out * sizeof (*out));
+
+        in += stream->hop_in;
+        out += stream->hop_out;
+    }
+}
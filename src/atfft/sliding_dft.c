@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <atfft/sliding_dft.h>
+#include "atfft_internal.h"
+
+/* The number of samples differenced at once before the bins are updated. */
+#define ATFFT_SLIDING_DFT_BLOCK 256
+
+/* For bin k the modulated sliding DFT keeps
+ *
+ *     y_k (n) = y_k (n - 1) + (x (n) - x (n - N)) W^(kn)
+ *
+ * where W = e^(-2 pi j / N). W^(kn) repeats every N samples so it is read
+ * from a table indexed by kn mod N, which is tracked for each bin. The DFT of
+ * the window ending at sample n is then y_k (n) W^(-k(n + 1)).
+ *
+ * The twiddle table is stored with real and imaginary parts in separate
+ * arrays, as are the accumulators. */
+struct atfft_sliding_dft
+{
+    int size, n_bins;
+    int *bins;
+    int *indices;
+    atfft_sample *twiddles_re, *twiddles_im;
+    atfft_sample *sums_re, *sums_im;
+
+    /* the last size samples and the position of the oldest */
+    atfft_sample *history;
+    int position;
+
+    /* working space */
+    atfft_sample *differences;
+};
+
+struct atfft_sliding_dft* atfft_sliding_dft_create (int size, const int *bins, int n_bins)
+{
+    assert (size > 0 && n_bins > 0);
+
+    struct atfft_sliding_dft *sdft;
+
+    if (!(sdft = calloc (1, sizeof (*sdft))))
+        return NULL;
+
+    sdft->size = size;
+    sdft->n_bins = n_bins;
+
+    sdft->bins = malloc (n_bins * sizeof (*(sdft->bins)));
+    sdft->indices = malloc (n_bins * sizeof (*(sdft->indices)));
+    sdft->twiddles_re = malloc (size * sizeof (*(sdft->twiddles_re)));
+    sdft->twiddles_im = malloc (size * sizeof (*(sdft->twiddles_im)));
+    sdft->sums_re = malloc (n_bins * sizeof (*(sdft->sums_re)));
+    sdft->sums_im = malloc (n_bins * sizeof (*(sdft->sums_im)));
+    sdft->history = malloc (size * sizeof (*(sdft->history)));
+    sdft->differences = malloc (ATFFT_SLIDING_DFT_BLOCK * sizeof (*(sdft->differences)));
+
+    if (!(sdft->bins && sdft->indices &&
+          sdft->twiddles_re && sdft->twiddles_im &&
+          sdft->sums_re && sdft->sums_im &&
+          sdft->history && sdft->differences))
+        goto failed;
+
+    for (int i = 0; i < n_bins; ++i)
+    {
+        assert (bins [i] >= 0 && bins [i] < size);
+        sdft->bins [i] = bins [i];
+    }
+
+    for (int i = 0; i < size; ++i)
+    {
+        atfft_complex t;
+
+        atfft_twiddle_factor (i, size, ATFFT_FORWARD, &t);
+        sdft->twiddles_re [i] = ATFFT_RE (t);
+        sdft->twiddles_im [i] = ATFFT_IM (t);
+    }
+
+    atfft_sliding_dft_reset (sdft);
+    return sdft;
+
+failed:
+    atfft_sliding_dft_destroy (sdft);
+    return NULL;
+}
+
+void atfft_sliding_dft_destroy (struct atfft_sliding_dft *sdft)
+{
+    if (sdft)
+    {
+        free (sdft->differences);
+        free (sdft->history);
+        free (sdft->sums_im);
+        free (sdft->sums_re);
+        free (sdft->twiddles_im);
+        free (sdft->twiddles_re);
+        free (sdft->indices);
+        free (sdft->bins);
+        free (sdft);
+    }
+}
+
+static void atfft_sliding_dft_update (struct atfft_sliding_dft *sdft, int n_samples)
+{
+    const atfft_sample *d = sdft->differences;
+    const atfft_sample *t_re = sdft->twiddles_re;
+    const atfft_sample *t_im = sdft->twiddles_im;
+    int size = sdft->size;
+
+    for (int b = 0; b < sdft->n_bins; ++b)
+    {
+        int k = sdft->bins [b];
+        int i = sdft->indices [b];
+        atfft_sample re = sdft->sums_re [b];
+        atfft_sample im = sdft->sums_im [b];
+
+        for (int n = 0; n < n_samples; ++n)
+        {
+            re += d [n] * t_re [i];
+            im += d [n] * t_im [i];
+
+            i += k;
+
+            if (i >= size)
+                i -= size;
+        }
+
+        sdft->indices [b] = i;
+        sdft->sums_re [b] = re;
+        sdft->sums_im [b] = im;
+    }
+}
+
+void atfft_sliding_dft_push (struct atfft_sliding_dft *sdft, const atfft_sample *in, int n_samples)
+{
+    while (n_samples > 0)
+    {
+        int n = n_samples < ATFFT_SLIDING_DFT_BLOCK ? n_samples : ATFFT_SLIDING_DFT_BLOCK;
+
+        /* Swap the new samples into the history, keeping
+         * the difference with the ones they replace. */
+        for (int i = 0; i < n; ++i)
+        {
+            sdft->differences [i] = in [i] - sdft->history [sdft->position];
+            sdft->history [sdft->position] = in [i];
+
+            if (++sdft->position == sdft->size)
+                sdft->position = 0;
+        }
+
+        atfft_sliding_dft_update (sdft, n);
+
+        in += n;
+        n_samples -= n;
+    }
+}
+
+void atfft_sliding_dft_get_bins (struct atfft_sliding_dft *sdft, atfft_complex *out)
+{
+    /* Each bin's table index is k(n + 1) mod N, so the phase of the window
+     * is removed by multiplying with the conjugate of its twiddle factor. */
+    for (int b = 0; b < sdft->n_bins; ++b)
+    {
+        int i = sdft->indices [b];
+        atfft_sample re = sdft->sums_re [b];
+        atfft_sample im = sdft->sums_im [b];
+
+        ATFFT_RE (out [b]) = re * sdft->twiddles_re [i] + im * sdft->twiddles_im [i];
+        ATFFT_IM (out [b]) = im * sdft->twiddles_re [i] - re * sdft->twiddles_im [i];
+    }
+}
+
+void atfft_sliding_dft_reset (struct atfft_sliding_dft *sdft)
+{
+    memset (sdft->history, 0, sdft->size * sizeof (*(sdft->history)));
+    memset (sdft->sums_re, 0, sdft->n_bins * sizeof (*(sdft->sums_re)));
+    memset (sdft->sums_im, 0, sdft->n_bins * sizeof (*(sdft->sums_im)));
+    sdft->position = 0;
+
+    for (int b = 0; b < sdft->n_bins; ++b)
+    {
+        sdft->indices [b] = 0;
+    }
+}
@@ -0,0 +1,465 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+#include <atfft/dft.h>
+#include <atfft/dft_util.h>
+#include <atfft/spectrogram.h>
+#include "constants.h"
+
+/* The number of frames transformed before the kernels are applied. */
+#define ATFFT_SPECTROGRAM_BATCH 16
+
+/* Spectral kernel weights smaller than this, relative to the largest weight
+ * of the band, are trimmed from the ends of the band's run of bins. */
+#define ATFFT_CQT_THRESHOLD 0.01
+
+enum atfft_spectrogram_scale
+{
+    ATFFT_SPECTROGRAM_MEL,
+    ATFFT_SPECTROGRAM_CQT
+};
+
+/* A row of the kernel matrix, covering bins start to start + size - 1,
+ * whose weights start at offset in the packed weight arrays. */
+struct atfft_spectrogram_band
+{
+    int start, size, offset;
+};
+
+/* The spectra of a batch are interleaved, so bin j of frame f is at
+ * spectra [j * ATFFT_SPECTROGRAM_BATCH + f]. Each frame is transformed
+ * into spectrum and copied in, as not every DFT implementation has
+ * strided transforms.
+ *
+ * Mel weights are real and apply to the power spectrum. Constant-Q
+ * weights are complex and apply to the spectrum itself, the imaginary
+ * parts are kept in a separate array. */
+struct atfft_spectrogram
+{
+    enum atfft_spectrogram_scale scale;
+    int frame_size, hop_size, fft_size, n_bins, n_bands;
+    atfft_sample log_offset;
+    struct atfft_dft *dft;
+    atfft_sample *window, *frame;
+
+    struct atfft_spectrogram_band *bands;
+    atfft_sample *weights, *weights_im;
+
+    /* working space */
+    atfft_complex *spectrum, *spectra;
+    atfft_sample *power;
+};
+
+static struct atfft_spectrogram* atfft_spectrogram_create (enum atfft_spectrogram_scale scale,
+                                                           int frame_size,
+                                                           int hop_size,
+                                                           int fft_size,
+                                                           int n_bands)
+{
+    assert (hop_size > 0 && n_bands > 0);
+    assert (fft_size >= frame_size);
+
+    struct atfft_spectrogram *spectrogram;
+    int n_bins = atfft_halfcomplex_size (fft_size);
+
+    if (!(spectrogram = calloc (1, sizeof (*spectrogram))))
+        return NULL;
+
+    spectrogram->scale = scale;
+    spectrogram->frame_size = frame_size;
+    spectrogram->hop_size = hop_size;
+    spectrogram->fft_size = fft_size;
+    spectrogram->n_bins = n_bins;
+    spectrogram->n_bands = n_bands;
+
+    spectrogram->dft = atfft_dft_create (fft_size, ATFFT_FORWARD, ATFFT_REAL);
+    spectrogram->frame = calloc (fft_size, sizeof (*(spectrogram->frame)));
+    spectrogram->bands = calloc (n_bands, sizeof (*(spectrogram->bands)));
+    spectrogram->spectrum = malloc (n_bins * sizeof (*(spectrogram->spectrum)));
+    spectrogram->spectra = calloc (ATFFT_SPECTROGRAM_BATCH * n_bins, sizeof (*(spectrogram->spectra)));
+
+    if (!(spectrogram->dft && spectrogram->frame && spectrogram->bands &&
+          spectrogram->spectrum && spectrogram->spectra))
+    {
+        atfft_spectrogram_destroy (spectrogram);
+        return NULL;
+    }
+
+    return spectrogram;
+}
+
+static atfft_sample atfft_hz_to_mel (atfft_sample frequency)
+{
+    return 2595.0 * log10 (1.0 + frequency / 700.0);
+}
+
+static atfft_sample atfft_mel_to_hz (atfft_sample mel)
+{
+    return 700.0 * (pow (10.0, mel / 2595.0) - 1.0);
+}
+
+struct atfft_spectrogram* atfft_spectrogram_create_mel (int frame_size,
+                                                        int hop_size,
+                                                        int fft_size,
+                                                        enum atfft_window_type window,
+                                                        atfft_sample sample_rate,
+                                                        int n_bands,
+                                                        atfft_sample min_frequency,
+                                                        atfft_sample max_frequency)
+{
+    assert (min_frequency >= 0.0 && min_frequency < max_frequency && max_frequency <= sample_rate / 2.0);
+
+    struct atfft_spectrogram *spectrogram;
+    atfft_sample min_mel = atfft_hz_to_mel (min_frequency);
+    atfft_sample mel_spacing = (atfft_hz_to_mel (max_frequency) - min_mel) / (n_bands + 1);
+    atfft_sample bin_spacing = sample_rate / fft_size;
+    int n_bins, n_weights = 0;
+
+    if (!(spectrogram = atfft_spectrogram_create (ATFFT_SPECTROGRAM_MEL, frame_size, hop_size, fft_size, n_bands)))
+        return NULL;
+
+    n_bins = spectrogram->n_bins;
+    spectrogram->window = malloc (frame_size * sizeof (*(spectrogram->window)));
+    spectrogram->power = malloc (ATFFT_SPECTROGRAM_BATCH * n_bins * sizeof (*(spectrogram->power)));
+
+    /* Each bin is in at most two bands, allow one more weight per band for rounding. */
+    spectrogram->weights = malloc ((2 * n_bins + n_bands) * sizeof (*(spectrogram->weights)));
+
+    if (!(spectrogram->window && spectrogram->power && spectrogram->weights))
+        goto failed;
+
+    atfft_window (spectrogram->window, frame_size, window, ATFFT_PERIODIC);
+
+    for (int b = 0; b < n_bands; ++b)
+    {
+        struct atfft_spectrogram_band *band = spectrogram->bands + b;
+        atfft_sample low = atfft_mel_to_hz (min_mel + b * mel_spacing);
+        atfft_sample centre = atfft_mel_to_hz (min_mel + (b + 1) * mel_spacing);
+        atfft_sample high = atfft_mel_to_hz (min_mel + (b + 2) * mel_spacing);
+
+        band->start = (int) floor (low / bin_spacing) + 1;
+        band->offset = n_weights;
+
+        for (int j = band->start; j < n_bins && j * bin_spacing < high; ++j)
+        {
+            atfft_sample frequency = j * bin_spacing;
+
+            spectrogram->weights [n_weights++] = frequency < centre ? (frequency - low) / (centre - low)
+                                                                    : (high - frequency) / (high - centre);
+        }
+
+        band->size = n_weights - band->offset;
+    }
+
+    return spectrogram;
+
+failed:
+    atfft_spectrogram_destroy (spectrogram);
+    return NULL;
+}
+
+/* Find the spectral kernel of a constant-Q band, conjugated and scaled by
+ * 1 / fft_size, as the kernel is correlated with the frame's spectrum. */
+static void atfft_cqt_spectral_kernel (struct atfft_dft *dft,
+                                       atfft_complex *temporal,
+                                       atfft_complex *spectral,
+                                       int fft_size,
+                                       int kernel_size,
+                                       atfft_sample q)
+{
+    int start = (fft_size - kernel_size) / 2;
+
+    memset (temporal, 0, fft_size * sizeof (*temporal));
+
+    for (int n = 0; n < kernel_size; ++n)
+    {
+        atfft_sample w = kernel_size > 1 ? 0.54 - 0.46 * cos (2.0 * M_PI * n / (kernel_size - 1)) : 1.0;
+        atfft_sample phase = 2.0 * M_PI * q * n / kernel_size;
+
+        ATFFT_RE (temporal [start + n]) = w * cos (phase) / kernel_size;
+        ATFFT_IM (temporal [start + n]) = w * sin (phase) / kernel_size;
+    }
+
+    atfft_dft_complex_transform (dft, temporal, spectral);
+
+    for (int j = 0; j < fft_size; ++j)
+    {
+        ATFFT_RE (spectral [j]) /= fft_size;
+        ATFFT_IM (spectral [j]) /= -fft_size;
+    }
+}
+
+struct atfft_spectrogram* atfft_spectrogram_create_cqt (int fft_size,
+                                                        int hop_size,
+                                                        atfft_sample sample_rate,
+                                                        atfft_sample min_frequency,
+                                                        int bins_per_octave,
+                                                        int n_bands)
+{
+    assert (min_frequency > 0.0 && bins_per_octave > 0);
+
+    struct atfft_spectrogram *spectrogram;
+    struct atfft_dft *dft = NULL;
+    atfft_complex *temporal = NULL, *spectral = NULL;
+    atfft_sample *shrunk;
+    atfft_sample q = 1.0 / (pow (2.0, 1.0 / bins_per_octave) - 1.0);
+    int n_bins, n_weights = 0;
+
+    /* The longest kernel is that of the lowest band. */
+    if (ceil (q * sample_rate / min_frequency) > fft_size)
+        return NULL;
+
+    if (!(spectrogram = atfft_spectrogram_create (ATFFT_SPECTROGRAM_CQT, fft_size, hop_size, fft_size, n_bands)))
+        return NULL;
+
+    n_bins = spectrogram->n_bins;
+    dft = atfft_dft_create (fft_size, ATFFT_FORWARD, ATFFT_COMPLEX);
+    temporal = malloc (fft_size * sizeof (*temporal));
+    spectral = malloc (fft_size * sizeof (*spectral));
+
+    /* Allocate for dense kernels, the arrays are shrunk to fit once the bands are trimmed. */
+    spectrogram->weights = malloc (n_bands * n_bins * sizeof (*(spectrogram->weights)));
+    spectrogram->weights_im = malloc (n_bands * n_bins * sizeof (*(spectrogram->weights_im)));
+
+    if (!(dft && temporal && spectral && spectrogram->weights && spectrogram->weights_im))
+        goto failed;
+
+    for (int b = 0; b < n_bands; ++b)
+    {
+        struct atfft_spectrogram_band *band = spectrogram->bands + b;
+        atfft_sample frequency = min_frequency * pow (2.0, (atfft_sample) b / bins_per_octave);
+        int kernel_size = (int) ceil (q * sample_rate / frequency);
+        atfft_sample peak = 0.0;
+        int end = 0;
+
+        atfft_cqt_spectral_kernel (dft, temporal, spectral, fft_size, kernel_size, q);
+
+        /* Only the positive frequencies are used, the frame's spectrum
+         * being halfcomplex and the kernel analytic. */
+        for (int j = 0; j < n_bins; ++j)
+            peak = ATFFT_MAX (peak, atfft_abs (spectral [j]));
+
+        band->start = 0;
+
+        while (band->start < n_bins - 1 && atfft_abs (spectral [band->start]) < ATFFT_CQT_THRESHOLD * peak)
+            ++band->start;
+
+        for (end = n_bins; end > band->start + 1; --end)
+        {
+            if (atfft_abs (spectral [end - 1]) >= ATFFT_CQT_THRESHOLD * peak)
+                break;
+        }
+
+        band->size = end - band->start;
+        band->offset = n_weights;
+
+        for (int j = band->start; j < end; ++j)
+        {
+            spectrogram->weights [n_weights] = ATFFT_RE (spectral [j]);
+            spectrogram->weights_im [n_weights] = ATFFT_IM (spectral [j]);
+            ++n_weights;
+        }
+    }
+
+    /* Shrinking should never fail, but if it does the dense arrays will do. */
+    if ((shrunk = realloc (spectrogram->weights, n_weights * sizeof (*shrunk))))
+        spectrogram->weights = shrunk;
+
+    if ((shrunk = realloc (spectrogram->weights_im, n_weights * sizeof (*shrunk))))
+        spectrogram->weights_im = shrunk;
+
+    free (spectral);
+    free (temporal);
+    atfft_dft_destroy (dft);
+    return spectrogram;
+
+failed:
+    free (spectral);
+    free (temporal);
+    atfft_dft_destroy (dft);
+    atfft_spectrogram_destroy (spectrogram);
+    return NULL;
+}
+
+void atfft_spectrogram_destroy (struct atfft_spectrogram *spectrogram)
+{
+    if (spectrogram)
+    {
+        free (spectrogram->power);
+        free (spectrogram->spectra);
+        free (spectrogram->spectrum);
+        free (spectrogram->weights_im);
+        free (spectrogram->weights);
+        free (spectrogram->bands);
+        free (spectrogram->frame);
+        free (spectrogram->window);
+        atfft_dft_destroy (spectrogram->dft);
+        free (spectrogram);
+    }
+}
+
+int atfft_spectrogram_frame_size (struct atfft_spectrogram *spectrogram)
+{
+    return spectrogram->frame_size;
+}
+
+int atfft_spectrogram_n_bands (struct atfft_spectrogram *spectrogram)
+{
+    return spectrogram->n_bands;
+}
+
+void atfft_spectrogram_set_log_offset (struct atfft_spectrogram *spectrogram, atfft_sample offset)
+{
+    assert (offset >= 0.0);
+    spectrogram->log_offset = offset;
+}
+
+/* Transform a batch of frames into the interleaved spectra. */
+static void atfft_spectrogram_transform_batch (struct atfft_spectrogram *spectrogram,
+                                               const atfft_sample *in,
+                                               int n_frames)
+{
+    for (int f = 0; f < n_frames; ++f)
+    {
+        const atfft_sample *frame = in + f * spectrogram->hop_size;
+
+        if (spectrogram->window)
+        {
+            for (int i = 0; i < spectrogram->frame_size; ++i)
+                spectrogram->frame [i] = frame [i] * spectrogram->window [i];
+        }
+        else
+        {
+            memcpy (spectrogram->frame, frame, spectrogram->frame_size * sizeof (*frame));
+        }
+
+        atfft_dft_real_forward_transform (spectrogram->dft, spectrogram->frame, spectrogram->spectrum);
+
+        for (int j = 0; j < spectrogram->n_bins; ++j)
+        {
+            ATFFT_RE (spectrogram->spectra [j * ATFFT_SPECTROGRAM_BATCH + f]) = ATFFT_RE (spectrogram->spectrum [j]);
+            ATFFT_IM (spectrogram->spectra [j * ATFFT_SPECTROGRAM_BATCH + f]) = ATFFT_IM (spectrogram->spectrum [j]);
+        }
+    }
+}
+
+/* Write the band powers of a batch to the output, compressing them if required. */
+static void atfft_spectrogram_write_band (struct atfft_spectrogram *spectrogram,
+                                          const atfft_sample *power,
+                                          int band,
+                                          int n_frames,
+                                          atfft_sample *out)
+{
+    int n_bands = spectrogram->n_bands;
+
+    if (spectrogram->log_offset > 0.0)
+    {
+        for (int f = 0; f < n_frames; ++f)
+            out [f * n_bands + band] = log (power [f] + spectrogram->log_offset);
+    }
+    else
+    {
+        for (int f = 0; f < n_frames; ++f)
+            out [f * n_bands + band] = power [f];
+    }
+}
+
+/* The sums over a band are kept for a whole batch at once, so the inner
+ * loops run across the frames of the batch with a fixed length. */
+static void atfft_spectrogram_apply_mel (struct atfft_spectrogram *spectrogram, int n_frames, atfft_sample *out)
+{
+    int total = ATFFT_SPECTROGRAM_BATCH * spectrogram->n_bins;
+    atfft_sample *power = spectrogram->power;
+
+    for (int i = 0; i < total; ++i)
+        power [i] = ATFFT_RE (spectrogram->spectra [i]) * ATFFT_RE (spectrogram->spectra [i]) +
+                    ATFFT_IM (spectrogram->spectra [i]) * ATFFT_IM (spectrogram->spectra [i]);
+
+    for (int b = 0; b < spectrogram->n_bands; ++b)
+    {
+        const struct atfft_spectrogram_band *band = spectrogram->bands + b;
+        const atfft_sample *weights = spectrogram->weights + band->offset;
+        atfft_sample sum [ATFFT_SPECTROGRAM_BATCH] = {0};
+
+        for (int j = 0; j < band->size; ++j)
+        {
+            const atfft_sample *p = power + (band->start + j) * ATFFT_SPECTROGRAM_BATCH;
+
+            for (int f = 0; f < ATFFT_SPECTROGRAM_BATCH; ++f)
+                sum [f] += weights [j] * p [f];
+        }
+
+        atfft_spectrogram_write_band (spectrogram, sum, b, n_frames, out);
+    }
+}
+
+static void atfft_spectrogram_apply_cqt (struct atfft_spectrogram *spectrogram, int n_frames, atfft_sample *out)
+{
+    for (int b = 0; b < spectrogram->n_bands; ++b)
+    {
+        const struct atfft_spectrogram_band *band = spectrogram->bands + b;
+        const atfft_sample *weights_re = spectrogram->weights + band->offset;
+        const atfft_sample *weights_im = spectrogram->weights_im + band->offset;
+        atfft_sample re [ATFFT_SPECTROGRAM_BATCH] = {0};
+        atfft_sample im [ATFFT_SPECTROGRAM_BATCH] = {0};
+        atfft_sample power [ATFFT_SPECTROGRAM_BATCH];
+
+        for (int j = 0; j < band->size; ++j)
+        {
+            atfft_complex *x = spectrogram->spectra + (band->start + j) * ATFFT_SPECTROGRAM_BATCH;
+
+            for (int f = 0; f < ATFFT_SPECTROGRAM_BATCH; ++f)
+            {
+                re [f] += weights_re [j] * ATFFT_RE (x [f]) - weights_im [j] * ATFFT_IM (x [f]);
+                im [f] += weights_re [j] * ATFFT_IM (x [f]) + weights_im [j] * ATFFT_RE (x [f]);
+            }
+        }
+
+        for (int f = 0; f < ATFFT_SPECTROGRAM_BATCH; ++f)
+            power [f] = re [f] * re [f] + im [f] * im [f];
+
+        atfft_spectrogram_write_band (spectrogram, power, b, n_frames, out);
+    }
+}
+
+void atfft_spectrogram_transform (struct atfft_spectrogram *spectrogram,
+                                  const atfft_sample *in,
+                                  int n_frames,
+                                  atfft_sample *out)
+{
+    for (int first = 0; first < n_frames; first += ATFFT_SPECTROGRAM_BATCH)
+    {
+        int n = ATFFT_MIN (ATFFT_SPECTROGRAM_BATCH, n_frames - first);
+        atfft_sample *batch_out = out + first * spectrogram->n_bands;
+
+        atfft_spectrogram_transform_batch (spectrogram, in + first * spectrogram->hop_size, n);
+
+        if (spectrogram->scale == ATFFT_SPECTROGRAM_MEL)
+            atfft_spectrogram_apply_mel (spectrogram, n, batch_out);
+        else
+            atfft_spectrogram_apply_cqt (spectrogram, n, batch_out);
+    }
+}
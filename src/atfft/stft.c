@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <atfft/dft.h>
+#include <atfft/dft_util.h>
+#include <atfft/stft.h>
+
+/* The analysis side keeps a ring buffer whose length is a power of 2 so
+ * positions can be wrapped with a mask. Frames are windowed as they are
+ * copied out of the ring buffer into the DFT input, so there is no
+ * separate windowing pass.
+ *
+ * The synthesis side folds the DFT normalisation and the COLA correction
+ * into its window, each frame is then multiplied and overlap-added in a
+ * single pass. */
+struct atfft_stft
+{
+    int frame_size, hop_size, fft_size;
+    struct atfft_dft *dft;
+    atfft_sample *window, *frame;
+
+    atfft_sample *ring;
+    int ring_mask;
+    unsigned int read_position, write_position;
+};
+
+struct atfft_istft
+{
+    int frame_size, hop_size, fft_size;
+    struct atfft_dft *dft;
+    atfft_sample *window, *frame, *overlap;
+};
+
+static int atfft_stft_ring_size (int min_size)
+{
+    int size = 1;
+
+    while (size < min_size)
+        size *= 2;
+
+    return size;
+}
+
+struct atfft_stft* atfft_stft_create (int frame_size,
+                                      int hop_size,
+                                      int fft_size,
+                                      enum atfft_window_type window)
+{
+    assert (hop_size > 0 && hop_size <= frame_size);
+    assert (fft_size >= frame_size);
+
+    struct atfft_stft *stft;
+    int ring_size = atfft_stft_ring_size (frame_size + hop_size);
+
+    if (!(stft = calloc (1, sizeof (*stft))))
+        return NULL;
+
+    stft->frame_size = frame_size;
+    stft->hop_size = hop_size;
+    stft->fft_size = fft_size;
+    stft->ring_mask = ring_size - 1;
+
+    stft->dft = atfft_dft_create (fft_size, ATFFT_FORWARD, ATFFT_REAL);
+    stft->window = malloc (frame_size * sizeof (*(stft->window)));
+    stft->frame = calloc (fft_size, sizeof (*(stft->frame)));
+    stft->ring = calloc (ring_size, sizeof (*(stft->ring)));
+
+    if (!(stft->dft && stft->window && stft->frame && stft->ring))
+        goto failed;
+
+    atfft_window (stft->window, frame_size, window, ATFFT_PERIODIC);
+    return stft;
+
+failed:
+    atfft_stft_destroy (stft);
+    return NULL;
+}
+
+void atfft_stft_destroy (struct atfft_stft *stft)
+{
+    if (stft)
+    {
+        free (stft->ring);
+        free (stft->frame);
+        free (stft->window);
+        atfft_dft_destroy (stft->dft);
+        free (stft);
+    }
+}
+
+int atfft_stft_push (struct atfft_stft *stft, const atfft_sample *in, int size)
+{
+    int ring_size = stft->ring_mask + 1;
+    int space = ring_size - (int) (stft->write_position - stft->read_position);
+    int n = ATFFT_MIN (size, space);
+    int start = stft->write_position & stft->ring_mask;
+    int first = ATFFT_MIN (n, ring_size - start);
+
+    memcpy (stft->ring + start, in, first * sizeof (*in));
+    memcpy (stft->ring, in + first, (n - first) * sizeof (*in));
+
+    stft->write_position += n;
+    return n;
+}
+
+static void atfft_stft_window_frame (atfft_sample *frame,
+                                     const atfft_sample *ring,
+                                     const atfft_sample *window,
+                                     int size)
+{
+    for (int i = 0; i < size; ++i)
+        frame [i] = ring [i] * window [i];
+}
+
+int atfft_stft_pull (struct atfft_stft *stft, atfft_complex *spectrum)
+{
+    int ring_size = stft->ring_mask + 1;
+    int start = stft->read_position & stft->ring_mask;
+    int first = ATFFT_MIN (stft->frame_size, ring_size - start);
+
+    if ((int) (stft->write_position - stft->read_position) < stft->frame_size)
+        return 0;
+
+    /* The frame may wrap around the end of the ring buffer,
+     * samples from frame_size onwards are left as zero padding. */
+    atfft_stft_window_frame (stft->frame, stft->ring + start, stft->window, first);
+    atfft_stft_window_frame (stft->frame + first,
+                             stft->ring,
+                             stft->window + first,
+                             stft->frame_size - first);
+
+    atfft_dft_real_forward_transform (stft->dft, stft->frame, spectrum);
+    stft->read_position += stft->hop_size;
+    return 1;
+}
+
+/******************************************
+ * Inverse STFT
+ ******************************************/
+static int atfft_istft_init_window (struct atfft_istft *istft)
+{
+    int frame_size = istft->frame_size;
+    int hop_size = istft->hop_size;
+
+    /* Sum the squared window over the frames overlapping
+     * each position within a hop, then divide the window
+     * by that sum so the overlapping analysis and synthesis
+     * windows add to one. Where the sum is zero every frame
+     * covering that position has zeroed it, so the signal
+     * can't be reconstructed. */
+    for (int i = 0; i < hop_size; ++i)
+    {
+        atfft_sample sum = 0.0;
+
+        for (int j = i; j < frame_size; j += hop_size)
+            sum += istft->window [j] * istft->window [j];
+
+        if (!(sum > 0.0))
+            return 0;
+
+        for (int j = i; j < frame_size; j += hop_size)
+            istft->window [j] /= sum * istft->fft_size;
+    }
+
+    return 1;
+}
+
+struct atfft_istft* atfft_istft_create (int frame_size,
+                                        int hop_size,
+                                        int fft_size,
+                                        enum atfft_window_type window)
+{
+    assert (hop_size > 0 && hop_size <= frame_size);
+    assert (fft_size >= frame_size);
+
+    struct atfft_istft *istft;
+
+    if (!(istft = calloc (1, sizeof (*istft))))
+        return NULL;
+
+    istft->frame_size = frame_size;
+    istft->hop_size = hop_size;
+    istft->fft_size = fft_size;
+
+    istft->dft = atfft_dft_create (fft_size, ATFFT_BACKWARD, ATFFT_REAL);
+    istft->window = malloc (frame_size * sizeof (*(istft->window)));
+    istft->frame = malloc (fft_size * sizeof (*(istft->frame)));
+    istft->overlap = calloc (frame_size, sizeof (*(istft->overlap)));
+
+    if (!(istft->dft && istft->window && istft->frame && istft->overlap))
+        goto failed;
+
+    atfft_window (istft->window, frame_size, window, ATFFT_PERIODIC);
+
+    if (!atfft_istft_init_window (istft))
+        goto failed;
+
+    return istft;
+
+failed:
+    atfft_istft_destroy (istft);
+    return NULL;
+}
+
+void atfft_istft_destroy (struct atfft_istft *istft)
+{
+    if (istft)
+    {
+        free (istft->overlap);
+        free (istft->frame);
+        free (istft->window);
+        atfft_dft_destroy (istft->dft);
+        free (istft);
+    }
+}
+
+void atfft_istft_transform (struct atfft_istft *istft, atfft_complex *spectrum, atfft_sample *out)
+{
+    int frame_size = istft->frame_size;
+    int hop_size = istft->hop_size;
+    atfft_sample *overlap = istft->overlap;
+    const atfft_sample *frame = istft->frame;
+    const atfft_sample *window = istft->window;
+    int i;
+
+    atfft_dft_real_backward_transform (istft->dft, spectrum, istft->frame);
+
+    /* The first hop of the frame completes the output... */
+    for (i = 0; i < hop_size; ++i)
+        out [i] = overlap [i] + frame [i] * window [i];
+
+    /* ...the rest is added to what is left of the overlap. */
+    for (i = hop_size; i < frame_size; ++i)
+        overlap [i - hop_size] = overlap [i] + frame [i] * window [i];
+
+    for (i = frame_size - hop_size; i < frame_size; ++i)
+        overlap [i] = 0.0;
+}
@@ -22,7 +22,7 @@
 
 #include <math.h>
 #include <atfft/windows.h>
-#include "constants.h"
+#include "../constants.h"
 
 void atfft_bartlett_window (atfft_sample *window, int size, enum atfft_window_symmetry symmetry)
 {
@@ -90,3 +90,92 @@ void atfft_blackman_window (atfft_sample *window, int size, enum atfft_window_sy
         window [i] = 0.42 - 0.5 * cos (x) + 0.08 * cos (2.0 * x);
     }
 }
+
+void atfft_sine_window (atfft_sample *window, int size)
+{
+    int i = 0;
+
+    for (i = 0; i < size; ++i)
+    {
+        window [i] = sin (M_PI * (i + 0.5) / size);
+    }
+}
+
+/* The zeroth order modified Bessel function of the first kind. */
+static atfft_sample atfft_bessel_i0 (atfft_sample x)
+{
+    atfft_sample sum = 1.0;
+    atfft_sample term = 1.0;
+    atfft_sample half_x = x / 2.0;
+    int k = 1;
+
+    do
+    {
+        term *= (half_x / k) * (half_x / k);
+        sum += term;
+        ++k;
+    }
+    while (term > sum * 1e-20);
+
+    return sum;
+}
+
+void atfft_kaiser_bessel_derived_window (atfft_sample *window, int size, atfft_sample alpha)
+{
+    int i = 0;
+    int half = size / 2;
+    atfft_sample total = 0.0;
+
+    /* Accumulate a Kaiser window of length half + 1 in the first half of the output. */
+    for (i = 0; i < half; ++i)
+    {
+        atfft_sample x = 2.0 * i / half - 1.0;
+        total += atfft_bessel_i0 (M_PI * alpha * sqrt (1.0 - x * x));
+        window [i] = total;
+    }
+
+    total += atfft_bessel_i0 (0.0);
+
+    for (i = 0; i < half; ++i)
+    {
+        window [i] = sqrt (window [i] / total);
+        window [size - 1 - i] = window [i];
+    }
+}
+
+void atfft_window (atfft_sample *window,
+                   int size,
+                   enum atfft_window_type type,
+                   enum atfft_window_symmetry symmetry)
+{
+    int i = 0;
+
+    switch (type)
+    {
+        case ATFFT_BARTLETT_WINDOW:
+            atfft_bartlett_window (window, size, symmetry);
+            break;
+
+        case ATFFT_HANN_WINDOW:
+            atfft_hann_window (window, size, symmetry);
+            break;
+
+        case ATFFT_HAMMING_WINDOW:
+            atfft_hamming_window (window, size, symmetry);
+            break;
+
+        case ATFFT_BLACKMAN_WINDOW:
+            atfft_blackman_window (window, size, symmetry);
+            break;
+
+        case ATFFT_SINE_WINDOW:
+            atfft_sine_window (window, size);
+            break;
+
+        default:
+            for (i = 0; i < size; ++i)
+            {
+                window [i] = 1.0;
+            }
+    }
+}
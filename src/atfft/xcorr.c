@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+#include <math.h>
+#include <atfft/dft.h>
+#include <atfft/dft_util.h>
+#include <atfft/xcorr.h>
+
+/* Added to the magnitude of each bin before PHAT normalisation
+ * so empty bins don't divide by zero. */
+#define ATFFT_XCORR_EPSILON 1e-30
+
+/* The channel spectra are stored with real and imaginary parts in separate
+ * arrays so the cross-spectrum kernel runs over contiguous values. The DFT
+ * normalisation is folded into the weighting of the cross-spectra. */
+struct atfft_xcorr
+{
+    int size, n_channels, fft_size, n_bins;
+    enum atfft_xcorr_weighting weighting;
+    struct atfft_dft *forward, *backward;
+
+    atfft_sample *spectra_re, *spectra_im;
+
+    /* working space */
+    atfft_sample *signal;
+    atfft_complex *spectrum;
+    atfft_complex *cross_spectrum;
+    atfft_sample *correlation;
+};
+
+struct atfft_xcorr* atfft_xcorr_create (int size, int n_channels, enum atfft_xcorr_weighting weighting)
+{
+    assert (size > 0 && n_channels > 0);
+
+    struct atfft_xcorr *xcorr;
+    int fft_size = 1;
+
+    while (fft_size < 2 * size)
+        fft_size *= 2;
+
+    if (!(xcorr = calloc (1, sizeof (*xcorr))))
+        return NULL;
+
+    xcorr->size = size;
+    xcorr->n_channels = n_channels;
+    xcorr->fft_size = fft_size;
+    xcorr->n_bins = atfft_halfcomplex_size (fft_size);
+    xcorr->weighting = weighting;
+
+    xcorr->forward = atfft_dft_create (fft_size, ATFFT_FORWARD, ATFFT_REAL);
+    xcorr->backward = atfft_dft_create (fft_size, ATFFT_BACKWARD, ATFFT_REAL);
+    xcorr->spectra_re = malloc (n_channels * xcorr->n_bins * sizeof (*(xcorr->spectra_re)));
+    xcorr->spectra_im = malloc (n_channels * xcorr->n_bins * sizeof (*(xcorr->spectra_im)));
+    xcorr->signal = calloc (fft_size, sizeof (*(xcorr->signal)));
+    xcorr->spectrum = malloc (xcorr->n_bins * sizeof (*(xcorr->spectrum)));
+    xcorr->cross_spectrum = malloc (xcorr->n_bins * sizeof (*(xcorr->cross_spectrum)));
+    xcorr->correlation = malloc (fft_size * sizeof (*(xcorr->correlation)));
+
+    if (!(xcorr->forward && xcorr->backward &&
+          xcorr->spectra_re && xcorr->spectra_im &&
+          xcorr->signal && xcorr->spectrum &&
+          xcorr->cross_spectrum && xcorr->correlation))
+        goto failed;
+
+    return xcorr;
+
+failed:
+    atfft_xcorr_destroy (xcorr);
+    return NULL;
+}
+
+void atfft_xcorr_destroy (struct atfft_xcorr *xcorr)
+{
+    if (xcorr)
+    {
+        free (xcorr->correlation);
+        free (xcorr->cross_spectrum);
+        free (xcorr->spectrum);
+        free (xcorr->signal);
+        free (xcorr->spectra_im);
+        free (xcorr->spectra_re);
+        atfft_dft_destroy (xcorr->backward);
+        atfft_dft_destroy (xcorr->forward);
+        free (xcorr);
+    }
+}
+
+void atfft_xcorr_set_signals (struct atfft_xcorr *xcorr, const atfft_sample *signals, int distance)
+{
+    int n_bins = xcorr->n_bins;
+
+    for (int c = 0; c < xcorr->n_channels; ++c)
+    {
+        atfft_sample *re = xcorr->spectra_re + c * n_bins;
+        atfft_sample *im = xcorr->spectra_im + c * n_bins;
+
+        /* The end of the signal buffer stays zero. */
+        for (int i = 0; i < xcorr->size; ++i)
+            xcorr->signal [i] = signals [c * distance + i];
+
+        atfft_dft_real_forward_transform (xcorr->forward, xcorr->signal, xcorr->spectrum);
+
+        for (int k = 0; k < n_bins; ++k)
+        {
+            re [k] = ATFFT_RE (xcorr->spectrum [k]);
+            im [k] = ATFFT_IM (xcorr->spectrum [k]);
+        }
+    }
+}
+
+/* Multiply the spectrum of a by the conjugate of the spectrum of b,
+ * applying the weighting and DFT normalisation in the same pass. */
+static void atfft_xcorr_cross_spectrum (struct atfft_xcorr *xcorr, int a, int b, atfft_complex *out)
+{
+    int n_bins = xcorr->n_bins;
+    const atfft_sample *a_re = xcorr->spectra_re + a * n_bins;
+    const atfft_sample *a_im = xcorr->spectra_im + a * n_bins;
+    const atfft_sample *b_re = xcorr->spectra_re + b * n_bins;
+    const atfft_sample *b_im = xcorr->spectra_im + b * n_bins;
+    atfft_sample scale = 1.0 / xcorr->fft_size;
+
+    if (xcorr->weighting == ATFFT_XCORR_PHAT)
+    {
+        for (int k = 0; k < n_bins; ++k)
+        {
+            atfft_sample re = a_re [k] * b_re [k] + a_im [k] * b_im [k];
+            atfft_sample im = a_im [k] * b_re [k] - a_re [k] * b_im [k];
+            atfft_sample w = scale / (sqrt (re * re + im * im) + ATFFT_XCORR_EPSILON);
+
+            ATFFT_RE (out [k]) = re * w;
+            ATFFT_IM (out [k]) = im * w;
+        }
+    }
+    else
+    {
+        for (int k = 0; k < n_bins; ++k)
+        {
+            ATFFT_RE (out [k]) = (a_re [k] * b_re [k] + a_im [k] * b_im [k]) * scale;
+            ATFFT_IM (out [k]) = (a_im [k] * b_re [k] - a_re [k] * b_im [k]) * scale;
+        }
+    }
+}
+
+/* The correlation at a lag which may be negative. */
+static atfft_sample atfft_xcorr_at_lag (const atfft_sample *correlation, int fft_size, int lag)
+{
+    return correlation [lag < 0 ? lag + fft_size : lag];
+}
+
+void atfft_xcorr_correlation (struct atfft_xcorr *xcorr,
+                              int a,
+                              int b,
+                              int max_lag,
+                              atfft_sample *correlation)
+{
+    assert (max_lag >= 0 && max_lag < xcorr->size);
+
+    atfft_xcorr_cross_spectrum (xcorr, a, b, xcorr->cross_spectrum);
+    atfft_dft_real_backward_transform (xcorr->backward, xcorr->cross_spectrum, xcorr->correlation);
+
+    for (int lag = -max_lag; lag <= max_lag; ++lag)
+        correlation [lag + max_lag] = atfft_xcorr_at_lag (xcorr->correlation, xcorr->fft_size, lag);
+}
+
+static void atfft_xcorr_find_peak (const atfft_sample *correlation,
+                                   int fft_size,
+                                   int max_lag,
+                                   int interpolate,
+                                   atfft_sample *lag,
+                                   atfft_sample *peak)
+{
+    int best = 0;
+    atfft_sample best_value = correlation [0];
+
+    for (int l = 1; l <= max_lag; ++l)
+    {
+        atfft_sample positive = correlation [l];
+        atfft_sample negative = correlation [fft_size - l];
+
+        if (positive > best_value)
+        {
+            best = l;
+            best_value = positive;
+        }
+
+        if (negative > best_value)
+        {
+            best = -l;
+            best_value = negative;
+        }
+    }
+
+    *lag = best;
+    *peak = best_value;
+
+    /* Fit a parabola through the peak and its neighbours,
+     * the neighbours exist as max_lag < size <= fft_size / 2. */
+    if (interpolate)
+    {
+        atfft_sample before = atfft_xcorr_at_lag (correlation, fft_size, best - 1);
+        atfft_sample after = atfft_xcorr_at_lag (correlation, fft_size, best + 1);
+        atfft_sample curvature = before - 2.0 * best_value + after;
+
+        if (curvature < 0.0)
+        {
+            atfft_sample offset = 0.5 * (before - after) / curvature;
+
+            *lag += offset;
+            *peak -= 0.25 * (before - after) * offset;
+        }
+    }
+}
+
+void atfft_xcorr_peak_lags (struct atfft_xcorr *xcorr,
+                            int max_lag,
+                            int interpolate,
+                            atfft_sample *lags,
+                            atfft_sample *peaks)
+{
+    assert (max_lag >= 0 && max_lag < xcorr->size);
+
+    int pair = 0;
+
+    for (int a = 0; a < xcorr->n_channels - 1; ++a)
+    {
+        for (int b = a + 1; b < xcorr->n_channels; ++b, ++pair)
+        {
+            atfft_sample peak;
+
+            atfft_xcorr_cross_spectrum (xcorr, a, b, xcorr->cross_spectrum);
+            atfft_dft_real_backward_transform (xcorr->backward, xcorr->cross_spectrum, xcorr->correlation);
+            atfft_xcorr_find_peak (xcorr->correlation,
+                                   xcorr->fft_size,
+                                   max_lag,
+                                   interpolate,
+                                   lags + pair,
+                                   &peak);
+
+            if (peaks)
+                peaks [pair] = peak;
+        }
+    }
+}
@@ -0,0 +1,384 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <atfft/convolver.h>
+
+/* The largest block size used by the background stages. */
+#define ATFFT_ZERO_LATENCY_MAX_BLOCK_SIZE 8192
+
+/* The kernel is partitioned as follows, where N is the block size:
+ *
+ *  - [0, N) is applied directly.
+ *
+ *  - [N, 4N) is applied by a uniformly partitioned convolver with a block
+ *    size of N, run in the calling thread. Its output is delayed by a block
+ *    which the offset of N into the kernel accounts for.
+ *
+ *  - Then come stages with block sizes B = 2N, 4N, 8N... each covering
+ *    [2B, 4B) of the kernel, the last stage covering the rest. A block is
+ *    handed to the stage's worker thread as soon as it is complete, the
+ *    result is not needed until a block later, as the convolver's own
+ *    delay of one block plus the one block of time for the worker add up
+ *    to the offset of 2B. */
+struct atfft_zero_latency_stage
+{
+    int block_size;
+    struct atfft_convolver *convolver;
+
+    /* input gathered for the next block, and the block being worked on */
+    atfft_sample *gather, *input;
+    int gather_position;
+
+    /* two blocks of output, one being read while the other is computed */
+    atfft_sample *output [2];
+    int front, read_position, pending;
+
+    /* working is set while the worker has a block, both it and quit are
+     * guarded by the mutex */
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t start, done;
+    int working, quit;
+    int sync_initialised, thread_started;
+};
+
+struct atfft_zero_latency_convolver
+{
+    int block_size;
+
+    /* direct head */
+    atfft_sample *head, *history;
+    int head_size;
+
+    /* uniformly partitioned stage in the calling thread */
+    struct atfft_convolver *near;
+    atfft_sample *near_output;
+
+    /* background stages */
+    struct atfft_zero_latency_stage *stages;
+    int n_stages;
+};
+
+static void* atfft_zero_latency_worker (void *arg)
+{
+    struct atfft_zero_latency_stage *stage = arg;
+
+    pthread_mutex_lock (&stage->mutex);
+
+    while (1)
+    {
+        while (!(stage->working || stage->quit))
+            pthread_cond_wait (&stage->start, &stage->mutex);
+
+        if (stage->quit)
+            break;
+
+        pthread_mutex_unlock (&stage->mutex);
+        atfft_convolver_process (stage->convolver, stage->input, stage->output [1 - stage->front]);
+        pthread_mutex_lock (&stage->mutex);
+
+        stage->working = 0;
+        pthread_cond_signal (&stage->done);
+    }
+
+    pthread_mutex_unlock (&stage->mutex);
+    return NULL;
+}
+
+/* Hand the block in stage->input to the worker. */
+static void atfft_zero_latency_stage_start (struct atfft_zero_latency_stage *stage)
+{
+    pthread_mutex_lock (&stage->mutex);
+    stage->working = 1;
+    pthread_cond_signal (&stage->start);
+    pthread_mutex_unlock (&stage->mutex);
+}
+
+/* Wait for the worker to finish the block it was last handed. */
+static void atfft_zero_latency_stage_wait (struct atfft_zero_latency_stage *stage)
+{
+    pthread_mutex_lock (&stage->mutex);
+
+    while (stage->working)
+        pthread_cond_wait (&stage->done, &stage->mutex);
+
+    pthread_mutex_unlock (&stage->mutex);
+}
+
+static int atfft_zero_latency_stage_init_sync (struct atfft_zero_latency_stage *stage)
+{
+    if (pthread_mutex_init (&stage->mutex, NULL))
+        return 0;
+
+    if (pthread_cond_init (&stage->start, NULL))
+    {
+        pthread_mutex_destroy (&stage->mutex);
+        return 0;
+    }
+
+    if (pthread_cond_init (&stage->done, NULL))
+    {
+        pthread_cond_destroy (&stage->start);
+        pthread_mutex_destroy (&stage->mutex);
+        return 0;
+    }
+
+    stage->sync_initialised = 1;
+    return 1;
+}
+
+static int atfft_zero_latency_stage_init (struct atfft_zero_latency_stage *stage,
+                                          const atfft_sample *kernel,
+                                          int kernel_size,
+                                          int block_size)
+{
+    stage->block_size = block_size;
+    stage->convolver = atfft_convolver_create (kernel, kernel_size, block_size);
+    stage->gather = malloc (block_size * sizeof (*(stage->gather)));
+    stage->input = malloc (block_size * sizeof (*(stage->input)));
+    stage->output [0] = calloc (block_size, sizeof (*(stage->output [0])));
+    stage->output [1] = calloc (block_size, sizeof (*(stage->output [1])));
+
+    if (!(stage->convolver && stage->gather && stage->input && stage->output [0] && stage->output [1]))
+        return 0;
+
+    if (!atfft_zero_latency_stage_init_sync (stage))
+        return 0;
+
+    if (pthread_create (&stage->thread, NULL, atfft_zero_latency_worker, stage))
+        return 0;
+
+    stage->thread_started = 1;
+    return 1;
+}
+
+static void atfft_zero_latency_stage_free (struct atfft_zero_latency_stage *stage)
+{
+    if (stage->thread_started)
+    {
+        /* Let any block in progress finish before stopping the thread. */
+        atfft_zero_latency_stage_wait (stage);
+
+        pthread_mutex_lock (&stage->mutex);
+        stage->quit = 1;
+        pthread_cond_signal (&stage->start);
+        pthread_mutex_unlock (&stage->mutex);
+        pthread_join (stage->thread, NULL);
+    }
+
+    if (stage->sync_initialised)
+    {
+        pthread_cond_destroy (&stage->done);
+        pthread_cond_destroy (&stage->start);
+        pthread_mutex_destroy (&stage->mutex);
+    }
+
+    free (stage->output [1]);
+    free (stage->output [0]);
+    free (stage->input);
+    free (stage->gather);
+    atfft_convolver_destroy (stage->convolver);
+}
+
+static int atfft_zero_latency_count_stages (int kernel_size, int block_size)
+{
+    int n_stages = 0;
+    int b = 2 * block_size;
+
+    while (2 * b < kernel_size)
+    {
+        ++n_stages;
+
+        if (b >= ATFFT_ZERO_LATENCY_MAX_BLOCK_SIZE)
+            break;
+
+        b *= 2;
+    }
+
+    return n_stages;
+}
+
+struct atfft_zero_latency_convolver* atfft_zero_latency_convolver_create (const atfft_sample *kernel,
+                                                                          int kernel_size,
+                                                                          int block_size)
+{
+    assert (kernel_size > 0 && block_size > 0);
+
+    struct atfft_zero_latency_convolver *convolver;
+    int near_end = ATFFT_MIN (4 * block_size, kernel_size);
+    int b = 2 * block_size;
+
+    if (!(convolver = calloc (1, sizeof (*convolver))))
+        return NULL;
+
+    convolver->block_size = block_size;
+    convolver->head_size = ATFFT_MIN (block_size, kernel_size);
+    convolver->head = malloc (convolver->head_size * sizeof (*(convolver->head)));
+    convolver->history = calloc (2 * block_size, sizeof (*(convolver->history)));
+
+    if (!(convolver->head && convolver->history))
+        goto failed;
+
+    /* The head is stored reversed for the direct convolution. */
+    for (int i = 0; i < convolver->head_size; ++i)
+        convolver->head [i] = kernel [convolver->head_size - 1 - i];
+
+    if (kernel_size > block_size)
+    {
+        convolver->near = atfft_convolver_create (kernel + block_size, near_end - block_size, block_size);
+        convolver->near_output = calloc (block_size, sizeof (*(convolver->near_output)));
+
+        if (!(convolver->near && convolver->near_output))
+            goto failed;
+    }
+
+    convolver->n_stages = atfft_zero_latency_count_stages (kernel_size, block_size);
+
+    if (convolver->n_stages)
+    {
+        convolver->stages = calloc (convolver->n_stages, sizeof (*(convolver->stages)));
+
+        if (!convolver->stages)
+            goto failed;
+    }
+
+    for (int i = 0; i < convolver->n_stages; ++i)
+    {
+        int start = 2 * b;
+        int end = i == convolver->n_stages - 1 ? kernel_size : ATFFT_MIN (4 * b, kernel_size);
+
+        if (!atfft_zero_latency_stage_init (convolver->stages + i, kernel + start, end - start, b))
+            goto failed;
+
+        b *= 2;
+    }
+
+    return convolver;
+
+failed:
+    atfft_zero_latency_convolver_destroy (convolver);
+    return NULL;
+}
+
+void atfft_zero_latency_convolver_destroy (struct atfft_zero_latency_convolver *convolver)
+{
+    if (convolver)
+    {
+        if (convolver->stages)
+        {
+            for (int i = 0; i < convolver->n_stages; ++i)
+                atfft_zero_latency_stage_free (convolver->stages + i);
+
+            free (convolver->stages);
+        }
+
+        free (convolver->near_output);
+        atfft_convolver_destroy (convolver->near);
+        free (convolver->history);
+        free (convolver->head);
+        free (convolver);
+    }
+}
+
+static void atfft_zero_latency_head (struct atfft_zero_latency_convolver *convolver,
+                                     const atfft_sample *in,
+                                     atfft_sample *out)
+{
+    int block_size = convolver->block_size;
+    int head_size = convolver->head_size;
+    atfft_sample *history = convolver->history;
+
+    /* The history holds the previous block followed by this one. */
+    memcpy (history + block_size, in, block_size * sizeof (*in));
+
+    for (int n = 0; n < block_size; ++n)
+    {
+        const atfft_sample *x = history + block_size + n - head_size + 1;
+        atfft_sample sum = 0.0;
+
+        for (int k = 0; k < head_size; ++k)
+            sum += convolver->head [k] * x [k];
+
+        out [n] = sum;
+    }
+
+    memcpy (history, history + block_size, block_size * sizeof (*history));
+}
+
+static void atfft_zero_latency_stage_process (struct atfft_zero_latency_stage *stage,
+                                              const atfft_sample *in,
+                                              atfft_sample *out,
+                                              int size)
+{
+    const atfft_sample *output = stage->output [stage->front] + stage->read_position;
+
+    for (int i = 0; i < size; ++i)
+        out [i] += output [i];
+
+    memcpy (stage->gather + stage->gather_position, in, size * sizeof (*in));
+    stage->gather_position += size;
+    stage->read_position += size;
+
+    if (stage->gather_position == stage->block_size)
+    {
+        /* Collect the previous block, this only waits if the worker is late. */
+        if (stage->pending)
+        {
+            atfft_zero_latency_stage_wait (stage);
+            stage->front = 1 - stage->front;
+        }
+
+        memcpy (stage->input, stage->gather, stage->block_size * sizeof (*(stage->gather)));
+        stage->pending = 1;
+        atfft_zero_latency_stage_start (stage);
+
+        stage->gather_position = 0;
+        stage->read_position = 0;
+    }
+}
+
+void atfft_zero_latency_convolver_process (struct atfft_zero_latency_convolver *convolver,
+                                           const atfft_sample *in,
+                                           atfft_sample *out)
+{
+    int block_size = convolver->block_size;
+
+    /* The head reads all of the input before writing any output,
+     * after that the input is only read from the history. */
+    atfft_zero_latency_head (convolver, in, out);
+    in = convolver->history;
+
+    if (convolver->near)
+    {
+        for (int i = 0; i < block_size; ++i)
+            out [i] += convolver->near_output [i];
+
+        atfft_convolver_process (convolver->near, in, convolver->near_output);
+    }
+
+    for (int i = 0; i < convolver->n_stages; ++i)
+        atfft_zero_latency_stage_process (convolver->stages + i, in, out, block_size);
+}
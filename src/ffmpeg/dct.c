@@ -27,6 +27,7 @@
 #include <libavutil/mem.h>
 #include <libavcodec/avfft.h>
 #include <atfft/dct.h>
+#include "../atfft/dct_generic.h"
 
 #ifndef ATFFT_TYPE_FLOAT
 #   ifdef _MSC_VER
@@ -49,6 +50,9 @@ struct atfft_dct
     /* buffer for libavcodec to operate on */
     size_t n_data_bytes;
     FFTSample *data;
+
+    /* the other transform types are built on the ffmpeg DFT */
+    struct atfft_dct_generic *generic;
 };
 
 int atfft_dct_is_supported_size (int size)
@@ -59,6 +63,17 @@ int atfft_dct_is_supported_size (int size)
     return atfft_is_power_of_2 (size) && size >= min && size <= max;
 }
 
+static int atfft_dct_is_ffmpeg_type (int size, enum atfft_dct_type type)
+{
+    /* Only DCT-II and DCT-III plans are wrapped for ffmpeg. */
+    return (type == ATFFT_DCT_II || type == ATFFT_DCT_III) && atfft_dct_is_supported_size (size);
+}
+
+int atfft_dct_is_supported_type (int size, enum atfft_dct_type type)
+{
+    return atfft_dct_is_ffmpeg_type (size, type) || atfft_dct_generic_is_supported_type (size, type);
+}
+
 struct atfft_dct* atfft_dct_create (int size, enum atfft_direction direction)
 {
     /* ffmpeg only supports sizes which are a power of 2. */
@@ -90,18 +105,51 @@ struct atfft_dct* atfft_dct_create (int size, enum atfft_direction direction)
     return plan;
 }
 
+struct atfft_dct* atfft_dct_create_type (int size, enum atfft_dct_type type)
+{
+    assert (atfft_dct_is_supported_type (size, type));
+
+    if (atfft_dct_is_ffmpeg_type (size, type))
+        return atfft_dct_create (size, type == ATFFT_DCT_II ? ATFFT_FORWARD : ATFFT_BACKWARD);
+
+    struct atfft_dct *plan;
+
+    if (!(plan = calloc (1, sizeof (*plan))))
+        return NULL;
+
+    plan->size = size;
+    plan->generic = atfft_dct_generic_create (size, type);
+
+    if (!plan->generic)
+    {
+        free (plan);
+        return NULL;
+    }
+
+    return plan;
+}
+
 void atfft_dct_destroy (struct atfft_dct *plan)
 {
     if (plan)
     {
+        atfft_dct_generic_destroy (plan->generic);
         av_free (plan->data);
-        av_dct_end (plan->context);
+
+        if (plan->context)
+            av_dct_end (plan->context);
         free (plan);
     }
 }
 
 void atfft_dct_transform (struct atfft_dct *plan, const atfft_sample *in, atfft_sample *out)
 {
+    if (plan->generic)
+    {
+        atfft_dct_generic_transform (plan->generic, in, out);
+        return;
+    }
+
 #ifdef ATFFT_TYPE_FLOAT
     memcpy (plan->data, in, plan->n_data_bytes);
 #else
@@ -120,3 +168,10 @@ void atfft_dct_transform (struct atfft_dct *plan, const atfft_sample *in, atfft_
     if (plan->direction == ATFFT_BACKWARD)
         atfft_scale_real (out, plan->size, plan->size / 2.0);
 }
+
+int atfft_dct_set_window (struct atfft_dct *plan, const atfft_sample *window)
+{
+    /* Only MDCTs have windows, and they use the generic implementation. */
+    assert (plan->generic);
+    return atfft_dct_generic_set_window (plan->generic, window);
+}
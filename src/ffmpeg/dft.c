@@ -20,6 +20,9 @@
  * SOFTWARE.
  */
 
+#define ATFFT_DFT_BACKEND ffmpeg
+#include "../atfft/dft_backend_internal.h"
+
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
@@ -27,6 +30,7 @@
 #include <libavutil/mem.h>
 #include <libavcodec/avfft.h>
 #include <atfft/dft.h>
+#include <atfft/dft_util.h>
 
 #ifndef ATFFT_TYPE_FLOAT
 #   ifdef _MSC_VER
@@ -117,6 +121,20 @@ struct atfft_dft* atfft_dft_create (int size, enum atfft_direction direction, en
     return plan;
 }
 
+struct atfft_dft* atfft_dft_create_pruned (int size,
+                                           enum atfft_direction direction,
+                                           enum atfft_format format,
+                                           int n_inputs,
+                                           int first_output,
+                                           int n_outputs)
+{
+    /* FFmpeg has no pruned transforms, so fall back to a full one. */
+    if (!atfft_dft_is_valid_pruning (size, direction, format, n_inputs, first_output, n_outputs))
+        return NULL;
+
+    return atfft_dft_create (size, direction, format);
+}
+
 void atfft_dft_destroy (struct atfft_dft *plan)
 {
     if (plan)
@@ -286,3 +304,21 @@ void atfft_dft_real_backward_transform_stride (struct atfft_dft *plan,
                                        out_stride,
                                        plan->size);
 }
+
+#ifdef ATFFT_MULTI_BACKEND
+const struct atfft_dft_backend ATFFT_DFT_BACKEND_SYMBOL (backend) =
+{
+    .name = ATFFT_DFT_BACKEND_NAME,
+    .is_supported_size = atfft_dft_is_supported_size,
+    .create = atfft_dft_create,
+    .create_pruned = atfft_dft_create_pruned,
+    .destroy = atfft_dft_destroy,
+    .complex_transform = atfft_dft_complex_transform,
+    .complex_transform_stride = atfft_dft_complex_transform_stride,
+    .real_forward_transform = atfft_dft_real_forward_transform,
+    .real_forward_transform_stride = atfft_dft_real_forward_transform_stride,
+    .real_backward_transform = atfft_dft_real_backward_transform,
+    .real_backward_transform_stride = atfft_dft_real_backward_transform_stride,
+    .print_plan = NULL
+};
+#endif
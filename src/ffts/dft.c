@@ -20,7 +20,12 @@
  * SOFTWARE.
  */
 
+#define ATFFT_DFT_BACKEND ffts
+#include "../atfft/dft_backend_internal.h"
+
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
 #include <assert.h>
 #include <atfft/dft.h>
 #include <atfft/dft_util.h>
@@ -45,13 +50,22 @@ struct atfft_dft
     /* the ffts plan */
     ffts_plan_t *plan;
 
-#ifndef ATFFT_TYPE_FLOAT
     /* input and output buffers for ffts transform */
     size_t in_size, out_size;
     float *in, *out;
-#endif
 };
 
+/* FFTS uses aligned SIMD loads and stores, so the caller's arrays can only
+ * be used directly if they are suitably aligned. */
+#ifndef ATFFT_FFTS_ALIGNMENT
+#define ATFFT_FFTS_ALIGNMENT 16
+#endif
+
+static int is_aligned (const void *array)
+{
+    return (uintptr_t) array % ATFFT_FFTS_ALIGNMENT == 0;
+}
+
 int atfft_dft_is_supported_size (int size, enum atfft_format format)
 {
     if (format == ATFFT_COMPLEX)
@@ -91,8 +105,8 @@ struct atfft_dft* atfft_dft_create (int size, enum atfft_direction direction, en
     plan->direction = direction;
     plan->format = format;
 
-#ifndef ATFFT_TYPE_FLOAT
-    /* allocate input and output buffers */
+    /* allocate input and output buffers, in single precision these are
+     * only used when the caller's arrays aren't aligned */
     if (format == ATFFT_COMPLEX)
     {
         plan->in_size = 2 * size;
@@ -117,7 +131,6 @@ struct atfft_dft* atfft_dft_create (int size, enum atfft_direction direction, en
 
     if (!(plan->in && plan->out))
         goto failed;
-#endif
 
     /* initialise the ffts plan */
     plan->plan = init_ffts_plan (size, direction, format);
@@ -132,6 +145,20 @@ failed:
     return NULL;
 }
 
+struct atfft_dft* atfft_dft_create_pruned (int size,
+                                           enum atfft_direction direction,
+                                           enum atfft_format format,
+                                           int n_inputs,
+                                           int first_output,
+                                           int n_outputs)
+{
+    /* FFTS has no pruned transforms, so fall back to a full one. */
+    if (!atfft_dft_is_valid_pruning (size, direction, format, n_inputs, first_output, n_outputs))
+        return NULL;
+
+    return atfft_dft_create (size, direction, format);
+}
+
 void atfft_dft_destroy (struct atfft_dft *plan)
 {
     if (plan)
@@ -139,10 +166,8 @@ void atfft_dft_destroy (struct atfft_dft *plan)
         if (plan->plan) /* ffts can't hack freeing a null pointer */
             ffts_free (plan->plan);
 
-#ifndef ATFFT_TYPE_FLOAT
         free (plan->out);
         free (plan->in);
-#endif
 
         free (plan);
     }
@@ -151,7 +176,16 @@ void atfft_dft_destroy (struct atfft_dft *plan)
 static void apply_transform (struct atfft_dft *plan, const atfft_sample *in, atfft_sample *out)
 {
 #ifdef ATFFT_TYPE_FLOAT
-    ffts_execute (plan->plan, (const float*) in, (float*) out);
+    if (is_aligned (in) && is_aligned (out))
+    {
+        ffts_execute (plan->plan, (const float*) in, (float*) out);
+    }
+    else
+    {
+        memcpy (plan->in, in, plan->in_size * sizeof (*(plan->in)));
+        ffts_execute (plan->plan, plan->in, plan->out);
+        memcpy (out, plan->out, plan->out_size * sizeof (*(plan->out)));
+    }
 #else
     atfft_sample_to_float_real (in, plan->in, plan->in_size);
     ffts_execute (plan->plan, plan->in, plan->out);
@@ -182,3 +216,21 @@ void atfft_dft_real_backward_transform (struct atfft_dft *plan, atfft_complex *i
 
     apply_transform (plan, (atfft_sample*) in, out);
 }
+
+#ifdef ATFFT_MULTI_BACKEND
+const struct atfft_dft_backend ATFFT_DFT_BACKEND_SYMBOL (backend) =
+{
+    .name = ATFFT_DFT_BACKEND_NAME,
+    .is_supported_size = atfft_dft_is_supported_size,
+    .create = atfft_dft_create,
+    .create_pruned = atfft_dft_create_pruned,
+    .destroy = atfft_dft_destroy,
+    .complex_transform = atfft_dft_complex_transform,
+    .complex_transform_stride = NULL,
+    .real_forward_transform = atfft_dft_real_forward_transform,
+    .real_forward_transform_stride = NULL,
+    .real_backward_transform = atfft_dft_real_backward_transform,
+    .real_backward_transform_stride = NULL,
+    .print_plan = NULL
+};
+#endif
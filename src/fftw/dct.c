@@ -26,11 +26,12 @@
 #include <atfft/dct.h>
 #include <fftw3.h>
 #include "fftw_definitions.h"
+#include "fftw_planner.h"
 
 struct atfft_dct
 {
     int size;
-    enum atfft_direction direction;
+    enum atfft_dct_type type;
 
     /* the fftw plan */
     atfft_fftw_plan plan;
@@ -38,17 +39,58 @@ struct atfft_dct
     /* aligned input and output buffers for fftw transform */
     size_t n_in_out_bytes;
     atfft_sample *in, *out;
+
+    /* MDCT/IMDCT window */
+    atfft_sample *window;
 };
 
+int atfft_dct_is_supported_type (int size, enum atfft_dct_type type)
+{
+    switch (type)
+    {
+        case ATFFT_DCT_I:
+            return size > 1;
+        case ATFFT_MDCT:
+        case ATFFT_IMDCT:
+            return size > 0 && atfft_is_even (size);
+        default:
+            return size > 0;
+    }
+}
+
 int atfft_dct_is_supported_size (int size)
 {
-    return size > 0;
+    return atfft_dct_is_supported_type (size, ATFFT_DCT_II);
 }
 
-struct atfft_dct* atfft_dct_create (int size, enum atfft_direction direction)
+static fftw_r2r_kind atfft_fftw_r2r_kind (enum atfft_dct_type type)
+{
+    switch (type)
+    {
+        case ATFFT_DCT_I:
+            return FFTW_REDFT00;
+        case ATFFT_DCT_II:
+            return FFTW_REDFT10;
+        case ATFFT_DCT_III:
+            return FFTW_REDFT01;
+        case ATFFT_DST_I:
+            return FFTW_RODFT00;
+        case ATFFT_DST_II:
+            return FFTW_RODFT10;
+        case ATFFT_DST_III:
+            return FFTW_RODFT01;
+        case ATFFT_DST_IV:
+            return FFTW_RODFT11;
+        default:
+            /* The MDCT and IMDCT are computed with a DCT-IV. */
+            return FFTW_REDFT11;
+    }
+}
+
+struct atfft_dct* atfft_dct_create_type (int size, enum atfft_dct_type type)
 {
     /* fftw supports all sizes. */
-    assert (atfft_dct_is_supported_size (size));
+    assert (atfft_dct_is_supported_type (size, type));
 
     struct atfft_dct *plan;
 
@@ -56,7 +98,7 @@ struct atfft_dct* atfft_dct_create (int size, enum atfft_direction direction)
         return NULL;
 
     plan->size = size;
-    plan->direction = direction;
+    plan->type = type;
 
     /* allocate input and output buffers */
     plan->n_in_out_bytes = size * sizeof (*(plan->in));
@@ -67,22 +109,12 @@ struct atfft_dct* atfft_dct_create (int size, enum atfft_direction direction)
         goto failed;
 
     /* initialise the fftw plan */
-    if (direction == ATFFT_FORWARD)
-    {
-        plan->plan = ATFFT_FFTW_PLAN_R2R_1D (size,
-                                             plan->in,
-                                             plan->out,
-                                             FFTW_REDFT10,
-                                             ATFFT_FFTW_PLANNING_METHOD);
-    }
-    else
-    {
-        plan->plan = ATFFT_FFTW_PLAN_R2R_1D (size,
-                                             plan->in,
-                                             plan->out,
-                                             FFTW_REDFT01,
-                                             ATFFT_FFTW_PLANNING_METHOD);
-    }
+    plan->plan = ATFFT_FFTW_PLAN_R2R_1D (size,
+                                         plan->in,
+                                         plan->out,
+                                         atfft_fftw_r2r_kind (type),
+                                         atfft_fftw_begin_planning());
+    atfft_fftw_end_planning();
 
     if (!plan->plan)
         goto failed;
@@ -94,10 +126,16 @@ failed:
     return NULL;
 }
 
+struct atfft_dct* atfft_dct_create (int size, enum atfft_direction direction)
+{
+    return atfft_dct_create_type (size, direction == ATFFT_FORWARD ? ATFFT_DCT_II : ATFFT_DCT_III);
+}
+
 void atfft_dct_destroy (struct atfft_dct *plan)
 {
     if (plan)
     {
+        free (plan->window);
         ATFFT_FFTW_DESTROY_PLAN (plan->plan);
         ATFFT_FFTW_FREE (plan->out);
         ATFFT_FFTW_FREE (plan->in);
@@ -105,12 +143,100 @@ void atfft_dct_destroy (struct atfft_dct *plan)
     }
 }
 
-void atfft_dct_transform (struct atfft_dct *plan, const atfft_sample *in, atfft_sample *out)
+int atfft_dct_set_window (struct atfft_dct *plan, const atfft_sample *window)
 {
-    memcpy (plan->in, in, plan->n_in_out_bytes);
+    /* Only to be used with MDCTs. */
+    assert (plan->type == ATFFT_MDCT || plan->type == ATFFT_IMDCT);
+
+    if (!window)
+    {
+        free (plan->window);
+        plan->window = NULL;
+        return 0;
+    }
+
+    if (!plan->window)
+    {
+        plan->window = malloc (2 * plan->size * sizeof (*(plan->window)));
+
+        if (!plan->window)
+            return -1;
+    }
+
+    memcpy (plan->window, window, 2 * plan->size * sizeof (*(plan->window)));
+    return 0;
+}
+
+static atfft_sample windowed (const struct atfft_dct *plan, const atfft_sample *in, int i)
+{
+    return plan->window ? plan->window [i] * in [i] : in [i];
+}
+
+static void mdct_transform (struct atfft_dct *plan, const atfft_sample *in, atfft_sample *out)
+{
+    int half = plan->size / 2;
+
+    /* fold the input quarters (a, b, c, d) into (-c_r - d, a - b_r) */
+    for (int i = 0; i < half; ++i)
+    {
+        plan->in [i] = - windowed (plan, in, 3 * half - 1 - i) - windowed (plan, in, 3 * half + i);
+        plan->in [half + i] = windowed (plan, in, i) - windowed (plan, in, plan->size - 1 - i);
+    }
+
     ATFFT_FFTW_EXECUTE (plan->plan);
     memcpy (out, plan->out, plan->n_in_out_bytes);
 
     /* fftw multiplies DCT bins by 2 */
     atfft_scale_real (out, plan->size, 0.5);
 }
+
+static void imdct_transform (struct atfft_dct *plan, const atfft_sample *in, atfft_sample *out)
+{
+    int size = plan->size;
+    int half = size / 2;
+
+    memcpy (plan->in, in, plan->n_in_out_bytes);
+    ATFFT_FFTW_EXECUTE (plan->plan);
+
+    /* unfold the DCT-IV output (p, q) into (q, -q_r, -p_r, -p),
+     * removing fftw's factor of 2 */
+    for (int i = 0; i < half; ++i)
+    {
+        atfft_sample p = 0.5 * plan->out [i];
+        atfft_sample q = 0.5 * plan->out [half + i];
+
+        out [i] = q;
+        out [size - 1 - i] = -q;
+        out [3 * half - 1 - i] = -p;
+        out [3 * half + i] = -p;
+    }
+
+    if (plan->window)
+    {
+        for (int i = 0; i < 2 * size; ++i)
+        {
+            out [i] *= plan->window [i];
+        }
+    }
+}
+
+void atfft_dct_transform (struct atfft_dct *plan, const atfft_sample *in, atfft_sample *out)
+{
+    if (plan->type == ATFFT_MDCT)
+    {
+        mdct_transform (plan, in, out);
+    }
+    else if (plan->type == ATFFT_IMDCT)
+    {
+        imdct_transform (plan, in, out);
+    }
+    else
+    {
+        memcpy (plan->in, in, plan->n_in_out_bytes);
+        ATFFT_FFTW_EXECUTE (plan->plan);
+        memcpy (out, plan->out, plan->n_in_out_bytes);
+
+        /* fftw multiplies DCT bins by 2 */
+        atfft_scale_real (out, plan->size, 0.5);
+    }
+}
@@ -20,6 +20,9 @@
  * SOFTWARE.
  */
 
+#define ATFFT_DFT_BACKEND fftw
+#include "../atfft/dft_backend_internal.h"
+
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
@@ -27,6 +30,7 @@
 #include <atfft/dft_util.h>
 #include <fftw3.h>
 #include "fftw_definitions.h"
+#include "fftw_planner.h"
 
 struct atfft_dft
 {
@@ -51,7 +55,8 @@ static atfft_fftw_plan init_fftw_plan (int size,
                                        enum atfft_direction direction,
                                        enum atfft_format format,
                                        atfft_sample *in,
-                                       atfft_sample *out)
+                                       atfft_sample *out,
+                                       unsigned flags)
 {
     if (format == ATFFT_COMPLEX)
     {
@@ -60,13 +65,13 @@ static atfft_fftw_plan init_fftw_plan (int size,
                                            (atfft_fftw_complex*) in,
                                            (atfft_fftw_complex*) out,
                                            FFTW_FORWARD,
-                                           ATFFT_FFTW_PLANNING_METHOD);
+                                           flags);
         else
             return ATFFT_FFTW_PLAN_DFT_1D (size,
                                            (atfft_fftw_complex*) in,
                                            (atfft_fftw_complex*) out,
                                            FFTW_BACKWARD,
-                                           ATFFT_FFTW_PLANNING_METHOD);
+                                           flags);
     }
     else
     {
@@ -74,12 +79,12 @@ static atfft_fftw_plan init_fftw_plan (int size,
             return ATFFT_FFTW_PLAN_DFT_R2C_1D (size,
                                                in,
                                                (atfft_fftw_complex*) out,
-                                               ATFFT_FFTW_PLANNING_METHOD);
+                                               flags);
         else
             return ATFFT_FFTW_PLAN_DFT_C2R_1D (size,
                                                (atfft_fftw_complex*) in,
                                                out,
-                                               ATFFT_FFTW_PLANNING_METHOD);
+                                               flags);
     }
 
     return NULL;
@@ -126,7 +131,8 @@ struct atfft_dft* atfft_dft_create (int size, enum atfft_direction direction, en
         goto failed;
 
     /* initialise the fftw plan */
-    plan->plan = init_fftw_plan (size, direction, format, plan->in, plan->out);
+    plan->plan = init_fftw_plan (size, direction, format, plan->in, plan->out, atfft_fftw_begin_planning());
+    atfft_fftw_end_planning();
 
     if (!plan->plan)
         goto failed;
@@ -138,6 +144,20 @@ failed:
     return NULL;
 }
 
+struct atfft_dft* atfft_dft_create_pruned (int size,
+                                           enum atfft_direction direction,
+                                           enum atfft_format format,
+                                           int n_inputs,
+                                           int first_output,
+                                           int n_outputs)
+{
+    /* FFTW has no pruned transforms, so fall back to a full one. */
+    if (!atfft_dft_is_valid_pruning (size, direction, format, n_inputs, first_output, n_outputs))
+        return NULL;
+
+    return atfft_dft_create (size, direction, format);
+}
+
 void atfft_dft_destroy (struct atfft_dft *plan)
 {
     if (plan)
@@ -156,12 +176,28 @@ static void apply_transform (struct atfft_dft *plan, const atfft_sample *in, atf
     memcpy (out, plan->out, plan->n_out_bytes);
 }
 
+/* FFTW's new-array execute functions can only be used on arrays with the
+ * same alignment as those the plan was made for, and which, like them,
+ * are distinct. */
+static int is_aligned (const atfft_sample *array, const atfft_sample *plan_array)
+{
+    return ATFFT_FFTW_ALIGNMENT_OF ((atfft_sample*) array) == ATFFT_FFTW_ALIGNMENT_OF ((atfft_sample*) plan_array);
+}
+
+static int can_execute_directly (struct atfft_dft *plan, const atfft_sample *in, atfft_sample *out)
+{
+    return is_aligned (in, plan->in) && is_aligned (out, plan->out) && (const void*) in != (const void*) out;
+}
+
 void atfft_dft_complex_transform (struct atfft_dft *plan, atfft_complex *in, atfft_complex *out)
 {
     /* Only to be used with complex FFTs. */
     assert (plan->format == ATFFT_COMPLEX);
 
-    apply_transform (plan, (atfft_sample*) in, (atfft_sample*) out);
+    if (can_execute_directly (plan, (atfft_sample*) in, (atfft_sample*) out))
+        ATFFT_FFTW_EXECUTE_DFT (plan->plan, (atfft_fftw_complex*) in, (atfft_fftw_complex*) out);
+    else
+        apply_transform (plan, (atfft_sample*) in, (atfft_sample*) out);
 }
 
 void atfft_dft_real_forward_transform (struct atfft_dft *plan, const atfft_sample *in, atfft_complex *out)
@@ -169,7 +205,10 @@ void atfft_dft_real_forward_transform (struct atfft_dft *plan, const atfft_sampl
     /* Only to be used for forward real FFTs. */
     assert ((plan->format == ATFFT_REAL) && (plan->direction == ATFFT_FORWARD));
 
-    apply_transform (plan, in, (atfft_sample*) out);
+    if (can_execute_directly (plan, in, (atfft_sample*) out))
+        ATFFT_FFTW_EXECUTE_DFT_R2C (plan->plan, (atfft_sample*) in, (atfft_fftw_complex*) out);
+    else
+        apply_transform (plan, in, (atfft_sample*) out);
 }
 
 void atfft_dft_real_backward_transform (struct atfft_dft *plan, atfft_complex *in, atfft_sample *out)
@@ -177,5 +216,33 @@ void atfft_dft_real_backward_transform (struct atfft_dft *plan, atfft_complex *i
     /* Only to be used for backward real FFTs. */
     assert ((plan->format == ATFFT_REAL) && (plan->direction == ATFFT_BACKWARD));
 
-    apply_transform (plan, (atfft_sample*) in, out);
+    /* Complex to real transforms overwrite their input, so it is always
+     * copied, but the output can be written directly. */
+    if (is_aligned (out, plan->out))
+    {
+        memcpy (plan->in, in, plan->n_in_bytes);
+        ATFFT_FFTW_EXECUTE_DFT_C2R (plan->plan, (atfft_fftw_complex*) plan->in, out);
+    }
+    else
+    {
+        apply_transform (plan, (atfft_sample*) in, out);
+    }
 }
+
+#ifdef ATFFT_MULTI_BACKEND
+const struct atfft_dft_backend ATFFT_DFT_BACKEND_SYMBOL (backend) =
+{
+    .name = ATFFT_DFT_BACKEND_NAME,
+    .is_supported_size = atfft_dft_is_supported_size,
+    .create = atfft_dft_create,
+    .create_pruned = atfft_dft_create_pruned,
+    .destroy = atfft_dft_destroy,
+    .complex_transform = atfft_dft_complex_transform,
+    .complex_transform_stride = NULL,
+    .real_forward_transform = atfft_dft_real_forward_transform,
+    .real_forward_transform_stride = NULL,
+    .real_backward_transform = atfft_dft_real_backward_transform,
+    .real_backward_transform_stride = NULL,
+    .print_plan = NULL
+};
+#endif
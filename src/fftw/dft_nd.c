@@ -27,6 +27,7 @@
 #include <atfft/dft_nd_util.h>
 #include <fftw3.h>
 #include "fftw_definitions.h"
+#include "fftw_planner.h"
 
 struct atfft_dft_nd
 {
@@ -46,7 +47,8 @@ static atfft_fftw_plan init_fftw_plan (const int *dims,
                                        enum atfft_direction direction,
                                        enum atfft_format format,
                                        atfft_sample *in,
-                                       atfft_sample *out)
+                                       atfft_sample *out,
+                                       unsigned flags)
 {
     if (format == ATFFT_COMPLEX)
     {
@@ -56,14 +58,14 @@ static atfft_fftw_plan init_fftw_plan (const int *dims,
                                         (atfft_fftw_complex*) in,
                                         (atfft_fftw_complex*) out,
                                         FFTW_FORWARD,
-                                        ATFFT_FFTW_PLANNING_METHOD);
+                                        flags);
         else
             return ATFFT_FFTW_PLAN_DFT (n_dims,
                                         dims,
                                         (atfft_fftw_complex*) in,
                                         (atfft_fftw_complex*) out,
                                         FFTW_BACKWARD,
-                                        ATFFT_FFTW_PLANNING_METHOD);
+                                        flags);
     }
     else
     {
@@ -72,13 +74,13 @@ static atfft_fftw_plan init_fftw_plan (const int *dims,
                                             dims,
                                             in,
                                             (atfft_fftw_complex*) out,
-                                            ATFFT_FFTW_PLANNING_METHOD);
+                                            flags);
         else
             return ATFFT_FFTW_PLAN_DFT_C2R (n_dims,
                                             dims,
                                             (atfft_fftw_complex*) in,
                                             out,
-                                            ATFFT_FFTW_PLANNING_METHOD);
+                                            flags);
     }
 
     return NULL;
@@ -128,7 +130,8 @@ struct atfft_dft_nd* atfft_dft_nd_create (const int *dims,
         goto failed;
 
     /* initialise the fftw plan */
-    plan->plan = init_fftw_plan (dims, n_dims, direction, format, plan->in, plan->out);
+    plan->plan = init_fftw_plan (dims, n_dims, direction, format, plan->in, plan->out, atfft_fftw_begin_planning());
+    atfft_fftw_end_planning();
 
     if (!plan->plan)
         goto failed;
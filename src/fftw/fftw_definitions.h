@@ -23,10 +23,6 @@
 #ifndef ATFFT_FFTW_DEFINITIONS_H_INCLUDED
 #define ATFFT_FFTW_DEFINITIONS_H_INCLUDED
 
-#ifndef ATFFT_FFTW_PLANNING_METHOD
-#define ATFFT_FFTW_PLANNING_METHOD FFTW_ESTIMATE
-#endif
-
 #if defined(ATFFT_TYPE_FLOAT)
 #   define ATFFT_FFTW_MALLOC fftwf_malloc
 #   define ATFFT_FFTW_FREE fftwf_free
@@ -39,6 +35,15 @@
 #   define ATFFT_FFTW_PLAN_DFT_C2R fftwf_plan_dft_c2r
 #   define ATFFT_FFTW_PLAN_R2R_1D fftwf_plan_r2r_1d
 #   define ATFFT_FFTW_EXECUTE fftwf_execute
+#   define ATFFT_FFTW_EXECUTE_DFT fftwf_execute_dft
+#   define ATFFT_FFTW_EXECUTE_DFT_R2C fftwf_execute_dft_r2c
+#   define ATFFT_FFTW_EXECUTE_DFT_C2R fftwf_execute_dft_c2r
+#   define ATFFT_FFTW_ALIGNMENT_OF fftwf_alignment_of
+#   define ATFFT_FFTW_IMPORT_WISDOM_FROM_FILENAME fftwf_import_wisdom_from_filename
+#   define ATFFT_FFTW_EXPORT_WISDOM_TO_FILENAME fftwf_export_wisdom_to_filename
+#   define ATFFT_FFTW_INIT_THREADS fftwf_init_threads
+#   define ATFFT_FFTW_PLAN_WITH_NTHREADS fftwf_plan_with_nthreads
+#   define ATFFT_FFTW_WISDOM_SUFFIX ".fftwf"
     typedef fftwf_plan atfft_fftw_plan;
     typedef fftwf_complex atfft_fftw_complex;
     
@@ -54,6 +59,15 @@
 #   define ATFFT_FFTW_PLAN_DFT_C2R fftw_plan_dft_c2r
 #   define ATFFT_FFTW_PLAN_R2R_1D fftw_plan_r2r_1d
 #   define ATFFT_FFTW_EXECUTE fftw_execute
+#   define ATFFT_FFTW_EXECUTE_DFT fftw_execute_dft
+#   define ATFFT_FFTW_EXECUTE_DFT_R2C fftw_execute_dft_r2c
+#   define ATFFT_FFTW_EXECUTE_DFT_C2R fftw_execute_dft_c2r
+#   define ATFFT_FFTW_ALIGNMENT_OF fftw_alignment_of
+#   define ATFFT_FFTW_IMPORT_WISDOM_FROM_FILENAME fftw_import_wisdom_from_filename
+#   define ATFFT_FFTW_EXPORT_WISDOM_TO_FILENAME fftw_export_wisdom_to_filename
+#   define ATFFT_FFTW_INIT_THREADS fftw_init_threads
+#   define ATFFT_FFTW_PLAN_WITH_NTHREADS fftw_plan_with_nthreads
+#   define ATFFT_FFTW_WISDOM_SUFFIX ".fftw"
     typedef fftw_plan atfft_fftw_plan;
     typedef fftw_complex atfft_fftw_complex;
 
@@ -69,6 +83,15 @@
 #   define ATFFT_FFTW_PLAN_DFT_C2R fftwl_plan_dft_c2r
 #   define ATFFT_FFTW_PLAN_R2R_1D fftwl_plan_r2r_1d
 #   define ATFFT_FFTW_EXECUTE fftwl_execute
+#   define ATFFT_FFTW_EXECUTE_DFT fftwl_execute_dft
+#   define ATFFT_FFTW_EXECUTE_DFT_R2C fftwl_execute_dft_r2c
+#   define ATFFT_FFTW_EXECUTE_DFT_C2R fftwl_execute_dft_c2r
+#   define ATFFT_FFTW_ALIGNMENT_OF fftwl_alignment_of
+#   define ATFFT_FFTW_IMPORT_WISDOM_FROM_FILENAME fftwl_import_wisdom_from_filename
+#   define ATFFT_FFTW_EXPORT_WISDOM_TO_FILENAME fftwl_export_wisdom_to_filename
+#   define ATFFT_FFTW_INIT_THREADS fftwl_init_threads
+#   define ATFFT_FFTW_PLAN_WITH_NTHREADS fftwl_plan_with_nthreads
+#   define ATFFT_FFTW_WISDOM_SUFFIX ".fftwl"
     typedef fftwl_plan atfft_fftw_plan;
     typedef fftwl_complex atfft_fftw_complex;
 #endif
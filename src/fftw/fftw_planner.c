@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <atfft/types.h>
+#include <atfft/dft_planner.h>
+#include <fftw3.h>
+#include "fftw_definitions.h"
+#include "fftw_planner.h"
+
+/* the wisdom file last imported */
+static char *atfft_fftw_imported_wisdom_file = NULL;
+
+/* The fftw wisdom file for a path, fftw's wisdom is kept separately
+ * for each precision so a suffix is added.
+ */
+static char* atfft_fftw_wisdom_file_name (const char *path)
+{
+    char *name;
+
+    if (!(name = malloc (strlen (path) + strlen (ATFFT_FFTW_WISDOM_SUFFIX) + 1)))
+        return NULL;
+
+    strcpy (name, path);
+    strcat (name, ATFFT_FFTW_WISDOM_SUFFIX);
+    return name;
+}
+
+static void atfft_fftw_import_wisdom (void)
+{
+    const char *path = atfft_dft_get_wisdom_file();
+
+    if (!path)
+    {
+        free (atfft_fftw_imported_wisdom_file);
+        atfft_fftw_imported_wisdom_file = NULL;
+        return;
+    }
+
+    if (atfft_fftw_imported_wisdom_file && !strcmp (path, atfft_fftw_imported_wisdom_file))
+        return;
+
+    char *name = atfft_fftw_wisdom_file_name (path);
+    char *imported = malloc (strlen (path) + 1);
+
+    if (name && imported)
+    {
+        /* The file may not exist yet, in which case there is nothing to load. */
+        ATFFT_FFTW_IMPORT_WISDOM_FROM_FILENAME (name);
+
+        strcpy (imported, path);
+        free (atfft_fftw_imported_wisdom_file);
+        atfft_fftw_imported_wisdom_file = imported;
+        imported = NULL;
+    }
+
+    free (imported);
+    free (name);
+}
+
+unsigned atfft_fftw_begin_planning (void)
+{
+#ifdef ATFFT_FFTW_THREADS
+    static int threads_initialised = 0;
+
+    if (!threads_initialised)
+        threads_initialised = ATFFT_FFTW_INIT_THREADS();
+
+    if (threads_initialised)
+        ATFFT_FFTW_PLAN_WITH_NTHREADS (atfft_dft_get_n_threads());
+#endif /* ATFFT_FFTW_THREADS */
+
+    atfft_fftw_import_wisdom();
+
+    switch (atfft_dft_get_planning_effort())
+    {
+        case ATFFT_MEASURE:
+            return FFTW_MEASURE;
+
+        case ATFFT_PATIENT:
+            return FFTW_PATIENT;
+
+        case ATFFT_EXHAUSTIVE:
+            return FFTW_EXHAUSTIVE;
+
+        default:
+            return FFTW_ESTIMATE;
+    }
+}
+
+void atfft_fftw_end_planning (void)
+{
+    const char *path = atfft_dft_get_wisdom_file();
+
+    /* Estimated plans don't produce any wisdom worth keeping. */
+    if (!path || atfft_dft_get_planning_effort() == ATFFT_ESTIMATE)
+        return;
+
+    char *name = atfft_fftw_wisdom_file_name (path);
+
+    if (name)
+        ATFFT_FFTW_EXPORT_WISDOM_TO_FILENAME (name);
+
+    free (name);
+}
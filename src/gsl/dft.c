@@ -20,25 +20,17 @@
  * SOFTWARE.
  */
 
+#define ATFFT_DFT_BACKEND gsl
+#include "../atfft/dft_backend_internal.h"
+
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_eigen.h>
-#include <gsl/gsl_fft_complex.h>
-#include <gsl/gsl_fft_real.h>
-#include <gsl/gsl_fft_halfcomplex.h>
 #include <atfft/dft.h>
-
-#ifdef ATFFT_TYPE_LONG_DOUBLE
-#   ifdef _MSC_VER
-#       pragma message(": warning: GSL only supports double precision floating point, " \
-                       "higher precision values will be demoted to double for FFT calculations.")
-#   else
-#       warning GSL only supports double precision floating point, \
-                higher precision values will be demoted to double for FFT calculations.
-#   endif
-#endif
+#include <atfft/dft_util.h>
+#include "gsl_definitions.h"
 
 struct atfft_dft
 {
@@ -49,7 +41,7 @@ struct atfft_dft
 
     /* buffer for in place transform */
     size_t n_data_bytes;
-    double *data;
+    atfft_gsl_sample *data;
 
     /* buffers for gsl internals */
     void *work_area;
@@ -78,8 +70,8 @@ struct atfft_dft* atfft_dft_create (int size, enum atfft_direction direction, en
     if (format == ATFFT_COMPLEX)
     {
         plan->n_data_bytes = 2 * size * sizeof (*(plan->data));
-        plan->work_area = gsl_fft_complex_workspace_alloc (size);
-        plan->tables = gsl_fft_complex_wavetable_alloc (size);
+        plan->work_area = ATFFT_GSL_FFT_COMPLEX_WORKSPACE_ALLOC (size);
+        plan->tables = ATFFT_GSL_FFT_COMPLEX_WAVETABLE_ALLOC (size);
 
         if (direction == ATFFT_FORWARD)
             plan->gsl_direction = -1;
@@ -89,12 +81,12 @@ struct atfft_dft* atfft_dft_create (int size, enum atfft_direction direction, en
     else
     {
         plan->n_data_bytes = size * sizeof (*(plan->data));
-        plan->work_area = gsl_fft_real_workspace_alloc (size);
+        plan->work_area = ATFFT_GSL_FFT_REAL_WORKSPACE_ALLOC (size);
 
         if (direction == ATFFT_FORWARD)
-            plan->tables = gsl_fft_real_wavetable_alloc (size);
+            plan->tables = ATFFT_GSL_FFT_REAL_WAVETABLE_ALLOC (size);
         else
-            plan->tables = gsl_fft_halfcomplex_wavetable_alloc (size);
+            plan->tables = ATFFT_GSL_FFT_HALFCOMPLEX_WAVETABLE_ALLOC (size);
     }
 
     plan->data = malloc (plan->n_data_bytes);
@@ -109,23 +101,37 @@ struct atfft_dft* atfft_dft_create (int size, enum atfft_direction direction, en
     return plan;
 }
 
+struct atfft_dft* atfft_dft_create_pruned (int size,
+                                           enum atfft_direction direction,
+                                           enum atfft_format format,
+                                           int n_inputs,
+                                           int first_output,
+                                           int n_outputs)
+{
+    /* GSL has no pruned transforms, so fall back to a full one. */
+    if (!atfft_dft_is_valid_pruning (size, direction, format, n_inputs, first_output, n_outputs))
+        return NULL;
+
+    return atfft_dft_create (size, direction, format);
+}
+
 void atfft_dft_destroy (struct atfft_dft *plan)
 {
     if (plan)
     {
         if (plan->format == ATFFT_COMPLEX)
         {
-            gsl_fft_complex_wavetable_free (plan->tables);
-            gsl_fft_complex_workspace_free (plan->work_area);
+            ATFFT_GSL_FFT_COMPLEX_WAVETABLE_FREE (plan->tables);
+            ATFFT_GSL_FFT_COMPLEX_WORKSPACE_FREE (plan->work_area);
         }
         else
         {
             if (plan->direction == ATFFT_FORWARD)
-                gsl_fft_real_wavetable_free (plan->tables);
+                ATFFT_GSL_FFT_REAL_WAVETABLE_FREE (plan->tables);
             else
-                gsl_fft_halfcomplex_wavetable_free (plan->tables);
+                ATFFT_GSL_FFT_HALFCOMPLEX_WAVETABLE_FREE (plan->tables);
 
-            gsl_fft_real_workspace_free (plan->work_area);
+            ATFFT_GSL_FFT_REAL_WORKSPACE_FREE (plan->work_area);
         }
 
         free (plan->data);
@@ -138,17 +144,17 @@ void atfft_dft_complex_transform (struct atfft_dft *plan, atfft_complex *in, atf
     /* Only to be used with complex FFTs. */
     assert (plan->format == ATFFT_COMPLEX);
 
-    gsl_complex_packed_array data = plan->data;
+    atfft_gsl_sample *data = plan->data;
 
-#ifdef ATFFT_TYPE_DOUBLE
+#ifndef ATFFT_TYPE_LONG_DOUBLE
     memcpy (data, in, plan->n_data_bytes);
 #else
     atfft_sample_to_double_complex (in, (atfft_complex_d*) data, plan->size);
 #endif
 
-    gsl_fft_complex_transform (data, 1, plan->size, plan->tables, plan->work_area, plan->gsl_direction);
+    ATFFT_GSL_FFT_COMPLEX_TRANSFORM (data, 1, plan->size, plan->tables, plan->work_area, plan->gsl_direction);
 
-#ifdef ATFFT_TYPE_DOUBLE
+#ifndef ATFFT_TYPE_LONG_DOUBLE
     memcpy (out, data, plan->n_data_bytes);
 #else
     atfft_double_to_sample_complex ((atfft_complex_d*) data, out, plan->size);
@@ -164,24 +170,24 @@ void atfft_dft_complex_transform_stride (struct atfft_dft *plan,
     /* Only to be used with complex FFTs. */
     assert (plan->format == ATFFT_COMPLEX);
 
-    gsl_complex_packed_array data = plan->data;
+    atfft_gsl_sample *data = plan->data;
 
-    atfft_sample_to_double_complex_stride (in,
-                                           in_stride,
-                                           (atfft_complex_d*) data,
-                                           1,
-                                           plan->size);
+    ATFFT_GSL_SAMPLE_TO_COMPLEX_STRIDE (in,
+                                        in_stride,
+                                        (atfft_gsl_complex*) data,
+                                        1,
+                                        plan->size);
 
-    gsl_fft_complex_transform (data, 1, plan->size, plan->tables, plan->work_area, plan->gsl_direction);
+    ATFFT_GSL_FFT_COMPLEX_TRANSFORM (data, 1, plan->size, plan->tables, plan->work_area, plan->gsl_direction);
 
-    atfft_double_to_sample_complex_stride ((atfft_complex_d*) data,
-                                           1,
-                                           out,
-                                           out_stride,
-                                           plan->size);
+    ATFFT_GSL_COMPLEX_TO_SAMPLE_STRIDE ((atfft_gsl_complex*) data,
+                                        1,
+                                        out,
+                                        out_stride,
+                                        plan->size);
 }
 
-static void halfcomplex_gsl_to_atfft (const double *in,
+static void halfcomplex_gsl_to_atfft (const atfft_gsl_sample *in,
                                       atfft_complex *out,
                                       int out_stride,
                                       int size)
@@ -216,13 +222,13 @@ void atfft_dft_real_forward_transform (struct atfft_dft *plan, const atfft_sampl
     /* Only to be used for forward real FFTs. */
     assert ((plan->format == ATFFT_REAL) && (plan->direction == ATFFT_FORWARD));
 
-#ifdef ATFFT_TYPE_DOUBLE
+#ifndef ATFFT_TYPE_LONG_DOUBLE
     memcpy (plan->data, in, plan->n_data_bytes);
 #else
     atfft_sample_to_double_real (in, plan->data, plan->size);
 #endif
 
-    gsl_fft_real_transform (plan->data, 1, plan->size, plan->tables, plan->work_area);
+    ATFFT_GSL_FFT_REAL_TRANSFORM (plan->data, 1, plan->size, plan->tables, plan->work_area);
     halfcomplex_gsl_to_atfft (plan->data, out, 1, plan->size);
 }
 
@@ -235,19 +241,19 @@ void atfft_dft_real_forward_transform_stride (struct atfft_dft *plan,
     /* Only to be used for forward real FFTs. */
     assert ((plan->format == ATFFT_REAL) && (plan->direction == ATFFT_FORWARD));
 
-    atfft_sample_to_double_real_stride (in,
-                                        in_stride,
-                                        plan->data,
-                                        1,
-                                        plan->size);
+    ATFFT_GSL_SAMPLE_TO_REAL_STRIDE (in,
+                                     in_stride,
+                                     plan->data,
+                                     1,
+                                     plan->size);
 
-    gsl_fft_real_transform (plan->data, 1, plan->size, plan->tables, plan->work_area);
+    ATFFT_GSL_FFT_REAL_TRANSFORM (plan->data, 1, plan->size, plan->tables, plan->work_area);
     halfcomplex_gsl_to_atfft (plan->data, out, out_stride, plan->size);
 }
 
 static void halfcomplex_atfft_to_gsl (atfft_complex *in,
                                       int in_stride,
-                                      double *out,
+                                      atfft_gsl_sample *out,
                                       int size)
 {
     out [0] = ATFFT_RE (in [0]);
@@ -279,9 +285,9 @@ void atfft_dft_real_backward_transform (struct atfft_dft *plan, atfft_complex *i
     assert ((plan->format == ATFFT_REAL) && (plan->direction == ATFFT_BACKWARD));
 
     halfcomplex_atfft_to_gsl (in, 1, plan->data, plan->size);
-    gsl_fft_halfcomplex_transform (plan->data, 1, plan->size, plan->tables, plan->work_area);   
+    ATFFT_GSL_FFT_HALFCOMPLEX_TRANSFORM (plan->data, 1, plan->size, plan->tables, plan->work_area);   
 
-#ifdef ATFFT_TYPE_DOUBLE
+#ifndef ATFFT_TYPE_LONG_DOUBLE
     memcpy (out, plan->data, plan->n_data_bytes);
 #else
     atfft_double_to_sample_real (plan->data, out, plan->size);
@@ -298,10 +304,28 @@ void atfft_dft_real_backward_transform_stride (struct atfft_dft *plan,
     assert ((plan->format == ATFFT_REAL) && (plan->direction == ATFFT_BACKWARD));
 
     halfcomplex_atfft_to_gsl (in, in_stride, plan->data, plan->size);
-    gsl_fft_halfcomplex_transform (plan->data, 1, plan->size, plan->tables, plan->work_area);   
-    atfft_double_to_sample_real_stride (plan->data,
-                                        1,
-                                        out,
-                                        out_stride,
-                                        plan->size);
+    ATFFT_GSL_FFT_HALFCOMPLEX_TRANSFORM (plan->data, 1, plan->size, plan->tables, plan->work_area);   
+    ATFFT_GSL_REAL_TO_SAMPLE_STRIDE (plan->data,
+                                     1,
+                                     out,
+                                     out_stride,
+                                     plan->size);
 }
+
+#ifdef ATFFT_MULTI_BACKEND
+const struct atfft_dft_backend ATFFT_DFT_BACKEND_SYMBOL (backend) =
+{
+    .name = ATFFT_DFT_BACKEND_NAME,
+    .is_supported_size = atfft_dft_is_supported_size,
+    .create = atfft_dft_create,
+    .create_pruned = atfft_dft_create_pruned,
+    .destroy = atfft_dft_destroy,
+    .complex_transform = atfft_dft_complex_transform,
+    .complex_transform_stride = atfft_dft_complex_transform_stride,
+    .real_forward_transform = atfft_dft_real_forward_transform,
+    .real_forward_transform_stride = atfft_dft_real_forward_transform_stride,
+    .real_backward_transform = atfft_dft_real_backward_transform,
+    .real_backward_transform_stride = atfft_dft_real_backward_transform_stride,
+    .print_plan = NULL
+};
+#endif
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ATFFT_GSL_DEFINITIONS_H_INCLUDED
+#define ATFFT_GSL_DEFINITIONS_H_INCLUDED
+
+#ifdef ATFFT_TYPE_LONG_DOUBLE
+#   ifdef _MSC_VER
+#       pragma message(": warning: GSL only supports single and double precision floating point, " \
+                       "higher precision values will be demoted to double for FFT calculations.")
+#   else
+#       warning GSL only supports single and double precision floating point, \
+                higher precision values will be demoted to double for FFT calculations.
+#   endif
+#endif
+
+/* Single precision builds use GSL's float transforms,
+ * so only long double samples need converting. */
+#if defined(ATFFT_TYPE_FLOAT)
+#   include <gsl/gsl_fft_complex_float.h>
+#   include <gsl/gsl_fft_real_float.h>
+#   include <gsl/gsl_fft_halfcomplex_float.h>
+#   define ATFFT_GSL_FFT_COMPLEX_WORKSPACE_ALLOC gsl_fft_complex_workspace_float_alloc
+#   define ATFFT_GSL_FFT_COMPLEX_WORKSPACE_FREE gsl_fft_complex_workspace_float_free
+#   define ATFFT_GSL_FFT_COMPLEX_WAVETABLE_ALLOC gsl_fft_complex_wavetable_float_alloc
+#   define ATFFT_GSL_FFT_COMPLEX_WAVETABLE_FREE gsl_fft_complex_wavetable_float_free
+#   define ATFFT_GSL_FFT_COMPLEX_TRANSFORM gsl_fft_complex_float_transform
+#   define ATFFT_GSL_FFT_REAL_WORKSPACE_ALLOC gsl_fft_real_workspace_float_alloc
+#   define ATFFT_GSL_FFT_REAL_WORKSPACE_FREE gsl_fft_real_workspace_float_free
+#   define ATFFT_GSL_FFT_REAL_WAVETABLE_ALLOC gsl_fft_real_wavetable_float_alloc
+#   define ATFFT_GSL_FFT_REAL_WAVETABLE_FREE gsl_fft_real_wavetable_float_free
+#   define ATFFT_GSL_FFT_REAL_TRANSFORM gsl_fft_real_float_transform
+#   define ATFFT_GSL_FFT_HALFCOMPLEX_WAVETABLE_ALLOC gsl_fft_halfcomplex_wavetable_float_alloc
+#   define ATFFT_GSL_FFT_HALFCOMPLEX_WAVETABLE_FREE gsl_fft_halfcomplex_wavetable_float_free
+#   define ATFFT_GSL_FFT_HALFCOMPLEX_TRANSFORM gsl_fft_halfcomplex_float_transform
+#   define ATFFT_GSL_SAMPLE_TO_REAL_STRIDE atfft_sample_to_float_real_stride
+#   define ATFFT_GSL_REAL_TO_SAMPLE_STRIDE atfft_float_to_sample_real_stride
+#   define ATFFT_GSL_SAMPLE_TO_COMPLEX_STRIDE atfft_sample_to_float_complex_stride
+#   define ATFFT_GSL_COMPLEX_TO_SAMPLE_STRIDE atfft_float_to_sample_complex_stride
+    typedef float atfft_gsl_sample;
+    typedef atfft_complex_f atfft_gsl_complex;
+
+#else
+#   include <gsl/gsl_fft_complex.h>
+#   include <gsl/gsl_fft_real.h>
+#   include <gsl/gsl_fft_halfcomplex.h>
+#   define ATFFT_GSL_FFT_COMPLEX_WORKSPACE_ALLOC gsl_fft_complex_workspace_alloc
+#   define ATFFT_GSL_FFT_COMPLEX_WORKSPACE_FREE gsl_fft_complex_workspace_free
+#   define ATFFT_GSL_FFT_COMPLEX_WAVETABLE_ALLOC gsl_fft_complex_wavetable_alloc
+#   define ATFFT_GSL_FFT_COMPLEX_WAVETABLE_FREE gsl_fft_complex_wavetable_free
+#   define ATFFT_GSL_FFT_COMPLEX_TRANSFORM gsl_fft_complex_transform
+#   define ATFFT_GSL_FFT_REAL_WORKSPACE_ALLOC gsl_fft_real_workspace_alloc
+#   define ATFFT_GSL_FFT_REAL_WORKSPACE_FREE gsl_fft_real_workspace_free
+#   define ATFFT_GSL_FFT_REAL_WAVETABLE_ALLOC gsl_fft_real_wavetable_alloc
+#   define ATFFT_GSL_FFT_REAL_WAVETABLE_FREE gsl_fft_real_wavetable_free
+#   define ATFFT_GSL_FFT_REAL_TRANSFORM gsl_fft_real_transform
+#   define ATFFT_GSL_FFT_HALFCOMPLEX_WAVETABLE_ALLOC gsl_fft_halfcomplex_wavetable_alloc
+#   define ATFFT_GSL_FFT_HALFCOMPLEX_WAVETABLE_FREE gsl_fft_halfcomplex_wavetable_free
+#   define ATFFT_GSL_FFT_HALFCOMPLEX_TRANSFORM gsl_fft_halfcomplex_transform
+#   define ATFFT_GSL_SAMPLE_TO_REAL_STRIDE atfft_sample_to_double_real_stride
+#   define ATFFT_GSL_REAL_TO_SAMPLE_STRIDE atfft_double_to_sample_real_stride
+#   define ATFFT_GSL_SAMPLE_TO_COMPLEX_STRIDE atfft_sample_to_double_complex_stride
+#   define ATFFT_GSL_COMPLEX_TO_SAMPLE_STRIDE atfft_double_to_sample_complex_stride
+    typedef double atfft_gsl_sample;
+    typedef atfft_complex_d atfft_gsl_complex;
+#endif
+
+#endif /* ATFFT_GSL_DEFINITIONS_H_INCLUDED */
@@ -25,6 +25,7 @@
 #include <math.h>
 #include <atfft/dct.h>
 #include "ipp_definitions.h"
+#include "../atfft/dct_generic.h"
 
 struct atfft_dct
 {
@@ -44,6 +45,9 @@ struct atfft_dct
     /* buffer for converting to/from long double */
     atfft_ipp_sample *conversion_buffer;
 #endif
+
+    /* the other transform types are built on the ipp DFT */
+    struct atfft_dct_generic *generic;
 };
 
 int atfft_dct_is_supported_size (int size)
@@ -140,6 +144,17 @@ static void* init_ipp_plan (int size,
     return NULL;
 }
 
+static int atfft_dct_is_ipp_type (int size, enum atfft_dct_type type)
+{
+    /* Only DCT-II and DCT-III plans are wrapped for ipp. */
+    return (type == ATFFT_DCT_II || type == ATFFT_DCT_III) && atfft_dct_is_supported_size (size);
+}
+
+int atfft_dct_is_supported_type (int size, enum atfft_dct_type type)
+{
+    return atfft_dct_is_ipp_type (size, type) || atfft_dct_generic_is_supported_type (size, type);
+}
+
 struct atfft_dct* atfft_dct_create (int size, enum atfft_direction direction)
 {
     /* ipp supports all sizes. */
@@ -188,10 +203,36 @@ failed:
     return NULL;
 }
 
+struct atfft_dct* atfft_dct_create_type (int size, enum atfft_dct_type type)
+{
+    assert (atfft_dct_is_supported_type (size, type));
+
+    if (atfft_dct_is_ipp_type (size, type))
+        return atfft_dct_create (size, type == ATFFT_DCT_II ? ATFFT_FORWARD : ATFFT_BACKWARD);
+
+    struct atfft_dct *plan;
+
+    if (!(plan = calloc (1, sizeof (*plan))))
+        return NULL;
+
+    plan->size = size;
+    plan->generic = atfft_dct_generic_create (size, type);
+
+    if (!plan->generic)
+    {
+        free (plan);
+        return NULL;
+    }
+
+    return plan;
+}
+
 void atfft_dct_destroy (struct atfft_dct *plan)
 {
     if (plan)
     {
+        atfft_dct_generic_destroy (plan->generic);
+
 #ifdef ATFFT_TYPE_LONG_DOUBLE
         ippFree (plan->conversion_buffer);
 #endif
@@ -233,6 +274,12 @@ static void scale_backward_transform (const atfft_sample* in,
 
 void atfft_dct_transform (struct atfft_dct *plan, const atfft_sample *in, atfft_sample *out)
 {
+    if (plan->generic)
+    {
+        atfft_dct_generic_transform (plan->generic, in, out);
+        return;
+    }
+
 #ifdef ATFFT_TYPE_LONG_DOUBLE
     if (plan->direction == ATFFT_FORWARD)
     {
@@ -281,3 +328,10 @@ void atfft_dct_transform (struct atfft_dct *plan, const atfft_sample *in, atfft_
     }
 #endif
 }
+
+int atfft_dct_set_window (struct atfft_dct *plan, const atfft_sample *window)
+{
+    /* Only MDCTs have windows, and they use the generic implementation. */
+    assert (plan->generic);
+    return atfft_dct_generic_set_window (plan->generic, window);
+}
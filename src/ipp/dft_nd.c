@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+#include <atfft/dft_nd.h>
+#include "ipp_definitions.h"
+#include "../atfft/dft_nd_generic.h"
+
+struct atfft_dft_nd
+{
+    enum atfft_direction direction;
+    enum atfft_format format;
+
+#ifdef ATFFT_TYPE_FLOAT
+    /* the ippi plan and work area, for 2d complex transforms */
+    IppiDFTSpec_C_32fc *plan;
+    Ipp8u *work_area;
+    int step;
+#endif
+
+    /* row-column transform built on the 1d ipp plans for other shapes */
+    struct atfft_dft_nd_generic *generic;
+};
+
+#ifdef ATFFT_TYPE_FLOAT
+/* ippi only has single precision DFTs, and its real DFTs produce a packed
+ * spectrum, so only 2d complex transforms are handed to it. */
+static IppiDFTSpec_C_32fc* init_ippi_plan (const int *dims, Ipp8u **work_area)
+{
+    atfft_init_ipp();
+
+    IppiSize roi = {dims [1], dims [0]};
+
+    /* get the sizes of all the buffers we need */
+    int plan_buffer_size = 0;
+    int plan_init_size = 0;
+    int work_area_size = 0;
+
+    if (ippiDFTGetSize_C_32fc (roi,
+                               IPP_FFT_NODIV_BY_ANY,
+                               ippAlgHintNone,
+                               &plan_buffer_size,
+                               &plan_init_size,
+                               &work_area_size) != ippStsNoErr)
+        return NULL;
+
+    /* allocate buffers */
+    IppiDFTSpec_C_32fc *plan = ippMalloc (plan_buffer_size);
+    Ipp8u *plan_init_buffer = NULL;
+
+    if (!plan)
+        goto failed;
+
+    if (plan_init_size > 0)
+    {
+        plan_init_buffer = ippMalloc (plan_init_size);
+
+        if (!plan_init_buffer)
+            goto failed;
+    }
+
+    if (work_area_size > 0)
+    {
+        *work_area = ippMalloc (work_area_size);
+
+        if (!(*work_area))
+            goto failed;
+    }
+
+    /* initialise the ippi plan */
+    if (ippiDFTInit_C_32fc (roi,
+                            IPP_FFT_NODIV_BY_ANY,
+                            ippAlgHintNone,
+                            plan,
+                            plan_init_buffer) != ippStsNoErr)
+        goto failed;
+
+    ippFree (plan_init_buffer);
+
+    return plan;
+
+failed:
+    ippFree (*work_area);
+    *work_area = NULL;
+
+    ippFree (plan_init_buffer);
+    ippFree (plan);
+
+    return NULL;
+}
+#endif /* ATFFT_TYPE_FLOAT */
+
+struct atfft_dft_nd* atfft_dft_nd_create (const int *dims,
+                                          int n_dims,
+                                          enum atfft_direction direction,
+                                          enum atfft_format format)
+{
+    struct atfft_dft_nd *plan;
+
+    if (!(plan = calloc (1, sizeof (*plan))))
+        return NULL;
+
+    plan->direction = direction;
+    plan->format = format;
+
+#ifdef ATFFT_TYPE_FLOAT
+    if (n_dims == 2 && format == ATFFT_COMPLEX)
+    {
+        plan->plan = init_ippi_plan (dims, &(plan->work_area));
+        plan->step = dims [1] * sizeof (Ipp32fc);
+
+        if (!plan->plan)
+            goto failed;
+
+        return plan;
+    }
+#endif
+
+    plan->generic = atfft_dft_nd_generic_create (dims, n_dims, direction, format);
+
+    if (!plan->generic)
+        goto failed;
+
+    return plan;
+
+failed:
+    atfft_dft_nd_destroy (plan);
+    return NULL;
+}
+
+void atfft_dft_nd_destroy (struct atfft_dft_nd *plan)
+{
+    if (plan)
+    {
+        atfft_dft_nd_generic_destroy (plan->generic);
+
+#ifdef ATFFT_TYPE_FLOAT
+        ippFree (plan->work_area);
+        ippFree (plan->plan);
+#endif
+
+        free (plan);
+    }
+}
+
+void atfft_dft_nd_complex_transform (struct atfft_dft_nd *plan, atfft_complex *in, atfft_complex *out)
+{
+    /* Only to be used with complex FFTs. */
+    assert (plan->format == ATFFT_COMPLEX);
+
+#ifdef ATFFT_TYPE_FLOAT
+    if (plan->plan)
+    {
+        if (plan->direction == ATFFT_FORWARD)
+            ippiDFTFwd_CToC_32fc_C1R ((const Ipp32fc*) in,
+                                      plan->step,
+                                      (Ipp32fc*) out,
+                                      plan->step,
+                                      plan->plan,
+                                      plan->work_area);
+        else
+            ippiDFTInv_CToC_32fc_C1R ((const Ipp32fc*) in,
+                                      plan->step,
+                                      (Ipp32fc*) out,
+                                      plan->step,
+                                      plan->plan,
+                                      plan->work_area);
+
+        return;
+    }
+#endif
+
+    atfft_dft_nd_generic_complex_transform (plan->generic, in, out);
+}
+
+void atfft_dft_nd_real_forward_transform (struct atfft_dft_nd *plan, const atfft_sample *in, atfft_complex *out)
+{
+    /* Only to be used for forward real FFTs. */
+    assert ((plan->format == ATFFT_REAL) && (plan->direction == ATFFT_FORWARD));
+
+    atfft_dft_nd_generic_real_forward_transform (plan->generic, in, out);
+}
+
+void atfft_dft_nd_real_backward_transform (struct atfft_dft_nd *plan, atfft_complex *in, atfft_sample *out)
+{
+    /* Only to be used for backward real FFTs. */
+    assert ((plan->format == ATFFT_REAL) && (plan->direction == ATFFT_BACKWARD));
+
+    atfft_dft_nd_generic_real_backward_transform (plan->generic, in, out);
+}
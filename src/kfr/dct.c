@@ -28,6 +28,7 @@
 #include <atfft/dct.h>
 #include <kfr/capi.h>
 #include "kfr_definitions.h"
+#include "../atfft/dct_generic.h"
 
 typedef void (*kfr_execute_function) (void*, atfft_kfr_sample*, const atfft_kfr_sample*, uint8_t*);
 
@@ -46,6 +47,9 @@ struct atfft_dct
     /* input and output buffers for kfr transform */
     size_t in_size, out_size;
     atfft_kfr_sample *in, *out;
+
+    /* the other transform types are built on the kfr DFT */
+    struct atfft_dct_generic *generic;
 };
 
 int atfft_dct_is_supported_size (int size)
@@ -53,6 +57,17 @@ int atfft_dct_is_supported_size (int size)
     return size >= 4 && size <= 16777216;
 }
 
+static int atfft_dct_is_kfr_type (int size, enum atfft_dct_type type)
+{
+    /* Only DCT-II and DCT-III plans are wrapped for kfr. */
+    return (type == ATFFT_DCT_II || type == ATFFT_DCT_III) && atfft_dct_is_supported_size (size);
+}
+
+int atfft_dct_is_supported_type (int size, enum atfft_dct_type type)
+{
+    return atfft_dct_is_kfr_type (size, type) || atfft_dct_generic_is_supported_type (size, type);
+}
+
 struct atfft_dct* atfft_dct_create (int size, enum atfft_direction direction)
 {
     /* kfr most sizes */
@@ -101,10 +116,35 @@ failed:
     return NULL;
 }
 
+struct atfft_dct* atfft_dct_create_type (int size, enum atfft_dct_type type)
+{
+    assert (atfft_dct_is_supported_type (size, type));
+
+    if (atfft_dct_is_kfr_type (size, type))
+        return atfft_dct_create (size, type == ATFFT_DCT_II ? ATFFT_FORWARD : ATFFT_BACKWARD);
+
+    struct atfft_dct *plan;
+
+    if (!(plan = calloc (1, sizeof (*plan))))
+        return NULL;
+
+    plan->size = size;
+    plan->generic = atfft_dct_generic_create (size, type);
+
+    if (!plan->generic)
+    {
+        free (plan);
+        return NULL;
+    }
+
+    return plan;
+}
+
 void atfft_dct_destroy (struct atfft_dct *plan)
 {
     if (plan)
     {
+        atfft_dct_generic_destroy (plan->generic);
         kfr_deallocate (plan->out);
         kfr_deallocate (plan->in);
         kfr_deallocate (plan->work_area);
@@ -115,6 +155,12 @@ void atfft_dct_destroy (struct atfft_dct *plan)
 
 void atfft_dct_transform (struct atfft_dct *plan, const atfft_sample *in, atfft_sample *out)
 {
+    if (plan->generic)
+    {
+        atfft_dct_generic_transform (plan->generic, in, out);
+        return;
+    }
+
 #ifdef ATFFT_TYPE_LONG_DOUBLE
     atfft_sample_to_double_real (in, plan->in, plan->in_size);
     plan->transform_function (plan->plan, plan->out, plan->in, plan->work_area);
@@ -123,3 +169,10 @@ void atfft_dct_transform (struct atfft_dct *plan, const atfft_sample *in, atfft_
     plan->transform_function (plan->plan, out, in, plan->work_area);
 #endif
 }
+
+int atfft_dct_set_window (struct atfft_dct *plan, const atfft_sample *window)
+{
+    /* Only MDCTs have windows, and they use the generic implementation. */
+    assert (plan->generic);
+    return atfft_dct_generic_set_window (plan->generic, window);
+}
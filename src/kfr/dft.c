@@ -22,6 +22,9 @@
 
 #define KFR_NO_C_COMPLEX_TYPES 1
 
+#define ATFFT_DFT_BACKEND kfr
+#include "../atfft/dft_backend_internal.h"
+
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
@@ -156,6 +159,20 @@ failed:
     return NULL;
 }
 
+struct atfft_dft* atfft_dft_create_pruned (int size,
+                                           enum atfft_direction direction,
+                                           enum atfft_format format,
+                                           int n_inputs,
+                                           int first_output,
+                                           int n_outputs)
+{
+    /* KFR has no pruned transforms, so fall back to a full one. */
+    if (!atfft_dft_is_valid_pruning (size, direction, format, n_inputs, first_output, n_outputs))
+        return NULL;
+
+    return atfft_dft_create (size, direction, format);
+}
+
 void atfft_dft_destroy (struct atfft_dft *plan)
 {
     if (plan)
@@ -201,6 +218,13 @@ void atfft_dft_complex_transform_stride (struct atfft_dft *plan,
     /* Only to be used with complex FFTs. */
     assert (plan->format == ATFFT_COMPLEX);
 
+    /* Unit strides can use the caller's arrays directly. */
+    if (in_stride == 1 && out_stride == 1)
+    {
+        atfft_dft_complex_transform (plan, in, out);
+        return;
+    }
+
 #ifdef ATFFT_TYPE_FLOAT
     atfft_sample_to_float_complex_stride (in,
                                           in_stride,
@@ -249,6 +273,13 @@ void atfft_dft_real_forward_transform_stride (struct atfft_dft *plan,
     /* Only to be used for forward real FFTs. */
     assert ((plan->format == ATFFT_REAL) && (plan->direction == ATFFT_FORWARD));
 
+    /* Unit strides can use the caller's arrays directly. */
+    if (in_stride == 1 && out_stride == 1)
+    {
+        atfft_dft_real_forward_transform (plan, in, out);
+        return;
+    }
+
 #ifdef ATFFT_TYPE_FLOAT
     atfft_sample_to_float_real_stride (in,
                                        in_stride,
@@ -297,6 +328,13 @@ void atfft_dft_real_backward_transform_stride (struct atfft_dft *plan,
     /* Only to be used for backward real FFTs. */
     assert ((plan->format == ATFFT_REAL) && (plan->direction == ATFFT_BACKWARD));
 
+    /* Unit strides can use the caller's arrays directly. */
+    if (in_stride == 1 && out_stride == 1)
+    {
+        atfft_dft_real_backward_transform (plan, in, out);
+        return;
+    }
+
 #ifdef ATFFT_TYPE_FLOAT
     atfft_sample_to_float_complex_stride (in,
                                           in_stride,
@@ -327,3 +365,21 @@ void atfft_dft_real_backward_transform_stride (struct atfft_dft *plan,
                                         plan->out_size);
 #endif
 }
+
+#ifdef ATFFT_MULTI_BACKEND
+const struct atfft_dft_backend ATFFT_DFT_BACKEND_SYMBOL (backend) =
+{
+    .name = ATFFT_DFT_BACKEND_NAME,
+    .is_supported_size = atfft_dft_is_supported_size,
+    .create = atfft_dft_create,
+    .create_pruned = atfft_dft_create_pruned,
+    .destroy = atfft_dft_destroy,
+    .complex_transform = atfft_dft_complex_transform,
+    .complex_transform_stride = atfft_dft_complex_transform_stride,
+    .real_forward_transform = atfft_dft_real_forward_transform,
+    .real_forward_transform_stride = atfft_dft_real_forward_transform_stride,
+    .real_backward_transform = atfft_dft_real_backward_transform,
+    .real_backward_transform_stride = atfft_dft_real_backward_transform_stride,
+    .print_plan = NULL
+};
+#endif
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define KFR_NO_C_COMPLEX_TYPES 1
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <atfft/dft.h>
+#include <atfft/dft_nd.h>
+#include <atfft/dft_nd_util.h>
+#include <atfft/dft_util.h>
+#include <kfr/capi.h>
+#include "kfr_definitions.h"
+
+typedef void (*kfr_execute_function) (void*, atfft_kfr_sample*, const atfft_kfr_sample*, uint8_t*);
+
+struct atfft_dft_nd
+{
+    enum atfft_direction direction;
+    enum atfft_format format;
+
+    /* the kfr multidimensional plan */
+    void *plan;
+    kfr_execute_function transform_function;
+
+    /* buffer for kfr internals */
+    uint8_t *work_area;
+
+#ifdef ATFFT_TYPE_LONG_DOUBLE
+    /* input and output buffers for kfr transform */
+    size_t in_size, out_size;
+    atfft_kfr_sample *in, *out;
+#endif
+};
+
+static int is_supported_shape (const int *dims, int n_dims, enum atfft_format format)
+{
+    for (int i = 0; i < n_dims - 1; ++i)
+    {
+        if (!atfft_dft_is_supported_size (dims [i], ATFFT_COMPLEX))
+            return 0;
+    }
+
+    return atfft_dft_is_supported_size (dims [n_dims - 1], format);
+}
+
+static void* init_kfr_plan (const int *dims, int n_dims, enum atfft_format format)
+{
+    unsigned *shape = malloc (n_dims * sizeof (*shape));
+    void *plan = NULL;
+
+    if (!shape)
+        return NULL;
+
+    for (int i = 0; i < n_dims; ++i)
+    {
+        shape [i] = dims [i];
+    }
+
+    /* real plans only need to produce the halfcomplex output */
+    if (format == ATFFT_COMPLEX)
+        plan = ATFFT_KFR_DFT_CREATE_MD_PLAN (n_dims, shape);
+    else
+        plan = ATFFT_KFR_DFT_REAL_CREATE_MD_PLAN (n_dims, shape, true);
+
+    free (shape);
+    return plan;
+}
+
+static kfr_execute_function get_kfr_execute_function (enum atfft_direction direction,
+                                                      enum atfft_format format)
+{
+    if (format == ATFFT_COMPLEX)
+    {
+        if (direction == ATFFT_FORWARD)
+            return (kfr_execute_function) ATFFT_KFR_DFT_EXECUTE;
+        else
+            return (kfr_execute_function) ATFFT_KFR_DFT_EXECUTE_INVERSE;
+    }
+    else
+    {
+        if (direction == ATFFT_FORWARD)
+            return (kfr_execute_function) ATFFT_KFR_DFT_REAL_EXECUTE;
+        else
+            return (kfr_execute_function) ATFFT_KFR_DFT_REAL_EXECUTE_INVERSE;
+    }
+}
+
+struct atfft_dft_nd* atfft_dft_nd_create (const int *dims,
+                                          int n_dims,
+                                          enum atfft_direction direction,
+                                          enum atfft_format format)
+{
+    /* every dimension must be a size kfr supports in one dimension,
+     * so the last dimension of a real transform must be even. */
+    assert (is_supported_shape (dims, n_dims, format));
+
+    struct atfft_dft_nd *plan;
+
+    if (!(plan = calloc (1, sizeof (*plan))))
+        return NULL;
+
+    plan->direction = direction;
+    plan->format = format;
+
+    /* initialise the kfr plan */
+    plan->plan = init_kfr_plan (dims, n_dims, format);
+
+    if (!plan->plan)
+        goto failed;
+
+    plan->transform_function = get_kfr_execute_function (direction, format);
+
+    /* once we have a plan we can find out how much work space it needs */
+    size_t n_work_bytes = 0;
+
+    if (format == ATFFT_COMPLEX)
+        n_work_bytes = ATFFT_KFR_DFT_GET_TEMP_SIZE (plan->plan);
+    else
+        n_work_bytes = ATFFT_KFR_DFT_REAL_GET_TEMP_SIZE (plan->plan);
+
+    plan->work_area = kfr_allocate (n_work_bytes);
+
+    if (!plan->work_area)
+        goto failed;
+
+#ifdef ATFFT_TYPE_LONG_DOUBLE
+    /* allocate input and output buffers */
+    int full_size = atfft_int_array_product (dims, n_dims);
+
+    if (format == ATFFT_COMPLEX)
+    {
+        plan->in_size = 2 * full_size;
+        plan->out_size = 2 * full_size;
+    }
+    else
+    {
+        int halfcomplex_size = atfft_nd_halfcomplex_size (dims, n_dims);
+
+        if (direction == ATFFT_FORWARD)
+        {
+            plan->in_size = full_size;
+            plan->out_size = 2 * halfcomplex_size;
+        }
+        else
+        {
+            plan->in_size = 2 * halfcomplex_size;
+            plan->out_size = full_size;
+        }
+    }
+
+    plan->in = kfr_allocate (plan->in_size * sizeof (*(plan->in)));
+    plan->out = kfr_allocate (plan->out_size * sizeof (*(plan->out)));
+
+    if (!(plan->in && plan->out))
+        goto failed;
+#endif
+
+    return plan;
+
+failed:
+    atfft_dft_nd_destroy (plan);
+    return NULL;
+}
+
+void atfft_dft_nd_destroy (struct atfft_dft_nd *plan)
+{
+    if (plan)
+    {
+#ifdef ATFFT_TYPE_LONG_DOUBLE
+        kfr_deallocate (plan->out);
+        kfr_deallocate (plan->in);
+#endif
+
+        kfr_deallocate (plan->work_area);
+
+        if (plan->plan)
+        {
+            if (plan->format == ATFFT_COMPLEX)
+                ATFFT_KFR_DFT_DELETE_PLAN (plan->plan);
+            else
+                ATFFT_KFR_DFT_REAL_DELETE_PLAN (plan->plan);
+        }
+
+        free (plan);
+    }
+}
+
+static void apply_transform (struct atfft_dft_nd *plan, const atfft_sample *in, atfft_sample *out)
+{
+#ifdef ATFFT_TYPE_LONG_DOUBLE
+    atfft_sample_to_double_real (in, plan->in, plan->in_size);
+    plan->transform_function (plan->plan, plan->out, plan->in, plan->work_area);
+    atfft_double_to_sample_real (plan->out, out, plan->out_size);
+#else
+    plan->transform_function (plan->plan, out, in, plan->work_area);
+#endif
+}
+
+void atfft_dft_nd_complex_transform (struct atfft_dft_nd *plan, atfft_complex *in, atfft_complex *out)
+{
+    /* Only to be used with complex FFTs. */
+    assert (plan->format == ATFFT_COMPLEX);
+
+    apply_transform (plan, (atfft_sample*) in, (atfft_sample*) out);
+}
+
+void atfft_dft_nd_real_forward_transform (struct atfft_dft_nd *plan, const atfft_sample *in, atfft_complex *out)
+{
+    /* Only to be used for forward real FFTs. */
+    assert ((plan->format == ATFFT_REAL) && (plan->direction == ATFFT_FORWARD));
+
+    apply_transform (plan, in, (atfft_sample*) out);
+}
+
+void atfft_dft_nd_real_backward_transform (struct atfft_dft_nd *plan, atfft_complex *in, atfft_sample *out)
+{
+    /* Only to be used for backward real FFTs. */
+    assert ((plan->format == ATFFT_REAL) && (plan->direction == ATFFT_BACKWARD));
+
+    apply_transform (plan, (atfft_sample*) in, out);
+}
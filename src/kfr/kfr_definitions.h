@@ -40,6 +40,8 @@
 #   define ATFFT_KFR_DFT_EXECUTE kfr_dft_execute_f32
 #   define ATFFT_KFR_DFT_EXECUTE_INVERSE kfr_dft_execute_inverse_f32
 #   define ATFFT_KFR_DFT_REAL_CREATE_PLAN kfr_dft_real_create_plan_f32
+#   define ATFFT_KFR_DFT_CREATE_MD_PLAN kfr_dft_create_md_plan_f32
+#   define ATFFT_KFR_DFT_REAL_CREATE_MD_PLAN kfr_dft_real_create_md_plan_f32
 #   define ATFFT_KFR_DFT_REAL_GET_TEMP_SIZE kfr_dft_real_get_temp_size_f32
 #   define ATFFT_KFR_DFT_REAL_DELETE_PLAN kfr_dft_real_delete_plan_f32
 #   define ATFFT_KFR_DFT_REAL_EXECUTE kfr_dft_real_execute_f32
@@ -58,6 +60,8 @@
 #   define ATFFT_KFR_DFT_EXECUTE kfr_dft_execute_f64
 #   define ATFFT_KFR_DFT_EXECUTE_INVERSE kfr_dft_execute_inverse_f64
 #   define ATFFT_KFR_DFT_REAL_CREATE_PLAN kfr_dft_real_create_plan_f64
+#   define ATFFT_KFR_DFT_CREATE_MD_PLAN kfr_dft_create_md_plan_f64
+#   define ATFFT_KFR_DFT_REAL_CREATE_MD_PLAN kfr_dft_real_create_md_plan_f64
 #   define ATFFT_KFR_DFT_REAL_GET_TEMP_SIZE kfr_dft_real_get_temp_size_f64
 #   define ATFFT_KFR_DFT_REAL_DELETE_PLAN kfr_dft_real_delete_plan_f64
 #   define ATFFT_KFR_DFT_REAL_EXECUTE kfr_dft_real_execute_f64
@@ -20,6 +20,9 @@
  * SOFTWARE.
  */
 
+#define ATFFT_DFT_BACKEND mkl
+#include "../atfft/dft_backend_internal.h"
+
 #include <stdlib.h>
 #include <assert.h>
 #include <atfft/dft.h>
@@ -149,6 +152,20 @@ failed:
     return NULL;
 }
 
+struct atfft_dft* atfft_dft_create_pruned (int size,
+                                           enum atfft_direction direction,
+                                           enum atfft_format format,
+                                           int n_inputs,
+                                           int first_output,
+                                           int n_outputs)
+{
+    /* MKL has no pruned transforms, so fall back to a full one. */
+    if (!atfft_dft_is_valid_pruning (size, direction, format, n_inputs, first_output, n_outputs))
+        return NULL;
+
+    return atfft_dft_create (size, direction, format);
+}
+
 void atfft_dft_destroy (struct atfft_dft *plan)
 {
     if (plan)
@@ -212,3 +229,21 @@ void atfft_dft_real_backward_transform (struct atfft_dft *plan, atfft_complex *i
     DftiComputeBackward(plan->plan, (atfft_sample*) in, (atfft_sample*) out);
 #endif
 }
+
+#ifdef ATFFT_MULTI_BACKEND
+const struct atfft_dft_backend ATFFT_DFT_BACKEND_SYMBOL (backend) =
+{
+    .name = ATFFT_DFT_BACKEND_NAME,
+    .is_supported_size = atfft_dft_is_supported_size,
+    .create = atfft_dft_create,
+    .create_pruned = atfft_dft_create_pruned,
+    .destroy = atfft_dft_destroy,
+    .complex_transform = atfft_dft_complex_transform,
+    .complex_transform_stride = NULL,
+    .real_forward_transform = atfft_dft_real_forward_transform,
+    .real_forward_transform_stride = NULL,
+    .real_backward_transform = atfft_dft_real_backward_transform,
+    .real_backward_transform_stride = NULL,
+    .print_plan = NULL
+};
+#endif
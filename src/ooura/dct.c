@@ -25,17 +25,8 @@
 #include <assert.h>
 #include <math.h>
 #include <atfft/dct.h>
-#include "ooura.h"
-
-#ifdef ATFFT_TYPE_LONG_DOUBLE
-#   ifdef _MSC_VER
-#       pragma message(": warning: Ooura only supports double precision floating point, " \
-                       "higher precision values will be demoted to double for FFT calculations.")
-#   else
-#       warning Ooura only supports double precision floating point, \
-                higher precision values will be demoted to double for FFT calculations.
-#   endif
-#endif
+#include "ooura_definitions.h"
+#include "../atfft/dct_generic.h"
 
 struct atfft_dct
 {
@@ -45,11 +36,14 @@ struct atfft_dct
 
     /* buffer for in place transform */
     size_t n_data_bytes;
-    double *data;
+    atfft_ooura_sample *data;
 
     /* buffers for ooura state */
     int *work_area;
-    double *tables;
+    atfft_ooura_sample *tables;
+
+    /* the other transform types are built on the ooura DFT */
+    struct atfft_dct_generic *generic;
 };
 
 int atfft_dct_is_supported_size (int size)
@@ -58,6 +52,17 @@ int atfft_dct_is_supported_size (int size)
     return atfft_is_power_of_2 (size) && size >= min;
 }
 
+static int atfft_dct_is_ooura_type (int size, enum atfft_dct_type type)
+{
+    /* Only DCT-II and DCT-III plans are wrapped for ooura. */
+    return (type == ATFFT_DCT_II || type == ATFFT_DCT_III) && atfft_dct_is_supported_size (size);
+}
+
+int atfft_dct_is_supported_type (int size, enum atfft_dct_type type)
+{
+    return atfft_dct_is_ooura_type (size, type) || atfft_dct_generic_is_supported_type (size, type);
+}
+
 struct atfft_dct* atfft_dct_create (int size, enum atfft_direction direction)
 {
     /* ooura only supports sizes which are a power of 2. */
@@ -89,7 +94,7 @@ struct atfft_dct* atfft_dct_create (int size, enum atfft_direction direction)
 
     /* run a transform to initialise ooura state */
     plan->work_area [0] = 0;
-    ddct (plan->size, plan->ooura_direction, plan->data, plan->work_area, plan->tables);
+    ATFFT_OOURA_DDCT (plan->size, plan->ooura_direction, plan->data, plan->work_area, plan->tables);
 
     return plan;
 
@@ -98,10 +103,35 @@ failed:
     return NULL;
 }
 
+struct atfft_dct* atfft_dct_create_type (int size, enum atfft_dct_type type)
+{
+    assert (atfft_dct_is_supported_type (size, type));
+
+    if (atfft_dct_is_ooura_type (size, type))
+        return atfft_dct_create (size, type == ATFFT_DCT_II ? ATFFT_FORWARD : ATFFT_BACKWARD);
+
+    struct atfft_dct *plan;
+
+    if (!(plan = calloc (1, sizeof (*plan))))
+        return NULL;
+
+    plan->size = size;
+    plan->generic = atfft_dct_generic_create (size, type);
+
+    if (!plan->generic)
+    {
+        free (plan);
+        return NULL;
+    }
+
+    return plan;
+}
+
 void atfft_dct_destroy (struct atfft_dct *plan)
 {
     if (plan)
     {
+        atfft_dct_generic_destroy (plan->generic);
         free (plan->tables);
         free (plan->work_area);
         free (plan->data);
@@ -111,7 +141,13 @@ void atfft_dct_destroy (struct atfft_dct *plan)
 
 void atfft_dct_transform (struct atfft_dct *plan, const atfft_sample *in, atfft_sample *out)
 {
-#ifdef ATFFT_TYPE_DOUBLE
+    if (plan->generic)
+    {
+        atfft_dct_generic_transform (plan->generic, in, out);
+        return;
+    }
+
+#ifndef ATFFT_TYPE_LONG_DOUBLE
     memcpy (plan->data, in, plan->n_data_bytes);
 #else
     atfft_sample_to_double_real (in, plan->data, plan->size);
@@ -120,11 +156,18 @@ void atfft_dct_transform (struct atfft_dct *plan, const atfft_sample *in, atfft_
     if (plan->direction == ATFFT_BACKWARD)
         plan->data [0] *= 0.5;
 
-    ddct (plan->size, plan->ooura_direction, plan->data, plan->work_area, plan->tables);
+    ATFFT_OOURA_DDCT (plan->size, plan->ooura_direction, plan->data, plan->work_area, plan->tables);
 
-#ifdef ATFFT_TYPE_DOUBLE
+#ifndef ATFFT_TYPE_LONG_DOUBLE
     memcpy (out, plan->data, plan->n_data_bytes);
 #else
     atfft_double_to_sample_real (plan->data, out, plan->size);
 #endif
 }
+
+int atfft_dct_set_window (struct atfft_dct *plan, const atfft_sample *window)
+{
+    /* Only MDCTs have windows, and they use the generic implementation. */
+    assert (plan->generic);
+    return atfft_dct_generic_set_window (plan->generic, window);
+}
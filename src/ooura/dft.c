@@ -20,22 +20,16 @@
  * SOFTWARE.
  */
 
+#define ATFFT_DFT_BACKEND ooura
+#include "../atfft/dft_backend_internal.h"
+
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 #include <math.h>
 #include <atfft/dft.h>
-#include "ooura.h"
-
-#ifdef ATFFT_TYPE_LONG_DOUBLE
-#   ifdef _MSC_VER
-#       pragma message(": warning: Ooura only supports double precision floating point, " \
-                       "higher precision values will be demoted to double for FFT calculations.")
-#   else
-#       warning Ooura only supports double precision floating point, \
-                higher precision values will be demoted to double for FFT calculations.
-#   endif
-#endif
+#include <atfft/dft_util.h>
+#include "ooura_definitions.h"
 
 struct atfft_dft
 {
@@ -46,11 +40,11 @@ struct atfft_dft
 
     /* buffer for in place transform */
     size_t n_data_bytes;
-    double *data;
+    atfft_ooura_sample *data;
 
     /* buffers for ooura internals */
     int *work_area;
-    double *tables;
+    atfft_ooura_sample *tables;
 };
 
 int atfft_dft_is_supported_size (int size, enum atfft_format format)
@@ -107,9 +101,9 @@ struct atfft_dft* atfft_dft_create (int size, enum atfft_direction direction, en
     plan->work_area [0] = 0;
 
     if (format == ATFFT_COMPLEX)
-        cdft (2 * plan->size, plan->ooura_direction, plan->data, plan->work_area, plan->tables);
+        ATFFT_OOURA_CDFT (2 * plan->size, plan->ooura_direction, plan->data, plan->work_area, plan->tables);
     else
-        rdft (plan->size, plan->ooura_direction, plan->data, plan->work_area, plan->tables);
+        ATFFT_OOURA_RDFT (plan->size, plan->ooura_direction, plan->data, plan->work_area, plan->tables);
 
     return plan;
 
@@ -118,6 +112,20 @@ failed:
     return NULL;
 }
 
+struct atfft_dft* atfft_dft_create_pruned (int size,
+                                           enum atfft_direction direction,
+                                           enum atfft_format format,
+                                           int n_inputs,
+                                           int first_output,
+                                           int n_outputs)
+{
+    /* Ooura's FFT has no pruned transforms, so fall back to a full one. */
+    if (!atfft_dft_is_valid_pruning (size, direction, format, n_inputs, first_output, n_outputs))
+        return NULL;
+
+    return atfft_dft_create (size, direction, format);
+}
+
 void atfft_dft_destroy (struct atfft_dft *plan)
 {
     if (plan)
@@ -134,15 +142,15 @@ void atfft_dft_complex_transform (struct atfft_dft *plan, atfft_complex *in, atf
     /* Only to be used with complex FFTs. */
     assert (plan->format == ATFFT_COMPLEX);
 
-#ifdef ATFFT_TYPE_DOUBLE
+#ifndef ATFFT_TYPE_LONG_DOUBLE
     memcpy (plan->data, in, plan->n_data_bytes);
 #else
     atfft_sample_to_double_complex (in, (atfft_complex_d*) plan->data, plan->size);
 #endif
 
-    cdft (2 * plan->size, plan->ooura_direction, plan->data, plan->work_area, plan->tables);
+    ATFFT_OOURA_CDFT (2 * plan->size, plan->ooura_direction, plan->data, plan->work_area, plan->tables);
 
-#ifdef ATFFT_TYPE_DOUBLE
+#ifndef ATFFT_TYPE_LONG_DOUBLE
     memcpy (out, plan->data, plan->n_data_bytes);
 #else
     atfft_double_to_sample_complex ((atfft_complex_d*) plan->data, out, plan->size);
@@ -158,22 +166,22 @@ void atfft_dft_complex_transform_stride (struct atfft_dft *plan,
     /* Only to be used with complex FFTs. */
     assert (plan->format == ATFFT_COMPLEX);
 
-    atfft_sample_to_double_complex_stride (in,
-                                           in_stride,
-                                           (atfft_complex_d*) plan->data,
-                                           1,
-                                           plan->size);
+    ATFFT_OOURA_SAMPLE_TO_COMPLEX_STRIDE (in,
+                                          in_stride,
+                                          (atfft_ooura_complex*) plan->data,
+                                          1,
+                                          plan->size);
 
-    cdft (2 * plan->size, plan->ooura_direction, plan->data, plan->work_area, plan->tables);
+    ATFFT_OOURA_CDFT (2 * plan->size, plan->ooura_direction, plan->data, plan->work_area, plan->tables);
 
-    atfft_double_to_sample_complex_stride ((atfft_complex_d*) plan->data,
-                                           1,
-                                           out,
-                                           out_stride,
-                                           plan->size);
+    ATFFT_OOURA_COMPLEX_TO_SAMPLE_STRIDE ((atfft_ooura_complex*) plan->data,
+                                          1,
+                                          out,
+                                          out_stride,
+                                          plan->size);
 }
 
-static void halfcomplex_ooura_to_atfft (const double *in,
+static void halfcomplex_ooura_to_atfft (const atfft_ooura_sample *in,
                                         atfft_complex *out,
                                         int out_stride,
                                         int size)
@@ -200,13 +208,13 @@ void atfft_dft_real_forward_transform (struct atfft_dft *plan, const atfft_sampl
     /* Only to be used for forward real FFTs. */
     assert ((plan->format == ATFFT_REAL) && (plan->direction == ATFFT_FORWARD));
 
-#ifdef ATFFT_TYPE_DOUBLE
+#ifndef ATFFT_TYPE_LONG_DOUBLE
     memcpy (plan->data, in, plan->n_data_bytes);
 #else
     atfft_sample_to_double_real (in, plan->data, plan->size);
 #endif
 
-    rdft (plan->size, plan->ooura_direction, plan->data, plan->work_area, plan->tables);
+    ATFFT_OOURA_RDFT (plan->size, plan->ooura_direction, plan->data, plan->work_area, plan->tables);
     halfcomplex_ooura_to_atfft (plan->data, out, 1, plan->size);
 }
 
@@ -219,19 +227,19 @@ void atfft_dft_real_forward_transform_stride (struct atfft_dft *plan,
     /* Only to be used for forward real FFTs. */
     assert ((plan->format == ATFFT_REAL) && (plan->direction == ATFFT_FORWARD));
 
-    atfft_sample_to_double_real_stride (in,
-                                        in_stride,
-                                        plan->data,
-                                        1,
-                                        plan->size);
+    ATFFT_OOURA_SAMPLE_TO_REAL_STRIDE (in,
+                                       in_stride,
+                                       plan->data,
+                                       1,
+                                       plan->size);
 
-    rdft (plan->size, plan->ooura_direction, plan->data, plan->work_area, plan->tables);
+    ATFFT_OOURA_RDFT (plan->size, plan->ooura_direction, plan->data, plan->work_area, plan->tables);
     halfcomplex_ooura_to_atfft (plan->data, out, out_stride, plan->size);
 }
 
 static void halfcomplex_atfft_to_ooura (atfft_complex *in,
                                         int in_stride,
-                                        double *out,
+                                        atfft_ooura_sample *out,
                                         int size)
 {
     int half_size = size / 2;
@@ -255,9 +263,9 @@ void atfft_dft_real_backward_transform (struct atfft_dft *plan, atfft_complex *i
     assert ((plan->format == ATFFT_REAL) && (plan->direction == ATFFT_BACKWARD));
 
     halfcomplex_atfft_to_ooura (in, 1, plan->data, plan->size);
-    rdft (plan->size, plan->ooura_direction, plan->data, plan->work_area, plan->tables);
+    ATFFT_OOURA_RDFT (plan->size, plan->ooura_direction, plan->data, plan->work_area, plan->tables);
 
-#ifdef ATFFT_TYPE_DOUBLE
+#ifndef ATFFT_TYPE_LONG_DOUBLE
     memcpy (out, plan->data, plan->n_data_bytes);
 #else
     atfft_double_to_sample_real (plan->data, out, plan->size);
@@ -274,10 +282,28 @@ void atfft_dft_real_backward_transform_stride (struct atfft_dft *plan,
     assert ((plan->format == ATFFT_REAL) && (plan->direction == ATFFT_BACKWARD));
 
     halfcomplex_atfft_to_ooura (in, in_stride, plan->data, plan->size);
-    rdft (plan->size, plan->ooura_direction, plan->data, plan->work_area, plan->tables);
-    atfft_double_to_sample_real_stride (plan->data,
-                                        1,
-                                        out,
-                                        out_stride,
-                                        plan->size);
+    ATFFT_OOURA_RDFT (plan->size, plan->ooura_direction, plan->data, plan->work_area, plan->tables);
+    ATFFT_OOURA_REAL_TO_SAMPLE_STRIDE (plan->data,
+                                       1,
+                                       out,
+                                       out_stride,
+                                       plan->size);
 }
+
+#ifdef ATFFT_MULTI_BACKEND
+const struct atfft_dft_backend ATFFT_DFT_BACKEND_SYMBOL (backend) =
+{
+    .name = ATFFT_DFT_BACKEND_NAME,
+    .is_supported_size = atfft_dft_is_supported_size,
+    .create = atfft_dft_create,
+    .create_pruned = atfft_dft_create_pruned,
+    .destroy = atfft_dft_destroy,
+    .complex_transform = atfft_dft_complex_transform,
+    .complex_transform_stride = atfft_dft_complex_transform_stride,
+    .real_forward_transform = atfft_dft_real_forward_transform,
+    .real_forward_transform_stride = atfft_dft_real_forward_transform_stride,
+    .real_backward_transform = atfft_dft_real_backward_transform,
+    .real_backward_transform_stride = atfft_dft_real_backward_transform_stride,
+    .print_plan = NULL
+};
+#endif
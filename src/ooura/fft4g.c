@@ -274,14 +274,24 @@ Appendix :
     w[] and ip[] are compatible with all routines.
 */
 
+/*
+atfft: the sample type can be overridden with OOURA_REAL,
+fft4g_float.c uses this to build a single precision copy.
+The cos/sin tables are always calculated in double precision.
+*/
+#ifndef OOURA_REAL
+#define OOURA_REAL double
+#endif
+
+
 
-void cdft(int n, int isgn, double *a, int *ip, double *w)
+void cdft(int n, int isgn, OOURA_REAL *a, int *ip, OOURA_REAL *w)
 {
-    void makewt(int nw, int *ip, double *w);
-    void bitrv2(int n, int *ip, double *a);
-    void bitrv2conj(int n, int *ip, double *a);
-    void cftfsub(int n, double *a, double *w);
-    void cftbsub(int n, double *a, double *w);
+    void makewt(int nw, int *ip, OOURA_REAL *w);
+    void bitrv2(int n, int *ip, OOURA_REAL *a);
+    void bitrv2conj(int n, int *ip, OOURA_REAL *a);
+    void cftfsub(int n, OOURA_REAL *a, OOURA_REAL *w);
+    void cftbsub(int n, OOURA_REAL *a, OOURA_REAL *w);
     
     if (n > (ip[0] << 2)) {
         makewt(n >> 2, ip, w);
@@ -300,17 +310,17 @@ void cdft(int n, int isgn, double *a, int *ip, double *w)
 }
 
 
-void rdft(int n, int isgn, double *a, int *ip, double *w)
+void rdft(int n, int isgn, OOURA_REAL *a, int *ip, OOURA_REAL *w)
 {
-    void makewt(int nw, int *ip, double *w);
-    void makect(int nc, int *ip, double *c);
-    void bitrv2(int n, int *ip, double *a);
-    void cftfsub(int n, double *a, double *w);
-    void cftbsub(int n, double *a, double *w);
-    void rftfsub(int n, double *a, int nc, double *c);
-    void rftbsub(int n, double *a, int nc, double *c);
+    void makewt(int nw, int *ip, OOURA_REAL *w);
+    void makect(int nc, int *ip, OOURA_REAL *c);
+    void bitrv2(int n, int *ip, OOURA_REAL *a);
+    void cftfsub(int n, OOURA_REAL *a, OOURA_REAL *w);
+    void cftbsub(int n, OOURA_REAL *a, OOURA_REAL *w);
+    void rftfsub(int n, OOURA_REAL *a, int nc, OOURA_REAL *c);
+    void rftbsub(int n, OOURA_REAL *a, int nc, OOURA_REAL *c);
     int nw, nc;
-    double xi;
+    OOURA_REAL xi;
     
     nw = ip[0];
     if (n > (nw << 2)) {
@@ -347,18 +357,18 @@ void rdft(int n, int isgn, double *a, int *ip, double *w)
 }
 
 
-void ddct(int n, int isgn, double *a, int *ip, double *w)
+void ddct(int n, int isgn, OOURA_REAL *a, int *ip, OOURA_REAL *w)
 {
-    void makewt(int nw, int *ip, double *w);
-    void makect(int nc, int *ip, double *c);
-    void bitrv2(int n, int *ip, double *a);
-    void cftfsub(int n, double *a, double *w);
-    void cftbsub(int n, double *a, double *w);
-    void rftfsub(int n, double *a, int nc, double *c);
-    void rftbsub(int n, double *a, int nc, double *c);
-    void dctsub(int n, double *a, int nc, double *c);
+    void makewt(int nw, int *ip, OOURA_REAL *w);
+    void makect(int nc, int *ip, OOURA_REAL *c);
+    void bitrv2(int n, int *ip, OOURA_REAL *a);
+    void cftfsub(int n, OOURA_REAL *a, OOURA_REAL *w);
+    void cftbsub(int n, OOURA_REAL *a, OOURA_REAL *w);
+    void rftfsub(int n, OOURA_REAL *a, int nc, OOURA_REAL *c);
+    void rftbsub(int n, OOURA_REAL *a, int nc, OOURA_REAL *c);
+    void dctsub(int n, OOURA_REAL *a, int nc, OOURA_REAL *c);
     int j, nw, nc;
-    double xr;
+    OOURA_REAL xr;
     
     nw = ip[0];
     if (n > (nw << 2)) {
@@ -406,18 +416,18 @@ void ddct(int n, int isgn, double *a, int *ip, double *w)
 }
 
 
-void ddst(int n, int isgn, double *a, int *ip, double *w)
+void ddst(int n, int isgn, OOURA_REAL *a, int *ip, OOURA_REAL *w)
 {
-    void makewt(int nw, int *ip, double *w);
-    void makect(int nc, int *ip, double *c);
-    void bitrv2(int n, int *ip, double *a);
-    void cftfsub(int n, double *a, double *w);
-    void cftbsub(int n, double *a, double *w);
-    void rftfsub(int n, double *a, int nc, double *c);
-    void rftbsub(int n, double *a, int nc, double *c);
-    void dstsub(int n, double *a, int nc, double *c);
+    void makewt(int nw, int *ip, OOURA_REAL *w);
+    void makect(int nc, int *ip, OOURA_REAL *c);
+    void bitrv2(int n, int *ip, OOURA_REAL *a);
+    void cftfsub(int n, OOURA_REAL *a, OOURA_REAL *w);
+    void cftbsub(int n, OOURA_REAL *a, OOURA_REAL *w);
+    void rftfsub(int n, OOURA_REAL *a, int nc, OOURA_REAL *c);
+    void rftbsub(int n, OOURA_REAL *a, int nc, OOURA_REAL *c);
+    void dstsub(int n, OOURA_REAL *a, int nc, OOURA_REAL *c);
     int j, nw, nc;
-    double xr;
+    OOURA_REAL xr;
     
     nw = ip[0];
     if (n > (nw << 2)) {
@@ -465,16 +475,16 @@ void ddst(int n, int isgn, double *a, int *ip, double *w)
 }
 
 
-void dfct(int n, double *a, double *t, int *ip, double *w)
+void dfct(int n, OOURA_REAL *a, OOURA_REAL *t, int *ip, OOURA_REAL *w)
 {
-    void makewt(int nw, int *ip, double *w);
-    void makect(int nc, int *ip, double *c);
-    void bitrv2(int n, int *ip, double *a);
-    void cftfsub(int n, double *a, double *w);
-    void rftfsub(int n, double *a, int nc, double *c);
-    void dctsub(int n, double *a, int nc, double *c);
+    void makewt(int nw, int *ip, OOURA_REAL *w);
+    void makect(int nc, int *ip, OOURA_REAL *c);
+    void bitrv2(int n, int *ip, OOURA_REAL *a);
+    void cftfsub(int n, OOURA_REAL *a, OOURA_REAL *w);
+    void rftfsub(int n, OOURA_REAL *a, int nc, OOURA_REAL *c);
+    void dctsub(int n, OOURA_REAL *a, int nc, OOURA_REAL *c);
     int j, k, l, m, mh, nw, nc;
-    double xr, xi, yr, yi;
+    OOURA_REAL xr, xi, yr, yi;
     
     nw = ip[0];
     if (n > (nw << 3)) {
@@ -561,16 +571,16 @@ void dfct(int n, double *a, double *t, int *ip, double *w)
 }
 
 
-void dfst(int n, double *a, double *t, int *ip, double *w)
+void dfst(int n, OOURA_REAL *a, OOURA_REAL *t, int *ip, OOURA_REAL *w)
 {
-    void makewt(int nw, int *ip, double *w);
-    void makect(int nc, int *ip, double *c);
-    void bitrv2(int n, int *ip, double *a);
-    void cftfsub(int n, double *a, double *w);
-    void rftfsub(int n, double *a, int nc, double *c);
-    void dstsub(int n, double *a, int nc, double *c);
+    void makewt(int nw, int *ip, OOURA_REAL *w);
+    void makect(int nc, int *ip, OOURA_REAL *c);
+    void bitrv2(int n, int *ip, OOURA_REAL *a);
+    void cftfsub(int n, OOURA_REAL *a, OOURA_REAL *w);
+    void rftfsub(int n, OOURA_REAL *a, int nc, OOURA_REAL *c);
+    void dstsub(int n, OOURA_REAL *a, int nc, OOURA_REAL *c);
     int j, k, l, m, mh, nw, nc;
-    double xr, xi, yr, yi;
+    OOURA_REAL xr, xi, yr, yi;
     
     nw = ip[0];
     if (n > (nw << 3)) {
@@ -653,9 +663,9 @@ void dfst(int n, double *a, double *t, int *ip, double *w)
 
 #include <math.h>
 
-void makewt(int nw, int *ip, double *w)
+void makewt(int nw, int *ip, OOURA_REAL *w)
 {
-    void bitrv2(int n, int *ip, double *a);
+    void bitrv2(int n, int *ip, OOURA_REAL *a);
     int j, nwh;
     double delta, x, y;
     
@@ -683,7 +693,7 @@ void makewt(int nw, int *ip, double *w)
 }
 
 
-void makect(int nc, int *ip, double *c)
+void makect(int nc, int *ip, OOURA_REAL *c)
 {
     int j, nch;
     double delta;
@@ -705,10 +715,10 @@ void makect(int nc, int *ip, double *c)
 /* -------- child routines -------- */
 
 
-void bitrv2(int n, int *ip, double *a)
+void bitrv2(int n, int *ip, OOURA_REAL *a)
 {
     int j, j1, k, k1, l, m, m2;
-    double xr, xi, yr, yi;
+    OOURA_REAL xr, xi, yr, yi;
     
     ip[0] = 0;
     l = n;
@@ -805,10 +815,10 @@ void bitrv2(int n, int *ip, double *a)
 }
 
 
-void bitrv2conj(int n, int *ip, double *a)
+void bitrv2conj(int n, int *ip, OOURA_REAL *a)
 {
     int j, j1, k, k1, l, m, m2;
-    double xr, xi, yr, yi;
+    OOURA_REAL xr, xi, yr, yi;
     
     ip[0] = 0;
     l = n;
@@ -914,12 +924,12 @@ void bitrv2conj(int n, int *ip, double *a)
 }
 
 
-void cftfsub(int n, double *a, double *w)
+void cftfsub(int n, OOURA_REAL *a, OOURA_REAL *w)
 {
-    void cft1st(int n, double *a, double *w);
-    void cftmdl(int n, int l, double *a, double *w);
+    void cft1st(int n, OOURA_REAL *a, OOURA_REAL *w);
+    void cftmdl(int n, int l, OOURA_REAL *a, OOURA_REAL *w);
     int j, j1, j2, j3, l;
-    double x0r, x0i, x1r, x1i, x2r, x2i, x3r, x3i;
+    OOURA_REAL x0r, x0i, x1r, x1i, x2r, x2i, x3r, x3i;
     
     l = 2;
     if (n > 8) {
@@ -966,12 +976,12 @@ void cftfsub(int n, double *a, double *w)
 }
 
 
-void cftbsub(int n, double *a, double *w)
+void cftbsub(int n, OOURA_REAL *a, OOURA_REAL *w)
 {
-    void cft1st(int n, double *a, double *w);
-    void cftmdl(int n, int l, double *a, double *w);
+    void cft1st(int n, OOURA_REAL *a, OOURA_REAL *w);
+    void cftmdl(int n, int l, OOURA_REAL *a, OOURA_REAL *w);
     int j, j1, j2, j3, l;
-    double x0r, x0i, x1r, x1i, x2r, x2i, x3r, x3i;
+    OOURA_REAL x0r, x0i, x1r, x1i, x2r, x2i, x3r, x3i;
     
     l = 2;
     if (n > 8) {
@@ -1018,11 +1028,11 @@ void cftbsub(int n, double *a, double *w)
 }
 
 
-void cft1st(int n, double *a, double *w)
+void cft1st(int n, OOURA_REAL *a, OOURA_REAL *w)
 {
     int j, k1, k2;
-    double wk1r, wk1i, wk2r, wk2i, wk3r, wk3i;
-    double x0r, x0i, x1r, x1i, x2r, x2i, x3r, x3i;
+    OOURA_REAL wk1r, wk1i, wk2r, wk2i, wk3r, wk3i;
+    OOURA_REAL x0r, x0i, x1r, x1i, x2r, x2i, x3r, x3i;
     
     x0r = a[0] + a[2];
     x0i = a[1] + a[3];
@@ -1123,11 +1133,11 @@ void cft1st(int n, double *a, double *w)
 }
 
 
-void cftmdl(int n, int l, double *a, double *w)
+void cftmdl(int n, int l, OOURA_REAL *a, OOURA_REAL *w)
 {
     int j, j1, j2, j3, k, k1, k2, m, m2;
-    double wk1r, wk1i, wk2r, wk2i, wk3r, wk3i;
-    double x0r, x0i, x1r, x1i, x2r, x2i, x3r, x3i;
+    OOURA_REAL wk1r, wk1i, wk2r, wk2i, wk3r, wk3i;
+    OOURA_REAL x0r, x0i, x1r, x1i, x2r, x2i, x3r, x3i;
     
     m = l << 2;
     for (j = 0; j < l; j += 2) {
@@ -1250,10 +1260,10 @@ void cftmdl(int n, int l, double *a, double *w)
 }
 
 
-void rftfsub(int n, double *a, int nc, double *c)
+void rftfsub(int n, OOURA_REAL *a, int nc, OOURA_REAL *c)
 {
     int j, k, kk, ks, m;
-    double wkr, wki, xr, xi, yr, yi;
+    OOURA_REAL wkr, wki, xr, xi, yr, yi;
     
     m = n >> 1;
     ks = 2 * nc / m;
@@ -1275,10 +1285,10 @@ void rftfsub(int n, double *a, int nc, double *c)
 }
 
 
-void rftbsub(int n, double *a, int nc, double *c)
+void rftbsub(int n, OOURA_REAL *a, int nc, OOURA_REAL *c)
 {
     int j, k, kk, ks, m;
-    double wkr, wki, xr, xi, yr, yi;
+    OOURA_REAL wkr, wki, xr, xi, yr, yi;
     
     a[1] = -a[1];
     m = n >> 1;
@@ -1302,10 +1312,10 @@ void rftbsub(int n, double *a, int nc, double *c)
 }
 
 
-void dctsub(int n, double *a, int nc, double *c)
+void dctsub(int n, OOURA_REAL *a, int nc, OOURA_REAL *c)
 {
     int j, k, kk, ks, m;
-    double wkr, wki, xr;
+    OOURA_REAL wkr, wki, xr;
     
     m = n >> 1;
     ks = nc / n;
@@ -1323,10 +1333,10 @@ void dctsub(int n, double *a, int nc, double *c)
 }
 
 
-void dstsub(int n, double *a, int nc, double *c)
+void dstsub(int n, OOURA_REAL *a, int nc, OOURA_REAL *c)
 {
     int j, k, kk, ks, m;
-    double wkr, wki, xr;
+    OOURA_REAL wkr, wki, xr;
     
     m = n >> 1;
     ks = nc / n;
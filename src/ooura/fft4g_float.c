@@ -0,0 +1,27 @@
+/*
+Single precision build of fft4g.c.
+Every function gets an _f suffix so both builds can be linked together.
+*/
+
+#define OOURA_REAL float
+
+#define cdft cdft_f
+#define rdft rdft_f
+#define ddct ddct_f
+#define ddst ddst_f
+#define dfct dfct_f
+#define dfst dfst_f
+#define makewt makewt_f
+#define makect makect_f
+#define bitrv2 bitrv2_f
+#define bitrv2conj bitrv2conj_f
+#define cftfsub cftfsub_f
+#define cftbsub cftbsub_f
+#define cft1st cft1st_f
+#define cftmdl cftmdl_f
+#define rftfsub rftfsub_f
+#define rftbsub rftbsub_f
+#define dctsub dctsub_f
+#define dstsub dstsub_f
+
+#include "fft4g.c"
@@ -8,4 +8,12 @@ void ddst(int, int, double *, int *, double *);
 void dfct(int, double *, double *, int *, double *);
 void dfst(int, double *, double *, int *, double *);
 
+/* single precision versions from fft4g_float.c */
+void cdft_f(int, int, float *, int *, float *);
+void rdft_f(int, int, float *, int *, float *);
+void ddct_f(int, int, float *, int *, float *);
+void ddst_f(int, int, float *, int *, float *);
+void dfct_f(int, float *, float *, int *, float *);
+void dfst_f(int, float *, float *, int *, float *);
+
 #endif /* OOURA_H_INCLUDED */
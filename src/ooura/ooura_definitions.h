@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ATFFT_OOURA_DEFINITIONS_H_INCLUDED
+#define ATFFT_OOURA_DEFINITIONS_H_INCLUDED
+
+#include "ooura.h"
+
+#ifdef ATFFT_TYPE_LONG_DOUBLE
+#   ifdef _MSC_VER
+#       pragma message(": warning: Ooura only supports single and double precision floating point, " \
+                       "higher precision values will be demoted to double for FFT calculations.")
+#   else
+#       warning Ooura only supports single and double precision floating point, \
+                higher precision values will be demoted to double for FFT calculations.
+#   endif
+#endif
+
+/* Single precision builds use the float copy of fft4g.c from fft4g_float.c,
+ * so only long double samples need converting. */
+#if defined(ATFFT_TYPE_FLOAT)
+#   define ATFFT_OOURA_CDFT cdft_f
+#   define ATFFT_OOURA_RDFT rdft_f
+#   define ATFFT_OOURA_DDCT ddct_f
+#   define ATFFT_OOURA_SAMPLE_TO_REAL_STRIDE atfft_sample_to_float_real_stride
+#   define ATFFT_OOURA_REAL_TO_SAMPLE_STRIDE atfft_float_to_sample_real_stride
+#   define ATFFT_OOURA_SAMPLE_TO_COMPLEX_STRIDE atfft_sample_to_float_complex_stride
+#   define ATFFT_OOURA_COMPLEX_TO_SAMPLE_STRIDE atfft_float_to_sample_complex_stride
+    typedef float atfft_ooura_sample;
+    typedef atfft_complex_f atfft_ooura_complex;
+
+#else
+#   define ATFFT_OOURA_CDFT cdft
+#   define ATFFT_OOURA_RDFT rdft
+#   define ATFFT_OOURA_DDCT ddct
+#   define ATFFT_OOURA_SAMPLE_TO_REAL_STRIDE atfft_sample_to_double_real_stride
+#   define ATFFT_OOURA_REAL_TO_SAMPLE_STRIDE atfft_double_to_sample_real_stride
+#   define ATFFT_OOURA_SAMPLE_TO_COMPLEX_STRIDE atfft_sample_to_double_complex_stride
+#   define ATFFT_OOURA_COMPLEX_TO_SAMPLE_STRIDE atfft_double_to_sample_complex_stride
+    typedef double atfft_ooura_sample;
+    typedef atfft_complex_d atfft_ooura_complex;
+#endif
+
+#endif /* ATFFT_OOURA_DEFINITIONS_H_INCLUDED */
@@ -20,10 +20,15 @@
  * SOFTWARE.
  */
 
+#define ATFFT_DFT_BACKEND pffft
+#include "../atfft/dft_backend_internal.h"
+
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <assert.h>
 #include <atfft/dft.h>
+#include <atfft/dft_util.h>
 #include "pffft.h"
 
 #ifndef ATFFT_TYPE_FLOAT
@@ -133,6 +138,20 @@ struct atfft_dft* atfft_dft_create (int size, enum atfft_direction direction, en
     return plan;
 }
 
+struct atfft_dft* atfft_dft_create_pruned (int size,
+                                           enum atfft_direction direction,
+                                           enum atfft_format format,
+                                           int n_inputs,
+                                           int first_output,
+                                           int n_outputs)
+{
+    /* PFFFT has no pruned transforms, so fall back to a full one. */
+    if (!atfft_dft_is_valid_pruning (size, direction, format, n_inputs, first_output, n_outputs))
+        return NULL;
+
+    return atfft_dft_create (size, direction, format);
+}
+
 void atfft_dft_destroy (struct atfft_dft *plan)
 {
     if (plan)
@@ -145,12 +164,31 @@ void atfft_dft_destroy (struct atfft_dft *plan)
     }
 }
 
+#ifdef ATFFT_TYPE_FLOAT
+/* pffft can work directly on the caller's arrays if they are aligned
+ * to its SIMD vectors. */
+static int is_aligned (const void *array)
+{
+    return (uintptr_t) array % (pffft_simd_size() * sizeof (float)) == 0;
+}
+#endif
+
 void atfft_dft_complex_transform (struct atfft_dft *plan, atfft_complex *in, atfft_complex *out)
 {
     /* Only to be used with complex FFTs. */
     assert (plan->format == ATFFT_COMPLEX);
 
 #ifdef ATFFT_TYPE_FLOAT
+    if (is_aligned (in) && is_aligned (out))
+    {
+        pffft_transform_ordered (plan->plan,
+                                 (float*) in,
+                                 (float*) out,
+                                 plan->work_area,
+                                 plan->pffft_direction);
+        return;
+    }
+
     memcpy (plan->in, in, plan->n_in_out_bytes);
 #else
     atfft_sample_to_float_complex (in, (atfft_complex_f*) plan->in, plan->size);
@@ -174,6 +212,12 @@ void atfft_dft_complex_transform_stride (struct atfft_dft *plan,
     /* Only to be used with complex FFTs. */
     assert (plan->format == ATFFT_COMPLEX);
 
+    if (in_stride == 1 && out_stride == 1)
+    {
+        atfft_dft_complex_transform (plan, in, out);
+        return;
+    }
+
     atfft_sample_to_float_complex_stride (in,
                                           in_stride,
                                           (atfft_complex_f*) plan->in,
@@ -216,13 +260,20 @@ void atfft_dft_real_forward_transform (struct atfft_dft *plan, const atfft_sampl
     /* Only to be used for forward real FFTs. */
     assert ((plan->format == ATFFT_REAL) && (plan->direction == ATFFT_FORWARD));
 
+    const float *pffft_in = plan->in;
+
+    /* The output is always rearranged into halfcomplex format,
+     * but the input can be used directly. */
 #ifdef ATFFT_TYPE_FLOAT
-    memcpy (plan->in, in, plan->n_in_out_bytes);
+    if (is_aligned (in))
+        pffft_in = in;
+    else
+        memcpy (plan->in, in, plan->n_in_out_bytes);
 #else
     atfft_sample_to_float_real (in, plan->in, plan->size);
 #endif
 
-    pffft_transform_ordered (plan->plan, plan->in, plan->out, plan->work_area, plan->pffft_direction);
+    pffft_transform_ordered (plan->plan, pffft_in, plan->out, plan->work_area, plan->pffft_direction);
     halfcomplex_pffft_to_atfft (plan->out, out, 1, plan->size);
 }
 
@@ -235,6 +286,12 @@ void atfft_dft_real_forward_transform_stride (struct atfft_dft *plan,
     /* Only to be used for forward real FFTs. */
     assert ((plan->format == ATFFT_REAL) && (plan->direction == ATFFT_FORWARD));
 
+    if (in_stride == 1 && out_stride == 1)
+    {
+        atfft_dft_real_forward_transform (plan, in, out);
+        return;
+    }
+
     atfft_sample_to_float_real_stride (in,
                                        in_stride,
                                        plan->in,
@@ -270,7 +327,18 @@ void atfft_dft_real_backward_transform (struct atfft_dft *plan, atfft_complex *i
     /* Only to be used for backward real FFTs. */
     assert ((plan->format == ATFFT_REAL) && (plan->direction == ATFFT_BACKWARD));
 
+    /* The input is always rearranged from halfcomplex format,
+     * but the output can be written directly. */
     halfcomplex_atfft_to_pffft (in, 1, plan->in, plan->size);
+
+#ifdef ATFFT_TYPE_FLOAT
+    if (is_aligned (out))
+    {
+        pffft_transform_ordered (plan->plan, plan->in, out, plan->work_area, plan->pffft_direction);
+        return;
+    }
+#endif
+
     pffft_transform_ordered (plan->plan, plan->in, plan->out, plan->work_area, plan->pffft_direction);
 
 #ifdef ATFFT_TYPE_FLOAT
@@ -289,6 +357,12 @@ void atfft_dft_real_backward_transform_stride (struct atfft_dft *plan,
     /* Only to be used for backward real FFTs. */
     assert ((plan->format == ATFFT_REAL) && (plan->direction == ATFFT_BACKWARD));
 
+    if (in_stride == 1 && out_stride == 1)
+    {
+        atfft_dft_real_backward_transform (plan, in, out);
+        return;
+    }
+
     halfcomplex_atfft_to_pffft (in, in_stride, plan->in, plan->size);
     pffft_transform_ordered (plan->plan, plan->in, plan->out, plan->work_area, plan->pffft_direction);
     atfft_float_to_sample_real_stride (plan->out,
@@ -297,3 +371,21 @@ void atfft_dft_real_backward_transform_stride (struct atfft_dft *plan,
                                        out_stride,
                                        plan->size);
 }
+
+#ifdef ATFFT_MULTI_BACKEND
+const struct atfft_dft_backend ATFFT_DFT_BACKEND_SYMBOL (backend) =
+{
+    .name = ATFFT_DFT_BACKEND_NAME,
+    .is_supported_size = atfft_dft_is_supported_size,
+    .create = atfft_dft_create,
+    .create_pruned = atfft_dft_create_pruned,
+    .destroy = atfft_dft_destroy,
+    .complex_transform = atfft_dft_complex_transform,
+    .complex_transform_stride = atfft_dft_complex_transform_stride,
+    .real_forward_transform = atfft_dft_real_forward_transform,
+    .real_forward_transform_stride = atfft_dft_real_forward_transform_stride,
+    .real_backward_transform = atfft_dft_real_backward_transform,
+    .real_backward_transform_stride = atfft_dft_real_backward_transform_stride,
+    .print_plan = NULL
+};
+#endif
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2021 Sean Enderby <sean.enderby@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <atfft/dft.h>
+#include <atfft/dft_util.h>
+#include <atfft/dft_unordered.h>
+#include "pffft.h"
+
+/* Spectra are left in pffft's internal order, which saves the reordering
+ * pass pffft_transform_ordered() makes in each direction. */
+struct atfft_dft_unordered
+{
+    int size;
+    enum atfft_format format;
+
+    /* the pffft plan */
+    PFFFT_Setup *plan;
+
+    /* the number of floats in signals and spectra */
+    int n_values;
+
+    /* aligned input, output and work buffers for pffft */
+    float *in, *out, *work_area;
+};
+
+int atfft_dft_unordered_is_supported_size (int size, enum atfft_format format)
+{
+    return atfft_dft_is_supported_size (size, format);
+}
+
+struct atfft_dft_unordered* atfft_dft_unordered_create (int size, enum atfft_format format)
+{
+    assert (atfft_dft_unordered_is_supported_size (size, format));
+
+    struct atfft_dft_unordered *dft;
+
+    if (!(dft = calloc (1, sizeof (*dft))))
+        return NULL;
+
+    dft->size = size;
+    dft->format = format;
+    dft->n_values = format == ATFFT_COMPLEX ? 2 * size : size;
+
+    dft->plan = pffft_new_setup (size, format == ATFFT_COMPLEX ? PFFFT_COMPLEX : PFFFT_REAL);
+    dft->in = pffft_aligned_malloc (dft->n_values * sizeof (*(dft->in)));
+    dft->out = pffft_aligned_malloc (dft->n_values * sizeof (*(dft->out)));
+    dft->work_area = pffft_aligned_malloc (dft->n_values * sizeof (*(dft->work_area)));
+
+    if (!(dft->plan && dft->in && dft->out && dft->work_area))
+        goto failed;
+
+    return dft;
+
+failed:
+    atfft_dft_unordered_destroy (dft);
+    return NULL;
+}
+
+void atfft_dft_unordered_destroy (struct atfft_dft_unordered *dft)
+{
+    if (dft)
+    {
+        if (dft->plan)
+            pffft_destroy_setup (dft->plan);
+
+        pffft_aligned_free (dft->work_area);
+        pffft_aligned_free (dft->out);
+        pffft_aligned_free (dft->in);
+        free (dft);
+    }
+}
+
+int atfft_dft_unordered_spectrum_size (struct atfft_dft_unordered *dft)
+{
+    return dft->n_values;
+}
+
+#ifdef ATFFT_TYPE_FLOAT
+static int is_aligned (const void *array)
+{
+    return (uintptr_t) array % (pffft_simd_size() * sizeof (float)) == 0;
+}
+#endif
+
+static void apply_transform (struct atfft_dft_unordered *dft,
+                             const atfft_sample *in,
+                             atfft_sample *out,
+                             pffft_direction_t direction)
+{
+#ifdef ATFFT_TYPE_FLOAT
+    if (is_aligned (in) && is_aligned (out))
+    {
+        pffft_transform (dft->plan, in, out, dft->work_area, direction);
+        return;
+    }
+
+    memcpy (dft->in, in, dft->n_values * sizeof (*in));
+    pffft_transform (dft->plan, dft->in, dft->out, dft->work_area, direction);
+    memcpy (out, dft->out, dft->n_values * sizeof (*out));
+#else
+    atfft_sample_to_float_real (in, dft->in, dft->n_values);
+    pffft_transform (dft->plan, dft->in, dft->out, dft->work_area, direction);
+    atfft_float_to_sample_real (dft->out, out, dft->n_values);
+#endif
+}
+
+void atfft_dft_unordered_complex_forward (struct atfft_dft_unordered *dft, atfft_complex *in, atfft_sample *spectrum)
+{
+    assert (dft->format == ATFFT_COMPLEX);
+    apply_transform (dft, (atfft_sample*) in, spectrum, PFFFT_FORWARD);
+}
+
+void atfft_dft_unordered_complex_backward (struct atfft_dft_unordered *dft, atfft_sample *spectrum, atfft_complex *out)
+{
+    assert (dft->format == ATFFT_COMPLEX);
+    apply_transform (dft, spectrum, (atfft_sample*) out, PFFFT_BACKWARD);
+}
+
+void atfft_dft_unordered_real_forward (struct atfft_dft_unordered *dft, const atfft_sample *in, atfft_sample *spectrum)
+{
+    assert (dft->format == ATFFT_REAL);
+    apply_transform (dft, in, spectrum, PFFFT_FORWARD);
+}
+
+void atfft_dft_unordered_real_backward (struct atfft_dft_unordered *dft, atfft_sample *spectrum, atfft_sample *out)
+{
+    assert (dft->format == ATFFT_REAL);
+    apply_transform (dft, spectrum, out, PFFFT_BACKWARD);
+}
+
+static void multiply_accumulate (const atfft_sample *a,
+                                 const atfft_sample *b,
+                                 atfft_sample scale,
+                                 atfft_sample *ab,
+                                 int re,
+                                 int im)
+{
+    atfft_sample product_re = a [re] * b [re] - a [im] * b [im];
+    atfft_sample product_im = a [re] * b [im] + a [im] * b [re];
+
+    ab [re] += product_re * scale;
+    ab [im] += product_im * scale;
+}
+
+/* A scalar version of pffft_zconvolve_accumulate() for spectra which
+ * aren't aligned or aren't single precision. */
+static void convolve_accumulate (struct atfft_dft_unordered *dft,
+                                 const atfft_sample *a,
+                                 const atfft_sample *b,
+                                 atfft_sample scale,
+                                 atfft_sample *ab)
+{
+    int n = dft->n_values;
+    int simd_size = pffft_simd_size();
+
+    if (simd_size == 1)
+    {
+        /* Without SIMD the spectra are in fftpack order, real spectra have
+         * the DC and Nyquist bins on their own at either end. */
+        int first = 0, last = n;
+
+        if (dft->format == ATFFT_REAL)
+        {
+            ab [0] += a [0] * b [0] * scale;
+            ab [n - 1] += a [n - 1] * b [n - 1] * scale;
+            first = 1;
+            last = n - 1;
+        }
+
+        for (int i = first; i < last; i += 2)
+            multiply_accumulate (a, b, scale, ab, i, i + 1);
+    }
+    else
+    {
+        /* With SIMD the spectra are blocks of simd_size real parts followed
+         * by simd_size imaginary parts. Real spectra keep the DC and Nyquist
+         * bins in the first real and imaginary slots. */
+        atfft_sample dc = ab [0] + a [0] * b [0] * scale;
+        atfft_sample nyquist = ab [simd_size] + a [simd_size] * b [simd_size] * scale;
+
+        for (int block = 0; block < n; block += 2 * simd_size)
+        {
+            for (int k = 0; k < simd_size; ++k)
+                multiply_accumulate (a, b, scale, ab, block + k, block + simd_size + k);
+        }
+
+        if (dft->format == ATFFT_REAL)
+        {
+            ab [0] = dc;
+            ab [simd_size] = nyquist;
+        }
+    }
+}
+
+void atfft_dft_unordered_convolve_accumulate (struct atfft_dft_unordered *dft,
+                                              const atfft_sample *a,
+                                              const atfft_sample *b,
+                                              atfft_sample scale,
+                                              atfft_sample *ab)
+{
+#ifdef ATFFT_TYPE_FLOAT
+    if (is_aligned (a) && is_aligned (b) && is_aligned (ab))
+    {
+        pffft_zconvolve_accumulate (dft->plan, a, b, ab, scale);
+        return;
+    }
+#endif
+
+    convolve_accumulate (dft, a, b, scale, ab);
+}
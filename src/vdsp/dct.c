@@ -24,6 +24,7 @@
 #include <assert.h>
 #include <Accelerate/Accelerate.h>
 #include <atfft/dct.h>
+#include "../atfft/dct_generic.h"
 
 #ifndef ATFFT_TYPE_FLOAT
 #   warning vDSP DCTs only support single precision floating point, \
@@ -38,6 +39,9 @@ struct atfft_dct
     float *in, *out;
 #endif
     vDSP_DFT_Setup setup;
+
+    /* the other transform types are built on the vDSP DFT */
+    struct atfft_dct_generic *generic;
 };
 
 int atfft_is_supported_length_vdsp_dct (unsigned int length)
@@ -54,6 +58,22 @@ int atfft_is_supported_length_vdsp_dct (unsigned int length)
         return 0;
 }
 
+int atfft_dct_is_supported_size (int size)
+{
+    return atfft_is_supported_length_vdsp_dct (size);
+}
+
+static int atfft_dct_is_vdsp_type (int size, enum atfft_dct_type type)
+{
+    /* Only DCT-II and DCT-III plans are wrapped for vDSP. */
+    return (type == ATFFT_DCT_II || type == ATFFT_DCT_III) && atfft_is_supported_length_vdsp_dct (size);
+}
+
+int atfft_dct_is_supported_type (int size, enum atfft_dct_type type)
+{
+    return atfft_dct_is_vdsp_type (size, type) || atfft_dct_generic_is_supported_type (size, type);
+}
+
 struct atfft_dct* atfft_dct_create (int size, enum atfft_direction direction)
 {
     struct atfft_dct *dct;
@@ -61,7 +81,7 @@ struct atfft_dct* atfft_dct_create (int size, enum atfft_direction direction)
     /* vDSP only supports certain lengths */
     assert (atfft_is_supported_length_vdsp_dct (size));
 
-    if (!(dct = malloc (sizeof (*dct))))
+    if (!(dct = calloc (1, sizeof (*dct))))
         return NULL;
 
     dct->size = size;
@@ -90,11 +110,39 @@ struct atfft_dct* atfft_dct_create (int size, enum atfft_direction direction)
     return dct;
 }
 
+struct atfft_dct* atfft_dct_create_type (int size, enum atfft_dct_type type)
+{
+    assert (atfft_dct_is_supported_type (size, type));
+
+    if (atfft_dct_is_vdsp_type (size, type))
+        return atfft_dct_create (size, type == ATFFT_DCT_II ? ATFFT_FORWARD : ATFFT_BACKWARD);
+
+    struct atfft_dct *dct;
+
+    if (!(dct = calloc (1, sizeof (*dct))))
+        return NULL;
+
+    dct->size = size;
+    dct->generic = atfft_dct_generic_create (size, type);
+
+    if (!dct->generic)
+    {
+        free (dct);
+        return NULL;
+    }
+
+    return dct;
+}
+
 void atfft_dct_destroy (struct atfft_dct *dct)
 {
     if (dct)
     {
-        vDSP_DFT_DestroySetup (dct->setup);
+        atfft_dct_generic_destroy (dct->generic);
+
+        if (dct->setup)
+            vDSP_DFT_DestroySetup (dct->setup);
+
 #ifndef ATFFT_TYPE_FLOAT
         free (dct->out);
         free (dct->in);
@@ -105,6 +153,12 @@ void atfft_dct_destroy (struct atfft_dct *dct)
 
 void atfft_dct_transform (struct atfft_dct *dct, const atfft_sample *in, atfft_sample *out)
 {
+    if (dct->generic)
+    {
+        atfft_dct_generic_transform (dct->generic, in, out);
+        return;
+    }
+
 #ifdef ATFFT_TYPE_FLOAT
     vDSP_DCT_Execute (dct->setup, in, out);
 #else
@@ -113,3 +167,10 @@ void atfft_dct_transform (struct atfft_dct *dct, const atfft_sample *in, atfft_s
     atfft_float_to_sample_real (dct->out, out, dct->size);
 #endif
 }
+
+int atfft_dct_set_window (struct atfft_dct *dct, const atfft_sample *window)
+{
+    /* Only MDCTs have windows, and they use the generic implementation. */
+    assert (dct->generic);
+    return atfft_dct_generic_set_window (dct->generic, window);
+}
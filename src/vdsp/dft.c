@@ -20,10 +20,14 @@
  * SOFTWARE.
  */
 
+#define ATFFT_DFT_BACKEND vdsp
+#include "../atfft/dft_backend_internal.h"
+
 #include <stdlib.h>
 #include <assert.h>
 #include <Accelerate/Accelerate.h>
 #include <atfft/dft.h>
+#include <atfft/dft_util.h>
 
 #ifdef ATFFT_TYPE_LONG_DOUBLE
 #   warning vDSP only supports double precision floating point, \
@@ -56,18 +60,18 @@ struct atfft_dft
     ATFFT_VDSP_DFT_SETUP setup;
 };
 
-int atfft_is_supported_length_vdsp_dft (unsigned int length, enum atfft_format format)
+int atfft_dft_is_supported_size (int size, enum atfft_format format)
 {
     int min = 8;
 
-    if (atfft_is_power_of_2 (length))
+    if (atfft_is_power_of_2 (size))
         return 1;
 
     if (format == ATFFT_REAL)
         min = 16;
 
-    if ((!(length % 3) && atfft_is_power_of_2 (length / 3) && (length / 3 >= min)) ||
-        (!(length % 5) && atfft_is_power_of_2 (length / 5) && (length / 5 >= min)))
+    if ((!(size % 3) && atfft_is_power_of_2 (size / 3) && (size / 3 >= min)) ||
+        (!(size % 5) && atfft_is_power_of_2 (size / 5) && (size / 5 >= min)))
         return 1;        
     else
         return 0;
@@ -79,7 +83,7 @@ struct atfft_dft* atfft_dft_create (int size, enum atfft_direction direction, en
     vDSP_DFT_Direction vdspDirection;
 
     /* vDSP only supports certain lengths */
-    assert (atfft_is_supported_length_vdsp_dft (size, format));
+    assert (atfft_dft_is_supported_size (size, format));
 
     if (!(fft = malloc (sizeof (*fft))))
         return NULL;
@@ -118,6 +122,20 @@ struct atfft_dft* atfft_dft_create (int size, enum atfft_direction direction, en
     return fft;
 }
 
+struct atfft_dft* atfft_dft_create_pruned (int size,
+                                           enum atfft_direction direction,
+                                           enum atfft_format format,
+                                           int n_inputs,
+                                           int first_output,
+                                           int n_outputs)
+{
+    /* vDSP has no pruned transforms, so fall back to a full one. */
+    if (!atfft_dft_is_valid_pruning (size, direction, format, n_inputs, first_output, n_outputs))
+        return NULL;
+
+    return atfft_dft_create (size, direction, format);
+}
+
 void atfft_dft_destroy (struct atfft_dft *fft)
 {
     if (fft)
@@ -245,3 +263,20 @@ void atfft_dft_real_backward_transform (struct atfft_dft *fft, atfft_complex *in
     atfft_real_vdsp_to_fftw (fft->outR, fft->outI, out, fft->size);
 }
 
+#ifdef ATFFT_MULTI_BACKEND
+const struct atfft_dft_backend ATFFT_DFT_BACKEND_SYMBOL (backend) =
+{
+    .name = ATFFT_DFT_BACKEND_NAME,
+    .is_supported_size = atfft_dft_is_supported_size,
+    .create = atfft_dft_create,
+    .create_pruned = atfft_dft_create_pruned,
+    .destroy = atfft_dft_destroy,
+    .complex_transform = atfft_dft_complex_transform,
+    .complex_transform_stride = NULL,
+    .real_forward_transform = atfft_dft_real_forward_transform,
+    .real_forward_transform_stride = NULL,
+    .real_backward_transform = atfft_dft_real_backward_transform,
+    .real_backward_transform_stride = NULL,
+    .print_plan = NULL
+};
+#endif